@@ -1,15 +1,16 @@
 #include "AdjacencyMatrix.h"
+#include "BinaryGraphFile.h"
+#include "MatrixTextParser.h"
 
+#include <iostream>
 #include <sstream>
 #include <iomanip>
-#include <fstream>
-#include <iostream>
 
 std::string AdjacencyMatrix::toString() const {
 	std::stringstream stringRepresentation;
 	for (int i = 0; i < m_numberOfVertices; ++i) {
 		for (int j = 0; j < m_numberOfVertices; ++j) {
-			stringRepresentation << std::setw(5) << m_matrix.at(j * m_numberOfVertices + i) << " ";
+			stringRepresentation << std::setw(5) << m_weights.at(j * m_numberOfVertices + i) << " ";
 		}
 		stringRepresentation << std::endl;
 	}
@@ -17,19 +18,34 @@ std::string AdjacencyMatrix::toString() const {
 }
 
 
-void AdjacencyMatrix::readDataFromFile(const std::string& filePath) {
+void AdjacencyMatrix::readDataFromFile(const std::string& filePath, int numberOfThreads) {
 
-	std::ifstream infile(filePath, std::ifstream::in);
-	if (!infile.is_open()) {
-		std::cout << "Plik " << filePath << " nie istnieje." << std::endl;
+	// file with signature of binary graph is never parsed as text, even if it is not valid
+	if (BinaryGraphFile::checkIfFileIsBinaryGraph(filePath)) {
+		readDataFromBinaryFile(filePath);
 		return;
 	}
 
-	infile >> m_numberOfVertices;
-	m_matrix.resize(m_numberOfVertices * m_numberOfVertices, 0);
-	for (int i = 0; i < m_numberOfVertices; ++i) {
-		for (int j = 0; j < m_numberOfVertices; ++j) {
-			infile >> m_matrix.at(j * m_numberOfVertices + i);
-		}
+	MatrixTextParser::parseFile(filePath, numberOfThreads, m_matrix, m_numberOfVertices);
+	m_weights = m_matrix;
+}
+
+
+bool AdjacencyMatrix::readDataFromBinaryFile(const std::string& filePath) {
+
+	std::unique_ptr<MappedFile> mappedFile = MappedFile::open(filePath);
+	const BinaryGraphFile::Header* header = mappedFile ? BinaryGraphFile::readHeader(*mappedFile, filePath) : nullptr;
+	if (header == nullptr) {
+		return false;
 	}
+	if (header->layout != BinaryGraphFile::DenseColumnWise) {
+		std::cout << "Plik " << filePath << " zawiera graf rzadki, uzyj opcji --sparse." << std::endl;
+		return false;
+	}
+
+	// dense graph is stored exactly the same way, so no copy is needed
+	m_numberOfVertices = static_cast<int>(header->numberOfVertices);
+	m_weights = BinaryGraphFile::getDenseWeights(*mappedFile);
+	m_mappedFile = std::move(mappedFile);
+	return true;
 }
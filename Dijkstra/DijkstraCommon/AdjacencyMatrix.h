@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include "ArrayView.h"
+#include "MappedFile.h"
+
 #include <vector>
 #include <string>
 #include <memory>
@@ -20,16 +23,22 @@ public:
 
 	/// <summary> 
 	/// Static factory method used for creating instance of adjacency matrix. 
+	/// Data file can be either text file or binary graph file (see BinaryGraphFile) - 
+	/// dense binary graph is mapped into memory and used without copying, text file
+	/// is parsed by multiple threads (see MatrixTextParser).
 	/// </summary>
 	/// <returns>
 	/// Unique pointer that points to created matrix. If data file could not 
-	/// be opened, created matrix contains no data.
+	/// be opened or is not valid, created matrix contains no data.
 	/// </returns>
 	/// <param name="filePath">
 	/// String with path to file that contains adjacency matrix information.
 	/// </param>
-	static inline std::unique_ptr<AdjacencyMatrix> fromFile(const std::string& filePath) {
-		return std::unique_ptr<AdjacencyMatrix>( new AdjacencyMatrix(filePath) );
+	/// <param name="numberOfThreads">
+	/// Number of threads that parse text file. By default all hardware threads are used.
+	/// </param>
+	static inline std::unique_ptr<AdjacencyMatrix> fromFile(const std::string& filePath, int numberOfThreads = 0) {
+		return std::unique_ptr<AdjacencyMatrix>( new AdjacencyMatrix(filePath, numberOfThreads) );
 	}
 
 
@@ -44,10 +53,11 @@ public:
 
 	/// <summary>
 	/// Returns matrix data in a form of continous 1D vector that contains
-	/// consecutive matrix columns.
+	/// consecutive matrix columns. Returned view is valid as long as matrix
+	/// exists.
 	/// </summary>
 	/// <returns>
-	/// Vector of doubles that represents matrix data. Data in this vector
+	/// View of doubles that represents matrix data. Data in this view
 	/// is arranged column-wise. 
 	/// <example>
 	/// If we have matrix like this:
@@ -59,8 +69,8 @@ public:
 	/// Result will look like this: [ 2 1 0 3 1 1 4 3 0 ]
 	/// </example>
 	/// </returns>
-	inline const std::vector<double>& asContinousVector() const {
-		return m_matrix;
+	inline ArrayView<double> asContinousVector() const {
+		return m_weights;
 	}
 
 
@@ -79,13 +89,31 @@ private:
 
 	/// <summary>
 	/// Private method that reads from data file and assigns values from
-	/// there to AdjacencyMatrix properties. If file could not be opened,
-	/// proper information is printed and nothing happens.
+	/// there to AdjacencyMatrix properties. If file could not be opened
+	/// or is not valid, proper information is printed and nothing happens.
 	/// </summary>
 	/// <param name="filePath">
 	/// String with path to file that contains adjacency matrix information.
 	/// </param>
-	void readDataFromFile(const std::string& filePath);
+	/// <param name="numberOfThreads">
+	/// Number of threads that parse text file (lower than 1 - all hardware threads).
+	/// </param>
+	void readDataFromFile(const std::string& filePath, int numberOfThreads);
+
+
+	/// <summary>
+	/// Private method that maps binary graph file with dense graph into memory.
+	/// If file could not be opened, is not valid or contains sparse graph (which
+	/// should be loaded as SparseGraph), proper information is printed and matrix
+	/// contains no data.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if dense graph has been mapped.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to binary graph file.
+	/// </param>
+	bool readDataFromBinaryFile(const std::string& filePath);
 
 
 	/// <summary>
@@ -95,12 +123,17 @@ private:
 	/// <param name="filePath">
 	/// String with path to file that contains adjacency matrix information.
 	/// </param>
-	AdjacencyMatrix(const std::string& filePath){
-		readDataFromFile(filePath);
+	/// <param name="numberOfThreads">
+	/// Number of threads that parse text file.
+	/// </param>
+	AdjacencyMatrix(const std::string& filePath, int numberOfThreads){
+		readDataFromFile(filePath, numberOfThreads);
 	}
 
 
 	std::vector<double> m_matrix;
+	std::unique_ptr<MappedFile> m_mappedFile;
+	ArrayView<double> m_weights;
 	int m_numberOfVertices = 0;
 
 };
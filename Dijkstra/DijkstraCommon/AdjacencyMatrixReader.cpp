@@ -0,0 +1,60 @@
+#include "AdjacencyMatrixReader.h"
+
+#include <iostream>
+
+
+AdjacencyMatrixReader::AdjacencyMatrixReader(const std::string& filePath) {
+
+	if (BinaryGraphFile::checkIfFileIsBinaryGraph(filePath)) {
+		m_mappedFile = MappedFile::open(filePath);
+		const BinaryGraphFile::Header* header = m_mappedFile ? BinaryGraphFile::readHeader(*m_mappedFile, filePath) : nullptr;
+		if (header == nullptr) {
+			m_mappedFile.reset();
+			return;
+		}
+
+		m_numberOfVertices = static_cast<int>(header->numberOfVertices);
+		if (header->layout == BinaryGraphFile::DenseColumnWise) {
+			m_denseWeights = BinaryGraphFile::getDenseWeights(*m_mappedFile);
+		}
+		else {
+			m_compressedArrays = BinaryGraphFile::getCompressedArrays(*m_mappedFile, -1);
+		}
+		return;
+	}
+
+	m_file.open(filePath, std::ifstream::in);
+	if (!m_file.is_open()) {
+		std::cout << "Plik " << filePath << " nie istnieje." << std::endl;
+		return;
+	}
+	m_file >> m_numberOfVertices;
+}
+
+
+bool AdjacencyMatrixReader::readNextRow(std::vector<double>& row) {
+	if (m_numberOfRowsRead >= m_numberOfVertices) {
+		return false;
+	}
+
+	row.assign(m_numberOfVertices, 0);
+	if (!m_denseWeights.empty()) {
+
+		// row of column-wise arranged matrix - every N-th weight
+		for (int j = 0; j < m_numberOfVertices; ++j) {
+			row[j] = m_denseWeights[static_cast<size_t>(j) * m_numberOfVertices + m_numberOfRowsRead];
+		}
+	}
+	else if (m_mappedFile) {
+		for (int e = m_compressedArrays.offsets[m_numberOfRowsRead]; e < m_compressedArrays.offsets[m_numberOfRowsRead + 1]; ++e) {
+			row.at(m_compressedArrays.targets[e]) = m_compressedArrays.weights[e];
+		}
+	}
+	else {
+		for (int j = 0; j < m_numberOfVertices; ++j) {
+			m_file >> row[j];
+		}
+	}
+	++m_numberOfRowsRead;
+	return true;
+}
@@ -0,0 +1,68 @@
+/**
+*	@file AdjacencyMatrixReader.h
+*	@brief This file contains class responsible for reading adjacency matrix
+*	from file row after row, without storing whole matrix in memory.
+*/
+
+#pragma once
+
+#include "BinaryGraphFile.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// This class reads adjacency matrix data file row after row. It is used by
+/// AdjacencyMatrix, and directly by code that must not hold whole matrix in
+/// memory at once. Binary graph files (see BinaryGraphFile) are mapped into
+/// memory and their rows are assembled without parsing. Please note that this class is final - to use it, consider
+/// composition (not inheritance).
+/// </summary>
+class AdjacencyMatrixReader final {
+
+public:
+
+	/// <summary>
+	/// Constructor - opens data file and reads number of vertices from it. If
+	/// file could not be opened, proper information is printed and number of
+	/// vertices is set to 0.
+	/// </summary>
+	/// <param name="filePath">
+	/// String with path to file that contains adjacency matrix information.
+	/// </param>
+	explicit AdjacencyMatrixReader(const std::string& filePath);
+
+
+	/// <summary>
+	/// Returns number of graph vertices - same number as number of rows
+	/// or columns in adjacency matrix
+	/// </summary>
+	inline int getNumberOfVertices() const {
+		return m_numberOfVertices;
+	}
+
+
+	/// <summary>
+	/// Reads next row of adjacency matrix - weights of edges leaving next vertex.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if row has been read (false if all rows have already
+	/// been read).
+	/// </returns>
+	/// <param name="row">
+	/// Vector that is filled with weights - row[j] is weight of edge leading to vertex j.
+	/// </param>
+	bool readNextRow(std::vector<double>& row);
+
+private:
+
+	std::ifstream m_file;
+	std::unique_ptr<MappedFile> m_mappedFile;
+	ArrayView<double> m_denseWeights;
+	BinaryGraphFile::CompressedArrays m_compressedArrays;
+	int m_numberOfVertices = 0;
+	int m_numberOfRowsRead = 0;
+
+};
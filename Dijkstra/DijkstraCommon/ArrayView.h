@@ -0,0 +1,91 @@
+/**
+*	@file ArrayView.h
+*	@brief This file contains template class that gives read-only access to
+*	continous array stored somewhere else.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/// <summary>
+/// Read-only view of continous array - it does not own the data, so the data
+/// must live longer than the view. Graph data can be stored either in vectors
+/// or in memory mapped file, and this class allows algorithms to read both in
+/// the same way. Please note that this class is final - to use it, consider
+/// composition (not inheritance).
+/// </summary>
+template<typename T>
+class ArrayView final {
+
+public:
+
+	/// <summary>
+	/// Default constructor - creates empty view.
+	/// </summary>
+	ArrayView() = default;
+
+
+	/// <summary>
+	/// Constructor - creates view of given array.
+	/// </summary>
+	/// <param name="data">
+	/// Pointer to first element of array.
+	/// </param>
+	/// <param name="size">
+	/// Number of elements in array.
+	/// </param>
+	ArrayView(const T* data, size_t size) : m_data(data), m_size(size) {}
+
+
+	/// <summary>
+	/// Constructor - creates view of data stored in vector. It is not explicit,
+	/// so vectors can be passed wherever view is expected.
+	/// </summary>
+	ArrayView(const std::vector<T>& vector) : m_data(vector.data()), m_size(vector.size()) {}
+
+
+	inline const T* data() const {
+		return m_data;
+	}
+
+	inline size_t size() const {
+		return m_size;
+	}
+
+	inline bool empty() const {
+		return m_size == 0;
+	}
+
+	inline const T* begin() const {
+		return m_data;
+	}
+
+	inline const T* end() const {
+		return m_data + m_size;
+	}
+
+	inline const T& operator[](size_t index) const {
+		return m_data[index];
+	}
+
+
+	/// <summary>
+	/// Returns element with given index - throws std::out_of_range exception
+	/// if index is not valid, exactly like std::vector does.
+	/// </summary>
+	inline const T& at(size_t index) const {
+		if (index >= m_size) {
+			throw std::out_of_range("ArrayView::at");
+		}
+		return m_data[index];
+	}
+
+private:
+
+	const T* m_data = nullptr;
+	size_t m_size = 0;
+
+};
@@ -0,0 +1,229 @@
+#include "BinaryGraphFile.h"
+#include "AdjacencyMatrix.h"
+#include "SparseGraph.h"
+
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+	const char binaryGraphSignature[8] = { 'D', 'J', 'K', 'G', 'R', 'A', 'P', 'H' };
+	const std::uint32_t byteOrderMark = 0x01020304;
+
+	static_assert(sizeof(BinaryGraphFile::Header) == 64, "Header of binary graph file must be 64 bytes long");
+	static_assert(sizeof(BinaryGraphFile::BlockIndexEntry) == 24, "Entry of column-block index must be 24 bytes long");
+	static_assert(sizeof(int) == sizeof(std::int32_t), "Offsets and targets are stored as 32-bit integers");
+
+}
+
+
+bool BinaryGraphFile::checkIfFileIsBinaryGraph(const std::string& filePath) {
+	char signature[sizeof(binaryGraphSignature)] = {};
+	std::ifstream file(filePath, std::ifstream::in | std::ifstream::binary);
+	file.read(signature, sizeof(signature));
+	return file.gcount() == sizeof(signature) && std::memcmp(signature, binaryGraphSignature, sizeof(signature)) == 0;
+}
+
+
+const BinaryGraphFile::Header* BinaryGraphFile::readHeader(const MappedFile& file, const std::string& filePath) {
+
+	if (file.getSize() < sizeof(Header) || std::memcmp(file.getData(), binaryGraphSignature, sizeof(binaryGraphSignature)) != 0) {
+		std::cout << "Plik " << filePath << " nie jest binarnym plikiem grafu." << std::endl;
+		return nullptr;
+	}
+
+	const Header* header = reinterpret_cast<const Header*>(file.getData());
+	if (header->version != formatVersion) {
+		std::cout << "Plik " << filePath << " ma nieobslugiwana wersje formatu (" << header->version << ")." << std::endl;
+		return nullptr;
+	}
+	if (header->byteOrderMark != byteOrderMark) {
+		std::cout << "Plik " << filePath << " zostal zapisany na maszynie o innej kolejnosci bajtow." << std::endl;
+		return nullptr;
+	}
+
+	// every section described by header must fit in the file
+	std::uint64_t fileSize = file.getSize();
+	bool isValid = header->numberOfVertices >= 0 && header->numberOfVertices <= INT_MAX
+		&& header->numberOfEdges >= 0 && header->numberOfEdges <= INT_MAX
+		&& header->dataOffset >= sizeof(Header) && header->dataOffset % sectionAlignment == 0 && header->dataOffset <= fileSize;
+	if (isValid && header->layout == DenseColumnWise) {
+		std::uint64_t numberOfWeights = static_cast<std::uint64_t>(header->numberOfVertices) * header->numberOfVertices;
+		isValid = numberOfWeights <= (fileSize - header->dataOffset) / sizeof(double) && header->numberOfBlocks == 0;
+	}
+	else if (isValid && header->layout == CompressedSparseRows) {
+		isValid = computeEndOfCompressedArrays(header->dataOffset, header->numberOfVertices, header->numberOfEdges) <= fileSize;
+		if (isValid && header->numberOfBlocks > 0) {
+			isValid = header->blockIndexOffset % sectionAlignment == 0
+				&& header->blockIndexOffset + header->numberOfBlocks * sizeof(BlockIndexEntry) <= fileSize;
+			for (std::uint32_t b = 0; isValid && b < header->numberOfBlocks; ++b) {
+				const BlockIndexEntry& entry = getBlockIndexEntry(file, static_cast<int>(b));
+				isValid = entry.firstVertex >= 0 && entry.lastVertex < header->numberOfVertices && entry.firstVertex <= entry.lastVertex + 1
+					&& entry.numberOfEdges >= 0 && entry.numberOfEdges <= header->numberOfEdges && entry.dataOffset % sectionAlignment == 0
+					&& computeEndOfCompressedArrays(entry.dataOffset, header->numberOfVertices, entry.numberOfEdges) <= fileSize;
+			}
+		}
+	}
+	else {
+		isValid = false;
+	}
+
+	if (!isValid) {
+		std::cout << "Plik " << filePath << " zawiera niepoprawne dane." << std::endl;
+		return nullptr;
+	}
+	return header;
+}
+
+
+ArrayView<double> BinaryGraphFile::getDenseWeights(const MappedFile& file) {
+	const Header* header = reinterpret_cast<const Header*>(file.getData());
+	return ArrayView<double>(reinterpret_cast<const double*>(file.getData() + header->dataOffset),
+		static_cast<size_t>(header->numberOfVertices) * static_cast<size_t>(header->numberOfVertices));
+}
+
+
+BinaryGraphFile::CompressedArrays BinaryGraphFile::getCompressedArrays(const MappedFile& file, int blockIndex) {
+	const Header* header = reinterpret_cast<const Header*>(file.getData());
+	if (blockIndex < 0) {
+		return getCompressedArraysAt(file, header->dataOffset, header->numberOfVertices, header->numberOfEdges);
+	}
+	const BlockIndexEntry& entry = getBlockIndexEntry(file, blockIndex);
+	return getCompressedArraysAt(file, entry.dataOffset, header->numberOfVertices, entry.numberOfEdges);
+}
+
+
+const BinaryGraphFile::BlockIndexEntry& BinaryGraphFile::getBlockIndexEntry(const MappedFile& file, int blockIndex) {
+	const Header* header = reinterpret_cast<const Header*>(file.getData());
+	return reinterpret_cast<const BlockIndexEntry*>(file.getData() + header->blockIndexOffset)[blockIndex];
+}
+
+
+bool BinaryGraphFile::writeDenseGraph(const std::string& filePath, const AdjacencyMatrix& matrix) {
+
+	std::ofstream file(filePath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+	if (!file.is_open()) {
+		std::cout << "Nie mozna utworzyc pliku " << filePath << "." << std::endl;
+		return false;
+	}
+
+	Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, binaryGraphSignature, sizeof(binaryGraphSignature));
+	header.version = formatVersion;
+	header.layout = DenseColumnWise;
+	header.byteOrderMark = byteOrderMark;
+	header.numberOfVertices = matrix.getNumberOfVertices();
+	header.numberOfEdges = 0;
+	header.dataOffset = sizeof(Header);
+
+	ArrayView<double> weights = matrix.asContinousVector();
+	writeSection(file, &header, sizeof(header));
+	writeSection(file, weights.data(), weights.size() * sizeof(double));
+
+	if (!file.good()) {
+		std::cout << "Nie mozna zapisac pliku " << filePath << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+bool BinaryGraphFile::writeSparseGraph(const std::string& filePath, const SparseGraph& graph, int numberOfBlocks) {
+
+	std::ofstream file(filePath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+	if (!file.is_open()) {
+		std::cout << "Nie mozna utworzyc pliku " << filePath << "." << std::endl;
+		return false;
+	}
+
+	// blocks of target vertices - the first ones are one vertex longer if vertices can not be divided evenly
+	int numberOfVertices = graph.getNumberOfVertices();
+	std::vector<std::unique_ptr<SparseGraph>> blocks;
+	std::vector<BlockIndexEntry> blockIndex(numberOfBlocks);
+	for (int b = 0, firstVertex = 0; b < numberOfBlocks; ++b) {
+		int blockSize = numberOfVertices / numberOfBlocks + (b < numberOfVertices % numberOfBlocks ? 1 : 0);
+		blocks.push_back(graph.extractEdgesWithTargetsInRange(std::make_pair(firstVertex, firstVertex + blockSize - 1)));
+		blockIndex[b].firstVertex = firstVertex;
+		blockIndex[b].lastVertex = firstVertex + blockSize - 1;
+		blockIndex[b].numberOfEdges = blocks.back()->getNumberOfEdges();
+		firstVertex += blockSize;
+	}
+
+	Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, binaryGraphSignature, sizeof(binaryGraphSignature));
+	header.version = formatVersion;
+	header.layout = CompressedSparseRows;
+	header.byteOrderMark = byteOrderMark;
+	header.numberOfVertices = numberOfVertices;
+	header.numberOfEdges = graph.getNumberOfEdges();
+	header.dataOffset = sizeof(Header);
+	header.numberOfBlocks = static_cast<std::uint32_t>(numberOfBlocks);
+
+	// offsets of all sections are known before anything is written
+	std::uint64_t nextOffset = computeEndOfCompressedArrays(header.dataOffset, header.numberOfVertices, header.numberOfEdges);
+	if (numberOfBlocks > 0) {
+		header.blockIndexOffset = alignOffset(nextOffset);
+		nextOffset = header.blockIndexOffset + numberOfBlocks * sizeof(BlockIndexEntry);
+		for (BlockIndexEntry& entry : blockIndex) {
+			entry.dataOffset = alignOffset(nextOffset);
+			nextOffset = computeEndOfCompressedArrays(entry.dataOffset, header.numberOfVertices, entry.numberOfEdges);
+		}
+	}
+
+	writeSection(file, &header, sizeof(header));
+	writeSection(file, graph.getOffsets().data(), graph.getOffsets().size() * sizeof(int));
+	writeSection(file, graph.getTargets().data(), graph.getTargets().size() * sizeof(int));
+	writeSection(file, graph.getWeights().data(), graph.getWeights().size() * sizeof(double));
+	if (numberOfBlocks > 0) {
+		writeSection(file, blockIndex.data(), blockIndex.size() * sizeof(BlockIndexEntry));
+		for (const auto& block : blocks) {
+			writeSection(file, block->getOffsets().data(), block->getOffsets().size() * sizeof(int));
+			writeSection(file, block->getTargets().data(), block->getTargets().size() * sizeof(int));
+			writeSection(file, block->getWeights().data(), block->getWeights().size() * sizeof(double));
+		}
+	}
+
+	if (!file.good()) {
+		std::cout << "Nie mozna zapisac pliku " << filePath << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+std::uint64_t BinaryGraphFile::alignOffset(std::uint64_t offset) {
+	return (offset + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+}
+
+
+std::uint64_t BinaryGraphFile::computeEndOfCompressedArrays(std::uint64_t dataOffset, std::int64_t numberOfVertices, std::int64_t numberOfEdges) {
+	std::uint64_t targetsOffset = alignOffset(dataOffset + (numberOfVertices + 1) * sizeof(int));
+	std::uint64_t weightsOffset = alignOffset(targetsOffset + numberOfEdges * sizeof(int));
+	return weightsOffset + numberOfEdges * sizeof(double);
+}
+
+
+BinaryGraphFile::CompressedArrays BinaryGraphFile::getCompressedArraysAt(const MappedFile& file, std::uint64_t dataOffset, std::int64_t numberOfVertices, std::int64_t numberOfEdges) {
+	std::uint64_t targetsOffset = alignOffset(dataOffset + (numberOfVertices + 1) * sizeof(int));
+	std::uint64_t weightsOffset = alignOffset(targetsOffset + numberOfEdges * sizeof(int));
+
+	CompressedArrays arrays;
+	arrays.offsets = ArrayView<int>(reinterpret_cast<const int*>(file.getData() + dataOffset), static_cast<size_t>(numberOfVertices + 1));
+	arrays.targets = ArrayView<int>(reinterpret_cast<const int*>(file.getData() + targetsOffset), static_cast<size_t>(numberOfEdges));
+	arrays.weights = ArrayView<double>(reinterpret_cast<const double*>(file.getData() + weightsOffset), static_cast<size_t>(numberOfEdges));
+	return arrays;
+}
+
+
+void BinaryGraphFile::writeSection(std::ostream& file, const void* data, std::uint64_t size) {
+	file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+	std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+	std::vector<char> padding(alignOffset(position) - position, 0);
+	file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+}
@@ -0,0 +1,224 @@
+/**
+*	@file BinaryGraphFile.h
+*	@brief This file contains BinaryGraphFile class responsible for writing
+*	graphs in binary format and for reading them from memory mapped files.
+*/
+
+#pragma once
+
+#include "ArrayView.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+class AdjacencyMatrix;
+class SparseGraph;
+
+/// <summary>
+/// This class contains static methods that write graphs in binary format and
+/// give access to data of binary graph file mapped into memory - without parsing
+/// and without copying. Please note that all methods are static.
+/// </summary>
+/// <remarks>
+/// File starts with 64-byte header (see Header structure). Every section that
+/// follows it starts at offset that is a multiple of 64 bytes, so arrays of
+/// doubles are aligned for vectorized kernels. All numbers are written in native
+/// byte order of the machine (the header contains byte order mark).
+/// <list type="bullet">
+/// <item>Dense graph: N * N doubles arranged column-wise - exactly like data
+/// returned by AdjacencyMatrix (entry [j * N + i] is weight of edge i -> j).</item>
+/// <item>Sparse graph: compressed sparse rows - N + 1 32-bit offsets, E 32-bit
+/// targets and E doubles (weights), each array in its own section.</item>
+/// </list>
+/// Sparse graph can contain optional column-block index: graph is divided into
+/// blocks of target vertices (the same way DijkstraMPI divides vertices between
+/// processes) and for each block the file contains its own compressed sparse rows
+/// with edges leading to vertices of this block only. Index entries describe
+/// blocks (see BlockIndexEntry structure). Column blocks of dense graph are always
+/// continous, so dense graph does not need index.
+/// </remarks>
+class BinaryGraphFile final {
+
+public:
+
+	/// <summary>
+	/// Layouts of graph data.
+	/// </summary>
+	enum Layout : std::uint32_t {
+		DenseColumnWise = 1,
+		CompressedSparseRows = 2
+	};
+
+
+	/// <summary>
+	/// Header of binary graph file - first 64 bytes of the file.
+	/// </summary>
+	struct Header {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t layout;
+		std::uint32_t byteOrderMark;
+		std::uint32_t reserved;
+		std::int64_t numberOfVertices;
+		std::int64_t numberOfEdges;
+		std::uint64_t dataOffset;
+		std::uint64_t blockIndexOffset;
+		std::uint32_t numberOfBlocks;
+		std::uint32_t reservedForFutureUse;
+	};
+
+
+	/// <summary>
+	/// Entry of column-block index - range of target vertices [a, b] of the block,
+	/// number of its edges and offset of its compressed sparse rows in the file.
+	/// </summary>
+	struct BlockIndexEntry {
+		std::int32_t firstVertex;
+		std::int32_t lastVertex;
+		std::int64_t numberOfEdges;
+		std::uint64_t dataOffset;
+	};
+
+
+	/// <summary>
+	/// Views of compressed sparse rows stored in mapped file.
+	/// </summary>
+	struct CompressedArrays {
+		ArrayView<int> offsets;
+		ArrayView<int> targets;
+		ArrayView<double> weights;
+	};
+
+
+	/// <summary>
+	/// Default constructor. Because this class contains only static methods, it
+	/// has been deleted.
+	/// </summary>
+	BinaryGraphFile() = delete;
+
+
+	/// <summary>
+	/// Checks if given file starts with binary graph file signature. Used to choose
+	/// between text and binary format, so files can be passed to all executables
+	/// without additional options.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file is binary graph file.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to file.
+	/// </param>
+	static bool checkIfFileIsBinaryGraph(const std::string& filePath);
+
+
+	/// <summary>
+	/// Validates header of mapped file and checks if all sections it describes fit
+	/// in the file. If file is not valid, proper information is printed.
+	/// </summary>
+	/// <returns>
+	/// Pointer to header stored in mapped file, or nullptr if file is not valid.
+	/// </returns>
+	/// <param name="file">
+	/// Mapped binary graph file.
+	/// </param>
+	/// <param name="filePath">
+	/// String with path to file - used in printed information.
+	/// </param>
+	static const Header* readHeader(const MappedFile& file, const std::string& filePath);
+
+
+	/// <summary>
+	/// Returns view of weights of dense graph - arranged column-wise. File should be
+	/// validated with readHeader first.
+	/// </summary>
+	static ArrayView<double> getDenseWeights(const MappedFile& file);
+
+
+	/// <summary>
+	/// Returns views of compressed sparse rows of sparse graph or of its block. File
+	/// should be validated with readHeader first.
+	/// </summary>
+	/// <param name="file">
+	/// Mapped binary graph file.
+	/// </param>
+	/// <param name="blockIndex">
+	/// Index of column block, or -1 for the whole graph.
+	/// </param>
+	static CompressedArrays getCompressedArrays(const MappedFile& file, int blockIndex);
+
+
+	/// <summary>
+	/// Returns column-block index entry of sparse graph. File should be validated with
+	/// readHeader first and blockIndex should be lower than number of blocks.
+	/// </summary>
+	static const BlockIndexEntry& getBlockIndexEntry(const MappedFile& file, int blockIndex);
+
+
+	/// <summary>
+	/// Writes dense graph to binary file. If file could not be created, proper information
+	/// is printed.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file has been written.
+	/// </returns>
+	/// <param name="filePath">
+	/// Path to output file. Existing file is overwritten.
+	/// </param>
+	/// <param name="matrix">
+	/// Graph stored as adjacency matrix.
+	/// </param>
+	static bool writeDenseGraph(const std::string& filePath, const AdjacencyMatrix& matrix);
+
+
+	/// <summary>
+	/// Writes sparse graph to binary file, optionally with column-block index. If file
+	/// could not be created, proper information is printed.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file has been written.
+	/// </returns>
+	/// <param name="filePath">
+	/// Path to output file. Existing file is overwritten.
+	/// </param>
+	/// <param name="graph">
+	/// Graph stored in sparse form.
+	/// </param>
+	/// <param name="numberOfBlocks">
+	/// Number of column blocks - usually number of processes DijkstraMPI will be run with.
+	/// If it is 0, index is not written.
+	/// </param>
+	static bool writeSparseGraph(const std::string& filePath, const SparseGraph& graph, int numberOfBlocks);
+
+
+	static const std::uint32_t formatVersion = 1;
+	static const std::uint64_t sectionAlignment = 64;
+
+private:
+
+	/// <summary>
+	/// Rounds offset up to the nearest multiple of section alignment.
+	/// </summary>
+	static std::uint64_t alignOffset(std::uint64_t offset);
+
+
+	/// <summary>
+	/// Computes offset of the first byte after compressed sparse rows that start at
+	/// given offset.
+	/// </summary>
+	static std::uint64_t computeEndOfCompressedArrays(std::uint64_t dataOffset, std::int64_t numberOfVertices, std::int64_t numberOfEdges);
+
+
+	/// <summary>
+	/// Returns views of compressed sparse rows that start at given offset.
+	/// </summary>
+	static CompressedArrays getCompressedArraysAt(const MappedFile& file, std::uint64_t dataOffset, std::int64_t numberOfVertices, std::int64_t numberOfEdges);
+
+
+	/// <summary>
+	/// Writes array to file and fills space up to the next section with zeros.
+	/// </summary>
+	static void writeSection(std::ostream& file, const void* data, std::uint64_t size);
+
+};
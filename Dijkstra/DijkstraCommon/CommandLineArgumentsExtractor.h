@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <sstream>
 #include <string>
+#include <vector>
 
 /// <summary>
 /// Simple helper class that contains static methods related to
@@ -41,11 +44,41 @@ public:
 	}
 
 
+	/// <summary>
+	/// Simple method that extracts indices of all source vertices - the one given as
+	/// first command line argument, followed by comma-separated vertices given in
+	/// <c>--sources</c> option. Repeated vertices are skipped. This method assumes that 
+	/// command line arguments have been validated.
+	/// </summary>
+	/// <returns>
+	/// Vector with indices of source vertices, in the order they have been given.
+	/// </returns>
+	/// <param name="argc">
+	/// Number of command line arguments.
+	/// </param>
+	/// <param name="argv">
+	/// C-style array with command line arguments. This method is designed in such
+	/// a way that argv should be passed to it directly from main function arguments.
+	/// </param>
+	static inline std::vector<int> extractSourceVerticesIndicesFromCommandLineArguments(int argc, char* argv[]) {
+		std::vector<int> sourceVerticesIndices = { extractSourceVertexIndexFromCommandLineArguments(argv) };
+		std::stringstream sources(extractOptionValue(argc, argv, "--sources", ""));
+		std::string source;
+		while (std::getline(sources, source, ',')) {
+			int sourceVertexIndex = std::stoi(source);
+			if (std::find(sourceVerticesIndices.begin(), sourceVerticesIndices.end(), sourceVertexIndex) == sourceVerticesIndices.end()) {
+				sourceVerticesIndices.push_back(sourceVertexIndex);
+			}
+		}
+		return sourceVerticesIndices;
+	}
+
+
 	/// <summary>
 	/// Simple method that extracts data file name from command line arguments. This
 	/// name should be second command line argument given by user. If it has not been
-	/// provided, default value is returned. This method assumes that command line 
-	/// arguments have been validated.
+	/// provided (or second argument is an option), default value is returned. This 
+	/// method assumes that command line arguments have been validated.
 	/// </summary>
 	/// <returns>
 	/// Data file name in form of a C++-style string.
@@ -58,7 +91,84 @@ public:
 	/// a way that argv should be passed to it directly from main function arguments.
 	/// </param>
 	static inline std::string extractInputFileNameFromCommandLineArguments(int argc, char* argv[]) {
-		return argc > 2 ? argv[2] : "../data/graph.dat";
+		return argc > 2 && !checkIfArgumentIsAnOption(argv[2]) ? argv[2] : "../data/graph.dat";
+	}
+
+
+	/// <summary>
+	/// Simple method that checks if option with given name has been provided by user.
+	/// Options are given after source vertex index in form of <c>--name</c> or
+	/// <c>--name=value</c>.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if option has been found.
+	/// </returns>
+	/// <param name="argc">
+	/// Number of command line arguments.
+	/// </param>
+	/// <param name="argv">
+	/// C-style array with command line arguments. This method is designed in such
+	/// a way that argv should be passed to it directly from main function arguments.
+	/// </param>
+	/// <param name="optionName">
+	/// Name of the option together with leading dashes, for example <c>--sparse</c>.
+	/// </param>
+	static inline bool checkIfOptionIsPresent(int argc, char* argv[], const std::string& optionName) {
+		return findOption(argc, argv, optionName) != nullptr;
+	}
+
+
+	/// <summary>
+	/// Simple method that extracts value of option given in form of <c>--name=value</c>.
+	/// If option has not been provided or has no value, default value is returned.
+	/// </summary>
+	/// <returns>
+	/// Option value in form of a C++-style string.
+	/// </returns>
+	/// <param name="argc">
+	/// Number of command line arguments.
+	/// </param>
+	/// <param name="argv">
+	/// C-style array with command line arguments. This method is designed in such
+	/// a way that argv should be passed to it directly from main function arguments.
+	/// </param>
+	/// <param name="optionName">
+	/// Name of the option together with leading dashes, for example <c>--threads</c>.
+	/// </param>
+	/// <param name="defaultValue">
+	/// Value returned if option has not been found.
+	/// </param>
+	static inline std::string extractOptionValue(int argc, char* argv[], const std::string& optionName, const std::string& defaultValue) {
+		const char* option = findOption(argc, argv, optionName);
+		if (option == nullptr || option[optionName.size()] != '=') {
+			return defaultValue;
+		}
+		return option + optionName.size() + 1;
+	}
+
+private:
+
+	/// <summary>
+	/// Checks if command line argument is an option (starts with two dashes).
+	/// </summary>
+	static inline bool checkIfArgumentIsAnOption(const std::string& argument) {
+		return argument.compare(0, 2, "--") == 0;
+	}
+
+
+	/// <summary>
+	/// Finds command line argument that represents option with given name. Returns
+	/// nullptr if it could not be found.
+	/// </summary>
+	static inline const char* findOption(int argc, char* argv[], const std::string& optionName) {
+		for (int i = 2; i < argc; ++i) {
+			std::string argument = argv[i];
+			if (argument.compare(0, optionName.size(), optionName) == 0
+				&& (argument.size() == optionName.size() || argument.at(optionName.size()) == '=')) {
+				return argv[i];
+			}
+		}
+		return nullptr;
 	}
 };
 
@@ -0,0 +1,209 @@
+#include "ContractionHierarchy.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+	const char hierarchySignature[8] = { 'D', 'J', 'K', 'C', 'H', 'I', 'E', 'R' };
+	const std::uint32_t formatVersion = 1;
+	const std::uint32_t byteOrderMark = 0x01020304;
+	const std::uint64_t sectionAlignment = 64;
+
+	static_assert(sizeof(ContractionHierarchy::Header) == 64, "Header of hierarchy file must be 64 bytes long");
+
+	std::uint64_t alignOffset(std::uint64_t offset) {
+		return (offset + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+	}
+
+	void writeSection(std::ostream& file, const void* data, std::uint64_t size) {
+		file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+		std::vector<char> padding(alignOffset(position) - position, 0);
+		file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+	}
+
+	template <typename T>
+	std::vector<T> copySection(const MappedFile& file, std::uint64_t offset, std::int64_t size) {
+		const T* data = reinterpret_cast<const T*>(file.getData() + offset);
+		return std::vector<T>(data, data + size);
+	}
+
+}
+
+
+std::unique_ptr<ContractionHierarchy> ContractionHierarchy::fromGraphs(const SparseGraph& graph, std::vector<int> ranks,
+	std::unique_ptr<SparseGraph> upwardGraph, std::vector<int> upwardMiddleVertices,
+	std::unique_ptr<SparseGraph> backwardGraph, std::vector<int> backwardMiddleVertices)
+{
+	std::unique_ptr<ContractionHierarchy> hierarchy(new ContractionHierarchy());
+	hierarchy->m_numberOfEdges = graph.getNumberOfEdges();
+	hierarchy->m_graphChecksum = graph.computeChecksum();
+	hierarchy->m_ranks = std::move(ranks);
+	hierarchy->m_upwardGraph = std::move(upwardGraph);
+	hierarchy->m_upwardMiddleVertices = std::move(upwardMiddleVertices);
+	hierarchy->m_backwardGraph = std::move(backwardGraph);
+	hierarchy->m_backwardMiddleVertices = std::move(backwardMiddleVertices);
+	return hierarchy;
+}
+
+
+std::unique_ptr<ContractionHierarchy> ContractionHierarchy::fromFile(const std::string& filePath, const SparseGraph& graph) {
+
+	std::unique_ptr<MappedFile> file = MappedFile::open(filePath);
+	if (!file) {
+		return nullptr;
+	}
+
+	if (file->getSize() < sizeof(Header) || std::memcmp(file->getData(), hierarchySignature, sizeof(hierarchySignature)) != 0) {
+		std::cout << "Plik " << filePath << " nie jest plikiem hierarchii kontrakcji." << std::endl;
+		return nullptr;
+	}
+	const Header* header = reinterpret_cast<const Header*>(file->getData());
+	if (header->version != formatVersion || header->byteOrderMark != byteOrderMark) {
+		std::cout << "Plik " << filePath << " ma nieobslugiwana wersje formatu lub kolejnosc bajtow." << std::endl;
+		return nullptr;
+	}
+
+	// hierarchy of other graph would give wrong distances
+	if (header->numberOfVertices != graph.getNumberOfVertices() || header->numberOfEdges != graph.getNumberOfEdges()
+		|| header->graphChecksum != graph.computeChecksum()) {
+		std::cout << "Plik " << filePath << " zostal utworzony dla innego grafu." << std::endl;
+		return nullptr;
+	}
+	if (header->numberOfUpwardEdges < 0 || header->numberOfUpwardEdges > INT32_MAX
+		|| header->numberOfBackwardEdges < 0 || header->numberOfBackwardEdges > INT32_MAX
+		|| computeSectionOffsets(*header).back() > file->getSize()) {
+		std::cout << "Plik " << filePath << " zawiera niepoprawne dane." << std::endl;
+		return nullptr;
+	}
+
+	// arrays are copied, so hierarchy has the same form as built one
+	std::vector<std::uint64_t> offsets = computeSectionOffsets(*header);
+	std::int64_t numberOfVertices = header->numberOfVertices;
+	std::unique_ptr<ContractionHierarchy> hierarchy(new ContractionHierarchy());
+	hierarchy->m_numberOfEdges = header->numberOfEdges;
+	hierarchy->m_graphChecksum = header->graphChecksum;
+	hierarchy->m_ranks = copySection<int>(*file, offsets[0], numberOfVertices);
+	hierarchy->m_upwardGraph = SparseGraph::fromCompressedArrays(copySection<int>(*file, offsets[1], numberOfVertices + 1),
+		copySection<int>(*file, offsets[2], header->numberOfUpwardEdges), copySection<double>(*file, offsets[3], header->numberOfUpwardEdges));
+	hierarchy->m_upwardMiddleVertices = copySection<int>(*file, offsets[4], header->numberOfUpwardEdges);
+	hierarchy->m_backwardGraph = SparseGraph::fromCompressedArrays(copySection<int>(*file, offsets[5], numberOfVertices + 1),
+		copySection<int>(*file, offsets[6], header->numberOfBackwardEdges), copySection<double>(*file, offsets[7], header->numberOfBackwardEdges));
+	hierarchy->m_backwardMiddleVertices = copySection<int>(*file, offsets[8], header->numberOfBackwardEdges);
+
+	// rows of both graphs must describe edges that exist
+	bool isValid = true;
+	for (const SparseGraph* sparseGraph : { hierarchy->m_upwardGraph.get(), hierarchy->m_backwardGraph.get() }) {
+		ArrayView<int> rowOffsets = sparseGraph->getOffsets();
+		for (std::int64_t v = 0; isValid && v < numberOfVertices; ++v) {
+			isValid = rowOffsets[v] >= 0 && rowOffsets[v] <= rowOffsets[v + 1] && rowOffsets[v + 1] <= sparseGraph->getNumberOfEdges();
+		}
+		for (int target : sparseGraph->getTargets()) {
+			isValid &= target >= 0 && target < numberOfVertices;
+		}
+	}
+	for (const std::vector<int>* middleVertices : { &hierarchy->m_upwardMiddleVertices, &hierarchy->m_backwardMiddleVertices }) {
+		for (int middleVertex : *middleVertices) {
+			isValid &= middleVertex >= -1 && middleVertex < numberOfVertices;
+		}
+	}
+	if (!isValid) {
+		std::cout << "Plik " << filePath << " zawiera niepoprawne dane." << std::endl;
+		return nullptr;
+	}
+	return hierarchy;
+}
+
+
+std::string ContractionHierarchy::getSidecarFilePath(const std::string& graphFilePath) {
+	return graphFilePath + ".ch";
+}
+
+
+bool ContractionHierarchy::writeToFile(const std::string& filePath) const {
+
+	std::ofstream file(filePath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+	if (!file.is_open()) {
+		std::cout << "Nie mozna utworzyc pliku " << filePath << "." << std::endl;
+		return false;
+	}
+
+	Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, hierarchySignature, sizeof(hierarchySignature));
+	header.version = formatVersion;
+	header.byteOrderMark = byteOrderMark;
+	header.numberOfVertices = getNumberOfVertices();
+	header.numberOfEdges = m_numberOfEdges;
+	header.graphChecksum = m_graphChecksum;
+	header.numberOfUpwardEdges = m_upwardGraph->getNumberOfEdges();
+	header.numberOfBackwardEdges = m_backwardGraph->getNumberOfEdges();
+
+	writeSection(file, &header, sizeof(header));
+	writeSection(file, m_ranks.data(), m_ranks.size() * sizeof(int));
+	for (const SparseGraph* graph : { m_upwardGraph.get(), m_backwardGraph.get() }) {
+		writeSection(file, graph->getOffsets().data(), graph->getOffsets().size() * sizeof(int));
+		writeSection(file, graph->getTargets().data(), graph->getTargets().size() * sizeof(int));
+		writeSection(file, graph->getWeights().data(), graph->getWeights().size() * sizeof(double));
+		const std::vector<int>& middleVertices = graph == m_upwardGraph.get() ? m_upwardMiddleVertices : m_backwardMiddleVertices;
+		writeSection(file, middleVertices.data(), middleVertices.size() * sizeof(int));
+	}
+
+	if (!file.good()) {
+		std::cout << "Nie mozna zapisac pliku " << filePath << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+void ContractionHierarchy::unpackEdge(int fromVertex, int toVertex, int middleVertex, std::vector<int>& path) const {
+	if (middleVertex == -1) {
+		path.push_back(toVertex);
+		return;
+	}
+
+	// middle vertex has been contracted before both ends of the shortcut, so edges to it
+	// are stored in its backward row and edges from it - in its upward row
+	unpackEdge(fromVertex, middleVertex, findMiddleVertex(*m_backwardGraph, m_backwardMiddleVertices, middleVertex, fromVertex), path);
+	unpackEdge(middleVertex, toVertex, findMiddleVertex(*m_upwardGraph, m_upwardMiddleVertices, middleVertex, toVertex), path);
+}
+
+
+int ContractionHierarchy::getNumberOfShortcuts() const {
+	return static_cast<int>(std::count_if(m_upwardMiddleVertices.begin(), m_upwardMiddleVertices.end(), [](int v) { return v != -1; })
+		+ std::count_if(m_backwardMiddleVertices.begin(), m_backwardMiddleVertices.end(), [](int v) { return v != -1; }));
+}
+
+
+int ContractionHierarchy::findMiddleVertex(const SparseGraph& graph, ArrayView<int> middleVertices, int vertex, int target) {
+	ArrayView<int> offsets = graph.getOffsets();
+	ArrayView<int> targets = graph.getTargets();
+	for (int e = offsets[vertex]; e < offsets[vertex + 1]; ++e) {
+		if (targets[e] == target) {
+			return middleVertices[e];
+		}
+	}
+	return -1;
+}
+
+
+std::vector<std::uint64_t> ContractionHierarchy::computeSectionOffsets(const Header& header) {
+	std::uint64_t numberOfVertices = static_cast<std::uint64_t>(header.numberOfVertices);
+	std::vector<std::uint64_t> offsets = { sizeof(Header) };
+	auto addSection = [&offsets](std::uint64_t size) {
+		offsets.push_back(alignOffset(offsets.back() + size));
+	};
+	addSection(numberOfVertices * sizeof(int));
+	for (std::int64_t numberOfEdges : { header.numberOfUpwardEdges, header.numberOfBackwardEdges }) {
+		addSection((numberOfVertices + 1) * sizeof(int));
+		addSection(numberOfEdges * sizeof(int));
+		addSection(numberOfEdges * sizeof(double));
+		addSection(numberOfEdges * sizeof(int));
+	}
+	return offsets;
+}
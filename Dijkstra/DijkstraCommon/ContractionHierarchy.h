@@ -0,0 +1,226 @@
+/**
+*	@file ContractionHierarchy.h
+*	@brief This file contains ContractionHierarchy class that stores graph
+*	preprocessed for fast point-to-point queries.
+*/
+
+
+#pragma once
+
+#include "ArrayView.h"
+#include "SparseGraph.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// This class stores contraction hierarchy of the graph - result of contracting
+/// vertices one after another (see ContractionHierarchyBuilder). Every edge of
+/// the hierarchy - original edge or shortcut - leads from vertex contracted
+/// earlier to vertex contracted later (with higher rank) or the other way round.
+/// Edges of the first kind form upward graph, edges of the second kind are stored
+/// reversed in backward graph, so both searches of ContractionHierarchyQuery go
+/// only up the hierarchy. Shortcut remembers vertex whose contraction created it,
+/// so it can be unpacked into path of original edges.
+/// </summary>
+/// <remarks>
+/// Hierarchy is saved to file next to the graph. File starts with 64-byte header
+/// (see Header structure) that contains number of vertices, number of edges and
+/// checksum of the graph it has been built for. Sections that follow it start at
+/// offsets that are multiples of 64 bytes: N 32-bit ranks, then upward graph and
+/// backward graph, both as compressed sparse rows (N + 1 offsets, targets, double
+/// weights) followed by 32-bit middle vertices of their edges (-1 for original
+/// edges).
+/// </remarks>
+class ContractionHierarchy final {
+
+public:
+
+	/// <summary>
+	/// Header of hierarchy file - first 64 bytes of the file.
+	/// </summary>
+	struct Header {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t byteOrderMark;
+		std::int64_t numberOfVertices;
+		std::int64_t numberOfEdges;
+		std::uint64_t graphChecksum;
+		std::int64_t numberOfUpwardEdges;
+		std::int64_t numberOfBackwardEdges;
+		std::uint64_t reserved;
+	};
+
+
+	/// <summary>
+	/// Static factory method used by ContractionHierarchyBuilder. Arrays are not
+	/// validated.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer to created object.
+	/// </returns>
+	/// <param name="graph">
+	/// Graph for which hierarchy has been built.
+	/// </param>
+	/// <param name="ranks">
+	/// Vector with position of every vertex in contraction order.
+	/// </param>
+	/// <param name="upwardGraph">
+	/// Edges leading from vertices to vertices with higher rank.
+	/// </param>
+	/// <param name="upwardMiddleVertices">
+	/// Middle vertices of edges of upward graph (-1 for original edges).
+	/// </param>
+	/// <param name="backwardGraph">
+	/// Edges leading from vertices to vertices with lower rank, reversed.
+	/// </param>
+	/// <param name="backwardMiddleVertices">
+	/// Middle vertices of edges of backward graph (-1 for original edges).
+	/// </param>
+	static std::unique_ptr<ContractionHierarchy> fromGraphs(const SparseGraph& graph, std::vector<int> ranks,
+		std::unique_ptr<SparseGraph> upwardGraph, std::vector<int> upwardMiddleVertices,
+		std::unique_ptr<SparseGraph> backwardGraph, std::vector<int> backwardMiddleVertices);
+
+
+	/// <summary>
+	/// Static factory method that reads hierarchy from file. If file does not exist,
+	/// is not valid or has been built for other graph, proper information is printed.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer to created object or nullptr if hierarchy can not be used.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to hierarchy file.
+	/// </param>
+	/// <param name="graph">
+	/// Graph that is going to be searched with the hierarchy.
+	/// </param>
+	static std::unique_ptr<ContractionHierarchy> fromFile(const std::string& filePath, const SparseGraph& graph);
+
+
+	/// <summary>
+	/// Returns path of hierarchy file of given graph file.
+	/// </summary>
+	static std::string getSidecarFilePath(const std::string& graphFilePath);
+
+
+	/// <summary>
+	/// Writes hierarchy to file. If file can not be written, proper information is
+	/// printed.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file has been written.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to hierarchy file.
+	/// </param>
+	bool writeToFile(const std::string& filePath) const;
+
+
+	/// <summary>
+	/// Appends to path vertices of original edges that form given edge of the
+	/// hierarchy - all of them except its first vertex.
+	/// </summary>
+	/// <param name="fromVertex">
+	/// First vertex of the edge (in original direction).
+	/// </param>
+	/// <param name="toVertex">
+	/// Last vertex of the edge (in original direction).
+	/// </param>
+	/// <param name="middleVertex">
+	/// Middle vertex of the edge, -1 if it is original edge.
+	/// </param>
+	/// <param name="path">
+	/// Vector to which vertices are appended.
+	/// </param>
+	void unpackEdge(int fromVertex, int toVertex, int middleVertex, std::vector<int>& path) const;
+
+
+	/// <summary>
+	/// Returns number of vertices.
+	/// </summary>
+	inline int getNumberOfVertices() const {
+		return static_cast<int>(m_ranks.size());
+	}
+
+
+	/// <summary>
+	/// Returns number of shortcuts - edges of the hierarchy that are not original edges.
+	/// </summary>
+	int getNumberOfShortcuts() const;
+
+
+	/// <summary>
+	/// Returns position of every vertex in contraction order.
+	/// </summary>
+	inline ArrayView<int> getRanks() const {
+		return m_ranks;
+	}
+
+
+	/// <summary>
+	/// Returns graph of edges leading to vertices with higher rank.
+	/// </summary>
+	inline const SparseGraph& getUpwardGraph() const {
+		return *m_upwardGraph;
+	}
+
+
+	/// <summary>
+	/// Returns middle vertices of edges of upward graph.
+	/// </summary>
+	inline ArrayView<int> getUpwardMiddleVertices() const {
+		return m_upwardMiddleVertices;
+	}
+
+
+	/// <summary>
+	/// Returns graph of edges leading to vertices with lower rank - edge u -> v is
+	/// stored as v -> u, so it leads up the hierarchy too.
+	/// </summary>
+	inline const SparseGraph& getBackwardGraph() const {
+		return *m_backwardGraph;
+	}
+
+
+	/// <summary>
+	/// Returns middle vertices of edges of backward graph.
+	/// </summary>
+	inline ArrayView<int> getBackwardMiddleVertices() const {
+		return m_backwardMiddleVertices;
+	}
+
+private:
+
+	/// <summary>
+	/// Default constructor. It is private, as objects of this class should not be created
+	/// on their own - for creating instances in code, please use static factory methods.
+	/// </summary>
+	ContractionHierarchy() = default;
+
+
+	/// <summary>
+	/// Finds edge of graph that leads from vertex to given target and returns its
+	/// middle vertex.
+	/// </summary>
+	static int findMiddleVertex(const SparseGraph& graph, ArrayView<int> middleVertices, int vertex, int target);
+
+
+	/// <summary>
+	/// Computes offsets of all sections of hierarchy file described by header -
+	/// the last one is offset of the end of the file.
+	/// </summary>
+	static std::vector<std::uint64_t> computeSectionOffsets(const Header& header);
+
+
+	std::int64_t m_numberOfEdges = 0;
+	std::uint64_t m_graphChecksum = 0;
+	std::vector<int> m_ranks;
+	std::unique_ptr<SparseGraph> m_upwardGraph;
+	std::vector<int> m_upwardMiddleVertices;
+	std::unique_ptr<SparseGraph> m_backwardGraph;
+	std::vector<int> m_backwardMiddleVertices;
+
+};
@@ -0,0 +1,293 @@
+#include "ContractionHierarchyBuilder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+
+namespace {
+
+	// witness search is only a heuristic - when it gives up, one shortcut too many is inserted;
+	// priorities are computed many times, so their searches are shorter
+	const int maximalNumberOfWitnessSearchVertices = 100;
+	const int maximalNumberOfPriorityWitnessSearchVertices = 20;
+
+}
+
+
+ContractionHierarchyBuilder::ContractionHierarchyBuilder(const SparseGraph& graph, int numberOfThreads) :
+	m_graph(graph),
+	m_numberOfVertices(graph.getNumberOfVertices()),
+	m_outgoingArcs(m_numberOfVertices),
+	m_incomingArcs(m_numberOfVertices),
+	m_priorities(m_numberOfVertices, 0),
+	m_numbersOfContractedNeighbours(m_numberOfVertices, 0),
+	m_isContracted(m_numberOfVertices, false),
+	m_isContractedInCurrentRound(m_numberOfVertices, false),
+	m_witnessSearches(numberOfThreads),
+	m_threadTeam(numberOfThreads)
+{
+	ArrayView<int> offsets = m_graph.getOffsets();
+	ArrayView<int> targets = m_graph.getTargets();
+	ArrayView<double> weights = m_graph.getWeights();
+	for (int v = 0; v < m_numberOfVertices; ++v) {
+		for (int e = offsets[v]; e < offsets[v + 1]; ++e) {
+			if (targets[e] != v) {
+				insertOrShortenArc(m_outgoingArcs[v], { targets[e], weights[e], -1 });
+				insertOrShortenArc(m_incomingArcs[targets[e]], { v, weights[e], -1 });
+			}
+		}
+	}
+	for (WitnessSearch& witnessSearch : m_witnessSearches) {
+		witnessSearch.distances.assign(m_numberOfVertices, std::numeric_limits<double>::infinity());
+		witnessSearch.isTarget.assign(m_numberOfVertices, false);
+	}
+}
+
+
+std::unique_ptr<ContractionHierarchy> ContractionHierarchyBuilder::build() {
+
+	std::vector<int> remainingVertices(m_numberOfVertices);
+	for (int v = 0; v < m_numberOfVertices; ++v) {
+		remainingVertices[v] = v;
+	}
+	runOnAllThreads(remainingVertices.size(), [&](size_t i, WitnessSearch& witnessSearch) {
+		m_priorities[remainingVertices[i]] = computePriority(remainingVertices[i], witnessSearch);
+	});
+
+	// edges of contracted vertex lead to vertices contracted later - up the hierarchy
+	std::vector<int> ranks(m_numberOfVertices, -1);
+	std::vector<std::vector<Arc>> upwardArcs(m_numberOfVertices);
+	std::vector<std::vector<Arc>> backwardArcs(m_numberOfVertices);
+	int nextRank = 0;
+	m_numberOfRounds = 0;
+	while (!remainingVertices.empty()) {
+
+		// vertices with locally minimal priority are not adjacent to each other
+		std::vector<int> independentSet;
+		for (int v : remainingVertices) {
+			if (checkIfPriorityIsLocalMinimum(v)) {
+				independentSet.push_back(v);
+			}
+		}
+		for (int v : independentSet) {
+			m_isContractedInCurrentRound[v] = true;
+		}
+
+		std::vector<std::vector<Shortcut>> shortcutsOfVertices(independentSet.size());
+		runOnAllThreads(independentSet.size(), [&](size_t i, WitnessSearch& witnessSearch) {
+			findShortcuts(independentSet[i], witnessSearch, &shortcutsOfVertices[i]);
+		});
+
+		// contracted vertices are removed from lists of their neighbours, then shortcuts between them are inserted
+		std::vector<int> neighboursToUpdate;
+		for (int v : independentSet) {
+			ranks[v] = nextRank++;
+			upwardArcs[v] = std::move(m_outgoingArcs[v]);
+			backwardArcs[v] = std::move(m_incomingArcs[v]);
+			for (const Arc& arc : upwardArcs[v]) {
+				removeArc(m_incomingArcs[arc.vertex], v);
+				neighboursToUpdate.push_back(arc.vertex);
+			}
+			for (const Arc& arc : backwardArcs[v]) {
+				removeArc(m_outgoingArcs[arc.vertex], v);
+				neighboursToUpdate.push_back(arc.vertex);
+			}
+			m_isContracted[v] = true;
+		}
+		for (size_t i = 0; i < independentSet.size(); ++i) {
+			for (const Shortcut& shortcut : shortcutsOfVertices[i]) {
+				insertOrShortenArc(m_outgoingArcs[shortcut.source], { shortcut.target, shortcut.weight, independentSet[i] });
+				insertOrShortenArc(m_incomingArcs[shortcut.target], { shortcut.source, shortcut.weight, independentSet[i] });
+			}
+		}
+		for (int v : independentSet) {
+			m_isContractedInCurrentRound[v] = false;
+		}
+		remainingVertices.erase(std::remove_if(remainingVertices.begin(), remainingVertices.end(),
+			[this](int v) { return m_isContracted[v] != 0; }), remainingVertices.end());
+
+		// only neighbours of contracted vertices have new edges, so only their priorities change
+		std::sort(neighboursToUpdate.begin(), neighboursToUpdate.end());
+		neighboursToUpdate.erase(std::unique(neighboursToUpdate.begin(), neighboursToUpdate.end()), neighboursToUpdate.end());
+		for (int v : neighboursToUpdate) {
+			++m_numbersOfContractedNeighbours[v];
+		}
+		runOnAllThreads(neighboursToUpdate.size(), [&](size_t i, WitnessSearch& witnessSearch) {
+			m_priorities[neighboursToUpdate[i]] = computePriority(neighboursToUpdate[i], witnessSearch);
+		});
+		++m_numberOfRounds;
+	}
+
+	auto upwardGraph = compressArcs(upwardArcs);
+	auto backwardGraph = compressArcs(backwardArcs);
+	return ContractionHierarchy::fromGraphs(m_graph, std::move(ranks), std::move(upwardGraph.first), std::move(upwardGraph.second),
+		std::move(backwardGraph.first), std::move(backwardGraph.second));
+}
+
+
+int ContractionHierarchyBuilder::findShortcuts(int vertex, WitnessSearch& witnessSearch, std::vector<Shortcut>* shortcuts) const {
+
+	const std::vector<Arc>& incomingArcs = m_incomingArcs[vertex];
+	const std::vector<Arc>& outgoingArcs = m_outgoingArcs[vertex];
+	int maximalNumberOfProcessedVertices = shortcuts ? maximalNumberOfWitnessSearchVertices : maximalNumberOfPriorityWitnessSearchVertices;
+	for (const Arc& outgoingArc : outgoingArcs) {
+		witnessSearch.isTarget[outgoingArc.vertex] = true;
+	}
+
+	int numberOfShortcuts = 0;
+	for (const Arc& incomingArc : incomingArcs) {
+
+		// witness search does not have to go further than the longest path through vertex
+		double maximalDistance = -1;
+		for (const Arc& outgoingArc : outgoingArcs) {
+			if (outgoingArc.vertex != incomingArc.vertex) {
+				maximalDistance = std::max(maximalDistance, incomingArc.weight + outgoingArc.weight);
+			}
+		}
+		if (maximalDistance < 0) {
+			continue;
+		}
+
+		int numberOfTargets = static_cast<int>(outgoingArcs.size()) - (witnessSearch.isTarget[incomingArc.vertex] ? 1 : 0);
+		runWitnessSearch(incomingArc.vertex, vertex, maximalDistance, numberOfTargets, maximalNumberOfProcessedVertices, witnessSearch);
+		for (const Arc& outgoingArc : outgoingArcs) {
+			double distanceThroughVertex = incomingArc.weight + outgoingArc.weight;
+			if (outgoingArc.vertex != incomingArc.vertex && witnessSearch.distances[outgoingArc.vertex] > distanceThroughVertex) {
+				++numberOfShortcuts;
+				if (shortcuts) {
+					shortcuts->push_back({ incomingArc.vertex, outgoingArc.vertex, distanceThroughVertex });
+				}
+			}
+		}
+
+		for (int v : witnessSearch.reachedVertices) {
+			witnessSearch.distances[v] = std::numeric_limits<double>::infinity();
+		}
+		witnessSearch.reachedVertices.clear();
+	}
+
+	for (const Arc& outgoingArc : outgoingArcs) {
+		witnessSearch.isTarget[outgoingArc.vertex] = false;
+	}
+	return numberOfShortcuts;
+}
+
+
+void ContractionHierarchyBuilder::runWitnessSearch(int sourceVertex, int excludedVertex, double maximalDistance, int numberOfTargets,
+	int maximalNumberOfProcessedVertices, WitnessSearch& witnessSearch) const
+{
+
+	// queue is a binary heap kept in vector, so its memory is reused by following searches
+	std::vector<std::pair<double, int>>& queue = witnessSearch.queue;
+	const std::greater<std::pair<double, int>> comparator;
+	queue.clear();
+	witnessSearch.distances[sourceVertex] = 0;
+	witnessSearch.reachedVertices.push_back(sourceVertex);
+	queue.push_back(std::make_pair(0.0, sourceVertex));
+
+	// queue may contain outdated entries - they are skipped, so no addressable heap is needed
+	int numberOfProcessedVertices = 0;
+	while (!queue.empty() && numberOfProcessedVertices < maximalNumberOfProcessedVertices && numberOfTargets > 0) {
+		std::pop_heap(queue.begin(), queue.end(), comparator);
+		std::pair<double, int> closestVertex = queue.back();
+		queue.pop_back();
+		if (closestVertex.first > witnessSearch.distances[closestVertex.second]) {
+			continue;
+		}
+		if (closestVertex.first > maximalDistance) {
+			break;
+		}
+		++numberOfProcessedVertices;
+		if (witnessSearch.isTarget[closestVertex.second] && closestVertex.second != sourceVertex) {
+			--numberOfTargets;
+		}
+
+		for (const Arc& arc : m_outgoingArcs[closestVertex.second]) {
+			if (arc.vertex == excludedVertex || m_isContractedInCurrentRound[arc.vertex]) {
+				continue;
+			}
+			double altDistance = closestVertex.first + arc.weight;
+			if (altDistance < witnessSearch.distances[arc.vertex]) {
+				if (witnessSearch.distances[arc.vertex] == std::numeric_limits<double>::infinity()) {
+					witnessSearch.reachedVertices.push_back(arc.vertex);
+				}
+				witnessSearch.distances[arc.vertex] = altDistance;
+				queue.push_back(std::make_pair(altDistance, arc.vertex));
+				std::push_heap(queue.begin(), queue.end(), comparator);
+			}
+		}
+	}
+}
+
+
+int ContractionHierarchyBuilder::computePriority(int vertex, WitnessSearch& witnessSearch) const {
+
+	int numberOfShortcuts = findShortcuts(vertex, witnessSearch, nullptr);
+	int numberOfRemovedEdges = static_cast<int>(m_incomingArcs[vertex].size() + m_outgoingArcs[vertex].size());
+	return numberOfShortcuts - numberOfRemovedEdges + m_numbersOfContractedNeighbours[vertex];
+}
+
+
+bool ContractionHierarchyBuilder::checkIfPriorityIsLocalMinimum(int vertex) const {
+	auto hasLowerPriority = [this](int v, int w) {
+		return m_priorities[v] < m_priorities[w] || (m_priorities[v] == m_priorities[w] && v < w);
+	};
+	for (const std::vector<Arc>* arcs : { &m_outgoingArcs[vertex], &m_incomingArcs[vertex] }) {
+		for (const Arc& arc : *arcs) {
+			if (!hasLowerPriority(vertex, arc.vertex)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+void ContractionHierarchyBuilder::insertOrShortenArc(std::vector<Arc>& arcs, const Arc& arc) {
+	for (Arc& existingArc : arcs) {
+		if (existingArc.vertex == arc.vertex) {
+			if (arc.weight < existingArc.weight) {
+				existingArc = arc;
+			}
+			return;
+		}
+	}
+	arcs.push_back(arc);
+}
+
+
+void ContractionHierarchyBuilder::removeArc(std::vector<Arc>& arcs, int vertex) {
+	arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [vertex](const Arc& arc) { return arc.vertex == vertex; }), arcs.end());
+}
+
+
+std::pair<std::unique_ptr<SparseGraph>, std::vector<int>> ContractionHierarchyBuilder::compressArcs(const std::vector<std::vector<Arc>>& arcs) {
+	std::vector<int> offsets = { 0 };
+	std::vector<int> targets;
+	std::vector<double> weights;
+	std::vector<int> middleVertices;
+	for (const std::vector<Arc>& arcsOfVertex : arcs) {
+		for (const Arc& arc : arcsOfVertex) {
+			targets.push_back(arc.vertex);
+			weights.push_back(arc.weight);
+			middleVertices.push_back(arc.middleVertex);
+		}
+		offsets.push_back(static_cast<int>(targets.size()));
+	}
+	return std::make_pair(SparseGraph::fromCompressedArrays(std::move(offsets), std::move(targets), std::move(weights)), std::move(middleVertices));
+}
+
+
+template <typename WorkType>
+void ContractionHierarchyBuilder::runOnAllThreads(size_t numberOfElements, const WorkType& work) {
+	if (numberOfElements == 0) {
+		return;
+	}
+	std::atomic<size_t> nextElement(0);
+	m_threadTeam.execute([&](int threadIndex) {
+		for (size_t i = nextElement++; i < numberOfElements; i = nextElement++) {
+			work(i, m_witnessSearches[threadIndex]);
+		}
+	});
+}
@@ -0,0 +1,182 @@
+/**
+*	@file ContractionHierarchyBuilder.h
+*	@brief This file contains ContractionHierarchyBuilder class that builds
+*	contraction hierarchy of sparse graph.
+*/
+
+
+#pragma once
+
+#include "ContractionHierarchy.h"
+#include "SparseGraph.h"
+#include "ThreadTeam.h"
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class builds contraction hierarchy of sparse graph. Vertices are removed
+/// (contracted) one after another; when vertex v is contracted, shortcut u -> w
+/// is inserted for every pair of its neighbours u -> v -> w unless witness search
+/// (Dijkstra algorithm from u that does not use v, limited to a few hundred
+/// vertices) finds path that is not longer. Vertices are ordered by edge
+/// difference - number of shortcuts their contraction would add minus number of
+/// edges it would remove - increased by number of already contracted neighbours,
+/// so contraction spreads evenly over the graph.
+/// </summary>
+/// <remarks>
+/// Contraction runs in rounds. In every round all vertices whose priority is
+/// lower than priorities of all their neighbours form independent set - no two
+/// of them are adjacent, so threads of ThreadTeam can find their shortcuts at the
+/// same time. Witness searches of a round do not go through vertices of its set,
+/// so the result does not depend on order in which they are contracted. Then
+/// priorities of their neighbours are updated, also in parallel.
+/// </remarks>
+class ContractionHierarchyBuilder
+{
+public:
+
+	/// <summary>
+	/// ContractionHierarchyBuilder class constructor. Prepares lists of outgoing
+	/// and incoming edges of all vertices - parallel edges are merged into the
+	/// shortest one and loops are skipped.
+	/// </summary>
+	/// <param name="graph">
+	/// Sparse graph that is going to be contracted. Please note that this object
+	/// stores reference to it - it is valid as long as graph itself is valid.
+	/// </param>
+	/// <param name="numberOfThreads">
+	/// Number of threads that run witness searches (including calling thread).
+	/// </param>
+	ContractionHierarchyBuilder(const SparseGraph& graph, int numberOfThreads);
+
+
+	/// <summary>
+	/// Contracts all vertices of the graph.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer to built hierarchy.
+	/// </returns>
+	std::unique_ptr<ContractionHierarchy> build();
+
+
+	/// <summary>
+	/// Returns number of rounds of contraction performed by last build.
+	/// </summary>
+	inline int getNumberOfRounds() const {
+		return m_numberOfRounds;
+	}
+
+private:
+
+	/// <summary>
+	/// Edge of the graph that is being contracted - original edge or shortcut.
+	/// Depending on the list it belongs to, vertex is its target or its source.
+	/// </summary>
+	struct Arc {
+		int vertex;
+		double weight;
+		int middleVertex;
+	};
+
+
+	/// <summary>
+	/// Shortcut that has to be inserted after contraction of vertex.
+	/// </summary>
+	struct Shortcut {
+		int source;
+		int target;
+		double weight;
+	};
+
+
+	/// <summary>
+	/// Memory used by witness searches of one thread - distances are reset after
+	/// every search, so search costs as much as number of vertices it reaches.
+	/// Targets are out-neighbours of contracted vertex, search ends when all of
+	/// them have been processed.
+	/// </summary>
+	struct WitnessSearch {
+		std::vector<double> distances;
+		std::vector<int> reachedVertices;
+		std::vector<char> isTarget;
+		std::vector<std::pair<double, int>> queue;
+	};
+
+
+	/// <summary>
+	/// Finds shortcuts needed to contract vertex - pair u -> v -> w needs one if
+	/// witness search does not find other path from u to w that is not longer.
+	/// If shortcuts are only counted (to compute priority), searches are shorter.
+	/// </summary>
+	/// <returns>
+	/// Number of found shortcuts.
+	/// </returns>
+	int findShortcuts(int vertex, WitnessSearch& witnessSearch, std::vector<Shortcut>* shortcuts) const;
+
+
+	/// <summary>
+	/// Runs Dijkstra algorithm from source vertex on not contracted vertices, except
+	/// excluded vertex and vertices contracted in current round. Search stops when
+	/// all targets or all vertices closer than given distance have been processed,
+	/// or when limit of processed vertices has been reached.
+	/// </summary>
+	void runWitnessSearch(int sourceVertex, int excludedVertex, double maximalDistance, int numberOfTargets,
+		int maximalNumberOfProcessedVertices, WitnessSearch& witnessSearch) const;
+
+
+	/// <summary>
+	/// Computes priority of vertex - its edge difference plus number of contracted
+	/// neighbours.
+	/// </summary>
+	int computePriority(int vertex, WitnessSearch& witnessSearch) const;
+
+
+	/// <summary>
+	/// Checks if vertex has lower priority than all its neighbours - ties are
+	/// resolved by vertex numbers.
+	/// </summary>
+	bool checkIfPriorityIsLocalMinimum(int vertex) const;
+
+
+	/// <summary>
+	/// Inserts arc into list or, if list already contains arc with the same vertex,
+	/// makes it shorter.
+	/// </summary>
+	static void insertOrShortenArc(std::vector<Arc>& arcs, const Arc& arc);
+
+
+	/// <summary>
+	/// Removes arc with given vertex from list.
+	/// </summary>
+	static void removeArc(std::vector<Arc>& arcs, int vertex);
+
+
+	/// <summary>
+	/// Creates compressed sparse rows from lists of arcs of all vertices.
+	/// </summary>
+	static std::pair<std::unique_ptr<SparseGraph>, std::vector<int>> compressArcs(const std::vector<std::vector<Arc>>& arcs);
+
+
+	/// <summary>
+	/// Runs work for all elements of vector on threads of ThreadTeam - elements are
+	/// taken by threads one after another, so threads finish at similar time.
+	/// </summary>
+	template <typename WorkType>
+	void runOnAllThreads(size_t numberOfElements, const WorkType& work);
+
+
+	const SparseGraph& m_graph;
+	int m_numberOfVertices;
+	int m_numberOfRounds = 0;
+	std::vector<std::vector<Arc>> m_outgoingArcs;
+	std::vector<std::vector<Arc>> m_incomingArcs;
+	std::vector<int> m_priorities;
+	std::vector<int> m_numbersOfContractedNeighbours;
+	std::vector<char> m_isContracted;
+	std::vector<char> m_isContractedInCurrentRound;
+	std::vector<WitnessSearch> m_witnessSearches;
+	ThreadTeam m_threadTeam;
+};
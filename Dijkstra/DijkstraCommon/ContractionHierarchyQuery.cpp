@@ -0,0 +1,114 @@
+#include "ContractionHierarchyQuery.h"
+
+#include <algorithm>
+#include <limits>
+
+
+ContractionHierarchyQuery::ContractionHierarchyQuery(const ContractionHierarchy& hierarchy, int sourceVertexIndex, int targetVertexIndex) :
+	m_hierarchy(hierarchy),
+	m_sourceVertexIndex(sourceVertexIndex),
+	m_targetVertexIndex(targetVertexIndex),
+	m_heaps{ VertexHeap(hierarchy.getNumberOfVertices()), VertexHeap(hierarchy.getNumberOfVertices()) }
+{
+	for (int direction = 0; direction < 2; ++direction) {
+		m_distances[direction].assign(hierarchy.getNumberOfVertices(), std::numeric_limits<double>::infinity());
+		m_parents[direction].assign(hierarchy.getNumberOfVertices(), -1);
+		m_parentEdges[direction].assign(hierarchy.getNumberOfVertices(), -1);
+	}
+	m_distances[0].at(sourceVertexIndex) = 0;
+	m_distances[1].at(targetVertexIndex) = 0;
+	m_heaps[0].insertOrDecreaseKey(sourceVertexIndex, 0);
+	m_heaps[1].insertOrDecreaseKey(targetVertexIndex, 0);
+}
+
+
+std::pair<const std::vector<double>, const std::vector<int>> ContractionHierarchyQuery::run() {
+
+	// forward search (0) goes up the upward graph, backward search (1) - up the backward graph
+	const SparseGraph* graphs[2] = { &m_hierarchy.getUpwardGraph(), &m_hierarchy.getBackwardGraph() };
+	double shortestDistance = std::numeric_limits<double>::infinity();
+	int meetingVertex = -1;
+	bool searchIsFinished[2] = { false, false };
+	for (int direction = 0; !searchIsFinished[0] || !searchIsFinished[1]; direction = 1 - direction) {
+		if (searchIsFinished[direction]) {
+			continue;
+		}
+		if (m_heaps[direction].isEmpty()) {
+			searchIsFinished[direction] = true;
+			continue;
+		}
+
+		// vertices that are not closer than the shortest path found so far can not improve it
+		VertexData closestVertex = m_heaps[direction].extractMin();
+		++m_numberOfProcessedVertices;
+		if (closestVertex.distance >= shortestDistance) {
+			searchIsFinished[direction] = true;
+			continue;
+		}
+		double distanceThroughVertex = closestVertex.distance + m_distances[1 - direction][closestVertex.vertexNumber];
+		if (distanceThroughVertex < shortestDistance) {
+			shortestDistance = distanceThroughVertex;
+			meetingVertex = closestVertex.vertexNumber;
+		}
+		if (checkIfVertexCanBeStalled(direction, closestVertex.vertexNumber)) {
+			continue;
+		}
+
+		ArrayView<int> offsets = graphs[direction]->getOffsets();
+		ArrayView<int> targets = graphs[direction]->getTargets();
+		ArrayView<double> weights = graphs[direction]->getWeights();
+		for (int e = offsets[closestVertex.vertexNumber]; e < offsets[closestVertex.vertexNumber + 1]; ++e) {
+			double altDistance = closestVertex.distance + weights[e];
+			if (altDistance < m_distances[direction][targets[e]]) {
+				m_distances[direction][targets[e]] = altDistance;
+				m_parents[direction][targets[e]] = closestVertex.vertexNumber;
+				m_parentEdges[direction][targets[e]] = e;
+				m_heaps[direction].insertOrDecreaseKey(targets[e], altDistance);
+			}
+		}
+	}
+
+	std::vector<double> distances(m_hierarchy.getNumberOfVertices(), std::numeric_limits<double>::infinity());
+	std::vector<int> predecessors(m_hierarchy.getNumberOfVertices(), -1);
+	distances[m_sourceVertexIndex] = 0;
+	distances[m_targetVertexIndex] = shortestDistance;
+	if (meetingVertex == -1) {
+		return std::make_pair(std::move(distances), std::move(predecessors));
+	}
+
+	// edges from source to meeting vertex are found backwards, edges from meeting vertex to target - forwards
+	std::vector<int> verticesUpToMeetingVertex = { meetingVertex };
+	while (verticesUpToMeetingVertex.back() != m_sourceVertexIndex) {
+		verticesUpToMeetingVertex.push_back(m_parents[0][verticesUpToMeetingVertex.back()]);
+	}
+	std::reverse(verticesUpToMeetingVertex.begin(), verticesUpToMeetingVertex.end());
+
+	std::vector<int> path = { m_sourceVertexIndex };
+	for (size_t i = 1; i < verticesUpToMeetingVertex.size(); ++i) {
+		int vertex = verticesUpToMeetingVertex[i];
+		m_hierarchy.unpackEdge(verticesUpToMeetingVertex[i - 1], vertex, m_hierarchy.getUpwardMiddleVertices()[m_parentEdges[0][vertex]], path);
+	}
+	for (int vertex = meetingVertex; vertex != m_targetVertexIndex; vertex = m_parents[1][vertex]) {
+		m_hierarchy.unpackEdge(vertex, m_parents[1][vertex], m_hierarchy.getBackwardMiddleVertices()[m_parentEdges[1][vertex]], path);
+	}
+	for (size_t i = 1; i < path.size(); ++i) {
+		predecessors[path[i]] = path[i - 1];
+	}
+	return std::make_pair(std::move(distances), std::move(predecessors));
+}
+
+
+bool ContractionHierarchyQuery::checkIfVertexCanBeStalled(int direction, int vertex) const {
+
+	// edges entering vertex from higher vertices are stored in graph of the other search
+	const SparseGraph& graph = direction == 0 ? m_hierarchy.getBackwardGraph() : m_hierarchy.getUpwardGraph();
+	ArrayView<int> offsets = graph.getOffsets();
+	ArrayView<int> targets = graph.getTargets();
+	ArrayView<double> weights = graph.getWeights();
+	for (int e = offsets[vertex]; e < offsets[vertex + 1]; ++e) {
+		if (m_distances[direction][targets[e]] + weights[e] < m_distances[direction][vertex]) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,83 @@
+/**
+*	@file ContractionHierarchyQuery.h
+*	@brief This file contains query engine that finds shortest path between
+*	two vertices using contraction hierarchy.
+*/
+
+
+#pragma once
+
+#include "ContractionHierarchy.h"
+#include "VertexHeap.h"
+
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class finds shortest path between two vertices with bidirectional search
+/// on contraction hierarchy. Forward search starts from source vertex on upward
+/// graph, backward search starts from target vertex on backward graph - both of
+/// them go only up the hierarchy, so they process small part of the graph. Every
+/// shortest path contains vertex with the highest rank that is reached by both
+/// searches. Searches run alternately; each of them stops when its closest vertex
+/// is not closer than the shortest path found so far. Vertices reached by edge
+/// from higher vertex that gives shorter distance are not expanded (stall-on-demand).
+/// </summary>
+class ContractionHierarchyQuery
+{
+public:
+
+	/// <summary>
+	/// ContractionHierarchyQuery class constructor. Prepares distance arrays and
+	/// heaps of both searches.
+	/// </summary>
+	/// <param name="hierarchy">
+	/// Contraction hierarchy of the graph. Please note that this object stores
+	/// reference to it - it is valid as long as hierarchy itself is valid.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Integer number that represents index of source vertex.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Integer number that represents index of target vertex.
+	/// </param>
+	ContractionHierarchyQuery(const ContractionHierarchy& hierarchy, int sourceVertexIndex, int targetVertexIndex);
+
+
+	/// <summary>
+	/// Finds shortest path from source vertex to target vertex. Shortcuts on the
+	/// path are unpacked into original edges.
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors in the same form as results of other implementations, but
+	/// only distance to target vertex and predecessors on path to it are valid.
+	/// </returns>
+	std::pair<const std::vector<double>, const std::vector<int>> run();
+
+
+	/// <summary>
+	/// Returns number of vertices processed by both searches during last run.
+	/// </summary>
+	inline int getNumberOfProcessedVertices() const {
+		return m_numberOfProcessedVertices;
+	}
+
+private:
+
+	/// <summary>
+	/// Checks if vertex is reached by edge from vertex with higher rank that gives
+	/// shorter distance than the current one - then shortest path to it does not
+	/// go up the hierarchy and its edges do not have to be relaxed.
+	/// </summary>
+	bool checkIfVertexCanBeStalled(int direction, int vertex) const;
+
+
+	const ContractionHierarchy& m_hierarchy;
+	int m_sourceVertexIndex;
+	int m_targetVertexIndex;
+	int m_numberOfProcessedVertices = 0;
+	VertexHeap m_heaps[2];
+	std::vector<double> m_distances[2];
+	std::vector<int> m_parents[2];
+	std::vector<int> m_parentEdges[2];
+};
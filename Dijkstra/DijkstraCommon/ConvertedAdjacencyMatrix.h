@@ -0,0 +1,88 @@
+/**
+*	@file ConvertedAdjacencyMatrix.h
+*	@brief This file contains class that stores adjacency matrix with weights
+*	converted to type chosen by user.
+*/
+
+#pragma once
+
+#include "ArrayView.h"
+#include "TransposedMatrixChunk.h"
+#include "WeightTraits.h"
+
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// This class stores whole adjacency matrix with weights converted from doubles
+/// to type given as template parameter - arranged column-wise (like AdjacencyMatrix
+/// stores it) or row-wise (as BasicTransposedMatrixChunk). Please note that this
+/// class is final - to use it, consider composition (not inheritance).
+/// </summary>
+template <typename WeightType>
+class ConvertedAdjacencyMatrix final {
+
+public:
+
+	/// <summary>
+	/// Static factory method that converts column-wise adjacency matrix with double
+	/// weights.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer to created object or nullptr if some weights can not be stored
+	/// in given type without changing results of the algorithm.
+	/// </returns>
+	/// <param name="columnWiseData">
+	/// Adjacency matrix arranged column-wise, as returned by AdjacencyMatrix.
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Number of vertices in the graph.
+	/// </param>
+	/// <param name="transpose">
+	/// Boolean that indicates if weights should be arranged row-wise.
+	/// </param>
+	static std::unique_ptr<ConvertedAdjacencyMatrix> fromColumnWiseData(const ArrayView<double>& columnWiseData, int totalNumberOfVertices, bool transpose) {
+		std::unique_ptr<ConvertedAdjacencyMatrix> matrix(new ConvertedAdjacencyMatrix());
+		if (!convertWeights(columnWiseData, matrix->m_columnWiseWeights)) {
+			return nullptr;
+		}
+		if (transpose) {
+			matrix->m_transposedMatrix.reset(new BasicTransposedMatrixChunk<WeightType>(
+				BasicTransposedMatrixChunk<WeightType>::fromColumnWiseData(matrix->m_columnWiseWeights, totalNumberOfVertices)));
+			matrix->m_columnWiseWeights = std::vector<WeightType>();
+		}
+		return matrix;
+	}
+
+
+	/// <summary>
+	/// Checks if weights are arranged row-wise.
+	/// </summary>
+	inline bool checkIfIsTransposed() const {
+		return m_transposedMatrix != nullptr;
+	}
+
+
+	/// <summary>
+	/// Returns weights arranged column-wise - empty view if matrix is transposed.
+	/// </summary>
+	inline ArrayView<WeightType> getColumnWiseWeights() const {
+		return m_columnWiseWeights;
+	}
+
+
+	/// <summary>
+	/// Returns weights arranged row-wise - should be called only if matrix is transposed.
+	/// </summary>
+	inline const BasicTransposedMatrixChunk<WeightType>& getTransposedMatrix() const {
+		return *m_transposedMatrix;
+	}
+
+private:
+
+	ConvertedAdjacencyMatrix() = default;
+
+	std::vector<WeightType> m_columnWiseWeights;
+	std::unique_ptr<BasicTransposedMatrixChunk<WeightType>> m_transposedMatrix;
+
+};
@@ -1,13 +1,18 @@
 #include "DijkstraAlgorithmBackend.h"
+#include "RelaxationKernels.h"
 
+#include <algorithm>
+#include <type_traits>
 #include <utility>
 
 
 
-DijkstraAlgorithmBackend::DijkstraAlgorithmBackend(const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex) :
+template <typename WeightType>
+BasicDijkstraAlgorithmBackend<WeightType>::BasicDijkstraAlgorithmBackend(const RangeType& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex) :
 	verticesToHandleRange(verticesToHandleRange),
-	distances(verticesToHandleRange.second - verticesToHandleRange.first + 1, std::numeric_limits<double>::infinity()),
+	distances(verticesToHandleRange.second - verticesToHandleRange.first + 1, infiniteDistance<DistanceType>()),
 	predecessors(verticesToHandleRange.second - verticesToHandleRange.first + 1, -1),
+	processedVerticesBitmap((verticesToHandleRange.second - verticesToHandleRange.first + 64) / 64, 0),
 	totalNumberOfVertices(totalNumberOfVertices)
 {
 	if (sourceVertexIndex >= verticesToHandleRange.first && sourceVertexIndex <= verticesToHandleRange.second) {
@@ -16,41 +21,215 @@ DijkstraAlgorithmBackend::DijkstraAlgorithmBackend(const std::pair<int, int>& ve
 }
 
 
-VertexData DijkstraAlgorithmBackend::findVertexWithMinimalDistanceToCluster() {
-	int closestVertex = -1;
-	double shortestDistance = std::numeric_limits<double>::infinity();
-	for (int i = 0; i < distances.size(); ++i) {
-		if (processedVerticesCluster.find(i + verticesToHandleRange.first) == processedVerticesCluster.end()) {
-			if (distances.at(i) < shortestDistance) {
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::findVertexWithMinimalDistanceToCluster() {
+	return findVertexWithMinimalDistanceToCluster(verticesToHandleRange);
+}
+
+
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::findVertexWithMinimalDistanceToCluster(const RangeType& handledVerticesSlice) {
+
+	// vectorized kernel works only for double distances and int vertex numbers
+	if constexpr (std::is_same<DistanceType, double>::value) {
+		VertexData closestVertex = RelaxationKernels::findMinimum(distances.data(), processedVerticesBitmap.data(),
+			handledVerticesSlice.first - verticesToHandleRange.first, handledVerticesSlice.second - verticesToHandleRange.first + 1);
+		return (closestVertex.vertexNumber != -1
+			? createVertexDataInstance(closestVertex.distance, verticesToHandleRange.first + closestVertex.vertexNumber)
+			: createVertexDataInstance());
+	}
+	else {
+		int closestVertex = -1;
+		DistanceType shortestDistance = infiniteDistance<DistanceType>();
+		forEachHandledVertexNotProcessed([&](int i) {
+			if (distances[i] < shortestDistance) {
 				closestVertex = verticesToHandleRange.first + i;
-				shortestDistance = distances.at(i);
+				shortestDistance = distances[i];
 			}
+		}, handledVerticesSlice.first - verticesToHandleRange.first, handledVerticesSlice.second - verticesToHandleRange.first + 1);
+		return (closestVertex != -1
+			? createVertexDataInstance<DistanceType>(shortestDistance, closestVertex)
+			: createVertexDataInstance<DistanceType>());
+	}
+}
+
+
+template <typename WeightType>
+void BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoop(const VertexDataType& vertexClosestToCluster, const ArrayView<WeightType>& processedPartOfAdjacencyMatrix) {
+
+	// weights of edges leading from vertex closest to cluster are stored every totalNumberOfVertices entries
+	performInnerForLoop(vertexClosestToCluster, processedPartOfAdjacencyMatrix.data() + vertexClosestToCluster.vertexNumber, totalNumberOfVertices);
+}
+
+
+template <typename WeightType>
+void BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoop(const VertexDataType& vertexClosestToCluster, const BasicTransposedMatrixChunk<WeightType>& processedPartOfAdjacencyMatrix) {
+
+	// weights of edges leading from vertex closest to cluster are stored next to each other
+	performInnerForLoop(vertexClosestToCluster, processedPartOfAdjacencyMatrix.getWeightsOfEdgesLeavingVertex(vertexClosestToCluster.vertexNumber), 1);
+}
+
+
+template <typename WeightType>
+void BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoop(const VertexDataType& vertexClosestToCluster, const SparseGraph& processedPartOfGraph) {
+
+	ArrayView<int> offsets = processedPartOfGraph.getOffsets();
+	ArrayView<int> targets = processedPartOfGraph.getTargets();
+	ArrayView<double> weights = processedPartOfGraph.getWeights();
+
+	for (int e = offsets.at(vertexClosestToCluster.vertexNumber); e < offsets.at(vertexClosestToCluster.vertexNumber + 1); ++e) {
+
+		// if target vertex is not handled by this object or has already been processed, we skip it
+		int target = targets[e];
+		if (target < verticesToHandleRange.first || target > verticesToHandleRange.second
+			|| checkIfHandledVertexHasBeenProcessed(target - verticesToHandleRange.first)) {
+			continue;
+		}
+
+		DistanceType altDistance = static_cast<DistanceType>(weights[e]) + vertexClosestToCluster.distance;
+		if (altDistance < distances[target - verticesToHandleRange.first]) {
+			distances[target - verticesToHandleRange.first] = altDistance;
+			predecessors[target - verticesToHandleRange.first] = vertexClosestToCluster.vertexNumber;
 		}
 	}
-	return (closestVertex != -1 
-		? createVertexDataInstance(distances.at(closestVertex - verticesToHandleRange.first), closestVertex) 
-		: createVertexDataInstance());
 }
 
 
-void DijkstraAlgorithmBackend::performInnerForLoop(const VertexData& vertexClosestToCluster, const std::vector<double>& processedPartOfAdjacencyMatrix) {
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(
+	const VertexDataType& vertexClosestToCluster, const ArrayView<WeightType>& processedPartOfAdjacencyMatrix) {
+	return performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(vertexClosestToCluster, processedPartOfAdjacencyMatrix, verticesToHandleRange);
+}
+
+
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(
+	const VertexDataType& vertexClosestToCluster, const BasicTransposedMatrixChunk<WeightType>& processedPartOfAdjacencyMatrix) {
+	return performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(vertexClosestToCluster, processedPartOfAdjacencyMatrix, verticesToHandleRange);
+}
+
+
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(
+	const VertexDataType& vertexClosestToCluster, const SparseGraph& processedPartOfGraph) {
+	return performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(vertexClosestToCluster, processedPartOfGraph, verticesToHandleRange);
+}
+
+
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(
+	const VertexDataType& vertexClosestToCluster, const ArrayView<WeightType>& processedPartOfAdjacencyMatrix, const RangeType& handledVerticesSlice) {
 
-	int numberOfVerticesToHandle = verticesToHandleRange.second - verticesToHandleRange.first + 1;
-	for (int i = 0; i < numberOfVerticesToHandle; ++i) {
+	// weights of edges leading from vertex closest to cluster are stored every totalNumberOfVertices entries
+	return performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(vertexClosestToCluster,
+		processedPartOfAdjacencyMatrix.data() + vertexClosestToCluster.vertexNumber, totalNumberOfVertices,
+		handledVerticesSlice.first - verticesToHandleRange.first, handledVerticesSlice.second - verticesToHandleRange.first + 1);
+}
+
+
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(
+	const VertexDataType& vertexClosestToCluster, const BasicTransposedMatrixChunk<WeightType>& processedPartOfAdjacencyMatrix, const RangeType& handledVerticesSlice) {
+
+	// weights of edges leading from vertex closest to cluster are stored next to each other
+	return performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(vertexClosestToCluster,
+		processedPartOfAdjacencyMatrix.getWeightsOfEdgesLeavingVertex(vertexClosestToCluster.vertexNumber), 1,
+		handledVerticesSlice.first - verticesToHandleRange.first, handledVerticesSlice.second - verticesToHandleRange.first + 1);
+}
+
+
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(
+	const VertexDataType& vertexClosestToCluster, const SparseGraph& processedPartOfGraph, const RangeType& handledVerticesSlice) {
+
+	ArrayView<int> offsets = processedPartOfGraph.getOffsets();
+	ArrayView<int> targets = processedPartOfGraph.getTargets();
+	ArrayView<double> weights = processedPartOfGraph.getWeights();
+
+	// targets in each row are sorted, so edges leading to vertices from the slice form continous block
+	const int* rowBegin = targets.data() + offsets.at(vertexClosestToCluster.vertexNumber);
+	const int* rowEnd = targets.data() + offsets.at(vertexClosestToCluster.vertexNumber + 1);
+	const int* sliceBegin = std::lower_bound(rowBegin, rowEnd, handledVerticesSlice.first);
+	const int* sliceEnd = std::upper_bound(sliceBegin, rowEnd, handledVerticesSlice.second);
 
-		// if vertex has already been processed, we skip it
-		if (processedVerticesCluster.find(verticesToHandleRange.first + i) != processedVerticesCluster.end()) {
+	for (const int* target = sliceBegin; target != sliceEnd; ++target) {
+
+		// processed vertices are skipped
+		int handledVertex = *target - verticesToHandleRange.first;
+		if (checkIfHandledVertexHasBeenProcessed(handledVertex)) {
 			continue;
 		}
 
-		double valueInMatrix = (processedPartOfAdjacencyMatrix.at(i * totalNumberOfVertices + vertexClosestToCluster.vertexNumber) < 0.001
-			? std::numeric_limits<double>::infinity()
-			: processedPartOfAdjacencyMatrix.at(i * totalNumberOfVertices + vertexClosestToCluster.vertexNumber));
-		double altDistance = valueInMatrix + vertexClosestToCluster.distance;
+		DistanceType altDistance = static_cast<DistanceType>(weights[target - targets.data()]) + vertexClosestToCluster.distance;
+		if (altDistance < distances[handledVertex]) {
+			distances[handledVertex] = altDistance;
+			predecessors[handledVertex] = vertexClosestToCluster.vertexNumber;
+		}
+	}
+	return findVertexWithMinimalDistanceToCluster(handledVerticesSlice);
+}
+
+
+template <typename WeightType>
+void BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoop(const VertexDataType& vertexClosestToCluster, const WeightType* weights, size_t stride) {
+
+	// processed vertices and missing edges are skipped - adding infinite weight
+	// would overflow integer distances
+	forEachHandledVertexNotProcessed([&](int i) {
+		if (!WeightTraits<WeightType>::checkIfIsEdge(weights[i * stride])) {
+			return;
+		}
+		DistanceType altDistance = static_cast<DistanceType>(weights[i * stride]) + vertexClosestToCluster.distance;
 
-		if (altDistance < distances.at(i)) {
-			distances.at(i) = altDistance;
-			predecessors.at(i) = vertexClosestToCluster.vertexNumber;
+		if (altDistance < distances[i]) {
+			distances[i] = altDistance;
+			predecessors[i] = vertexClosestToCluster.vertexNumber;
+		}
+	}, 0, static_cast<int>(distances.size()));
+}
+
+
+template <typename WeightType>
+typename BasicDijkstraAlgorithmBackend<WeightType>::VertexDataType BasicDijkstraAlgorithmBackend<WeightType>::performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(
+	const VertexDataType& vertexClosestToCluster, const WeightType* weights, size_t stride, int begin, int end) {
+
+	// continous double weights can be processed by vectorized kernels
+	if constexpr (std::is_same<WeightType, double>::value) {
+		if (stride == 1) {
+			VertexData closestVertex = RelaxationKernels::relaxAndFindMinimum(vertexClosestToCluster, weights, distances.data(), predecessors.data(),
+				processedVerticesBitmap.data(), begin, end);
+			return (closestVertex.vertexNumber != -1
+				? createVertexDataInstance(closestVertex.distance, verticesToHandleRange.first + closestVertex.vertexNumber)
+				: createVertexDataInstance());
 		}
 	}
-}
\ No newline at end of file
+
+	int closestVertex = -1;
+	DistanceType shortestDistance = infiniteDistance<DistanceType>();
+	forEachHandledVertexNotProcessed([&](int i) {
+
+		// relax edge leading to vertex i
+		if (WeightTraits<WeightType>::checkIfIsEdge(weights[i * stride])) {
+			DistanceType altDistance = static_cast<DistanceType>(weights[i * stride]) + vertexClosestToCluster.distance;
+
+			if (altDistance < distances[i]) {
+				distances[i] = altDistance;
+				predecessors[i] = vertexClosestToCluster.vertexNumber;
+			}
+		}
+
+		// and use its final distance in this iteration to find next closest vertex
+		if (distances[i] < shortestDistance) {
+			closestVertex = verticesToHandleRange.first + i;
+			shortestDistance = distances[i];
+		}
+	}, begin, end);
+	return (closestVertex != -1
+		? createVertexDataInstance<DistanceType>(shortestDistance, closestVertex)
+		: createVertexDataInstance<DistanceType>());
+}
+
+
+template class BasicDijkstraAlgorithmBackend<double>;
+template class BasicDijkstraAlgorithmBackend<float>;
+template class BasicDijkstraAlgorithmBackend<std::uint16_t>;
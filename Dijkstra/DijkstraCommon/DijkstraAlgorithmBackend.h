@@ -14,9 +14,14 @@
 
 #pragma once
 
+#include "ArrayView.h"
+#include "SparseGraph.h"
+#include "TransposedMatrixChunk.h"
 #include "VertexData.h"
+#include "WeightTraits.h"
 
-#include <set>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 
@@ -25,13 +30,26 @@
 /// kind of building blocks that Dijkstra algorithm implementations can
 /// then reuse. It manages distance and predecessors arrays as well as
 /// stores cluster of already processed vertices - so user can focus on 
-/// managing algorithm flow. Please note that this class is final - to 
+/// managing algorithm flow. Only handled vertices are remembered in the
+/// cluster (in form of a bitmap), other vertices are just counted. Please note that this class is final - to 
 /// use it, consider composition (not inheritance).
 /// </summary>
-class DijkstraAlgorithmBackend final {
+/// <remarks>
+/// Template parameter is type of weights of dense graph (see WeightTraits - distances
+/// are stored in type it defines). Most of the code uses DijkstraAlgorithmBackend
+/// alias (double weights) - only this type uses vectorized kernels, others use
+/// generic loops. Sparse graphs always store double weights.
+/// </remarks>
+template <typename WeightType>
+class BasicDijkstraAlgorithmBackend final {
 
 public:
 
+	using DistanceType = typename WeightTraits<WeightType>::DistanceType;
+	using VertexDataType = BasicVertexData<DistanceType>;
+	using RangeType = std::pair<int, int>;
+
+
 	/// <summary>
 	/// Constructor of Dijkstra algorithm backend class. It prepares class
 	/// properties - distance and predecessors arrays as well as cluster of
@@ -50,29 +68,36 @@ public:
 	/// <param name="sourceVertexIndex">
 	/// Integer number that represents index of source vertex. 
 	/// </param>
-	DijkstraAlgorithmBackend(const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex);
+	BasicDijkstraAlgorithmBackend(const RangeType& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex);
 
 
 	/// <summary>
 	/// Checks if all graph vertices have already been processed - so it checks
-	/// it size of cluster is equal to total number of verices in input graph.
+	/// if number of processed vertices is equal to total number of verices in 
+	/// input graph.
 	/// </summary>
 	/// <returns>
 	/// Boolean that indicates if all vertices have been processed. 
 	/// </returns>
 	inline bool checkIfAllVerticesHaveBeenProcessed() const {
-		return processedVerticesCluster.size() == totalNumberOfVertices;
+		return numberOfProcessedVertices == totalNumberOfVertices;
 	}
 	
 
 	/// <summary>
 	/// Marks vertiex as processed - adds it to cluster of processed vertices.
+	/// Every vertex processed in the whole graph should be marked, but only
+	/// handled ones are stored.
 	/// </summary>
 	/// <param name="vertex">
 	/// Number of vertex that should be added to the cluster of processed vertices.
 	/// </param>
 	inline void markVertexAsProcessed(int vertex) {
-		processedVerticesCluster.insert(vertex);
+		++numberOfProcessedVertices;
+		if (vertex >= verticesToHandleRange.first && vertex <= verticesToHandleRange.second) {
+			int handledVertex = vertex - verticesToHandleRange.first;
+			processedVerticesBitmap[handledVertex / 64] |= std::uint64_t(1) << (handledVertex % 64);
+		}
 	}
 	
 
@@ -85,7 +110,23 @@ public:
 	/// been found, returns VertexData with vertex index set to -1 and distance to 
 	/// infinity. 
 	/// </returns>
-	VertexData findVertexWithMinimalDistanceToCluster();
+	VertexDataType findVertexWithMinimalDistanceToCluster();
+
+
+	/// <summary>
+	/// This method finds vertex with minimal distance to cluster of processed
+	/// vertices, but only among vertices from given slice of handled range. 
+	/// Different threads can call it for disjoint slices at the same time.
+	/// </summary>
+	/// <returns>
+	/// VertexData structure with vertex index and distance. If no proper vertex has
+	/// been found, returns VertexData with vertex index set to -1 and distance to 
+	/// infinity. 
+	/// </returns>
+	/// <param name="handledVerticesSlice">
+	/// Range of vertices [a, b] that is a part of handled range (may be empty).
+	/// </param>
+	VertexDataType findVertexWithMinimalDistanceToCluster(const RangeType& handledVerticesSlice);
 
 
 	/// <summary>
@@ -103,7 +144,148 @@ public:
 	/// passed in a form of 1D vector of weights. Data from matrix should be aranged 
 	/// column-wise.
 	/// </param>
-	void performInnerForLoop(const VertexData& vertexClosestToCluster, const std::vector<double>& processedPartOfAdjacencyMatrix);
+	void performInnerForLoop(const VertexDataType& vertexClosestToCluster, const ArrayView<WeightType>& processedPartOfAdjacencyMatrix);
+
+
+	/// <summary>
+	/// This method performs inner for loop of dijkstra algorithm for graph stored
+	/// in sparse form - only outgoing edges of vertex that has been recently added
+	/// to cluster are visited, so it takes time proportional to its degree instead
+	/// of number of handled vertices.
+	/// </summary>
+	/// <param name="vertexClosestToCluster">
+	/// VertexData structure that represents vertex that  has been recently added
+	/// to cluster (so the one with shortest distance to the cluster).
+	/// </param>
+	/// <param name="processedPartOfGraph">
+	/// Part of sparse graph that is being processed by this object. Edges which target
+	/// vertices are not handled by this object are skipped.
+	/// </param>
+	void performInnerForLoop(const VertexDataType& vertexClosestToCluster, const SparseGraph& processedPartOfGraph);
+
+
+	/// <summary>
+	/// This method performs inner for loop of dijkstra algorithm for part of adjacency
+	/// matrix arranged row-wise - weights of edges leaving vertex that has been recently
+	/// added to cluster are read sequentially.
+	/// </summary>
+	/// <param name="vertexClosestToCluster">
+	/// VertexData structure that represents vertex that  has been recently added
+	/// to cluster (so the one with shortest distance to the cluster).
+	/// </param>
+	/// <param name="processedPartOfAdjacencyMatrix">
+	/// Part of adjacency matrix that is being processed by this object, arranged row-wise.
+	/// </param>
+	void performInnerForLoop(const VertexDataType& vertexClosestToCluster, const BasicTransposedMatrixChunk<WeightType>& processedPartOfAdjacencyMatrix);
+
+
+	/// <summary>
+	/// This method performs inner for loop of dijkstra algorithm and then finds vertex
+	/// with minimal distance to cluster of processed vertices - so it does the work of
+	/// performInnerForLoop and findVertexWithMinimalDistanceToCluster in one pass over 
+	/// the distances array.
+	/// </summary>
+	/// <returns>
+	/// VertexData structure with vertex index and distance. If no proper vertex has
+	/// been found, returns VertexData with vertex index set to -1 and distance to 
+	/// infinity. 
+	/// </returns>
+	/// <param name="vertexClosestToCluster">
+	/// VertexData structure that represents vertex that  has been recently added
+	/// to cluster (so the one with shortest distance to the cluster).
+	/// </param>
+	/// <param name="processedPartOfAdjacencyMatrix">
+	/// Part of adjacency matrix that is being processed by this object - it should be
+	/// passed in a form of 1D vector of weights. Data from matrix should be aranged 
+	/// column-wise.
+	/// </param>
+	VertexDataType performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(const VertexDataType& vertexClosestToCluster, const ArrayView<WeightType>& processedPartOfAdjacencyMatrix);
+
+
+	/// <summary>
+	/// Does the same as the method above, but only for vertices from given slice of
+	/// handled range - so different threads can relax disjoint slices at the same time.
+	/// </summary>
+	/// <param name="handledVerticesSlice">
+	/// Range of vertices [a, b] that is a part of handled range (may be empty).
+	/// </param>
+	VertexDataType performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(const VertexDataType& vertexClosestToCluster, const ArrayView<WeightType>& processedPartOfAdjacencyMatrix,
+		const RangeType& handledVerticesSlice);
+
+
+	/// <summary>
+	/// This method performs inner for loop of dijkstra algorithm for graph stored
+	/// in sparse form and then finds vertex with minimal distance to cluster of 
+	/// processed vertices.
+	/// </summary>
+	/// <returns>
+	/// VertexData structure with vertex index and distance. If no proper vertex has
+	/// been found, returns VertexData with vertex index set to -1 and distance to 
+	/// infinity. 
+	/// </returns>
+	/// <param name="vertexClosestToCluster">
+	/// VertexData structure that represents vertex that  has been recently added
+	/// to cluster (so the one with shortest distance to the cluster).
+	/// </param>
+	/// <param name="processedPartOfGraph">
+	/// Part of sparse graph that is being processed by this object.
+	/// </param>
+	VertexDataType performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(const VertexDataType& vertexClosestToCluster, const SparseGraph& processedPartOfGraph);
+
+
+	/// <summary>
+	/// Does the same as the method above, but only for vertices from given slice of
+	/// handled range - so different threads can relax disjoint slices at the same time.
+	/// </summary>
+	/// <param name="handledVerticesSlice">
+	/// Range of vertices [a, b] that is a part of handled range (may be empty).
+	/// </param>
+	VertexDataType performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(const VertexDataType& vertexClosestToCluster, const SparseGraph& processedPartOfGraph,
+		const RangeType& handledVerticesSlice);
+
+
+	/// <summary>
+	/// This method performs inner for loop of dijkstra algorithm for part of adjacency 
+	/// matrix arranged row-wise and then finds vertex with minimal distance to cluster
+	/// of processed vertices - both in one sequential pass.
+	/// </summary>
+	/// <returns>
+	/// VertexData structure with vertex index and distance. If no proper vertex has
+	/// been found, returns VertexData with vertex index set to -1 and distance to 
+	/// infinity. 
+	/// </returns>
+	/// <param name="vertexClosestToCluster">
+	/// VertexData structure that represents vertex that  has been recently added
+	/// to cluster (so the one with shortest distance to the cluster).
+	/// </param>
+	/// <param name="processedPartOfAdjacencyMatrix">
+	/// Part of adjacency matrix that is being processed by this object, arranged row-wise.
+	/// </param>
+	VertexDataType performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(const VertexDataType& vertexClosestToCluster, const BasicTransposedMatrixChunk<WeightType>& processedPartOfAdjacencyMatrix);
+
+
+	/// <summary>
+	/// Does the same as the method above, but only for vertices from given slice of
+	/// handled range - so different threads can relax disjoint slices at the same time.
+	/// </summary>
+	/// <param name="handledVerticesSlice">
+	/// Range of vertices [a, b] that is a part of handled range (may be empty).
+	/// </param>
+	VertexDataType performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(const VertexDataType& vertexClosestToCluster, const BasicTransposedMatrixChunk<WeightType>& processedPartOfAdjacencyMatrix,
+		const RangeType& handledVerticesSlice);
+
+
+	/// <summary>
+	/// Checks if vertex has already been added to cluster of processed vertices.
+	/// Only handled vertices are stored, so for other ones false is returned.
+	/// </summary>
+	/// <param name="vertex">
+	/// Number of vertex in the whole graph.
+	/// </param>
+	inline bool checkIfVertexHasBeenProcessed(int vertex) const {
+		return vertex >= verticesToHandleRange.first && vertex <= verticesToHandleRange.second
+			&& checkIfHandledVertexHasBeenProcessed(vertex - verticesToHandleRange.first);
+	}
 
 
 	/// <summary>
@@ -113,7 +295,7 @@ public:
 	/// Reference to const vector of distances.Please note that it is a reference
 	/// so it is valid only as long as this object is valid.
 	/// </returns>
-	const std::vector<double>& getDistances() const {
+	const std::vector<DistanceType>& getDistances() const {
 		return distances;
 	}
 
@@ -131,11 +313,101 @@ public:
 
 private:
 
-	std::pair<int, int> verticesToHandleRange;
-	std::vector<double> distances;
+	/// <summary>
+	/// Checks if handled vertex has already been processed. 
+	/// </summary>
+	/// <param name="handledVertex">
+	/// Index of vertex counted from the beginning of handled range.
+	/// </param>
+	inline bool checkIfHandledVertexHasBeenProcessed(int handledVertex) const {
+		return (processedVerticesBitmap[handledVertex / 64] >> (handledVertex % 64)) & 1;
+	}
+
+
+	/// <summary>
+	/// Performs inner for loop of dijkstra algorithm using weights of edges leading
+	/// from vertex closest to cluster to handled vertices. Weight for handled vertex i 
+	/// is stored in weights[i * stride].
+	/// </summary>
+	void performInnerForLoop(const VertexDataType& vertexClosestToCluster, const WeightType* weights, size_t stride);
+
+
+	/// <summary>
+	/// Performs inner for loop of dijkstra algorithm using weights of edges leading
+	/// from vertex closest to cluster to handled vertices and finds next vertex closest
+	/// to cluster. Weight for handled vertex i is stored in weights[i * stride]. Only
+	/// vertices in range [begin, end) counted from the beginning of handled range are visited.
+	/// </summary>
+	VertexDataType performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(const VertexDataType& vertexClosestToCluster, const WeightType* weights, size_t stride,
+		int begin, int end);
+
+
+	/// <summary>
+	/// Calls given function for every handled vertex in range [begin, end) that has
+	/// not been processed yet, in ascending order. Whole 64-vertex blocks of processed
+	/// vertices are skipped at once.
+	/// </summary>
+	/// <param name="function">
+	/// Function that takes index of vertex counted from the beginning of handled range.
+	/// </param>
+	template <typename Function>
+	inline void forEachHandledVertexNotProcessed(Function function, int begin, int end) const {
+		for (int block = begin / 64; block * 64 < end; ++block) {
+			std::uint64_t processedInBlock = processedVerticesBitmap[block];
+			if (processedInBlock == ~std::uint64_t(0)) {
+				continue;
+			}
+			int blockBegin = block * 64 > begin ? block * 64 : begin;
+			int blockEnd = block * 64 + 64 < end ? block * 64 + 64 : end;
+			for (int i = blockBegin; i < blockEnd; ++i) {
+				if (!((processedInBlock >> (i % 64)) & 1)) {
+					function(i);
+				}
+			}
+		}
+	}
+
+
+	RangeType verticesToHandleRange;
+	std::vector<DistanceType> distances;
 	std::vector<int> predecessors;
-	std::set<int> processedVerticesCluster;
+	std::vector<std::uint64_t> processedVerticesBitmap;
 
+	int numberOfProcessedVertices = 0;
 	int totalNumberOfVertices;
 
+};
+
+
+/// <summary>
+/// Backend with double weights - the one used by default.
+/// </summary>
+using DijkstraAlgorithmBackend = BasicDijkstraAlgorithmBackend<double>;
+
+
+/// <summary>
+/// Type of weights stored in given graph representation - used by algorithm
+/// implementations to choose backend for the graph they process.
+/// </summary>
+template <typename GraphDataType>
+struct GraphWeightType {
+	using Type = double;
+};
+
+
+template <typename WeightType>
+struct GraphWeightType<ArrayView<WeightType>> {
+	using Type = WeightType;
+};
+
+
+template <typename WeightType>
+struct GraphWeightType<std::vector<WeightType>> {
+	using Type = WeightType;
+};
+
+
+template <typename WeightType>
+struct GraphWeightType<BasicTransposedMatrixChunk<WeightType>> {
+	using Type = WeightType;
 };
\ No newline at end of file
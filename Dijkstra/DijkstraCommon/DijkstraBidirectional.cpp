@@ -0,0 +1,102 @@
+#include "DijkstraBidirectional.h"
+
+
+template <typename GraphDataType, typename ReversedGraphDataType>
+std::pair<const std::vector<double>, const std::vector<int>> DijkstraBidirectional<GraphDataType, ReversedGraphDataType>::run() {
+
+	// local closest vertices of threads for both searches (0 - forward, 1 - backward) - two sets are used
+	// alternately, so threads can read one of them while others already write next iteration results
+	int numberOfThreads = m_threadTeam.getNumberOfThreads();
+	std::vector<CacheLinePadded<VertexData>> localMinimaOfThreads[2][2] = {
+		{ std::vector<CacheLinePadded<VertexData>>(numberOfThreads), std::vector<CacheLinePadded<VertexData>>(numberOfThreads) },
+		{ std::vector<CacheLinePadded<VertexData>>(numberOfThreads), std::vector<CacheLinePadded<VertexData>>(numberOfThreads) }
+	};
+	DijkstraAlgorithmBackend* backends[2] = { &m_forwardBackend, &m_backwardBackend };
+	bool searchesHaveMet = false;
+
+	m_threadTeam.execute([&](int threadIndex) {
+
+		// every thread owns slice of vertices in both searches
+		std::pair<int, int> ownedVerticesSlice = ThreadTeam::computeSliceOfRange(std::make_pair(0, m_totalNumberOfVertices - 1), numberOfThreads, threadIndex);
+		localMinimaOfThreads[0][0][threadIndex].value = m_forwardBackend.findVertexWithMinimalDistanceToCluster(ownedVerticesSlice);
+		localMinimaOfThreads[0][1][threadIndex].value = m_backwardBackend.findVertexWithMinimalDistanceToCluster(ownedVerticesSlice);
+
+		int iteration = 0;
+		for (; ; ++iteration) {
+			auto& localMinima = localMinimaOfThreads[iteration % 2];
+			auto& nextLocalMinima = localMinimaOfThreads[(iteration + 1) % 2];
+			m_threadTeam.synchronize();
+
+			// every thread computes global closest vertices of both searches on its own
+			VertexData globalMinima[2] = { localMinima[0][0].value, localMinima[1][0].value };
+			for (int direction = 0; direction < 2; ++direction) {
+				for (int i = 1; i < numberOfThreads; ++i) {
+					if (localMinima[direction][i].value.distance < globalMinima[direction].distance) {
+						globalMinima[direction] = localMinima[direction][i].value;
+					}
+				}
+			}
+
+			// if one of searches has no valid closest vertex, they can not meet - target is unreachable
+			if (globalMinima[0].vertexNumber == -1 || globalMinima[1].vertexNumber == -1) {
+				break;
+			}
+
+			// search with closer vertex processes it, ties go to forward search
+			int direction = globalMinima[1].distance < globalMinima[0].distance ? 1 : 0;
+			int vertex = globalMinima[direction].vertexNumber;
+			bool processedByOtherSearch = backends[1 - direction]->checkIfVertexHasBeenProcessed(vertex);
+			if (vertex >= ownedVerticesSlice.first && vertex <= ownedVerticesSlice.second) {
+				backends[direction]->markVertexAsProcessed(vertex);
+			}
+
+			// vertex processed by both searches - labels of both of them already contain shortest path
+			if (processedByOtherSearch) {
+				if (threadIndex == 0) {
+					searchesHaveMet = true;
+				}
+				break;
+			}
+
+			// only the search that processed vertex relaxes edges, local minimum of the other one does not change
+			nextLocalMinima[1 - direction][threadIndex].value = localMinima[1 - direction][threadIndex].value;
+			nextLocalMinima[direction][threadIndex].value = direction == 0
+				? m_forwardBackend.performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(globalMinima[0], m_graphData, ownedVerticesSlice)
+				: m_backwardBackend.performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(globalMinima[1], m_reversedGraphData, ownedVerticesSlice);
+		}
+		if (threadIndex == 0) {
+			m_numberOfProcessedVertices = searchesHaveMet ? iteration + 1 : iteration;
+		}
+	});
+
+	// shortest path goes through vertex with minimal sum of distances from source and to target - also when
+	// one search has run out of vertices before meeting, its labels are final then (e.g. source equal to target)
+	const std::vector<double>& forwardDistances = m_forwardBackend.getDistances();
+	const std::vector<double>& backwardDistances = m_backwardBackend.getDistances();
+	int meetingVertex = -1;
+	double shortestDistance = std::numeric_limits<double>::infinity();
+	for (int v = 0; v < m_totalNumberOfVertices; ++v) {
+		if (forwardDistances[v] + backwardDistances[v] < shortestDistance) {
+			meetingVertex = v;
+			shortestDistance = forwardDistances[v] + backwardDistances[v];
+		}
+	}
+
+	// path from meeting vertex to target is stored by backward search in reversed order
+	std::vector<double> distances = forwardDistances;
+	std::vector<int> predecessors = m_forwardBackend.getPredecessors();
+	const std::vector<int>& successors = m_backwardBackend.getPredecessors();
+	distances[m_targetVertexIndex] = shortestDistance;
+	if (meetingVertex == -1) {
+		predecessors[m_targetVertexIndex] = -1;
+	}
+	for (int vertex = meetingVertex; vertex != -1 && vertex != m_targetVertexIndex; vertex = successors[vertex]) {
+		predecessors[successors[vertex]] = vertex;
+	}
+	return std::make_pair(std::move(distances), std::move(predecessors));
+}
+
+
+template class DijkstraBidirectional<ArrayView<double>, TransposedMatrixChunk>;
+template class DijkstraBidirectional<TransposedMatrixChunk, ArrayView<double>>;
+template class DijkstraBidirectional<SparseGraph, SparseGraph>;
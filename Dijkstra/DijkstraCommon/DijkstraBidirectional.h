@@ -0,0 +1,96 @@
+/**
+*	@file DijkstraBidirectional.h
+*	@brief This file contains bidirectional Dijkstra algorithm implementation
+*	that finds shortest path between two vertices.
+*/
+
+
+#pragma once
+
+#include "DijkstraAlgorithmBackend.h"
+#include "ThreadTeam.h"
+
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class contains bidirectional Dijkstra algorithm implementation, used
+/// by DijkstraSerial (with one thread) and DijkstraThreaded. Forward search
+/// starts from source vertex on the graph, backward search starts from target
+/// vertex on reversed graph - both of them use their own DijkstraAlgorithmBackend.
+/// In every iteration the search with closer vertex processes it, so both of
+/// them grow evenly. Algorithm stops when some vertex has been processed by both
+/// searches - shortest path goes then through vertex with minimal sum of forward
+/// and backward distance. Every thread of ThreadTeam owns a slice of vertices,
+/// exactly like in DijkstraThreaded. Template parameters are types of graph and
+/// reversed graph representations.
+/// </summary>
+template <typename GraphDataType, typename ReversedGraphDataType>
+class DijkstraBidirectional
+{
+public:
+
+	/// <summary>
+	/// DijkstraBidirectional class constructor. Prepares backends of both searches
+	/// and starts threads that will run the algorithm.
+	/// </summary>
+	/// <param name="totalNumberOfVertices">
+	/// Integer number that represents total number of vertices in processed
+	/// graph.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Integer number that represents index of source vertex.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Integer number that represents index of target vertex.
+	/// </param>
+	/// <param name="graphData">
+	/// Graph used by forward search. Please note that this object stores reference
+	/// to it - it is valid as long as graph itself is valid.
+	/// </param>
+	/// <param name="reversedGraphData">
+	/// The same graph with every edge reversed, used by backward search. Adjacency
+	/// matrix arranged column-wise is reversed graph of TransposedMatrixChunk with
+	/// the same data (and vice versa), sparse graph can be reversed with
+	/// SparseGraph::createReversedGraph.
+	/// </param>
+	/// <param name="numberOfThreads">
+	/// Number of threads that run the algorithm (including calling thread).
+	/// </param>
+	DijkstraBidirectional(int totalNumberOfVertices, int sourceVertexIndex, int targetVertexIndex, const GraphDataType& graphData,
+		const ReversedGraphDataType& reversedGraphData, int numberOfThreads = 1)
+		: m_forwardBackend(std::make_pair(0, totalNumberOfVertices - 1), totalNumberOfVertices, sourceVertexIndex),
+		m_backwardBackend(std::make_pair(0, totalNumberOfVertices - 1), totalNumberOfVertices, targetVertexIndex),
+		m_graphData(graphData), m_reversedGraphData(reversedGraphData), m_totalNumberOfVertices(totalNumberOfVertices),
+		m_targetVertexIndex(targetVertexIndex), m_threadTeam(numberOfThreads) {}
+
+
+	/// <summary>
+	/// Bidirectional Dijkstra algorithm implementation. Finds shortest path from
+	/// source vertex to target vertex.
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors in the same form as results of other implementations, but
+	/// only distance to target vertex and predecessors on path to it are valid.
+	/// </returns>
+	std::pair<const std::vector<double>, const std::vector<int>> run();
+
+
+	/// <summary>
+	/// Returns number of vertices processed by both searches during last run.
+	/// </summary>
+	inline int getNumberOfProcessedVertices() const {
+		return m_numberOfProcessedVertices;
+	}
+
+private:
+
+	DijkstraAlgorithmBackend m_forwardBackend;
+	DijkstraAlgorithmBackend m_backwardBackend;
+	const GraphDataType& m_graphData;
+	const ReversedGraphDataType& m_reversedGraphData;
+	int m_totalNumberOfVertices;
+	int m_targetVertexIndex;
+	int m_numberOfProcessedVertices = 0;
+	ThreadTeam m_threadTeam;
+};
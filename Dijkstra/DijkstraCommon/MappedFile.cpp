@@ -0,0 +1,40 @@
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <iostream>
+
+
+std::unique_ptr<MappedFile> MappedFile::open(const std::string& filePath) {
+
+	int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) {
+		std::cout << "Plik " << filePath << " nie istnieje." << std::endl;
+		return nullptr;
+	}
+
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0) {
+		std::cout << "Plik " << filePath << " jest pusty." << std::endl;
+		close(fileDescriptor);
+		return nullptr;
+	}
+
+	// mapping stays valid after file descriptor is closed
+	size_t size = static_cast<size_t>(fileStatus.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if (data == MAP_FAILED) {
+		std::cout << "Nie mozna odwzorowac pliku " << filePath << " w pamieci." << std::endl;
+		return nullptr;
+	}
+	return std::unique_ptr<MappedFile>(new MappedFile(static_cast<const char*>(data), size));
+}
+
+
+MappedFile::~MappedFile() {
+	munmap(const_cast<char*>(m_data), m_size);
+}
@@ -0,0 +1,73 @@
+/**
+*	@file MappedFile.h
+*	@brief This file contains class that maps whole file into memory.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/// <summary>
+/// This class maps whole file into memory (read-only) using mmap. Pages of the
+/// file are loaded by operating system when they are accessed for the first time,
+/// and they are shared with page cache - so opening file that has recently been
+/// used takes almost no time. File is unmapped when object is destroyed. Please
+/// note that this class is final - to use it, consider composition (not inheritance).
+/// </summary>
+class MappedFile final {
+
+public:
+
+	/// <summary>
+	/// Static factory method used for mapping file into memory.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to mapped file. If file could not be opened or
+	/// mapped, proper information is printed and nullptr is returned.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to file.
+	/// </param>
+	static std::unique_ptr<MappedFile> open(const std::string& filePath);
+
+
+	/// <summary>
+	/// Destructor - unmaps file.
+	/// </summary>
+	~MappedFile();
+
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+
+	/// <summary>
+	/// Returns pointer to first byte of file. It is aligned at least to page size.
+	/// </summary>
+	inline const char* getData() const {
+		return m_data;
+	}
+
+
+	/// <summary>
+	/// Returns size of file in bytes.
+	/// </summary>
+	inline size_t getSize() const {
+		return m_size;
+	}
+
+private:
+
+	/// <summary>
+	/// Mapped file private constructor. It SHOULD NOT be used on it's own - for
+	/// creating instances in code, please use static factory method.
+	/// </summary>
+	MappedFile(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+
+	const char* m_data;
+	size_t m_size;
+
+};
@@ -0,0 +1,211 @@
+#include "MatrixTextParser.h"
+#include "MappedFile.h"
+#include "ThreadTeam.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+	/// <summary>
+	/// Table of whitespace characters - one lookup instead of six comparisons for
+	/// every byte of the file.
+	/// </summary>
+	struct WhitespaceTable {
+		bool isWhitespace[256] = {};
+		WhitespaceTable() {
+			for (unsigned char character : { ' ', '\n', '\r', '\t', '\v', '\f' }) {
+				isWhitespace[character] = true;
+			}
+		}
+	};
+
+	const WhitespaceTable whitespaceTable;
+
+	inline bool isWhitespace(char character) {
+		return whitespaceTable.isWhitespace[static_cast<unsigned char>(character)];
+	}
+
+
+	/// <summary>
+	/// Parses number written as [-]digits[.digits] with at most 15 significant digits -
+	/// such mantissa and power of 10 up to 10^22 are represented exactly, so single
+	/// division gives correctly rounded result, identical to std::from_chars.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if number had this simple form.
+	/// </returns>
+	inline bool parseSimpleDecimal(const char* begin, const char* end, double& value) {
+		static const double powersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+		bool isNegative = begin < end && *begin == '-';
+		begin += isNegative ? 1 : 0;
+		unsigned long long mantissa = 0;
+		int numberOfDigits = 0;
+		int numberOfFractionDigits = 0;
+		bool afterPoint = false;
+		for (; begin < end; ++begin) {
+			unsigned digit = static_cast<unsigned char>(*begin) - '0';
+			if (digit < 10) {
+				mantissa = mantissa * 10 + digit;
+				++numberOfDigits;
+				numberOfFractionDigits += afterPoint ? 1 : 0;
+			}
+			else if (*begin == '.' && !afterPoint) {
+				afterPoint = true;
+			}
+			else {
+				return false;
+			}
+		}
+		if (numberOfDigits == 0 || numberOfDigits > 15 || numberOfFractionDigits > 22) {
+			return false;
+		}
+		value = static_cast<double>(mantissa) / powersOf10[numberOfFractionDigits];
+		value = isNegative ? -value : value;
+		return true;
+	}
+
+}
+
+
+bool MatrixTextParser::parseFile(const std::string& filePath, int numberOfThreads, std::vector<double>& columnWiseWeights, int& numberOfVertices) {
+
+	numberOfVertices = 0;
+	columnWiseWeights.clear();
+	std::unique_ptr<MappedFile> file = MappedFile::open(filePath);
+	if (!file) {
+		return false;
+	}
+	const char* fileBegin = file->getData();
+	const char* fileEnd = fileBegin + file->getSize();
+
+	// first number in file is number of vertices
+	const char* position = fileBegin;
+	long long line = 1;
+	for (; position < fileEnd && isWhitespace(*position); ++position) {
+		line += *position == '\n' ? 1 : 0;
+	}
+	const char* numberEnd = std::find_if(position, fileEnd, isWhitespace);
+	int parsedNumberOfVertices = 0;
+	auto result = std::from_chars(position, numberEnd, parsedNumberOfVertices);
+	if (position == fileEnd || result.ec != std::errc() || result.ptr != numberEnd || parsedNumberOfVertices < 0) {
+		std::cout << "Plik " << filePath << " zawiera niepoprawne dane w linii " << line << "." << std::endl;
+		return false;
+	}
+
+	// parts of the rest of file end at line boundaries, so no number is divided between them
+	long long dataSize = fileEnd - numberEnd;
+	int numberOfHardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+	int numberOfParts = numberOfThreads > 0 ? numberOfThreads : std::max(1, numberOfHardwareThreads);
+	numberOfParts = static_cast<int>(std::max(1LL, std::min<long long>(numberOfParts, dataSize / minimalPartSize)));
+
+	std::vector<Part> parts(numberOfParts);
+	const char* partBegin = numberEnd;
+	for (int p = 0; p < numberOfParts; ++p) {
+		const char* partEnd = p + 1 < numberOfParts ? numberEnd + dataSize * (p + 1) / numberOfParts : fileEnd;
+		partEnd = std::max(partBegin, partEnd);
+		partEnd = partEnd < fileEnd ? std::min(fileEnd, std::find(partEnd, fileEnd, '\n') + 1) : fileEnd;
+		parts[p] = { partBegin, partEnd, 0, 0, 0, 0, -1 };
+		partBegin = partEnd;
+	}
+
+	ThreadTeam threadTeam(numberOfParts);
+	threadTeam.execute([&parts](int threadIndex) {
+		countNumbers(parts[threadIndex]);
+	});
+
+	// position of first number and first line of each part - sums over previous parts
+	long long numberOfNumbers = 0;
+	for (Part& part : parts) {
+		part.firstLine = line;
+		part.firstNumber = numberOfNumbers;
+		line += part.numberOfLines;
+		numberOfNumbers += part.numberOfNumbers;
+	}
+
+	long long numberOfWeights = static_cast<long long>(parsedNumberOfVertices) * parsedNumberOfVertices;
+	if (numberOfNumbers < numberOfWeights) {
+		std::cout << "Plik " << filePath << " zawiera za malo danych (oczekiwano " << numberOfWeights
+			<< " wag, znaleziono " << numberOfNumbers << ")." << std::endl;
+		return false;
+	}
+
+	columnWiseWeights.assign(static_cast<size_t>(numberOfWeights), 0);
+	double* weights = columnWiseWeights.data();
+	threadTeam.execute([&parts, parsedNumberOfVertices, weights](int threadIndex) {
+		parseNumbers(parts[threadIndex], parsedNumberOfVertices, weights);
+	});
+
+	// parts are ordered, so the first error found is the first one in file
+	for (const Part& part : parts) {
+		if (part.lineWithError >= 0) {
+			std::cout << "Plik " << filePath << " zawiera niepoprawne dane w linii " << part.lineWithError << "." << std::endl;
+			columnWiseWeights.clear();
+			return false;
+		}
+	}
+	numberOfVertices = parsedNumberOfVertices;
+	return true;
+}
+
+
+void MatrixTextParser::countNumbers(Part& part) {
+
+	// part always starts after whitespace, so every non-whitespace after whitespace starts a number
+	bool previousIsWhitespace = true;
+	for (const char* position = part.begin; position < part.end; ++position) {
+		bool currentIsWhitespace = isWhitespace(*position);
+		part.numberOfNumbers += previousIsWhitespace && !currentIsWhitespace ? 1 : 0;
+		part.numberOfLines += *position == '\n' ? 1 : 0;
+		previousIsWhitespace = currentIsWhitespace;
+	}
+}
+
+
+void MatrixTextParser::parseNumbers(Part& part, int numberOfVertices, double* columnWiseWeights) {
+
+	long long numberOfWeights = static_cast<long long>(numberOfVertices) * numberOfVertices;
+	long long index = part.firstNumber;
+	if (index >= numberOfWeights) {
+		return;
+	}
+
+	// rows are stored as columns of continous vector
+	long long row = index / numberOfVertices;
+	long long column = index % numberOfVertices;
+	long long line = part.firstLine;
+	const char* position = part.begin;
+	while (index < numberOfWeights) {
+		for (; position < part.end && isWhitespace(*position); ++position) {
+			line += *position == '\n' ? 1 : 0;
+		}
+		if (position == part.end) {
+			return;
+		}
+
+		const char* numberEnd = position;
+		while (numberEnd < part.end && !isWhitespace(*numberEnd)) {
+			++numberEnd;
+		}
+		double value = 0;
+		if (!parseSimpleDecimal(position, numberEnd, value)) {
+			auto result = std::from_chars(*position == '+' ? position + 1 : position, numberEnd, value);
+			if (result.ec != std::errc() || result.ptr != numberEnd) {
+				part.lineWithError = line;
+				return;
+			}
+		}
+
+		columnWiseWeights[column * numberOfVertices + row] = value;
+		position = numberEnd;
+		++index;
+		if (++column == numberOfVertices) {
+			column = 0;
+			++row;
+		}
+	}
+}
@@ -0,0 +1,88 @@
+/**
+*	@file MatrixTextParser.h
+*	@brief This file contains class responsible for parsing text adjacency
+*	matrix files using multiple threads.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// This class contains static method that parses whole text adjacency matrix
+/// file at once. File is mapped into memory and divided into parts that end at
+/// line boundaries - each thread counts numbers in its part, then parses them
+/// with <c>std::from_chars</c> and writes weights directly to their places in
+/// column-wise arranged matrix. Please note that all methods are static.
+/// </summary>
+class MatrixTextParser final {
+
+public:
+
+	/// <summary>
+	/// Default constructor. Because this class contains only static methods, it
+	/// has been deleted.
+	/// </summary>
+	MatrixTextParser() = delete;
+
+
+	/// <summary>
+	/// Parses text file that contains number of vertices N followed by N * N weights
+	/// (row after row, separated with any whitespace). Numbers after the last weight
+	/// are ignored. If file could not be opened, contains text that is not a number
+	/// or contains too few weights, proper information (with number of line) is printed.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file has been parsed.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to file that contains adjacency matrix information.
+	/// </param>
+	/// <param name="numberOfThreads">
+	/// Number of threads used for parsing. If it is lower than 1, all hardware threads
+	/// are used. Small files are always parsed by one thread.
+	/// </param>
+	/// <param name="columnWiseWeights">
+	/// Vector that is filled with weights - entry [j * N + i] is weight of edge i -> j.
+	/// </param>
+	/// <param name="numberOfVertices">
+	/// Integer that is set to number of vertices (0 if file could not be parsed).
+	/// </param>
+	static bool parseFile(const std::string& filePath, int numberOfThreads, std::vector<double>& columnWiseWeights, int& numberOfVertices);
+
+private:
+
+	/// <summary>
+	/// Part of file handled by one thread. Parts start at the beginning of a line.
+	/// </summary>
+	struct Part {
+		const char* begin;
+		const char* end;
+		long long firstLine;
+		long long numberOfLines;
+		long long firstNumber;
+		long long numberOfNumbers;
+		long long lineWithError;
+	};
+
+
+	/// <summary>
+	/// Counts numbers and lines in part of file.
+	/// </summary>
+	static void countNumbers(Part& part);
+
+
+	/// <summary>
+	/// Parses numbers of part of file and writes these that belong to matrix to their
+	/// places. If text that is not a number is found, its line is stored in part.
+	/// </summary>
+	static void parseNumbers(Part& part, int numberOfVertices, double* columnWiseWeights);
+
+
+	/// <summary>
+	/// Smallest part of file worth parsing by separate thread.
+	/// </summary>
+	static const long long minimalPartSize = 1 << 20;
+
+};
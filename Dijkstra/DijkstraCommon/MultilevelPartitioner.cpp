@@ -0,0 +1,506 @@
+#include "MultilevelPartitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+
+std::vector<int> MultilevelPartitioner::partitionGraph(const SparseGraph& graph, int numberOfParts, double allowedImbalance) {
+
+	int numberOfVertices = graph.getNumberOfVertices();
+	std::vector<int> parts(numberOfVertices, 0);
+	if (numberOfParts <= 1 || numberOfVertices == 0) {
+		return parts;
+	}
+
+	// every bisection gets its share of allowed imbalance, so that their product does not exceed it
+	int numberOfBisectionLevels = 0;
+	while ((1 << numberOfBisectionLevels) < numberOfParts) {
+		++numberOfBisectionLevels;
+	}
+	double allowedImbalanceOfBisection = std::pow(1.0 + allowedImbalance, 1.0 / numberOfBisectionLevels) - 1.0;
+
+	std::vector<int> originalVertices(numberOfVertices);
+	std::iota(originalVertices.begin(), originalVertices.end(), 0);
+	std::mt19937 generator(5489u);
+	partitionRecursively(createUndirectedGraph(graph), originalVertices, 0, numberOfParts, allowedImbalanceOfBisection, generator, parts);
+
+	// very small graphs can leave some parts empty - they take vertices of the largest parts
+	if (numberOfVertices >= numberOfParts) {
+		std::vector<int> sizesOfParts(numberOfParts, 0);
+		for (int part : parts) {
+			++sizesOfParts[part];
+		}
+		for (int part = 0; part < numberOfParts; ++part) {
+			if (sizesOfParts[part] > 0) {
+				continue;
+			}
+			int largestPart = static_cast<int>(std::max_element(sizesOfParts.begin(), sizesOfParts.end()) - sizesOfParts.begin());
+			int vertex = static_cast<int>(std::find(parts.begin(), parts.end(), largestPart) - parts.begin());
+			parts[vertex] = part;
+			--sizesOfParts[largestPart];
+			++sizesOfParts[part];
+		}
+	}
+	return parts;
+}
+
+
+std::int64_t MultilevelPartitioner::computeEdgeCut(const SparseGraph& graph, const std::vector<int>& parts) {
+
+	ArrayView<int> offsets = graph.getOffsets();
+	ArrayView<int> targets = graph.getTargets();
+	std::int64_t edgeCut = 0;
+	for (int v = 0; v < graph.getNumberOfVertices(); ++v) {
+		for (int e = offsets[v]; e < offsets[v + 1]; ++e) {
+			edgeCut += parts[v] != parts[targets[e]];
+		}
+	}
+	return edgeCut;
+}
+
+
+double MultilevelPartitioner::computeImbalance(const std::vector<int>& parts, int numberOfParts) {
+
+	if (parts.empty()) {
+		return 1.0;
+	}
+	std::vector<int> sizesOfParts(numberOfParts, 0);
+	for (int part : parts) {
+		++sizesOfParts[part];
+	}
+	return *std::max_element(sizesOfParts.begin(), sizesOfParts.end()) * static_cast<double>(numberOfParts) / parts.size();
+}
+
+
+MultilevelPartitioner::WeightedGraph MultilevelPartitioner::createUndirectedGraph(const SparseGraph& graph) {
+
+	int numberOfVertices = graph.getNumberOfVertices();
+	ArrayView<int> offsets = graph.getOffsets();
+	ArrayView<int> targets = graph.getTargets();
+
+	// every edge is put into rows of both its vertices
+	std::vector<int> rowOffsets(numberOfVertices + 1, 0);
+	for (int v = 0; v < numberOfVertices; ++v) {
+		for (int e = offsets[v]; e < offsets[v + 1]; ++e) {
+			if (targets[e] != v) {
+				++rowOffsets[v + 1];
+				++rowOffsets[targets[e] + 1];
+			}
+		}
+	}
+	for (int v = 0; v < numberOfVertices; ++v) {
+		rowOffsets[v + 1] += rowOffsets[v];
+	}
+	std::vector<int> positions(rowOffsets.begin(), rowOffsets.end() - 1);
+	std::vector<int> rowNeighbours(rowOffsets.back());
+	for (int v = 0; v < numberOfVertices; ++v) {
+		for (int e = offsets[v]; e < offsets[v + 1]; ++e) {
+			if (targets[e] != v) {
+				rowNeighbours[positions[v]++] = targets[e];
+				rowNeighbours[positions[targets[e]]++] = v;
+			}
+		}
+	}
+
+	// repeated neighbours are merged - position of neighbour points into current row only if it has been seen in this row
+	WeightedGraph undirectedGraph;
+	undirectedGraph.offsets.reserve(numberOfVertices + 1);
+	undirectedGraph.offsets.push_back(0);
+	std::fill(positions.begin(), positions.end(), -1);
+	for (int v = 0; v < numberOfVertices; ++v) {
+		int rowStart = static_cast<int>(undirectedGraph.neighbours.size());
+		for (int e = rowOffsets[v]; e < rowOffsets[v + 1]; ++e) {
+			int neighbour = rowNeighbours[e];
+			if (positions[neighbour] >= rowStart) {
+				++undirectedGraph.edgeWeights[positions[neighbour]];
+			}
+			else {
+				positions[neighbour] = static_cast<int>(undirectedGraph.neighbours.size());
+				undirectedGraph.neighbours.push_back(neighbour);
+				undirectedGraph.edgeWeights.push_back(1);
+			}
+		}
+		undirectedGraph.offsets.push_back(static_cast<int>(undirectedGraph.neighbours.size()));
+	}
+	undirectedGraph.vertexWeights.assign(numberOfVertices, 1);
+	undirectedGraph.totalVertexWeight = numberOfVertices;
+	return undirectedGraph;
+}
+
+
+MultilevelPartitioner::WeightedGraph MultilevelPartitioner::extractSubgraph(const WeightedGraph& graph, const std::vector<int>& vertices) {
+
+	std::vector<int> newNumbers(graph.getNumberOfVertices(), -1);
+	for (int i = 0; i < static_cast<int>(vertices.size()); ++i) {
+		newNumbers[vertices[i]] = i;
+	}
+
+	WeightedGraph subgraph;
+	subgraph.offsets.reserve(vertices.size() + 1);
+	subgraph.offsets.push_back(0);
+	subgraph.vertexWeights.reserve(vertices.size());
+	for (int vertex : vertices) {
+		for (int e = graph.offsets[vertex]; e < graph.offsets[vertex + 1]; ++e) {
+			if (newNumbers[graph.neighbours[e]] != -1) {
+				subgraph.neighbours.push_back(newNumbers[graph.neighbours[e]]);
+				subgraph.edgeWeights.push_back(graph.edgeWeights[e]);
+			}
+		}
+		subgraph.offsets.push_back(static_cast<int>(subgraph.neighbours.size()));
+		subgraph.vertexWeights.push_back(graph.vertexWeights[vertex]);
+		subgraph.totalVertexWeight += graph.vertexWeights[vertex];
+	}
+	return subgraph;
+}
+
+
+void MultilevelPartitioner::partitionRecursively(const WeightedGraph& graph, const std::vector<int>& originalVertices, int firstPart, int numberOfParts,
+	double allowedImbalance, std::mt19937& generator, std::vector<int>& parts) {
+
+	if (numberOfParts == 1 || graph.getNumberOfVertices() == 0) {
+		for (int vertex : originalVertices) {
+			parts[vertex] = firstPart;
+		}
+		return;
+	}
+
+	// parts are divided between halves as equally as possible, and so are vertices
+	int numberOfPartsOfFirstHalf = numberOfParts / 2;
+	std::vector<std::uint8_t> sides = bisectGraph(graph, static_cast<double>(numberOfPartsOfFirstHalf) / numberOfParts, allowedImbalance, generator);
+
+	std::vector<int> verticesOfHalves[2];
+	std::vector<int> originalVerticesOfHalves[2];
+	for (int v = 0; v < graph.getNumberOfVertices(); ++v) {
+		verticesOfHalves[sides[v]].push_back(v);
+		originalVerticesOfHalves[sides[v]].push_back(originalVertices[v]);
+	}
+	partitionRecursively(extractSubgraph(graph, verticesOfHalves[0]), originalVerticesOfHalves[0], firstPart, numberOfPartsOfFirstHalf,
+		allowedImbalance, generator, parts);
+	partitionRecursively(extractSubgraph(graph, verticesOfHalves[1]), originalVerticesOfHalves[1], firstPart + numberOfPartsOfFirstHalf,
+		numberOfParts - numberOfPartsOfFirstHalf, allowedImbalance, generator, parts);
+}
+
+
+std::vector<std::uint8_t> MultilevelPartitioner::bisectGraph(const WeightedGraph& graph, double fractionOfFirstPart, double allowedImbalance, std::mt19937& generator) {
+
+	// coarsen graph until it is small enough or matching does not shrink it any more (e.g. star graph)
+	int maximalVertexWeight = std::max(1, static_cast<int>(1.5 * graph.totalVertexWeight / numberOfVerticesOfCoarsestGraph));
+	std::vector<WeightedGraph> coarseGraphs;
+	std::vector<std::vector<int>> coarseVerticesOfLevels;
+	const WeightedGraph* currentGraph = &graph;
+	while (currentGraph->getNumberOfVertices() > numberOfVerticesOfCoarsestGraph) {
+		std::vector<int> coarseVertices;
+		WeightedGraph coarseGraph = coarsenGraph(*currentGraph, maximalVertexWeight, generator, coarseVertices);
+		if (coarseGraph.getNumberOfVertices() > 0.95 * currentGraph->getNumberOfVertices()) {
+			break;
+		}
+		coarseGraphs.push_back(std::move(coarseGraph));
+		coarseVerticesOfLevels.push_back(std::move(coarseVertices));
+		currentGraph = &coarseGraphs.back();
+	}
+
+	// part weights can exceed their targets by allowed fraction and weight of the heaviest vertex of the level
+	int targetWeights[2];
+	targetWeights[0] = static_cast<int>(std::lround(graph.totalVertexWeight * fractionOfFirstPart));
+	targetWeights[1] = graph.totalVertexWeight - targetWeights[0];
+	auto computeMaximalWeights = [&](const WeightedGraph& levelGraph, int maximalWeights[2]) {
+		int heaviestVertexWeight = *std::max_element(levelGraph.vertexWeights.begin(), levelGraph.vertexWeights.end());
+		for (int side = 0; side < 2; ++side) {
+			maximalWeights[side] = static_cast<int>(targetWeights[side] * (1.0 + allowedImbalance)) + heaviestVertexWeight;
+		}
+	};
+
+	// the coarsest graph is divided several times from random vertices - the smallest cut is kept
+	int maximalWeights[2];
+	computeMaximalWeights(*currentGraph, maximalWeights);
+	std::vector<std::uint8_t> sides;
+	int edgeCut = 0;
+	std::uniform_int_distribution<int> vertexDistribution(0, currentGraph->getNumberOfVertices() - 1);
+	for (int attempt = 0; attempt < numberOfInitialBisections; ++attempt) {
+		std::vector<std::uint8_t> attemptSides = growBisection(*currentGraph, vertexDistribution(generator), targetWeights[0], generator);
+		int attemptEdgeCut = refineBisection(*currentGraph, attemptSides, maximalWeights);
+		if (sides.empty() || attemptEdgeCut < edgeCut) {
+			sides = std::move(attemptSides);
+			edgeCut = attemptEdgeCut;
+		}
+	}
+
+	// division is projected to finer graphs and refined on each of them
+	for (int level = static_cast<int>(coarseGraphs.size()) - 1; level >= 0; --level) {
+		const WeightedGraph& finerGraph = level > 0 ? coarseGraphs[level - 1] : graph;
+		const std::vector<int>& coarseVertices = coarseVerticesOfLevels[level];
+		std::vector<std::uint8_t> finerSides(finerGraph.getNumberOfVertices());
+		for (int v = 0; v < finerGraph.getNumberOfVertices(); ++v) {
+			finerSides[v] = sides[coarseVertices[v]];
+		}
+		sides = std::move(finerSides);
+		computeMaximalWeights(finerGraph, maximalWeights);
+		refineBisection(finerGraph, sides, maximalWeights);
+	}
+	return sides;
+}
+
+
+MultilevelPartitioner::WeightedGraph MultilevelPartitioner::coarsenGraph(const WeightedGraph& graph, int maximalVertexWeight, std::mt19937& generator,
+	std::vector<int>& coarseVertices) {
+
+	int numberOfVertices = graph.getNumberOfVertices();
+	std::vector<int> order(numberOfVertices);
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), generator);
+
+	// every coarse vertex is made of one or two vertices
+	coarseVertices.assign(numberOfVertices, -1);
+	std::vector<std::pair<int, int>> mergedVertices;
+	mergedVertices.reserve(numberOfVertices);
+	for (int vertex : order) {
+		if (coarseVertices[vertex] != -1) {
+			continue;
+		}
+		int matchedVertex = -1;
+		int heaviestEdgeWeight = 0;
+		for (int e = graph.offsets[vertex]; e < graph.offsets[vertex + 1]; ++e) {
+			int neighbour = graph.neighbours[e];
+			if (coarseVertices[neighbour] == -1 && graph.edgeWeights[e] > heaviestEdgeWeight
+				&& graph.vertexWeights[vertex] + graph.vertexWeights[neighbour] <= maximalVertexWeight) {
+				matchedVertex = neighbour;
+				heaviestEdgeWeight = graph.edgeWeights[e];
+			}
+		}
+		coarseVertices[vertex] = static_cast<int>(mergedVertices.size());
+		if (matchedVertex != -1) {
+			coarseVertices[matchedVertex] = static_cast<int>(mergedVertices.size());
+		}
+		mergedVertices.emplace_back(vertex, matchedVertex);
+	}
+
+	// edges between merged vertices disappear, parallel edges are merged the same way as in undirected graph
+	int numberOfCoarseVertices = static_cast<int>(mergedVertices.size());
+	WeightedGraph coarseGraph;
+	coarseGraph.offsets.reserve(numberOfCoarseVertices + 1);
+	coarseGraph.offsets.push_back(0);
+	coarseGraph.vertexWeights.reserve(numberOfCoarseVertices);
+	coarseGraph.totalVertexWeight = graph.totalVertexWeight;
+	std::vector<int> positions(numberOfCoarseVertices, -1);
+	for (int coarseVertex = 0; coarseVertex < numberOfCoarseVertices; ++coarseVertex) {
+		int rowStart = static_cast<int>(coarseGraph.neighbours.size());
+		int vertexWeight = 0;
+		for (int vertex : { mergedVertices[coarseVertex].first, mergedVertices[coarseVertex].second }) {
+			if (vertex == -1) {
+				continue;
+			}
+			vertexWeight += graph.vertexWeights[vertex];
+			for (int e = graph.offsets[vertex]; e < graph.offsets[vertex + 1]; ++e) {
+				int coarseNeighbour = coarseVertices[graph.neighbours[e]];
+				if (coarseNeighbour == coarseVertex) {
+					continue;
+				}
+				if (positions[coarseNeighbour] >= rowStart) {
+					coarseGraph.edgeWeights[positions[coarseNeighbour]] += graph.edgeWeights[e];
+				}
+				else {
+					positions[coarseNeighbour] = static_cast<int>(coarseGraph.neighbours.size());
+					coarseGraph.neighbours.push_back(coarseNeighbour);
+					coarseGraph.edgeWeights.push_back(graph.edgeWeights[e]);
+				}
+			}
+		}
+		coarseGraph.offsets.push_back(static_cast<int>(coarseGraph.neighbours.size()));
+		coarseGraph.vertexWeights.push_back(vertexWeight);
+	}
+	return coarseGraph;
+}
+
+
+std::vector<std::uint8_t> MultilevelPartitioner::growBisection(const WeightedGraph& graph, int seedVertex, int targetWeightOfFirstPart, std::mt19937& generator) {
+
+	int numberOfVertices = graph.getNumberOfVertices();
+	std::vector<std::uint8_t> sides(numberOfVertices, 1);
+	std::vector<std::uint8_t> lockedVertices(numberOfVertices, 0);
+
+	// gain of moving vertex to the first part - all its edges are internal at the beginning
+	std::vector<int> gains(numberOfVertices, 0);
+	for (int v = 0; v < numberOfVertices; ++v) {
+		for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+			gains[v] -= graph.edgeWeights[e];
+		}
+	}
+
+	// when growing part has no more neighbours, it continues from vertices taken in random order
+	std::vector<int> order(numberOfVertices);
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), generator);
+	int nextVertexInOrder = 0;
+
+	GainQueue queue;
+	queue.emplace(gains[seedVertex], seedVertex);
+	int weightOfFirstPart = 0;
+	while (weightOfFirstPart < targetWeightOfFirstPart) {
+		int vertex = takeVertexWithHighestGain(queue, gains, sides, lockedVertices, 1);
+		while (vertex == -1 && nextVertexInOrder < numberOfVertices) {
+			vertex = sides[order[nextVertexInOrder]] == 1 ? order[nextVertexInOrder] : -1;
+			++nextVertexInOrder;
+		}
+		if (vertex == -1) {
+			break;
+		}
+
+		// vertex is not moved if it would take the part further from its target weight
+		int weightAfterMove = weightOfFirstPart + graph.vertexWeights[vertex];
+		if (weightAfterMove - targetWeightOfFirstPart > targetWeightOfFirstPart - weightOfFirstPart) {
+			break;
+		}
+		sides[vertex] = 0;
+		weightOfFirstPart = weightAfterMove;
+		for (int e = graph.offsets[vertex]; e < graph.offsets[vertex + 1]; ++e) {
+			int neighbour = graph.neighbours[e];
+			if (sides[neighbour] == 1) {
+				gains[neighbour] += 2 * graph.edgeWeights[e];
+				queue.emplace(gains[neighbour], neighbour);
+			}
+		}
+	}
+	return sides;
+}
+
+
+int MultilevelPartitioner::refineBisection(const WeightedGraph& graph, std::vector<std::uint8_t>& sides, const int maximalWeights[2]) {
+
+	int numberOfVertices = graph.getNumberOfVertices();
+	int maximalNumberOfMovesWithoutImprovement = std::max(50, numberOfVertices / 100);
+	auto computeOverweight = [&](const int weights[2]) {
+		return std::max(0, weights[0] - maximalWeights[0]) + std::max(0, weights[1] - maximalWeights[1]);
+	};
+
+	int weights[2] = { 0, 0 };
+	for (int v = 0; v < numberOfVertices; ++v) {
+		weights[sides[v]] += graph.vertexWeights[v];
+	}
+	int edgeCut = computeWeightedEdgeCut(graph, sides);
+
+	std::vector<int> gains(numberOfVertices);
+	std::vector<std::uint8_t> lockedVertices(numberOfVertices);
+	std::vector<int> movedVertices;
+	while (true) {
+
+		// gains are computed again in every pass, only vertices at the boundary are queued at the beginning
+		GainQueue queues[2];
+		for (int v = 0; v < numberOfVertices; ++v) {
+			gains[v] = 0;
+			bool vertexIsAtBoundary = false;
+			for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+				bool edgeIsCut = sides[graph.neighbours[e]] != sides[v];
+				gains[v] += edgeIsCut ? graph.edgeWeights[e] : -graph.edgeWeights[e];
+				vertexIsAtBoundary |= edgeIsCut;
+			}
+			if (vertexIsAtBoundary) {
+				queues[sides[v]].emplace(gains[v], v);
+			}
+		}
+		std::fill(lockedVertices.begin(), lockedVertices.end(), 0);
+		movedVertices.clear();
+
+		int currentEdgeCut = edgeCut;
+		int bestEdgeCut = edgeCut;
+		int bestOverweight = computeOverweight(weights);
+		size_t bestNumberOfMoves = 0;
+		int numberOfMovesWithoutImprovement = 0;
+		while (numberOfMovesWithoutImprovement < maximalNumberOfMovesWithoutImprovement) {
+
+			// vertex is moved from overweight part, otherwise the one with higher gain is moved if the other part can take it
+			int candidates[2] = { takeVertexWithHighestGain(queues[0], gains, sides, lockedVertices, 0),
+				takeVertexWithHighestGain(queues[1], gains, sides, lockedVertices, 1) };
+			int side = -1;
+			for (int s = 0; s < 2; ++s) {
+				if (candidates[s] == -1) {
+					continue;
+				}
+				int weightOfOtherPart = weights[1 - s] + graph.vertexWeights[candidates[s]];
+				bool moveIsAllowed = weights[s] > maximalWeights[s]
+					? weightOfOtherPart <= maximalWeights[1 - s] || weightOfOtherPart < weights[s]
+					: weightOfOtherPart <= maximalWeights[1 - s];
+				if (!moveIsAllowed) {
+					continue;
+				}
+				if (side == -1 || weights[s] > maximalWeights[s]
+					|| (weights[side] <= maximalWeights[side] && (gains[candidates[s]] > gains[candidates[side]]
+						|| (gains[candidates[s]] == gains[candidates[side]] && weights[s] > weights[side])))) {
+					side = s;
+				}
+			}
+			if (side == -1) {
+				break;
+			}
+			if (candidates[1 - side] != -1) {
+				queues[1 - side].emplace(gains[candidates[1 - side]], candidates[1 - side]);
+			}
+
+			int vertex = candidates[side];
+			sides[vertex] = static_cast<std::uint8_t>(1 - side);
+			weights[side] -= graph.vertexWeights[vertex];
+			weights[1 - side] += graph.vertexWeights[vertex];
+			currentEdgeCut -= gains[vertex];
+			lockedVertices[vertex] = 1;
+			movedVertices.push_back(vertex);
+			for (int e = graph.offsets[vertex]; e < graph.offsets[vertex + 1]; ++e) {
+				int neighbour = graph.neighbours[e];
+				gains[neighbour] += sides[neighbour] == side ? 2 * graph.edgeWeights[e] : -2 * graph.edgeWeights[e];
+				if (!lockedVertices[neighbour]) {
+					queues[sides[neighbour]].emplace(gains[neighbour], neighbour);
+				}
+			}
+
+			int overweight = computeOverweight(weights);
+			if (overweight < bestOverweight || (overweight == bestOverweight && currentEdgeCut < bestEdgeCut)) {
+				bestEdgeCut = currentEdgeCut;
+				bestOverweight = overweight;
+				bestNumberOfMoves = movedVertices.size();
+				numberOfMovesWithoutImprovement = 0;
+			}
+			else {
+				++numberOfMovesWithoutImprovement;
+			}
+		}
+
+		// moves made after the best division are undone
+		for (size_t i = movedVertices.size(); i > bestNumberOfMoves; --i) {
+			int vertex = movedVertices[i - 1];
+			weights[sides[vertex]] -= graph.vertexWeights[vertex];
+			sides[vertex] = static_cast<std::uint8_t>(1 - sides[vertex]);
+			weights[sides[vertex]] += graph.vertexWeights[vertex];
+		}
+		edgeCut = bestEdgeCut;
+		if (bestNumberOfMoves == 0) {
+			break;
+		}
+	}
+	return edgeCut;
+}
+
+
+int MultilevelPartitioner::computeWeightedEdgeCut(const WeightedGraph& graph, const std::vector<std::uint8_t>& sides) {
+
+	// every edge is stored twice
+	int edgeCut = 0;
+	for (int v = 0; v < graph.getNumberOfVertices(); ++v) {
+		for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+			edgeCut += sides[graph.neighbours[e]] != sides[v] ? graph.edgeWeights[e] : 0;
+		}
+	}
+	return edgeCut / 2;
+}
+
+
+int MultilevelPartitioner::takeVertexWithHighestGain(GainQueue& queue, const std::vector<int>& gains, const std::vector<std::uint8_t>& sides,
+	const std::vector<std::uint8_t>& lockedVertices, std::uint8_t side) {
+
+	while (!queue.empty()) {
+		std::pair<int, int> entry = queue.top();
+		queue.pop();
+		if (!lockedVertices[entry.second] && sides[entry.second] == side && gains[entry.second] == entry.first) {
+			return entry.second;
+		}
+	}
+	return -1;
+}
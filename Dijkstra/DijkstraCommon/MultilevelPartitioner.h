@@ -0,0 +1,205 @@
+/**
+*	@file MultilevelPartitioner.h
+*	@brief This file contains MultilevelPartitioner class that divides vertices
+*	of sparse graph into parts connected by as few edges as possible.
+*/
+
+#pragma once
+
+#include "SparseGraph.h"
+
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class divides vertices of sparse graph into given number of parts of similar
+/// sizes, so that as few edges as possible connect vertices of different parts (edge
+/// cut). Directions of edges are ignored - edges u -> v and v -> u are merged into one
+/// undirected edge with weight equal to number of merged edges. Graph is divided by
+/// recursive bisection, and every bisection is multilevel: graph is coarsened by heavy
+/// edge matching, the smallest graph is divided by greedy graph growing and the division
+/// is projected back through all levels, refined by Fiduccia-Mattheyses algorithm (linear
+/// time variant of Kernighan-Lin algorithm) on each of them. Random choices use generator
+/// with fixed seed, so the same graph is always divided the same way. Please note that all
+/// methods are static.
+/// </summary>
+class MultilevelPartitioner final {
+
+public:
+
+	/// <summary>
+	/// Default constructor. Because this class contains only static methods, it
+	/// has been deleted.
+	/// </summary>
+	MultilevelPartitioner() = delete;
+
+
+	/// <summary>
+	/// Divides vertices of graph into parts. Sizes of parts differ from the average by
+	/// no more than given fraction of it (plus one vertex) and, if there are at least as
+	/// many vertices as parts, every part contains at least one vertex.
+	/// </summary>
+	/// <returns>
+	/// Vector with part of every vertex (numbers from 0 to numberOfParts - 1).
+	/// </returns>
+	/// <param name="graph">
+	/// Sparse graph that should be divided.
+	/// </param>
+	/// <param name="numberOfParts">
+	/// Number of parts, at least 1.
+	/// </param>
+	/// <param name="allowedImbalance">
+	/// Fraction by which size of every part can exceed the average size.
+	/// </param>
+	static std::vector<int> partitionGraph(const SparseGraph& graph, int numberOfParts, double allowedImbalance = 0.03);
+
+
+	/// <summary>
+	/// Computes number of edges of graph that connect vertices of different parts.
+	/// </summary>
+	/// <returns>
+	/// Number of cut edges - every directed edge is counted separately.
+	/// </returns>
+	/// <param name="graph">
+	/// Sparse graph divided into parts.
+	/// </param>
+	/// <param name="parts">
+	/// Part of every vertex.
+	/// </param>
+	static std::int64_t computeEdgeCut(const SparseGraph& graph, const std::vector<int>& parts);
+
+
+	/// <summary>
+	/// Computes imbalance of parts - ratio of size of the largest part to average size
+	/// of a part.
+	/// </summary>
+	/// <returns>
+	/// Imbalance, 1 if all parts have the same size.
+	/// </returns>
+	/// <param name="parts">
+	/// Part of every vertex.
+	/// </param>
+	/// <param name="numberOfParts">
+	/// Number of parts.
+	/// </param>
+	static double computeImbalance(const std::vector<int>& parts, int numberOfParts);
+
+private:
+
+	/// <summary>
+	/// Undirected graph with weights of vertices and edges, stored in compressed sparse
+	/// rows - every edge is stored in rows of both its vertices. Weight of vertex is number
+	/// of original vertices merged into it.
+	/// </summary>
+	struct WeightedGraph {
+		std::vector<int> offsets;
+		std::vector<int> neighbours;
+		std::vector<int> edgeWeights;
+		std::vector<int> vertexWeights;
+		int totalVertexWeight = 0;
+
+		inline int getNumberOfVertices() const {
+			return static_cast<int>(vertexWeights.size());
+		}
+	};
+
+
+	/// <summary>
+	/// Queue of vertices ordered by gain of moving them to the other part. Gains change
+	/// while vertices are moved, so new entry is pushed for every change and outdated
+	/// entries are skipped when they reach the top.
+	/// </summary>
+	typedef std::priority_queue<std::pair<int, int>> GainQueue;
+
+
+	/// <summary>
+	/// Creates undirected weighted graph from sparse graph - loops are skipped and parallel
+	/// edges are merged.
+	/// </summary>
+	static WeightedGraph createUndirectedGraph(const SparseGraph& graph);
+
+
+	/// <summary>
+	/// Creates graph induced by given vertices, numbered in the order of the vector.
+	/// </summary>
+	static WeightedGraph extractSubgraph(const WeightedGraph& graph, const std::vector<int>& vertices);
+
+
+	/// <summary>
+	/// Divides vertices of graph (originalVertices are their numbers in the whole graph)
+	/// into parts [firstPart, firstPart + numberOfParts) - bisects it and divides both
+	/// halves recursively.
+	/// </summary>
+	static void partitionRecursively(const WeightedGraph& graph, const std::vector<int>& originalVertices, int firstPart, int numberOfParts,
+		double allowedImbalance, std::mt19937& generator, std::vector<int>& parts);
+
+
+	/// <summary>
+	/// Divides graph into two parts - the first one should have given fraction of total
+	/// weight of vertices. Graph is coarsened, smallest graph is divided and division is
+	/// refined on every level while it is projected back.
+	/// </summary>
+	/// <returns>
+	/// Vector with part (0 or 1) of every vertex.
+	/// </returns>
+	static std::vector<std::uint8_t> bisectGraph(const WeightedGraph& graph, double fractionOfFirstPart, double allowedImbalance, std::mt19937& generator);
+
+
+	/// <summary>
+	/// Creates coarser graph by heavy edge matching - vertices are visited in random order
+	/// and every unmatched vertex is merged with unmatched neighbour connected by the
+	/// heaviest edge, unless weight of merged vertex would exceed given limit.
+	/// </summary>
+	/// <returns>
+	/// Coarser graph. Vector coarseVertices receives vertex of coarser graph for every
+	/// vertex of given graph.
+	/// </returns>
+	static WeightedGraph coarsenGraph(const WeightedGraph& graph, int maximalVertexWeight, std::mt19937& generator, std::vector<int>& coarseVertices);
+
+
+	/// <summary>
+	/// Divides graph into two parts by greedy graph growing - all vertices start in the
+	/// second part and vertex with the highest gain is moved to the first one until it
+	/// reaches its target weight. Growing starts from given vertex, and then from another
+	/// random vertex whenever the first part has no more neighbours.
+	/// </summary>
+	static std::vector<std::uint8_t> growBisection(const WeightedGraph& graph, int seedVertex, int targetWeightOfFirstPart, std::mt19937& generator);
+
+
+	/// <summary>
+	/// Refines division of graph by passes of Fiduccia-Mattheyses algorithm. In every pass
+	/// vertices with the highest gain are moved to the other part (each of them at most
+	/// once) as long as part weights stay within limits, even if it increases the cut;
+	/// then moves made after the best division of the pass are undone. Passes are repeated
+	/// until one of them does not improve the division.
+	/// </summary>
+	/// <returns>
+	/// Edge cut of refined division.
+	/// </returns>
+	static int refineBisection(const WeightedGraph& graph, std::vector<std::uint8_t>& sides, const int maximalWeights[2]);
+
+
+	/// <summary>
+	/// Computes sum of weights of edges that connect vertices of different parts.
+	/// </summary>
+	static int computeWeightedEdgeCut(const WeightedGraph& graph, const std::vector<std::uint8_t>& sides);
+
+
+	/// <summary>
+	/// Takes entry of vertex with the highest current gain from queue of given part -
+	/// outdated entries, locked vertices and vertices of the other part are skipped.
+	/// </summary>
+	/// <returns>
+	/// Number of vertex or -1 if there is no such vertex.
+	/// </returns>
+	static int takeVertexWithHighestGain(GainQueue& queue, const std::vector<int>& gains, const std::vector<std::uint8_t>& sides,
+		const std::vector<std::uint8_t>& lockedVertices, std::uint8_t side);
+
+
+	static const int numberOfVerticesOfCoarsestGraph = 100;
+	static const int numberOfInitialBisections = 4;
+
+};
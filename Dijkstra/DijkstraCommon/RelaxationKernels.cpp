@@ -0,0 +1,537 @@
+#include "RelaxationKernels.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RELAXATION_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+
+namespace {
+
+	using FindMinimumKernel = VertexData(*)(const double*, const std::uint64_t*, int, int);
+	using RelaxAndFindMinimumKernel = VertexData(*)(const VertexData&, const double*, double*, int*, const std::uint64_t*, int, int);
+
+	const double infinity = std::numeric_limits<double>::infinity();
+
+
+	/// <summary>
+	/// Set of kernels that use the same instruction set.
+	/// </summary>
+	struct KernelsSet {
+
+		const char* name;
+		FindMinimumKernel findMinimum;
+		RelaxAndFindMinimumKernel relaxAndFindMinimum;
+
+	};
+
+
+	inline bool checkIfVertexHasBeenProcessed(std::uint64_t processedInBlock, int vertex) {
+		return (processedInBlock >> (vertex % 64)) & 1;
+	}
+
+
+	inline void updateMinimum(int vertex, const double* distances, int& closestVertex, double& shortestDistance) {
+		if (distances[vertex] < shortestDistance) {
+			closestVertex = vertex;
+			shortestDistance = distances[vertex];
+		}
+	}
+
+
+	inline void relaxAndUpdateMinimum(int vertex, const VertexData& vertexClosestToCluster, const double* weights, double* distances,
+		int* predecessors, int& closestVertex, double& shortestDistance) {
+
+		double valueInMatrix = weights[vertex] < 0.001 ? infinity : weights[vertex];
+		double altDistance = valueInMatrix + vertexClosestToCluster.distance;
+		if (altDistance < distances[vertex]) {
+			distances[vertex] = altDistance;
+			predecessors[vertex] = vertexClosestToCluster.vertexNumber;
+		}
+		updateMinimum(vertex, distances, closestVertex, shortestDistance);
+	}
+
+
+	/// <summary>
+	/// Merges minimum found by one vector lane with the current one. Each lane
+	/// remembers first vertex with its minimal distance, so vertex with smaller
+	/// index wins if distances are equal.
+	/// </summary>
+	inline void mergeMinimum(double laneDistance, long long laneVertex, int& closestVertex, double& shortestDistance) {
+		if (laneVertex == -1) {
+			return;
+		}
+		if (laneDistance < shortestDistance || (laneDistance == shortestDistance && laneVertex < closestVertex)) {
+			closestVertex = static_cast<int>(laneVertex);
+			shortestDistance = laneDistance;
+		}
+	}
+
+
+	/// <summary>
+	/// Returns end of 64-vertex block of bitmap that vertex belongs to, but not
+	/// further than end of processed range.
+	/// </summary>
+	inline int computeBlockEnd(int vertex, int end) {
+		return std::min(end, (vertex / 64 + 1) * 64);
+	}
+
+
+	VertexData findMinimumScalar(const double* distances, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+		int closestVertex = -1;
+		double shortestDistance = infinity;
+		for (int blockBegin = begin, blockEnd = begin; blockBegin < end; blockBegin = blockEnd) {
+			blockEnd = computeBlockEnd(blockBegin, end);
+			std::uint64_t processedInBlock = processedVerticesBitmap[blockBegin / 64];
+			for (int i = blockBegin; i < blockEnd && processedInBlock != ~std::uint64_t(0); ++i) {
+				if (!checkIfVertexHasBeenProcessed(processedInBlock, i)) {
+					updateMinimum(i, distances, closestVertex, shortestDistance);
+				}
+			}
+		}
+		return createVertexDataInstance(shortestDistance, closestVertex);
+	}
+
+
+	VertexData relaxAndFindMinimumScalar(const VertexData& vertexClosestToCluster, const double* weights, double* distances,
+		int* predecessors, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+
+		int closestVertex = -1;
+		double shortestDistance = infinity;
+		for (int blockBegin = begin, blockEnd = begin; blockBegin < end; blockBegin = blockEnd) {
+			blockEnd = computeBlockEnd(blockBegin, end);
+			std::uint64_t processedInBlock = processedVerticesBitmap[blockBegin / 64];
+			for (int i = blockBegin; i < blockEnd && processedInBlock != ~std::uint64_t(0); ++i) {
+				if (!checkIfVertexHasBeenProcessed(processedInBlock, i)) {
+					relaxAndUpdateMinimum(i, vertexClosestToCluster, weights, distances, predecessors, closestVertex, shortestDistance);
+				}
+			}
+		}
+		return createVertexDataInstance(shortestDistance, closestVertex);
+	}
+
+
+#ifdef RELAXATION_KERNELS_X86
+
+	// SSE2 - two vertices at once, blends are done with and/andnot/or
+
+	__attribute__((target("sse2")))
+	inline __m128d computeNotProcessedMaskSSE2(std::uint64_t processedInBlock, int vertex) {
+		std::uint64_t processed = processedInBlock >> (vertex % 64);
+		return _mm_castsi128_pd(_mm_set_epi64x(static_cast<long long>((processed >> 1) & 1) - 1, static_cast<long long>(processed & 1) - 1));
+	}
+
+
+	__attribute__((target("sse2")))
+	inline __m128d blendSSE2(__m128d mask, __m128d ifSet, __m128d ifNotSet) {
+		return _mm_or_pd(_mm_and_pd(mask, ifSet), _mm_andnot_pd(mask, ifNotSet));
+	}
+
+
+	__attribute__((target("sse2")))
+	inline __m128i blendSSE2(__m128i mask, __m128i ifSet, __m128i ifNotSet) {
+		return _mm_or_si128(_mm_and_si128(mask, ifSet), _mm_andnot_si128(mask, ifNotSet));
+	}
+
+
+	__attribute__((target("sse2")))
+	void mergeLanesSSE2(__m128d bestDistances, __m128i bestVertices, int& closestVertex, double& shortestDistance) {
+		alignas(16) double laneDistances[2];
+		alignas(16) long long laneVertices[2];
+		_mm_store_pd(laneDistances, bestDistances);
+		_mm_store_si128(reinterpret_cast<__m128i*>(laneVertices), bestVertices);
+		for (int lane = 0; lane < 2; ++lane) {
+			mergeMinimum(laneDistances[lane], laneVertices[lane], closestVertex, shortestDistance);
+		}
+	}
+
+
+	__attribute__((target("sse2")))
+	VertexData findMinimumSSE2(const double* distances, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+		int closestVertex = -1;
+		double shortestDistance = infinity;
+		__m128d bestDistances = _mm_set1_pd(infinity);
+		__m128i bestVertices = _mm_set1_epi64x(-1);
+
+		for (int blockBegin = begin, blockEnd = begin; blockBegin < end; blockBegin = blockEnd) {
+			blockEnd = computeBlockEnd(blockBegin, end);
+			std::uint64_t processedInBlock = processedVerticesBitmap[blockBegin / 64];
+			if (processedInBlock == ~std::uint64_t(0)) {
+				continue;
+			}
+
+			int i = blockBegin;
+			for (; i + 2 <= blockEnd; i += 2) {
+				__m128d notProcessed = computeNotProcessedMaskSSE2(processedInBlock, i);
+				__m128d currentDistances = _mm_loadu_pd(distances + i);
+				__m128d smaller = _mm_and_pd(_mm_cmplt_pd(currentDistances, bestDistances), notProcessed);
+				bestDistances = blendSSE2(smaller, currentDistances, bestDistances);
+				bestVertices = blendSSE2(_mm_castpd_si128(smaller), _mm_set_epi64x(i + 1, i), bestVertices);
+			}
+			for (; i < blockEnd; ++i) {
+				if (!checkIfVertexHasBeenProcessed(processedInBlock, i)) {
+					updateMinimum(i, distances, closestVertex, shortestDistance);
+				}
+			}
+		}
+
+		mergeLanesSSE2(bestDistances, bestVertices, closestVertex, shortestDistance);
+		return createVertexDataInstance(shortestDistance, closestVertex);
+	}
+
+
+	__attribute__((target("sse2")))
+	VertexData relaxAndFindMinimumSSE2(const VertexData& vertexClosestToCluster, const double* weights, double* distances,
+		int* predecessors, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+
+		const __m128d threshold = _mm_set1_pd(0.001);
+		const __m128d infinities = _mm_set1_pd(infinity);
+		const __m128d sourceDistance = _mm_set1_pd(vertexClosestToCluster.distance);
+		const __m128i sourceVertex = _mm_set1_epi32(vertexClosestToCluster.vertexNumber);
+
+		int closestVertex = -1;
+		double shortestDistance = infinity;
+		__m128d bestDistances = infinities;
+		__m128i bestVertices = _mm_set1_epi64x(-1);
+
+		for (int blockBegin = begin, blockEnd = begin; blockBegin < end; blockBegin = blockEnd) {
+			blockEnd = computeBlockEnd(blockBegin, end);
+			std::uint64_t processedInBlock = processedVerticesBitmap[blockBegin / 64];
+			if (processedInBlock == ~std::uint64_t(0)) {
+				continue;
+			}
+
+			int i = blockBegin;
+			for (; i + 2 <= blockEnd; i += 2) {
+				__m128d notProcessed = computeNotProcessedMaskSSE2(processedInBlock, i);
+
+				// "no edge" weights are replaced with infinity
+				__m128d currentWeights = _mm_loadu_pd(weights + i);
+				__m128d altDistances = _mm_add_pd(blendSSE2(_mm_cmplt_pd(currentWeights, threshold), infinities, currentWeights), sourceDistance);
+
+				// relaxation
+				__m128d currentDistances = _mm_loadu_pd(distances + i);
+				__m128d better = _mm_and_pd(_mm_cmplt_pd(altDistances, currentDistances), notProcessed);
+				currentDistances = blendSSE2(better, altDistances, currentDistances);
+				_mm_storeu_pd(distances + i, currentDistances);
+
+				// predecessors are 32-bit, so mask lanes have to be squeezed
+				__m128i betterPredecessors = _mm_shuffle_epi32(_mm_castpd_si128(better), _MM_SHUFFLE(3, 3, 2, 0));
+				__m128i currentPredecessors = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(predecessors + i));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(predecessors + i), blendSSE2(betterPredecessors, sourceVertex, currentPredecessors));
+
+				// minimum for the next iteration
+				__m128d smaller = _mm_and_pd(_mm_cmplt_pd(currentDistances, bestDistances), notProcessed);
+				bestDistances = blendSSE2(smaller, currentDistances, bestDistances);
+				bestVertices = blendSSE2(_mm_castpd_si128(smaller), _mm_set_epi64x(i + 1, i), bestVertices);
+			}
+			for (; i < blockEnd; ++i) {
+				if (!checkIfVertexHasBeenProcessed(processedInBlock, i)) {
+					relaxAndUpdateMinimum(i, vertexClosestToCluster, weights, distances, predecessors, closestVertex, shortestDistance);
+				}
+			}
+		}
+
+		mergeLanesSSE2(bestDistances, bestVertices, closestVertex, shortestDistance);
+		return createVertexDataInstance(shortestDistance, closestVertex);
+	}
+
+
+	// AVX2 - four vertices at once
+
+	__attribute__((target("avx2")))
+	inline __m256d computeNotProcessedMaskAVX2(std::uint64_t processedInBlock, int vertex) {
+		__m256i processed = _mm256_and_si256(_mm256_set1_epi64x(static_cast<long long>(processedInBlock >> (vertex % 64))), _mm256_setr_epi64x(1, 2, 4, 8));
+		return _mm256_castsi256_pd(_mm256_cmpeq_epi64(processed, _mm256_setzero_si256()));
+	}
+
+
+	__attribute__((target("avx2")))
+	void mergeLanesAVX2(__m256d bestDistances, __m256i bestVertices, int& closestVertex, double& shortestDistance) {
+		alignas(32) double laneDistances[4];
+		alignas(32) long long laneVertices[4];
+		_mm256_store_pd(laneDistances, bestDistances);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(laneVertices), bestVertices);
+		for (int lane = 0; lane < 4; ++lane) {
+			mergeMinimum(laneDistances[lane], laneVertices[lane], closestVertex, shortestDistance);
+		}
+	}
+
+
+	__attribute__((target("avx2")))
+	VertexData findMinimumAVX2(const double* distances, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+		const __m256i laneOffsets = _mm256_setr_epi64x(0, 1, 2, 3);
+
+		int closestVertex = -1;
+		double shortestDistance = infinity;
+		__m256d bestDistances = _mm256_set1_pd(infinity);
+		__m256i bestVertices = _mm256_set1_epi64x(-1);
+
+		for (int blockBegin = begin, blockEnd = begin; blockBegin < end; blockBegin = blockEnd) {
+			blockEnd = computeBlockEnd(blockBegin, end);
+			std::uint64_t processedInBlock = processedVerticesBitmap[blockBegin / 64];
+			if (processedInBlock == ~std::uint64_t(0)) {
+				continue;
+			}
+
+			int i = blockBegin;
+			for (; i + 4 <= blockEnd; i += 4) {
+				__m256d notProcessed = computeNotProcessedMaskAVX2(processedInBlock, i);
+				__m256d currentDistances = _mm256_loadu_pd(distances + i);
+				__m256d smaller = _mm256_and_pd(_mm256_cmp_pd(currentDistances, bestDistances, _CMP_LT_OQ), notProcessed);
+				bestDistances = _mm256_blendv_pd(bestDistances, currentDistances, smaller);
+				bestVertices = _mm256_blendv_epi8(bestVertices, _mm256_add_epi64(_mm256_set1_epi64x(i), laneOffsets), _mm256_castpd_si256(smaller));
+			}
+			for (; i < blockEnd; ++i) {
+				if (!checkIfVertexHasBeenProcessed(processedInBlock, i)) {
+					updateMinimum(i, distances, closestVertex, shortestDistance);
+				}
+			}
+		}
+
+		mergeLanesAVX2(bestDistances, bestVertices, closestVertex, shortestDistance);
+		return createVertexDataInstance(shortestDistance, closestVertex);
+	}
+
+
+	__attribute__((target("avx2")))
+	VertexData relaxAndFindMinimumAVX2(const VertexData& vertexClosestToCluster, const double* weights, double* distances,
+		int* predecessors, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+
+		const __m256d threshold = _mm256_set1_pd(0.001);
+		const __m256d infinities = _mm256_set1_pd(infinity);
+		const __m256d sourceDistance = _mm256_set1_pd(vertexClosestToCluster.distance);
+		const __m128i sourceVertex = _mm_set1_epi32(vertexClosestToCluster.vertexNumber);
+		const __m256i laneOffsets = _mm256_setr_epi64x(0, 1, 2, 3);
+		const __m256i squeezeLanes = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+		int closestVertex = -1;
+		double shortestDistance = infinity;
+		__m256d bestDistances = infinities;
+		__m256i bestVertices = _mm256_set1_epi64x(-1);
+
+		for (int blockBegin = begin, blockEnd = begin; blockBegin < end; blockBegin = blockEnd) {
+			blockEnd = computeBlockEnd(blockBegin, end);
+			std::uint64_t processedInBlock = processedVerticesBitmap[blockBegin / 64];
+			if (processedInBlock == ~std::uint64_t(0)) {
+				continue;
+			}
+
+			int i = blockBegin;
+			for (; i + 4 <= blockEnd; i += 4) {
+				__m256d notProcessed = computeNotProcessedMaskAVX2(processedInBlock, i);
+
+				// "no edge" weights are replaced with infinity
+				__m256d currentWeights = _mm256_loadu_pd(weights + i);
+				__m256d noEdge = _mm256_cmp_pd(currentWeights, threshold, _CMP_LT_OQ);
+				__m256d altDistances = _mm256_add_pd(_mm256_blendv_pd(currentWeights, infinities, noEdge), sourceDistance);
+
+				// relaxation
+				__m256d currentDistances = _mm256_loadu_pd(distances + i);
+				__m256d better = _mm256_and_pd(_mm256_cmp_pd(altDistances, currentDistances, _CMP_LT_OQ), notProcessed);
+				currentDistances = _mm256_blendv_pd(currentDistances, altDistances, better);
+				_mm256_storeu_pd(distances + i, currentDistances);
+
+				// predecessors are 32-bit, so mask lanes have to be squeezed
+				__m128i betterPredecessors = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(better), squeezeLanes));
+				__m128i currentPredecessors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(predecessors + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(predecessors + i), _mm_blendv_epi8(currentPredecessors, sourceVertex, betterPredecessors));
+
+				// minimum for the next iteration
+				__m256d smaller = _mm256_and_pd(_mm256_cmp_pd(currentDistances, bestDistances, _CMP_LT_OQ), notProcessed);
+				bestDistances = _mm256_blendv_pd(bestDistances, currentDistances, smaller);
+				bestVertices = _mm256_blendv_epi8(bestVertices, _mm256_add_epi64(_mm256_set1_epi64x(i), laneOffsets), _mm256_castpd_si256(smaller));
+			}
+			for (; i < blockEnd; ++i) {
+				if (!checkIfVertexHasBeenProcessed(processedInBlock, i)) {
+					relaxAndUpdateMinimum(i, vertexClosestToCluster, weights, distances, predecessors, closestVertex, shortestDistance);
+				}
+			}
+		}
+
+		mergeLanesAVX2(bestDistances, bestVertices, closestVertex, shortestDistance);
+		return createVertexDataInstance(shortestDistance, closestVertex);
+	}
+
+
+	// AVX-512 - eight vertices at once, bits of processed vertices bitmap are used as mask directly
+
+	__attribute__((target("avx512f")))
+	void mergeLanesAVX512(__m512d bestDistances, __m512i bestVertices, int& closestVertex, double& shortestDistance) {
+		alignas(64) double laneDistances[8];
+		alignas(64) long long laneVertices[8];
+		_mm512_store_pd(laneDistances, bestDistances);
+		_mm512_store_si512(laneVertices, bestVertices);
+		for (int lane = 0; lane < 8; ++lane) {
+			mergeMinimum(laneDistances[lane], laneVertices[lane], closestVertex, shortestDistance);
+		}
+	}
+
+
+	__attribute__((target("avx512f")))
+	VertexData findMinimumAVX512(const double* distances, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+		const __m512i laneOffsets = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+
+		int closestVertex = -1;
+		double shortestDistance = infinity;
+		__m512d bestDistances = _mm512_set1_pd(infinity);
+		__m512i bestVertices = _mm512_set1_epi64(-1);
+
+		for (int blockBegin = begin, blockEnd = begin; blockBegin < end; blockBegin = blockEnd) {
+			blockEnd = computeBlockEnd(blockBegin, end);
+			std::uint64_t processedInBlock = processedVerticesBitmap[blockBegin / 64];
+			if (processedInBlock == ~std::uint64_t(0)) {
+				continue;
+			}
+
+			int i = blockBegin;
+			for (; i + 8 <= blockEnd; i += 8) {
+				__mmask8 notProcessed = static_cast<__mmask8>(~(processedInBlock >> (i % 64)) & 0xFF);
+				__m512d currentDistances = _mm512_loadu_pd(distances + i);
+				__mmask8 smaller = _mm512_mask_cmp_pd_mask(notProcessed, currentDistances, bestDistances, _CMP_LT_OQ);
+				bestDistances = _mm512_mask_mov_pd(bestDistances, smaller, currentDistances);
+				bestVertices = _mm512_mask_mov_epi64(bestVertices, smaller, _mm512_add_epi64(_mm512_set1_epi64(i), laneOffsets));
+			}
+			for (; i < blockEnd; ++i) {
+				if (!checkIfVertexHasBeenProcessed(processedInBlock, i)) {
+					updateMinimum(i, distances, closestVertex, shortestDistance);
+				}
+			}
+		}
+
+		mergeLanesAVX512(bestDistances, bestVertices, closestVertex, shortestDistance);
+		return createVertexDataInstance(shortestDistance, closestVertex);
+	}
+
+
+	__attribute__((target("avx512f")))
+	VertexData relaxAndFindMinimumAVX512(const VertexData& vertexClosestToCluster, const double* weights, double* distances,
+		int* predecessors, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+
+		const __m512d threshold = _mm512_set1_pd(0.001);
+		const __m512d infinities = _mm512_set1_pd(infinity);
+		const __m512d sourceDistance = _mm512_set1_pd(vertexClosestToCluster.distance);
+		const __m512i sourceVertex = _mm512_set1_epi32(vertexClosestToCluster.vertexNumber);
+		const __m512i laneOffsets = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+
+		int closestVertex = -1;
+		double shortestDistance = infinity;
+		__m512d bestDistances = infinities;
+		__m512i bestVertices = _mm512_set1_epi64(-1);
+
+		for (int blockBegin = begin, blockEnd = begin; blockBegin < end; blockBegin = blockEnd) {
+			blockEnd = computeBlockEnd(blockBegin, end);
+			std::uint64_t processedInBlock = processedVerticesBitmap[blockBegin / 64];
+			if (processedInBlock == ~std::uint64_t(0)) {
+				continue;
+			}
+
+			int i = blockBegin;
+			for (; i + 8 <= blockEnd; i += 8) {
+				__mmask8 notProcessed = static_cast<__mmask8>(~(processedInBlock >> (i % 64)) & 0xFF);
+
+				// "no edge" weights are replaced with infinity
+				__m512d currentWeights = _mm512_loadu_pd(weights + i);
+				__mmask8 noEdge = _mm512_cmp_pd_mask(currentWeights, threshold, _CMP_LT_OQ);
+				__m512d altDistances = _mm512_add_pd(_mm512_mask_mov_pd(currentWeights, noEdge, infinities), sourceDistance);
+
+				// relaxation - only improved distances and predecessors are written back
+				__m512d currentDistances = _mm512_loadu_pd(distances + i);
+				__mmask8 better = _mm512_mask_cmp_pd_mask(notProcessed, altDistances, currentDistances, _CMP_LT_OQ);
+				currentDistances = _mm512_mask_mov_pd(currentDistances, better, altDistances);
+				_mm512_mask_storeu_pd(distances + i, better, altDistances);
+				_mm512_mask_storeu_epi32(predecessors + i, static_cast<__mmask16>(better), sourceVertex);
+
+				// minimum for the next iteration
+				__mmask8 smaller = _mm512_mask_cmp_pd_mask(notProcessed, currentDistances, bestDistances, _CMP_LT_OQ);
+				bestDistances = _mm512_mask_mov_pd(bestDistances, smaller, currentDistances);
+				bestVertices = _mm512_mask_mov_epi64(bestVertices, smaller, _mm512_add_epi64(_mm512_set1_epi64(i), laneOffsets));
+			}
+			for (; i < blockEnd; ++i) {
+				if (!checkIfVertexHasBeenProcessed(processedInBlock, i)) {
+					relaxAndUpdateMinimum(i, vertexClosestToCluster, weights, distances, predecessors, closestVertex, shortestDistance);
+				}
+			}
+		}
+
+		mergeLanesAVX512(bestDistances, bestVertices, closestVertex, shortestDistance);
+		return createVertexDataInstance(shortestDistance, closestVertex);
+	}
+
+#endif // RELAXATION_KERNELS_X86
+
+
+	const KernelsSet scalarKernels { "scalar", findMinimumScalar, relaxAndFindMinimumScalar };
+#ifdef RELAXATION_KERNELS_X86
+	const KernelsSet sse2Kernels { "sse2", findMinimumSSE2, relaxAndFindMinimumSSE2 };
+	const KernelsSet avx2Kernels { "avx2", findMinimumAVX2, relaxAndFindMinimumAVX2 };
+	const KernelsSet avx512Kernels { "avx512", findMinimumAVX512, relaxAndFindMinimumAVX512 };
+#endif // RELAXATION_KERNELS_X86
+
+
+	/// <summary>
+	/// Finds kernels with given name that are supported by the processor.
+	/// Returns nullptr if there are no such kernels.
+	/// </summary>
+	const KernelsSet* findSupportedKernels(const std::string& instructionSetName) {
+#ifdef RELAXATION_KERNELS_X86
+		__builtin_cpu_init();
+		if (instructionSetName == "avx512") {
+			return __builtin_cpu_supports("avx512f") ? &avx512Kernels : nullptr;
+		}
+		if (instructionSetName == "avx2") {
+			return __builtin_cpu_supports("avx2") ? &avx2Kernels : nullptr;
+		}
+		if (instructionSetName == "sse2") {
+			return __builtin_cpu_supports("sse2") ? &sse2Kernels : nullptr;
+		}
+#endif // RELAXATION_KERNELS_X86
+		return instructionSetName == "scalar" ? &scalarKernels : nullptr;
+	}
+
+
+	/// <summary>
+	/// Selects best kernels supported by the processor.
+	/// </summary>
+	const KernelsSet* selectBestKernels() {
+		for (const char* instructionSetName : { "avx512", "avx2", "sse2" }) {
+			if (const KernelsSet* kernels = findSupportedKernels(instructionSetName)) {
+				return kernels;
+			}
+		}
+		return &scalarKernels;
+	}
+
+
+	const KernelsSet* selectedKernels = selectBestKernels();
+
+}
+
+
+VertexData RelaxationKernels::findMinimum(const double* distances, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+	return selectedKernels->findMinimum(distances, processedVerticesBitmap, begin, end);
+}
+
+
+VertexData RelaxationKernels::relaxAndFindMinimum(const VertexData& vertexClosestToCluster, const double* weights, double* distances,
+	int* predecessors, const std::uint64_t* processedVerticesBitmap, int begin, int end) {
+	return selectedKernels->relaxAndFindMinimum(vertexClosestToCluster, weights, distances, predecessors, processedVerticesBitmap, begin, end);
+}
+
+
+const char* RelaxationKernels::getInstructionSetName() {
+	return selectedKernels->name;
+}
+
+
+bool RelaxationKernels::selectInstructionSet(const std::string& instructionSetName) {
+	const KernelsSet* kernels = findSupportedKernels(instructionSetName);
+	if (kernels == nullptr) {
+		return false;
+	}
+	selectedKernels = kernels;
+	return true;
+}
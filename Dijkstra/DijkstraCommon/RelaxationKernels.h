@@ -0,0 +1,90 @@
+/**
+*	@file RelaxationKernels.h
+*	@brief This file contains vectorized versions of the hottest loops of
+*	Dijkstra algorithm together with runtime selection of instruction set.
+*/
+
+#pragma once
+
+#include "VertexData.h"
+
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// This class contains kernels used by DijkstraAlgorithmBackend for the
+/// hottest loops of dense Dijkstra algorithm: search for vertex closest to
+/// cluster and inner loop fused with that search. Each kernel exists in
+/// scalar, SSE2, AVX2 and AVX-512 version - the best one supported by the
+/// processor is selected when program starts. Results of all versions are
+/// exactly the same. All methods are static and the constructor is deleted.
+/// </summary>
+/// <remarks>
+/// Kernels work on vertices in range [begin, end) counted from the beginning
+/// of handled range. Processed vertices are given as a bitmap (bit i % 64 of
+/// word i / 64 is set if vertex i has been processed). Returned VertexData
+/// contains index from the same range, or -1 if there is no vertex with finite
+/// distance that has not been processed.
+/// </remarks>
+class RelaxationKernels final {
+
+public:
+
+	/// <summary>
+	/// Deleted constructor - all methods in this class are static, there is
+	/// no need for creating instance of it.
+	/// </summary>
+	RelaxationKernels() = delete;
+
+
+	/// <summary>
+	/// Finds vertex with minimal distance that has not been processed yet. If
+	/// several vertices have the same distance, the one with smallest index is
+	/// returned.
+	/// </summary>
+	/// <returns>
+	/// VertexData structure with index and distance of found vertex.
+	/// </returns>
+	static VertexData findMinimum(const double* distances, const std::uint64_t* processedVerticesBitmap, int begin, int end);
+
+
+	/// <summary>
+	/// Performs inner for loop of Dijkstra algorithm for weights stored next to
+	/// each other and finds vertex with minimal distance in the same pass. Weights
+	/// lower than 0.001 are treated as no edge - it is done with blends, without
+	/// branches.
+	/// </summary>
+	/// <returns>
+	/// VertexData structure with index and distance of found vertex.
+	/// </returns>
+	/// <param name="vertexClosestToCluster">
+	/// Vertex that has been recently added to cluster (global number and distance).
+	/// </param>
+	/// <param name="weights">
+	/// Weights of edges leading from vertex closest to cluster, weights[i] is the
+	/// weight of edge leading to vertex i.
+	/// </param>
+	static VertexData relaxAndFindMinimum(const VertexData& vertexClosestToCluster, const double* weights, double* distances,
+		int* predecessors, const std::uint64_t* processedVerticesBitmap, int begin, int end);
+
+
+	/// <summary>
+	/// Returns name of currently used instruction set: scalar, sse2, avx2 or avx512.
+	/// </summary>
+	static const char* getInstructionSetName();
+
+
+	/// <summary>
+	/// Forces kernels to use given instruction set instead of the best one. Mainly
+	/// useful for benchmarking and comparing results.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if instruction set is known and supported by the
+	/// processor. If not, currently used kernels are left unchanged.
+	/// </returns>
+	/// <param name="instructionSetName">
+	/// Name of instruction set: scalar, sse2, avx2 or avx512.
+	/// </param>
+	static bool selectInstructionSet(const std::string& instructionSetName);
+
+};
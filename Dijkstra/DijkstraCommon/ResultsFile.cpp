@@ -0,0 +1,176 @@
+#include "ResultsFile.h"
+
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+	const char resultsFileSignature[8] = { 'D', 'J', 'K', 'R', 'S', 'L', 'T', 'S' };
+	const std::uint32_t byteOrderMark = 0x01020304;
+
+	static_assert(sizeof(ResultsFile::Header) == 64, "Header of results file must be 64 bytes long");
+	static_assert(sizeof(int) == sizeof(std::int32_t), "Predecessors are stored as 32-bit integers");
+
+}
+
+
+ResultsFile::Header ResultsFile::createHeader(int numberOfVertices, int sourceVertexIndex, int targetVertexIndex, PredecessorsEncoding predecessorsEncoding) {
+	Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, resultsFileSignature, sizeof(resultsFileSignature));
+	header.version = formatVersion;
+	header.byteOrderMark = byteOrderMark;
+	header.numberOfVertices = numberOfVertices;
+	header.sourceVertex = sourceVertexIndex;
+	header.targetVertex = targetVertexIndex;
+	header.distancesOffset = alignOffset(sizeof(Header));
+	header.predecessorsOffset = alignOffset(header.distancesOffset + static_cast<std::uint64_t>(numberOfVertices) * sizeof(double));
+	header.predecessorsEncoding = predecessorsEncoding;
+	return header;
+}
+
+
+void ResultsFile::compressPredecessors(ArrayView<int> predecessors, int firstVertex, std::vector<char>& buffer) {
+	for (size_t i = 0; i < predecessors.size(); ++i) {
+		std::uint64_t value = 0;
+		if (predecessors[i] != -1) {
+			std::int64_t difference = static_cast<std::int64_t>(predecessors[i]) - (firstVertex + static_cast<std::int64_t>(i));
+			value = (difference >= 0 ? static_cast<std::uint64_t>(difference) * 2 : static_cast<std::uint64_t>(-difference) * 2 - 1) + 1;
+		}
+		while (value >= 0x80) {
+			buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		buffer.push_back(static_cast<char>(value));
+	}
+}
+
+
+bool ResultsFile::writeToFile(const std::string& filePath, const std::vector<double>& distances, const std::vector<int>& predecessors,
+	int sourceVertexIndex, int targetVertexIndex, bool useCompression)
+{
+	std::ofstream file(filePath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+	if (!file.is_open()) {
+		std::cout << "Nie mozna utworzyc pliku " << filePath << "." << std::endl;
+		return false;
+	}
+
+	int numberOfVertices = static_cast<int>(distances.size());
+	Header header = createHeader(numberOfVertices, sourceVertexIndex, targetVertexIndex, useCompression ? Compressed : Plain);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.seekp(static_cast<std::streamoff>(header.distancesOffset));
+	file.write(reinterpret_cast<const char*>(distances.data()), static_cast<std::streamsize>(numberOfVertices * sizeof(double)));
+
+	// space between sections is filled with zeros
+	std::vector<char> buffer(header.predecessorsOffset - header.distancesOffset - numberOfVertices * sizeof(double), 0);
+	file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	if (useCompression) {
+		buffer.clear();
+		compressPredecessors(predecessors, 0, buffer);
+		file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	}
+	else {
+		file.write(reinterpret_cast<const char*>(predecessors.data()), static_cast<std::streamsize>(numberOfVertices * sizeof(int)));
+	}
+
+	if (!file.good()) {
+		std::cout << "Nie mozna zapisac pliku " << filePath << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+const ResultsFile::Header* ResultsFile::readHeader(const MappedFile& file, const std::string& filePath) {
+
+	if (file.getSize() < sizeof(Header) || std::memcmp(file.getData(), resultsFileSignature, sizeof(resultsFileSignature)) != 0) {
+		std::cout << "Plik " << filePath << " nie jest binarnym plikiem wynikow." << std::endl;
+		return nullptr;
+	}
+
+	const Header* header = reinterpret_cast<const Header*>(file.getData());
+	if (header->version != formatVersion) {
+		std::cout << "Plik " << filePath << " ma nieobslugiwana wersje formatu (" << header->version << ")." << std::endl;
+		return nullptr;
+	}
+	if (header->byteOrderMark != byteOrderMark) {
+		std::cout << "Plik " << filePath << " zostal zapisany na maszynie o innej kolejnosci bajtow." << std::endl;
+		return nullptr;
+	}
+
+	// every section described by header must fit in the file
+	std::uint64_t fileSize = file.getSize();
+	bool isValid = header->numberOfVertices > 0 && header->numberOfVertices <= INT_MAX
+		&& header->sourceVertex >= 0 && header->sourceVertex < header->numberOfVertices
+		&& header->targetVertex >= -1 && header->targetVertex < header->numberOfVertices
+		&& header->distancesOffset >= sizeof(Header) && header->distancesOffset % sectionAlignment == 0
+		&& header->predecessorsOffset % sectionAlignment == 0
+		&& header->predecessorsOffset >= header->distancesOffset + header->numberOfVertices * sizeof(double)
+		&& header->predecessorsOffset <= fileSize;
+	if (isValid && header->predecessorsEncoding == Plain) {
+		isValid = static_cast<std::uint64_t>(header->numberOfVertices) <= (fileSize - header->predecessorsOffset) / sizeof(int);
+	}
+	else if (isValid && header->predecessorsEncoding == Compressed) {
+		isValid = static_cast<std::uint64_t>(header->numberOfVertices) <= fileSize - header->predecessorsOffset;
+	}
+	else {
+		isValid = false;
+	}
+
+	if (!isValid) {
+		std::cout << "Plik " << filePath << " zawiera niepoprawne dane." << std::endl;
+		return nullptr;
+	}
+	return header;
+}
+
+
+ArrayView<double> ResultsFile::getDistances(const MappedFile& file) {
+	const Header* header = reinterpret_cast<const Header*>(file.getData());
+	return ArrayView<double>(reinterpret_cast<const double*>(file.getData() + header->distancesOffset), static_cast<size_t>(header->numberOfVertices));
+}
+
+
+ArrayView<int> ResultsFile::getPredecessors(const MappedFile& file) {
+	const Header* header = reinterpret_cast<const Header*>(file.getData());
+	return ArrayView<int>(reinterpret_cast<const int*>(file.getData() + header->predecessorsOffset), static_cast<size_t>(header->numberOfVertices));
+}
+
+
+bool ResultsFile::decompressPredecessors(const MappedFile& file, const std::string& filePath, std::vector<int>& predecessors) {
+	const Header* header = reinterpret_cast<const Header*>(file.getData());
+	const unsigned char* data = reinterpret_cast<const unsigned char*>(file.getData());
+	std::uint64_t position = header->predecessorsOffset;
+	std::int64_t numberOfVertices = header->numberOfVertices;
+
+	predecessors.assign(static_cast<size_t>(numberOfVertices), -1);
+	for (std::int64_t vertex = 0; vertex < numberOfVertices; ++vertex) {
+		std::uint64_t value = 0;
+		int shift = 0;
+		bool hasNextByte = true;
+		while (hasNextByte && position < file.getSize() && shift < 64) {
+			value |= static_cast<std::uint64_t>(data[position] & 0x7F) << shift;
+			hasNextByte = (data[position] & 0x80) != 0;
+			shift += 7;
+			++position;
+		}
+
+		// predecessor has to be a vertex of the graph
+		std::int64_t difference = ((value - 1) & 1) ? -static_cast<std::int64_t>((value - 1) / 2) - 1 : static_cast<std::int64_t>((value - 1) / 2);
+		if (hasNextByte || (value != 0 && (vertex + difference < 0 || vertex + difference >= numberOfVertices))) {
+			std::cout << "Plik " << filePath << " zawiera niepoprawne dane." << std::endl;
+			return false;
+		}
+		if (value != 0) {
+			predecessors[static_cast<size_t>(vertex)] = static_cast<int>(vertex + difference);
+		}
+	}
+	return true;
+}
+
+
+std::uint64_t ResultsFile::alignOffset(std::uint64_t offset) {
+	return (offset + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+}
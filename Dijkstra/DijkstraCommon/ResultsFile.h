@@ -0,0 +1,201 @@
+/**
+*	@file ResultsFile.h
+*	@brief This file contains ResultsFile class responsible for writing algorithm
+*	results in binary format and for reading them from memory mapped files.
+*/
+
+#pragma once
+
+#include "ArrayView.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// This class describes binary file with results of single-source search -
+/// distances and predecessors of all vertices, which form shortest path tree.
+/// Numbers are not formatted and every process can write its own part of both
+/// arrays at known offset, so results do not have to be gathered by one process.
+/// Paths are not stored - any of them can be extracted from predecessors in time
+/// proportional to its length (see DijkstraPaths). Please note that all methods
+/// are static.
+/// </summary>
+/// <remarks>
+/// File starts with 64-byte header (see Header structure). Then N doubles
+/// (distances) and N predecessors follow, each array in its own section that
+/// starts at offset that is a multiple of 64 bytes. All numbers are written in
+/// native byte order of the machine (the header contains byte order mark). If
+/// search stopped at target vertex, only distance to it and predecessors on path
+/// to it are valid.
+/// <list type="bullet">
+/// <item>Plain predecessors: N 32-bit numbers (-1 for source vertex and
+/// unreachable vertices).</item>
+/// <item>Compressed predecessors: variable-length numbers that take the rest of
+/// the file - 0 for vertex without predecessor, otherwise difference between
+/// predecessor and vertex (zigzag encoded, so small negative differences are small
+/// too) increased by 1. Every byte carries 7 bits of the number, the highest bit
+/// is set in all bytes except the last one. Neighbours of vertex usually have
+/// close numbers, so most predecessors take one or two bytes.</item>
+/// </list>
+/// </remarks>
+class ResultsFile final {
+
+public:
+
+	/// <summary>
+	/// Encodings of predecessors section.
+	/// </summary>
+	enum PredecessorsEncoding : std::uint32_t {
+		Plain = 1,
+		Compressed = 2
+	};
+
+
+	/// <summary>
+	/// Header of results file - first 64 bytes of the file.
+	/// </summary>
+	struct Header {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t byteOrderMark;
+		std::int64_t numberOfVertices;
+		std::int64_t sourceVertex;
+		std::int64_t targetVertex;
+		std::uint64_t distancesOffset;
+		std::uint64_t predecessorsOffset;
+		std::uint32_t predecessorsEncoding;
+		std::uint32_t reserved;
+	};
+
+
+	/// <summary>
+	/// Default constructor. Because this class contains only static methods, it
+	/// has been deleted.
+	/// </summary>
+	ResultsFile() = delete;
+
+
+	/// <summary>
+	/// Creates header of results file with offsets of both sections.
+	/// </summary>
+	/// <param name="numberOfVertices">
+	/// Number of vertices of the graph.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Number of source vertex.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex, or -1 if search has not been stopped at target vertex.
+	/// </param>
+	/// <param name="predecessorsEncoding">
+	/// Encoding of predecessors section.
+	/// </param>
+	static Header createHeader(int numberOfVertices, int sourceVertexIndex, int targetVertexIndex, PredecessorsEncoding predecessorsEncoding);
+
+
+	/// <summary>
+	/// Appends compressed predecessors of continous range of vertices to buffer. Ranges
+	/// compressed one after another form predecessors section of the whole graph.
+	/// </summary>
+	/// <param name="predecessors">
+	/// Predecessors of vertices of the range.
+	/// </param>
+	/// <param name="firstVertex">
+	/// Number of the first vertex of the range.
+	/// </param>
+	/// <param name="buffer">
+	/// Buffer to which compressed predecessors are appended.
+	/// </param>
+	static void compressPredecessors(ArrayView<int> predecessors, int firstVertex, std::vector<char>& buffer);
+
+
+	/// <summary>
+	/// Writes results file. If file could not be created, proper information is printed.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file has been written.
+	/// </returns>
+	/// <param name="filePath">
+	/// Path to output file. Existing file is overwritten.
+	/// </param>
+	/// <param name="distances">
+	/// Distances to all vertices.
+	/// </param>
+	/// <param name="predecessors">
+	/// Predecessors of all vertices.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Number of source vertex.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex, or -1 if search has not been stopped at target vertex.
+	/// </param>
+	/// <param name="useCompression">
+	/// Boolean that indicates if predecessors should be compressed.
+	/// </param>
+	static bool writeToFile(const std::string& filePath, const std::vector<double>& distances, const std::vector<int>& predecessors,
+		int sourceVertexIndex, int targetVertexIndex, bool useCompression);
+
+
+	/// <summary>
+	/// Validates header of mapped file and checks if all sections it describes fit
+	/// in the file. If file is not valid, proper information is printed.
+	/// </summary>
+	/// <returns>
+	/// Pointer to header stored in mapped file, or nullptr if file is not valid.
+	/// </returns>
+	/// <param name="file">
+	/// Mapped results file.
+	/// </param>
+	/// <param name="filePath">
+	/// String with path to file - used in printed information.
+	/// </param>
+	static const Header* readHeader(const MappedFile& file, const std::string& filePath);
+
+
+	/// <summary>
+	/// Returns view of distances. File should be validated with readHeader first.
+	/// </summary>
+	static ArrayView<double> getDistances(const MappedFile& file);
+
+
+	/// <summary>
+	/// Returns view of plain predecessors. File should be validated with readHeader
+	/// first and its predecessors should not be compressed.
+	/// </summary>
+	static ArrayView<int> getPredecessors(const MappedFile& file);
+
+
+	/// <summary>
+	/// Decompresses predecessors of all vertices. File should be validated with
+	/// readHeader first and its predecessors should be compressed. If data is not
+	/// valid, proper information is printed.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if predecessors have been decompressed.
+	/// </returns>
+	/// <param name="file">
+	/// Mapped results file.
+	/// </param>
+	/// <param name="filePath">
+	/// String with path to file - used in printed information.
+	/// </param>
+	/// <param name="predecessors">
+	/// Vector that receives predecessors of all vertices.
+	/// </param>
+	static bool decompressPredecessors(const MappedFile& file, const std::string& filePath, std::vector<int>& predecessors);
+
+
+	static const std::uint32_t formatVersion = 1;
+	static const std::uint64_t sectionAlignment = 64;
+
+private:
+
+	/// <summary>
+	/// Rounds offset up to the nearest multiple of section alignment.
+	/// </summary>
+	static std::uint64_t alignOffset(std::uint64_t offset);
+
+};
@@ -1,30 +1,176 @@
 #include "ResultsPrinter.h"
 
+#include <charconv>
+
+namespace {
+
+	// buffer is written to the stream when it grows over this size
+	const size_t bufferWriteThreshold = 1 << 20;
+
+	// the same number of significant digits as default precision of streams
+	const int distancePrecision = 6;
+
+	const char resultsHeader[] = "============ RESULTS ============\n";
+	const char pathsHeader[] = "============= PATHS =============\n";
+
+}
+
+
+ResultsPrinter::~ResultsPrinter() {
+	writeBuffer();
+}
+
+
 void ResultsPrinter::printResultingDistances(const std::vector<double>& distances, int sourceVertexIndex) {
-	stream << "============ RESULTS ============" << std::endl;
-	for (int i = 0; i < distances.size(); ++i) {
-		stream << "Distance from vertex " << sourceVertexIndex << " to " << i << ": " << distances.at(i) << std::endl;
+	append(resultsHeader, sizeof(resultsHeader) - 1);
+	for (int i = 0; i < static_cast<int>(distances.size()); ++i) {
+		printDistance(distances[i], sourceVertexIndex, i);
+		writeBufferIfFull();
 	}
+	writeBuffer();
 }
 
 
 void ResultsPrinter::printResultingPaths(const std::vector<int>& predecessors, int sourceVertexIndex) {
-	stream << "============= PATHS =============" << std::endl;
+	append(pathsHeader, sizeof(pathsHeader) - 1);
+	std::vector<PathState> pathStates = computePathStates(predecessors, sourceVertexIndex);
 	for (int i = 0; i < static_cast<int>(predecessors.size()); ++i) {
-		std::vector<int> path;
-		int currentVertex = i;
-		while (currentVertex != -1) {
-			path.push_back(currentVertex);
-			currentVertex = predecessors.at(currentVertex);
-		}
-		if (std::find(path.begin(), path.end(), sourceVertexIndex) != path.end()) {
-			for (int i = static_cast<int>(path.size()) - 1; i >= 0; --i) {
-				stream << path.at(i) << ", ";
-			}
+		if (pathStates[i] == PathState::LeadsToSource) {
+			printPath(predecessors, i);
 		}
 		else {
-			stream << "Vertex " << i << " unreachable from source vertex.";
+			printUnreachableVertex(i);
+		}
+		writeBufferIfFull();
+	}
+	writeBuffer();
+}
+
+
+void ResultsPrinter::printResultForTargetVertex(const std::vector<double>& distances, const std::vector<int>& predecessors, int sourceVertexIndex, int targetVertexIndex) {
+	append(resultsHeader, sizeof(resultsHeader) - 1);
+	printDistance(distances.at(targetVertexIndex), sourceVertexIndex, targetVertexIndex);
+	append(pathsHeader, sizeof(pathsHeader) - 1);
+
+	// only path to target vertex is walked - predecessors of other vertices may be not valid
+	bool leadsToSource = false;
+	for (int currentVertex = targetVertexIndex; currentVertex != -1 && !leadsToSource; currentVertex = predecessors.at(currentVertex)) {
+		leadsToSource = currentVertex == sourceVertexIndex;
+	}
+	if (leadsToSource) {
+		printPath(predecessors, targetVertexIndex);
+	}
+	else {
+		printUnreachableVertex(targetVertexIndex);
+	}
+	writeBuffer();
+}
+
+
+void ResultsPrinter::printPathToTargetVertex(double distance, ArrayView<int> path, int sourceVertexIndex, int targetVertexIndex) {
+	printDistance(distance, sourceVertexIndex, targetVertexIndex);
+	if (path.empty()) {
+		printUnreachableVertex(targetVertexIndex);
+	}
+	else {
+		for (int vertex : path) {
+			appendNumber(vertex);
+			append(", ", 2);
+		}
+		append("\n", 1);
+	}
+	writeBufferIfFull();
+}
+
+
+void ResultsPrinter::printPath(const std::vector<int>& predecessors, int vertex) {
+	path.clear();
+	for (int currentVertex = vertex; currentVertex != -1; currentVertex = predecessors[currentVertex]) {
+		path.push_back(currentVertex);
+	}
+	for (auto it = path.rbegin(); it != path.rend(); ++it) {
+		appendNumber(*it);
+		append(", ", 2);
+	}
+	append("\n", 1);
+}
+
+
+void ResultsPrinter::printDistance(double distance, int sourceVertexIndex, int vertex) {
+	append("Distance from vertex ", 21);
+	appendNumber(sourceVertexIndex);
+	append(" to ", 4);
+	appendNumber(vertex);
+	append(": ", 2);
+	appendNumber(distance);
+	append("\n", 1);
+}
+
+
+void ResultsPrinter::printUnreachableVertex(int vertex) {
+	append("Vertex ", 7);
+	appendNumber(vertex);
+	append(" unreachable from source vertex.\n", 33);
+}
+
+
+std::vector<ResultsPrinter::PathState> ResultsPrinter::computePathStates(const std::vector<int>& predecessors, int sourceVertexIndex) {
+	std::vector<PathState> pathStates(predecessors.size(), PathState::Unknown);
+	pathStates.at(sourceVertexIndex) = PathState::LeadsToSource;
+	std::vector<int> visitedVertices;
+	for (int i = 0; i < static_cast<int>(predecessors.size()); ++i) {
+
+		// walk up the tree until the end of the path or vertex with known state is reached
+		int currentVertex = i;
+		while (currentVertex != -1 && pathStates[currentVertex] == PathState::Unknown) {
+			pathStates[currentVertex] = PathState::Visited;
+			visitedVertices.push_back(currentVertex);
+			currentVertex = predecessors[currentVertex];
+		}
+
+		// vertex visited during this walk means that predecessors form a cycle
+		PathState state = currentVertex == -1 || pathStates[currentVertex] == PathState::Visited
+			? PathState::Unreachable
+			: pathStates[currentVertex];
+		for (int visitedVertex : visitedVertices) {
+			pathStates[visitedVertex] = state;
 		}
-		stream << std::endl;
+		visitedVertices.clear();
+	}
+	return pathStates;
+}
+
+
+void ResultsPrinter::append(const char* text, size_t length) {
+	buffer.append(text, length);
+}
+
+
+void ResultsPrinter::appendNumber(int number) {
+	char text[16];
+	char* end = std::to_chars(text, text + sizeof(text), number).ptr;
+	buffer.append(text, end - text);
+}
+
+
+void ResultsPrinter::appendNumber(double number) {
+	char text[32];
+	char* end = std::to_chars(text, text + sizeof(text), number, std::chars_format::general, distancePrecision).ptr;
+	buffer.append(text, end - text);
+}
+
+
+void ResultsPrinter::writeBufferIfFull() {
+	if (buffer.size() >= bufferWriteThreshold) {
+		writeBuffer();
+	}
+}
+
+
+void ResultsPrinter::writeBuffer() {
+	if (!buffer.empty()) {
+		stream.write(buffer.data(), buffer.size());
+		buffer.clear();
 	}
+	stream.flush();
 }
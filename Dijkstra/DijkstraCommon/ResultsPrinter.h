@@ -6,8 +6,10 @@
 
 #pragma once
 
-#include <algorithm>
+#include "ArrayView.h"
+
 #include <iostream>
+#include <string>
 #include <vector>
 
 /// <summary>
@@ -17,6 +19,12 @@
 /// indeprendent of Log class - if Log is disabled, this class
 /// can still print result to output.
 /// </summary>
+/// <remarks>
+/// Text is formatted with std::to_chars into a buffer that is
+/// written to the stream in large blocks, so printing does not
+/// depend on formatting and flushing of the stream. Numbers look
+/// the same as numbers printed by the stream with default settings.
+/// </remarks>
 class ResultsPrinter final {
 
 public:
@@ -32,6 +40,12 @@ public:
 	ResultsPrinter(std::ostream& stream) : stream(stream) {}
 
 
+	/// <summary>
+	/// Results printer destructor. Writes text left in the buffer.
+	/// </summary>
+	~ResultsPrinter();
+
+
 	/// <summary>
 	/// Prints list of distances from source vertex to output stream. 
 	/// </summary>
@@ -47,7 +61,8 @@ public:
 	/// <summary>
 	/// Prints paths from source vertex to every vertex in graph. If vertex
 	/// can not be accessed from source vertex, proper information about this
-	/// is printed.
+	/// is printed. Vertices whose paths lead to source vertex are found in
+	/// a single pass over predecessor tree, so every path is walked once.
 	/// </summary>
 	/// <param name="predecessors">
 	/// Vector of valid predecessors created using Dijkstra algorithm. 
@@ -58,9 +73,120 @@ public:
 	void printResultingPaths(const std::vector<int>& predecessors, int sourceVertexIndex);
 
 
+	/// <summary>
+	/// Prints distance from source vertex to target vertex and path between them.
+	/// Used when search stops as soon as target vertex is reached - results for
+	/// other vertices are not valid then, so they are not printed.
+	/// </summary>
+	/// <param name="distances">
+	/// Vector of distances - only distance to target vertex has to be valid.
+	/// </param>
+	/// <param name="predecessors">
+	/// Vector of predecessors - only those on path to target vertex have to be valid.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Number of source vertex.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex.
+	/// </param>
+	void printResultForTargetVertex(const std::vector<double>& distances, const std::vector<int>& predecessors, int sourceVertexIndex, int targetVertexIndex);
+
+
+	/// <summary>
+	/// Prints distance from source vertex to target vertex and given path between
+	/// them, without headers. Used to print paths extracted from results file.
+	/// </summary>
+	/// <param name="distance">
+	/// Distance from source vertex to target vertex.
+	/// </param>
+	/// <param name="path">
+	/// Vertices of the path from source vertex to target vertex - empty if target
+	/// vertex is unreachable.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Number of source vertex.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex.
+	/// </param>
+	void printPathToTargetVertex(double distance, ArrayView<int> path, int sourceVertexIndex, int targetVertexIndex);
+
+
 private:
 
+	/// <summary>
+	/// States of vertices in predecessor tree - used to remember which paths
+	/// lead to source vertex.
+	/// </summary>
+	enum class PathState : char {
+		Unknown,
+		Visited,
+		LeadsToSource,
+		Unreachable
+	};
+
+
+	/// <summary>
+	/// Prints path from source vertex to given vertex in one line - the path
+	/// has to lead to source vertex.
+	/// </summary>
+	void printPath(const std::vector<int>& predecessors, int vertex);
+
+
+	/// <summary>
+	/// Prints line with distance from source vertex to given vertex.
+	/// </summary>
+	void printDistance(double distance, int sourceVertexIndex, int vertex);
+
+
+	/// <summary>
+	/// Prints line with information that vertex can not be accessed from source vertex.
+	/// </summary>
+	void printUnreachableVertex(int vertex);
+
+
+	/// <summary>
+	/// Finds out which vertices have paths that lead to source vertex. Every
+	/// vertex is visited once - walk up the tree stops at the first vertex
+	/// whose state is already known.
+	/// </summary>
+	static std::vector<PathState> computePathStates(const std::vector<int>& predecessors, int sourceVertexIndex);
+
+
+	/// <summary>
+	/// Appends text to the buffer.
+	/// </summary>
+	void append(const char* text, size_t length);
+
+
+	/// <summary>
+	/// Appends formatted number to the buffer.
+	/// </summary>
+	void appendNumber(int number);
+
+
+	/// <summary>
+	/// Appends formatted number to the buffer.
+	/// </summary>
+	void appendNumber(double number);
+
+
+	/// <summary>
+	/// Writes buffer to the stream if it is full enough.
+	/// </summary>
+	void writeBufferIfFull();
+
+
+	/// <summary>
+	/// Writes whole buffer to the stream.
+	/// </summary>
+	void writeBuffer();
+
+
 	std::ostream& stream;
+	std::string buffer;
+	std::vector<int> path;
 
 };
 
@@ -0,0 +1,326 @@
+#include "SparseGraph.h"
+#include "AdjacencyMatrixReader.h"
+#include "BinaryGraphFile.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+
+std::unique_ptr<SparseGraph> SparseGraph::fromFile(const std::string& filePath) {
+	return BinaryGraphFile::checkIfFileIsBinaryGraph(filePath) ? fromBinaryFile(filePath) : compressRowsOfMatrix(filePath);
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::compressRowsOfMatrix(const std::string& filePath) {
+
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+
+	AdjacencyMatrixReader reader(filePath);
+	int numberOfVertices = reader.getNumberOfVertices();
+	if (numberOfVertices <= 0) {
+		return graph;
+	}
+
+	// rows of adjacency matrix are outgoing edges, so they can be appended directly
+	graph->m_offsets.reserve(numberOfVertices + 1);
+	graph->m_offsets.push_back(0);
+	std::vector<double> row;
+	while (reader.readNextRow(row)) {
+		for (int j = 0; j < numberOfVertices; ++j) {
+			if (row[j] >= 0.001) {
+				graph->m_targets.push_back(j);
+				graph->m_weights.push_back(row[j]);
+			}
+		}
+		graph->m_offsets.push_back(static_cast<int>(graph->m_targets.size()));
+	}
+	graph->useOwnedArrays();
+	return graph;
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::extractRowsOfVerticesInRange(const std::pair<int, int>& verticesRange) const {
+
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+	if (verticesRange.second < verticesRange.first) {
+		return graph;
+	}
+
+	// rows are continous, so they are copied at once and offsets start from 0
+	int firstEdge = m_offsetsView.at(verticesRange.first);
+	int lastEdge = m_offsetsView.at(verticesRange.second + 1);
+	graph->m_offsets.reserve(verticesRange.second - verticesRange.first + 2);
+	for (int v = verticesRange.first; v <= verticesRange.second + 1; ++v) {
+		graph->m_offsets.push_back(m_offsetsView[v] - firstEdge);
+	}
+	graph->m_targets.assign(m_targetsView.begin() + firstEdge, m_targetsView.begin() + lastEdge);
+	graph->m_weights.assign(m_weightsView.begin() + firstEdge, m_weightsView.begin() + lastEdge);
+	graph->useOwnedArrays();
+	return graph;
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::createReversedGraph() const {
+
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+	int numberOfVertices = getNumberOfVertices();
+	if (numberOfVertices == 0) {
+		return graph;
+	}
+
+	// count edges entering every vertex - they become its outgoing edges
+	graph->m_offsets.assign(numberOfVertices + 1, 0);
+	for (int target : m_targetsView) {
+		++graph->m_offsets[target + 1];
+	}
+	for (int v = 0; v < numberOfVertices; ++v) {
+		graph->m_offsets[v + 1] += graph->m_offsets[v];
+	}
+
+	// sources are visited in ascending order, so targets in each reversed row stay sorted
+	std::vector<int> positions(graph->m_offsets.begin(), graph->m_offsets.end() - 1);
+	graph->m_targets.resize(m_targetsView.size());
+	graph->m_weights.resize(m_weightsView.size());
+	for (int v = 0; v < numberOfVertices; ++v) {
+		for (int e = m_offsetsView[v]; e < m_offsetsView[v + 1]; ++e) {
+			int position = positions[m_targetsView[e]]++;
+			graph->m_targets[position] = v;
+			graph->m_weights[position] = m_weightsView[e];
+		}
+	}
+	graph->useOwnedArrays();
+	return graph;
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::createRenumberedGraph(const std::vector<int>& newNumbers) const {
+
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+	int numberOfVertices = getNumberOfVertices();
+	if (numberOfVertices == 0) {
+		return graph;
+	}
+
+	// rows are moved to positions of their new vertex numbers
+	graph->m_offsets.assign(numberOfVertices + 1, 0);
+	for (int v = 0; v < numberOfVertices; ++v) {
+		graph->m_offsets[newNumbers[v] + 1] = m_offsetsView[v + 1] - m_offsetsView[v];
+	}
+	for (int v = 0; v < numberOfVertices; ++v) {
+		graph->m_offsets[v + 1] += graph->m_offsets[v];
+	}
+
+	std::vector<std::pair<int, double>> row;
+	graph->m_targets.resize(m_targetsView.size());
+	graph->m_weights.resize(m_weightsView.size());
+	for (int v = 0; v < numberOfVertices; ++v) {
+		row.clear();
+		for (int e = m_offsetsView[v]; e < m_offsetsView[v + 1]; ++e) {
+			row.emplace_back(newNumbers[m_targetsView[e]], m_weightsView[e]);
+		}
+
+		// targets in each row have to be sorted
+		std::sort(row.begin(), row.end(), [](const std::pair<int, double>& lhs, const std::pair<int, double>& rhs) {
+			return lhs.first < rhs.first;
+		});
+		int position = graph->m_offsets[newNumbers[v]];
+		for (const std::pair<int, double>& edge : row) {
+			graph->m_targets[position] = edge.first;
+			graph->m_weights[position] = edge.second;
+			++position;
+		}
+	}
+	graph->useOwnedArrays();
+	return graph;
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::createGraphWithChangedEdges(std::vector<Edge> changedEdges) const {
+
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+	int numberOfVertices = getNumberOfVertices();
+	if (numberOfVertices == 0) {
+		return graph;
+	}
+
+	// stable sort keeps changes of the same edge in given order, so the last of them can be chosen
+	std::stable_sort(changedEdges.begin(), changedEdges.end(), [](const Edge& lhs, const Edge& rhs) {
+		return lhs.source != rhs.source ? lhs.source < rhs.source : lhs.target < rhs.target;
+	});
+
+	// every row is merged with changes of its vertex - both are sorted by target vertex
+	graph->m_offsets.reserve(numberOfVertices + 1);
+	graph->m_offsets.push_back(0);
+	graph->m_targets.reserve(m_targetsView.size() + changedEdges.size());
+	graph->m_weights.reserve(m_weightsView.size() + changedEdges.size());
+	size_t c = 0;
+	for (int v = 0; v < numberOfVertices; ++v) {
+		int e = m_offsetsView[v];
+		while (e < m_offsetsView[v + 1] || (c < changedEdges.size() && changedEdges[c].source == v)) {
+			if (c == changedEdges.size() || changedEdges[c].source != v || (e < m_offsetsView[v + 1] && m_targetsView[e] < changedEdges[c].target)) {
+				graph->m_targets.push_back(m_targetsView[e]);
+				graph->m_weights.push_back(m_weightsView[e]);
+				++e;
+				continue;
+			}
+
+			// all existing edges to target vertex of the change are replaced by its last change
+			int target = changedEdges[c].target;
+			while (c + 1 < changedEdges.size() && changedEdges[c + 1].source == v && changedEdges[c + 1].target == target) {
+				++c;
+			}
+			if (changedEdges[c].weight >= 0.001) {
+				graph->m_targets.push_back(target);
+				graph->m_weights.push_back(changedEdges[c].weight);
+			}
+			while (e < m_offsetsView[v + 1] && m_targetsView[e] == target) {
+				++e;
+			}
+			++c;
+		}
+		graph->m_offsets.push_back(static_cast<int>(graph->m_targets.size()));
+	}
+	graph->useOwnedArrays();
+	return graph;
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::fromEdgeListFile(const std::string& filePath) {
+
+	std::ifstream infile(filePath, std::ifstream::in);
+	if (!infile.is_open()) {
+		std::cout << "Plik " << filePath << " nie istnieje." << std::endl;
+		return std::unique_ptr<SparseGraph>(new SparseGraph());
+	}
+
+	int numberOfVertices = 0;
+	infile >> numberOfVertices;
+
+	std::vector<Edge> edges;
+	Edge edge;
+	while (infile >> edge.source >> edge.target >> edge.weight) {
+		if (edge.source < 0 || edge.source >= numberOfVertices || edge.target < 0 || edge.target >= numberOfVertices) {
+			std::cout << "Krawedz " << edge.source << " -> " << edge.target << " wykracza poza graf, pomijam." << std::endl;
+			continue;
+		}
+		edges.push_back(edge);
+	}
+	return fromEdgeList(numberOfVertices, std::move(edges));
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::fromBinaryFile(const std::string& filePath, int blockIndex) {
+
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+	std::unique_ptr<MappedFile> mappedFile = MappedFile::open(filePath);
+	const BinaryGraphFile::Header* header = mappedFile ? BinaryGraphFile::readHeader(*mappedFile, filePath) : nullptr;
+	if (header == nullptr) {
+		return graph;
+	}
+	if (blockIndex >= static_cast<int>(header->numberOfBlocks)) {
+		std::cout << "Plik " << filePath << " nie zawiera bloku " << blockIndex << "." << std::endl;
+		return graph;
+	}
+
+	// dense graph has to be compressed, sparse one is used the way it is stored
+	if (header->layout == BinaryGraphFile::DenseColumnWise) {
+		return compressRowsOfMatrix(filePath);
+	}
+
+	BinaryGraphFile::CompressedArrays arrays = BinaryGraphFile::getCompressedArrays(*mappedFile, blockIndex);
+	graph->m_offsetsView = arrays.offsets;
+	graph->m_targetsView = arrays.targets;
+	graph->m_weightsView = arrays.weights;
+	graph->m_mappedFile = std::move(mappedFile);
+	return graph;
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::fromEdgeList(int numberOfVertices, std::vector<Edge> edges) {
+
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+	if (numberOfVertices <= 0) {
+		return graph;
+	}
+
+	edges.erase(std::remove_if(edges.begin(), edges.end(), [](const Edge& edge) { return edge.weight < 0.001; }), edges.end());
+	std::sort(edges.begin(), edges.end(), [](const Edge& lhs, const Edge& rhs) {
+		return lhs.source != rhs.source ? lhs.source < rhs.source : lhs.target < rhs.target;
+	});
+
+	graph->m_offsets.assign(numberOfVertices + 1, 0);
+	graph->m_targets.reserve(edges.size());
+	graph->m_weights.reserve(edges.size());
+	for (const Edge& edge : edges) {
+		++graph->m_offsets.at(edge.source + 1);
+		graph->m_targets.push_back(edge.target);
+		graph->m_weights.push_back(edge.weight);
+	}
+	for (int i = 0; i < numberOfVertices; ++i) {
+		graph->m_offsets.at(i + 1) += graph->m_offsets.at(i);
+	}
+	graph->useOwnedArrays();
+	return graph;
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::fromCompressedArrays(std::vector<int> offsets, std::vector<int> targets, std::vector<double> weights) {
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+	graph->m_offsets = std::move(offsets);
+	graph->m_targets = std::move(targets);
+	graph->m_weights = std::move(weights);
+	graph->useOwnedArrays();
+	return graph;
+}
+
+
+std::unique_ptr<SparseGraph> SparseGraph::extractEdgesWithTargetsInRange(const std::pair<int, int>& targetVerticesRange) const {
+
+	std::unique_ptr<SparseGraph> graph(new SparseGraph());
+	int numberOfVertices = getNumberOfVertices();
+	if (numberOfVertices == 0) {
+		return graph;
+	}
+
+	graph->m_offsets.reserve(numberOfVertices + 1);
+	graph->m_offsets.push_back(0);
+	for (int v = 0; v < numberOfVertices; ++v) {
+
+		// targets in each row are sorted, so edges in range form continous block
+		auto rowBegin = m_targetsView.begin() + m_offsetsView.at(v);
+		auto rowEnd = m_targetsView.begin() + m_offsetsView.at(v + 1);
+		auto first = std::lower_bound(rowBegin, rowEnd, targetVerticesRange.first);
+		auto last = std::upper_bound(first, rowEnd, targetVerticesRange.second);
+
+		graph->m_targets.insert(graph->m_targets.end(), first, last);
+		graph->m_weights.insert(graph->m_weights.end(),
+			m_weightsView.begin() + (first - m_targetsView.begin()), m_weightsView.begin() + (last - m_targetsView.begin()));
+		graph->m_offsets.push_back(static_cast<int>(graph->m_targets.size()));
+	}
+	graph->useOwnedArrays();
+	return graph;
+}
+
+
+void SparseGraph::useOwnedArrays() {
+	m_offsetsView = m_offsets;
+	m_targetsView = m_targets;
+	m_weightsView = m_weights;
+}
+
+
+std::uint64_t SparseGraph::computeChecksum() const {
+	std::uint64_t checksum = 14695981039346656037ull;
+	auto addBytes = [&checksum](const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			checksum = (checksum ^ bytes[i]) * 1099511628211ull;
+		}
+	};
+	addBytes(m_offsetsView.data(), m_offsetsView.size() * sizeof(int));
+	addBytes(m_targetsView.data(), m_targetsView.size() * sizeof(int));
+	addBytes(m_weightsView.data(), m_weightsView.size() * sizeof(double));
+	return checksum;
+}
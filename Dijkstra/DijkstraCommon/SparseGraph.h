@@ -0,0 +1,286 @@
+/**
+*	@file SparseGraph.h
+*	@brief This file contains class responsible for loading from file
+*	and storing sparse graphs in compressed sparse row (CSR) form.
+*/
+
+#pragma once
+
+#include "ArrayView.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <memory>
+
+/// <summary>
+/// Simple helper struct that represents single directed, weighted edge
+/// of the graph. Used when building sparse graph from list of edges.
+/// </summary>
+struct Edge {
+
+	int source;
+	int target;
+	double weight;
+
+};
+
+
+/// <summary>
+/// This class is responsible for loading from file and storing information
+/// about processed graph in compressed sparse row (CSR) form. Unlike
+/// AdjacencyMatrix, memory used by this class grows with number of edges
+/// instead of square of number of vertices. Outgoing edges of vertex v are
+/// stored in range [offsets[v], offsets[v + 1]) of targets and weights
+/// arrays, sorted by target vertex. Weights lower than 0.001 are treated
+/// as no edge - the same way as in adjacency matrix. Arrays are either owned
+/// by the graph or stored in memory mapped binary graph file.
+/// </summary>
+class SparseGraph final {
+
+public:
+
+	/// <summary>
+	/// Static factory method used for creating instance of sparse graph from
+	/// file with adjacency matrix (the same format AdjacencyMatrix uses). Matrix
+	/// is read row by row, so it is never stored in memory as a whole. Binary
+	/// graph files are opened with fromBinaryFile.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph. If data file could not
+	/// be opened, created graph contains no data.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to file that contains adjacency matrix information.
+	/// </param>
+	static std::unique_ptr<SparseGraph> fromFile(const std::string& filePath);
+
+
+	/// <summary>
+	/// Static factory method used for creating instance of sparse graph from
+	/// file with list of edges. First value in the file is number of vertices,
+	/// then each line contains one edge in form of: source target weight.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph. If data file could not
+	/// be opened, created graph contains no data.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to file that contains list of edges.
+	/// </param>
+	static std::unique_ptr<SparseGraph> fromEdgeListFile(const std::string& filePath);
+
+
+	/// <summary>
+	/// Static factory method used for creating instance of sparse graph from
+	/// binary graph file (see BinaryGraphFile). Sparse graph is mapped into memory
+	/// and used without parsing and copying; dense graph is compressed row by row.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph. If data file could not
+	/// be opened or is not valid, created graph contains no data.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to binary graph file.
+	/// </param>
+	/// <param name="blockIndex">
+	/// Index of column block of sparse graph to use instead of the whole graph -
+	/// it contains only edges leading to vertices of the block. -1 means whole graph.
+	/// </param>
+	static std::unique_ptr<SparseGraph> fromBinaryFile(const std::string& filePath, int blockIndex = -1);
+
+
+	/// <summary>
+	/// Static factory method used for creating instance of sparse graph from
+	/// list of edges stored in memory. Edges do not have to be sorted.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph.
+	/// </returns>
+	/// <param name="numberOfVertices">
+	/// Total number of vertices in the graph.
+	/// </param>
+	/// <param name="edges">
+	/// Vector of edges. Edges with weight lower than 0.001 are skipped.
+	/// </param>
+	static std::unique_ptr<SparseGraph> fromEdgeList(int numberOfVertices, std::vector<Edge> edges);
+
+
+	/// <summary>
+	/// Static factory method used for creating instance of sparse graph from
+	/// already prepared CSR arrays - for example received from other process.
+	/// Arrays are not validated.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph.
+	/// </returns>
+	/// <param name="offsets">
+	/// Vector of numberOfVertices + 1 offsets into targets and weights arrays.
+	/// </param>
+	/// <param name="targets">
+	/// Vector of target vertices of all edges.
+	/// </param>
+	/// <param name="weights">
+	/// Vector of weights of all edges.
+	/// </param>
+	static std::unique_ptr<SparseGraph> fromCompressedArrays(std::vector<int> offsets, std::vector<int> targets, std::vector<double> weights);
+
+
+	/// <summary>
+	/// Creates new graph that contains only those edges which target vertex
+	/// belongs to given range. Vertex numbers are not changed, so the result
+	/// still has the same number of vertices. Used for dividing graph between
+	/// processes.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph.
+	/// </returns>
+	/// <param name="targetVerticesRange">
+	/// Pair of integer values a, b that represents range [a, b] of target
+	/// vertices.
+	/// </param>
+	std::unique_ptr<SparseGraph> extractEdgesWithTargetsInRange(const std::pair<int, int>& targetVerticesRange) const;
+
+
+	/// <summary>
+	/// Creates new graph that contains only rows (outgoing edges) of vertices that
+	/// belong to given range. Vertex v of the range becomes row v - a of the result,
+	/// targets keep their numbers. Used for dividing graph between processes that
+	/// own vertices together with edges leaving them.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph.
+	/// </returns>
+	/// <param name="verticesRange">
+	/// Pair of integer values a, b that represents range [a, b] of vertices.
+	/// </param>
+	std::unique_ptr<SparseGraph> extractRowsOfVerticesInRange(const std::pair<int, int>& verticesRange) const;
+
+
+	/// <summary>
+	/// Creates new graph with every edge reversed - edge u -> v becomes v -> u and
+	/// keeps its weight. Used by backward search of bidirectional algorithm.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph.
+	/// </returns>
+	std::unique_ptr<SparseGraph> createReversedGraph() const;
+
+
+	/// <summary>
+	/// Creates new graph with renumbered vertices - vertex v becomes vertex newNumbers[v]
+	/// and edges keep their weights. Targets in every row are sorted again. Used to make
+	/// vertices of every part of graph partition continous.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph.
+	/// </returns>
+	/// <param name="newNumbers">
+	/// Permutation of vertex numbers - new number of every vertex.
+	/// </param>
+	std::unique_ptr<SparseGraph> createRenumberedGraph(const std::vector<int>& newNumbers) const;
+
+
+	/// <summary>
+	/// Creates new graph in which given edges are changed - weight of existing edge
+	/// is replaced, edge that does not exist is inserted and edge with weight lower
+	/// than 0.001 is deleted (the same way as in adjacency matrix). If the same edge
+	/// is changed more than once, the last change is used.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer that points to created graph.
+	/// </returns>
+	/// <param name="changedEdges">
+	/// Vector of changed edges with their new weights. Vertices of edges should
+	/// belong to the graph.
+	/// </param>
+	std::unique_ptr<SparseGraph> createGraphWithChangedEdges(std::vector<Edge> changedEdges) const;
+
+
+	/// <summary>
+	/// Computes checksum of compressed sparse rows (64-bit FNV-1a). It identifies
+	/// version of the graph, so data computed for the graph and saved next to it
+	/// is not used with other graph.
+	/// </summary>
+	std::uint64_t computeChecksum() const;
+
+
+	/// <summary>
+	/// Returns number of graph vertices.
+	/// </summary>
+	/// <returns>
+	/// Integer number that represents number of graph vertices.
+	/// </returns>
+	inline int getNumberOfVertices() const {
+		return m_offsetsView.empty() ? 0 : static_cast<int>(m_offsetsView.size()) - 1;
+	}
+
+
+	/// <summary>
+	/// Returns number of graph edges.
+	/// </summary>
+	/// <returns>
+	/// Integer number that represents number of graph edges.
+	/// </returns>
+	inline int getNumberOfEdges() const {
+		return static_cast<int>(m_targetsView.size());
+	}
+
+
+	/// <summary>
+	/// Returns vector of offsets - outgoing edges of vertex v are stored in
+	/// range [offsets[v], offsets[v + 1]) of targets and weights vectors.
+	/// </summary>
+	inline ArrayView<int> getOffsets() const {
+		return m_offsetsView;
+	}
+
+
+	/// <summary>
+	/// Returns vector of target vertices of all edges.
+	/// </summary>
+	inline ArrayView<int> getTargets() const {
+		return m_targetsView;
+	}
+
+
+	/// <summary>
+	/// Returns vector of weights of all edges.
+	/// </summary>
+	inline ArrayView<double> getWeights() const {
+		return m_weightsView;
+	}
+
+private:
+
+	/// <summary>
+	/// Sparse graph private constructor. It SHOULD NOT be used on it's
+	/// own - for creating instances in code, please use static factory methods.
+	/// </summary>
+	SparseGraph() = default;
+
+
+	/// <summary>
+	/// Creates sparse graph by compressing rows of adjacency matrix read one after
+	/// another - from text or binary file.
+	/// </summary>
+	static std::unique_ptr<SparseGraph> compressRowsOfMatrix(const std::string& filePath);
+
+
+	/// <summary>
+	/// Points views of arrays to vectors owned by the graph. Should be called
+	/// after vectors are filled.
+	/// </summary>
+	void useOwnedArrays();
+
+
+	std::vector<int> m_offsets;
+	std::vector<int> m_targets;
+	std::vector<double> m_weights;
+	std::unique_ptr<MappedFile> m_mappedFile;
+	ArrayView<int> m_offsetsView;
+	ArrayView<int> m_targetsView;
+	ArrayView<double> m_weightsView;
+
+};
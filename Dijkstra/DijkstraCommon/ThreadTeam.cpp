@@ -0,0 +1,98 @@
+#include "ThreadTeam.h"
+
+#include <algorithm>
+
+
+ThreadTeam::ThreadTeam(int numberOfThreads) : m_numberOfThreads(std::max(1, numberOfThreads)) {
+	for (int i = 1; i < m_numberOfThreads; ++i) {
+		m_threads.emplace_back(&ThreadTeam::waitForWork, this, i);
+	}
+}
+
+
+ThreadTeam::~ThreadTeam() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_shouldStop = true;
+		++m_workGeneration;
+	}
+	m_workAvailable.notify_all();
+	for (std::thread& thread : m_threads) {
+		thread.join();
+	}
+}
+
+
+void ThreadTeam::execute(const std::function<void(int)>& work) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_work = work;
+		m_numberOfThreadsFinished = 0;
+		++m_workGeneration;
+	}
+	m_workAvailable.notify_all();
+
+	// calling thread is a member of the team
+	work(0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_workFinished.wait(lock, [this]() { return m_numberOfThreadsFinished == m_numberOfThreads - 1; });
+}
+
+
+void ThreadTeam::synchronize() {
+	if (m_numberOfThreads == 1) {
+		return;
+	}
+
+	// last thread that reaches the barrier releases all others by starting new generation
+	unsigned generation = m_barrierGeneration.load(std::memory_order_acquire);
+	if (m_numberOfThreadsAtBarrier.fetch_add(1, std::memory_order_acq_rel) == m_numberOfThreads - 1) {
+		m_numberOfThreadsAtBarrier.store(0, std::memory_order_relaxed);
+		m_barrierGeneration.fetch_add(1, std::memory_order_release);
+	}
+	else {
+		while (m_barrierGeneration.load(std::memory_order_acquire) == generation) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+
+std::pair<int, int> ThreadTeam::computeSliceOfRange(const std::pair<int, int>& verticesRange, int numberOfThreads, int threadIndex) {
+	int rangeSize = verticesRange.second - verticesRange.first + 1;
+	int numberOfBlocks = (rangeSize + 63) / 64;
+	int averageNumberOfBlocksPerThread = numberOfBlocks / numberOfThreads;
+	int numberOfBlocksLeft = numberOfBlocks - averageNumberOfBlocksPerThread * numberOfThreads;
+
+	int firstBlock = threadIndex * averageNumberOfBlocksPerThread + std::min(threadIndex, numberOfBlocksLeft);
+	int numberOfBlocksForThread = averageNumberOfBlocksPerThread + (threadIndex < numberOfBlocksLeft ? 1 : 0);
+	int firstVertex = verticesRange.first + std::min(rangeSize, firstBlock * 64);
+	int lastVertex = verticesRange.first + std::min(rangeSize, (firstBlock + numberOfBlocksForThread) * 64) - 1;
+	return std::make_pair(firstVertex, lastVertex);
+}
+
+
+void ThreadTeam::waitForWork(int threadIndex) {
+	unsigned lastWorkGeneration = 0;
+	while (true) {
+		std::function<void(int)> work;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_workAvailable.wait(lock, [&]() { return m_workGeneration != lastWorkGeneration; });
+			lastWorkGeneration = m_workGeneration;
+			if (m_shouldStop) {
+				return;
+			}
+			work = m_work;
+		}
+
+		work(threadIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++m_numberOfThreadsFinished;
+		}
+		m_workFinished.notify_one();
+	}
+}
@@ -0,0 +1,131 @@
+/**
+*	@file ThreadTeam.h
+*	@brief This file contains persistent team of threads synchronized with
+*	barrier, used by multithreaded Dijkstra algorithm implementations.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Simple helper struct that places value in its own cache line, so threads
+/// writing to neighbouring values do not invalidate each other's caches.
+/// </summary>
+template <typename T>
+struct alignas(64) CacheLinePadded {
+
+	T value;
+
+};
+
+
+/// <summary>
+/// Persistent team of threads. Threads are created once, in constructor, and
+/// wait for work - function that each thread of the team runs with its own
+/// index. Calling thread always takes part in the work as thread 0, so only
+/// it should use MPI (MPI_THREAD_FUNNELED is enough). Inside the work, threads
+/// can wait for each other using synchronize method (barrier). Please note
+/// that this class is final - to use it, consider composition (not inheritance).
+/// </summary>
+class ThreadTeam final {
+
+public:
+
+	/// <summary>
+	/// Constructor of thread team. Starts numberOfThreads - 1 threads that wait
+	/// for work (calling thread is the last member of the team).
+	/// </summary>
+	/// <param name="numberOfThreads">
+	/// Number of threads in the team. Values lower than 1 are treated as 1.
+	/// </param>
+	explicit ThreadTeam(int numberOfThreads);
+
+
+	/// <summary>
+	/// Destructor - tells waiting threads to finish and joins them.
+	/// </summary>
+	~ThreadTeam();
+
+
+	ThreadTeam(const ThreadTeam&) = delete;
+	ThreadTeam& operator=(const ThreadTeam&) = delete;
+
+
+	/// <summary>
+	/// Returns number of threads in the team (including calling thread).
+	/// </summary>
+	inline int getNumberOfThreads() const {
+		return m_numberOfThreads;
+	}
+
+
+	/// <summary>
+	/// Runs given function on all threads of the team and waits until every
+	/// thread finishes it. Calling thread runs it with index 0.
+	/// </summary>
+	/// <param name="work">
+	/// Function that takes index of thread - number in range [0, numberOfThreads - 1].
+	/// </param>
+	void execute(const std::function<void(int)>& work);
+
+
+	/// <summary>
+	/// Barrier - waits until every thread of the team calls this method. Should
+	/// be called only inside function passed to execute method, by all threads.
+	/// </summary>
+	void synchronize();
+
+
+	/// <summary>
+	/// Static method responsible for dividing range of vertices between threads.
+	/// Every slice except the last one starts at multiple of 64 vertices (counted
+	/// from the beginning of the range), so threads never share a cache line of
+	/// distances nor a word of processed vertices bitmap.
+	/// </summary>
+	/// <returns>
+	/// Pair of integers that represents range of vertices given thread will
+	/// handle. This range can be written as [a, b] (it is closed) and can be
+	/// empty (b = a - 1).
+	/// </returns>
+	/// <param name="verticesRange">
+	/// Range of vertices [a, b] that should be divided.
+	/// </param>
+	/// <param name="numberOfThreads">
+	/// Number of threads that range is divided between.
+	/// </param>
+	/// <param name="threadIndex">
+	/// Index of thread that slice is computed for.
+	/// </param>
+	static std::pair<int, int> computeSliceOfRange(const std::pair<int, int>& verticesRange, int numberOfThreads, int threadIndex);
+
+private:
+
+	/// <summary>
+	/// Loop run by every thread except calling one - waits for work, does it and
+	/// reports that it is finished.
+	/// </summary>
+	void waitForWork(int threadIndex);
+
+
+	int m_numberOfThreads;
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_workFinished;
+	std::function<void(int)> m_work;
+	unsigned m_workGeneration = 0;
+	int m_numberOfThreadsFinished = 0;
+	bool m_shouldStop = false;
+
+	std::atomic<int> m_numberOfThreadsAtBarrier { 0 };
+	std::atomic<unsigned> m_barrierGeneration { 0 };
+
+};
@@ -0,0 +1,119 @@
+/**
+*	@file TransposedMatrixChunk.h
+*	@brief This file contains class that stores part of adjacency matrix
+*	arranged row-wise, so weights of edges leaving one vertex are continous.
+*/
+
+#pragma once
+
+#include "ArrayView.h"
+
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class stores part of adjacency matrix that contains columns of
+/// handled vertices, but - unlike column-wise 1D vector of weights - its
+/// data is arranged row-wise. Weights of edges that lead from given vertex 
+/// to all handled vertices are therefore stored next to each other, so
+/// inner loop of Dijkstra algorithm reads memory sequentially.
+/// <example>
+/// If handled part of matrix looks like this:
+/// <code>
+/// [ 2 3 ]
+/// [ 1 1 ]
+/// [ 0 1 ]
+/// </code>
+/// Data will look like this: [ 2 3 1 1 0 1 ]
+/// </example>
+/// Template parameter is type of weights (see WeightTraits) - most of the code
+/// uses TransposedMatrixChunk alias (double weights).
+/// </summary>
+template <typename WeightType>
+class BasicTransposedMatrixChunk final {
+
+public:
+
+	/// <summary>
+	/// Constructor that takes data which is already arranged row-wise.
+	/// </summary>
+	/// <param name="weights">
+	/// Vector of weights arranged row-wise. Its size should be equal to number
+	/// of handled vertices times total number of vertices.
+	/// </param>
+	/// <param name="numberOfHandledVertices">
+	/// Number of handled vertices - in other words, length of one row.
+	/// </param>
+	BasicTransposedMatrixChunk(std::vector<WeightType> weights, int numberOfHandledVertices)
+		: m_weights(std::move(weights)), m_numberOfHandledVertices(numberOfHandledVertices) {}
+
+
+	/// <summary>
+	/// Static factory method that creates chunk by transposing part of adjacency
+	/// matrix arranged column-wise (the form returned by AdjacencyMatrix).
+	/// </summary>
+	/// <returns>
+	/// Created chunk.
+	/// </returns>
+	/// <param name="columnWiseData">
+	/// Part of adjacency matrix arranged column-wise.
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Total number of vertices in processed graph - in other words, length of 
+	/// one column.
+	/// </param>
+	static BasicTransposedMatrixChunk fromColumnWiseData(const ArrayView<WeightType>& columnWiseData, int totalNumberOfVertices) {
+		int numberOfHandledVertices = totalNumberOfVertices > 0 ? static_cast<int>(columnWiseData.size()) / totalNumberOfVertices : 0;
+		std::vector<WeightType> weights(columnWiseData.size());
+		for (int i = 0; i < numberOfHandledVertices; ++i) {
+			for (int v = 0; v < totalNumberOfVertices; ++v) {
+				weights[static_cast<size_t>(v) * numberOfHandledVertices + i] = columnWiseData[static_cast<size_t>(i) * totalNumberOfVertices + v];
+			}
+		}
+		return BasicTransposedMatrixChunk(std::move(weights), numberOfHandledVertices);
+	}
+
+
+	/// <summary>
+	/// Returns pointer to continous row of weights of edges that lead from given
+	/// vertex to every handled vertex.
+	/// </summary>
+	/// <returns>
+	/// Pointer to first of numberOfHandledVertices weights.
+	/// </returns>
+	/// <param name="vertex">
+	/// Number of vertex (in the whole graph) that edges start from.
+	/// </param>
+	inline const WeightType* getWeightsOfEdgesLeavingVertex(int vertex) const {
+		return m_weights.data() + static_cast<size_t>(vertex) * m_numberOfHandledVertices;
+	}
+
+
+	/// <summary>
+	/// Returns number of handled vertices - in other words, length of one row.
+	/// </summary>
+	inline int getNumberOfHandledVertices() const {
+		return m_numberOfHandledVertices;
+	}
+
+
+	/// <summary>
+	/// Returns all weights arranged row-wise. If chunk contains whole matrix, the
+	/// same data read column-wise is adjacency matrix of reversed graph.
+	/// </summary>
+	inline ArrayView<WeightType> getWeights() const {
+		return m_weights;
+	}
+
+private:
+
+	std::vector<WeightType> m_weights;
+	int m_numberOfHandledVertices;
+
+};
+
+
+/// <summary>
+/// Transposed chunk of adjacency matrix with double weights - the one used by default.
+/// </summary>
+using TransposedMatrixChunk = BasicTransposedMatrixChunk<double>;
@@ -1,7 +1,10 @@
 #include "Validator.h"
 
 #include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <algorithm>
+#include <sstream>
 #include <string>
 
 std::pair<bool, const char*> Validator::validateCommandLineArguments(int argc, char* argv[]) {
@@ -9,12 +12,7 @@ std::pair<bool, const char*> Validator::validateCommandLineArguments(int argc, c
 		return std::make_pair(false, "Too few command line arguments.");
 	}
 
-	std::string firstArgument = argv[1];
-	bool isFirstArgumentAPositiveNumber = !firstArgument.empty()
-		&& std::find_if(firstArgument.begin(), firstArgument.end(),
-			[](unsigned char c) { return !std::isdigit(c); }) == firstArgument.end();
-
-	if (!isFirstArgumentAPositiveNumber) {
+	if (!checkIfTextIsANumber(argv[1])) {
 		return std::make_pair(false, "First command line argument should be a positive number.");
 	}
 
@@ -30,4 +28,136 @@ std::pair<bool, const char*> Validator::validateVerticesNumbers(int totalNumberO
 		return std::make_pair(false, "This source vertex is not valid. Exiting.");
 	}
 	else return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateNumberOfThreads(const std::string& numberOfThreads) {
+	if (!checkIfTextIsANumber(numberOfThreads) || numberOfThreads.size() > 4 || std::stoi(numberOfThreads) == 0) {
+		return std::make_pair(false, "Number of threads should be a positive number.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateBucketWidth(const std::string& bucketWidth) {
+	char* end = nullptr;
+	double value = std::strtod(bucketWidth.c_str(), &end);
+	if (bucketWidth.empty() || *end != '\0' || !(value > 0) || std::isinf(value)) {
+		return std::make_pair(false, "Bucket width should be a positive number.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateSourceVertices(const std::string& sourceVertices) {
+	std::stringstream sources(sourceVertices);
+	std::string source;
+	while (std::getline(sources, source, ',')) {
+		if (!checkIfTextIsANumber(source) || source.size() > 9) {
+			return std::make_pair(false, "Source vertices should be positive numbers separated with commas.");
+		}
+	}
+	if (sourceVertices.empty() || sourceVertices.back() == ',') {
+		return std::make_pair(false, "Source vertices should be positive numbers separated with commas.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateConverterCommandLineArguments(int argc, char* argv[]) {
+	if (argc < 3) {
+		return std::make_pair(false, "Too few command line arguments.");
+	}
+
+	if (std::string(argv[1]).compare(0, 2, "--") == 0 || std::string(argv[2]).compare(0, 2, "--") == 0) {
+		return std::make_pair(false, "First two command line arguments should be paths to input and output files.");
+	}
+
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validatePathsCommandLineArguments(int argc, char* argv[]) {
+	if (argc < 3) {
+		return std::make_pair(false, "Too few command line arguments.");
+	}
+
+	if (std::string(argv[1]).compare(0, 2, "--") == 0) {
+		return std::make_pair(false, "First command line argument should be path to results file.");
+	}
+
+	bool targetsArePresent = false;
+	for (int i = 2; i < argc; ++i) {
+		std::string argument = argv[i];
+		if (argument.compare(0, 10, "--targets=") == 0) {
+			targetsArePresent = targetsArePresent || argument.size() > 10;
+		}
+		else if (argument.compare(0, 2, "--") != 0) {
+			if (!checkIfTextIsANumber(argument) || argument.size() > 9) {
+				return std::make_pair(false, "Target vertices should be non-negative numbers.");
+			}
+			targetsArePresent = true;
+		}
+	}
+	if (!targetsArePresent) {
+		return std::make_pair(false, "Target vertices should be given after results file or as --targets=FILE.");
+	}
+
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateNumberOfBlocks(const std::string& numberOfBlocks) {
+	if (!checkIfTextIsANumber(numberOfBlocks) || numberOfBlocks.size() > 5 || std::stoi(numberOfBlocks) == 0) {
+		return std::make_pair(false, "Number of blocks should be a positive number.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateWeightType(const std::string& weightType) {
+	if (weightType != "double" && weightType != "float" && weightType != "uint16") {
+		return std::make_pair(false, "Type of weights should be double, float or uint16.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateBalanceMode(const std::string& balanceMode) {
+	if (balanceMode != "edges" && balanceMode != "measured" && balanceMode != "partition") {
+		return std::make_pair(false, "Mode of balancing should be given as --balance=edges, --balance=measured or --balance=partition.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateTargetVertex(const std::string& targetVertex) {
+	if (!checkIfTextIsANumber(targetVertex) || targetVertex.size() > 9) {
+		return std::make_pair(false, "Target vertex should be given as --target=VERTEX.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateNumberOfLandmarks(const std::string& numberOfLandmarks) {
+	if (!checkIfTextIsANumber(numberOfLandmarks) || numberOfLandmarks.size() > 2 || std::stoi(numberOfLandmarks) == 0
+		|| std::stoi(numberOfLandmarks) > 64) {
+		return std::make_pair(false, "Number of landmarks should be a number from 1 to 64.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+std::pair<bool, const char*> Validator::validateSizeOfBatch(const std::string& sizeOfBatch) {
+	if (!checkIfTextIsANumber(sizeOfBatch) || sizeOfBatch.size() > 7 || std::stoi(sizeOfBatch) == 0 || std::stoi(sizeOfBatch) > 1000000) {
+		return std::make_pair(false, "Size of batch of changes should be a number from 1 to 1000000.");
+	}
+	return std::make_pair(true, "");
+}
+
+
+bool Validator::checkIfTextIsANumber(const std::string& text) {
+	return !text.empty()
+		&& std::find_if(text.begin(), text.end(),
+			[](unsigned char c) { return !std::isdigit(c); }) == text.end();
 }
\ No newline at end of file
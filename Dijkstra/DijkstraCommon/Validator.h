@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <string>
 #include <utility>
 
 /// <summary>
@@ -62,4 +63,184 @@ public:
 	/// </param>
 	static std::pair<bool, const char*> validateVerticesNumbers(int totalNumberOfVertices, int sourceVertexIndex);
 
+
+	/// <summary>
+	/// Simple validator of number of threads given by user in <c>--threads</c> option.
+	/// It should be a number greater than 0.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// number of threads is valid. String contains error message. If
+	/// it is valid, this string is empty.
+	/// </returns>
+	/// <param name="numberOfThreads">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateNumberOfThreads(const std::string& numberOfThreads);
+
+
+	/// <summary>
+	/// Simple validator of bucket width given by user in <c>--delta-stepping</c> option.
+	/// It should be a number greater than 0 (fractions are allowed).
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// bucket width is valid. String contains error message. If
+	/// it is valid, this string is empty.
+	/// </returns>
+	/// <param name="bucketWidth">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateBucketWidth(const std::string& bucketWidth);
+
+
+	/// <summary>
+	/// Simple validator of source vertices given by user in <c>--sources</c> option.
+	/// It should be a list of non-negative numbers separated with commas.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// list of source vertices is valid. String contains error message. If
+	/// it is valid, this string is empty.
+	/// </returns>
+	/// <param name="sourceVertices">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateSourceVertices(const std::string& sourceVertices);
+
+
+	/// <summary>
+	/// Simple command line arguments validator of graph converter. User should provide
+	/// at least two arguments - paths to input and output files.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// command line arguments are valid. String contains error message. If
+	/// arguments are valid, this string is empty.
+	/// </returns>
+	/// <param name="argc">
+	/// Number of command line arguments.
+	/// </param>
+	/// <param name="argv">
+	/// C-style array with command line arguments, passed directly from main function.
+	/// </param>
+	static std::pair<bool, const char*> validateConverterCommandLineArguments(int argc, char* argv[]);
+
+
+	/// <summary>
+	/// Simple command line arguments validator of path extraction tool. User should
+	/// provide path to results file and target vertices - as numbers that follow it or
+	/// in file given in <c>--targets</c> option.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// command line arguments are valid. String contains error message. If
+	/// arguments are valid, this string is empty.
+	/// </returns>
+	/// <param name="argc">
+	/// Number of command line arguments.
+	/// </param>
+	/// <param name="argv">
+	/// C-style array with command line arguments, passed directly from main function.
+	/// </param>
+	static std::pair<bool, const char*> validatePathsCommandLineArguments(int argc, char* argv[]);
+
+
+	/// <summary>
+	/// Simple validator of number of column blocks given by user in <c>--blocks</c> option.
+	/// It should be a number greater than 0.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// number of blocks is valid. String contains error message. If
+	/// it is valid, this string is empty.
+	/// </returns>
+	/// <param name="numberOfBlocks">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateNumberOfBlocks(const std::string& numberOfBlocks);
+
+
+	/// <summary>
+	/// Simple validator of type of weights given by user in <c>--weights</c> option.
+	/// It should be double, float or uint16.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// type of weights is valid. String contains error message. If
+	/// it is valid, this string is empty.
+	/// </returns>
+	/// <param name="weightType">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateWeightType(const std::string& weightType);
+
+
+	/// <summary>
+	/// Simple validator of mode of balancing given by user in <c>--balance</c> option.
+	/// It should be edges, measured or partition.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// mode of balancing is valid. String contains error message. If
+	/// it is valid, this string is empty.
+	/// </returns>
+	/// <param name="balanceMode">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateBalanceMode(const std::string& balanceMode);
+
+
+	/// <summary>
+	/// Simple validator of target vertex given by user in <c>--target</c> option.
+	/// It should be a number - whether such vertex exists is checked later, by
+	/// validateVerticesNumbers.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// target vertex is valid. String contains error message. If
+	/// it is valid, this string is empty.
+	/// </returns>
+	/// <param name="targetVertex">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateTargetVertex(const std::string& targetVertex);
+
+
+	/// <summary>
+	/// Simple validator of number of landmarks given by user in <c>--build-landmarks</c>
+	/// option. It should be a number from 1 to 64.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// number of landmarks is valid. String contains error message. If
+	/// it is valid, this string is empty.
+	/// </returns>
+	/// <param name="numberOfLandmarks">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateNumberOfLandmarks(const std::string& numberOfLandmarks);
+
+
+	/// <summary>
+	/// Simple validator of maximal size of batch of changes given by user in
+	/// <c>--benchmark-updates</c> option. It should be a number from 1 to 1000000.
+	/// </summary>
+	/// <returns>
+	/// Pair with boolean and C-style const string. Boolean indicates if 
+	/// size of batch is valid. String contains error message. If it is
+	/// valid, this string is empty.
+	/// </returns>
+	/// <param name="sizeOfBatch">
+	/// Value of the option, as given in command line.
+	/// </param>
+	static std::pair<bool, const char*> validateSizeOfBatch(const std::string& sizeOfBatch);
+
+private:
+
+	/// <summary>
+	/// Checks if text is not empty and contains only digits.
+	/// </summary>
+	static bool checkIfTextIsANumber(const std::string& text);
+
 };
\ No newline at end of file
@@ -10,19 +10,40 @@
 
 /// <summary>
 /// Simple helper struct that contains current data about distance 
-/// from source vertex as well as number of vertex. Please do not
+/// from source vertex as well as number of vertex. Template parameter
+/// is type of distance - most of the code uses VertexData alias (double
+/// distance). Please do not
 /// create instances of this struct on your own - use function 
 /// createVertexDataInstance instead - it initializes struct properties
 /// to default values.
 /// </summary>
-struct VertexData {
+template <typename DistanceType>
+struct BasicVertexData {
 
-	double distance;
+	DistanceType distance;
 	int vertexNumber;
 
 };
 
 
+/// <summary>
+/// Vertex data used by all algorithm implementations by default.
+/// </summary>
+using VertexData = BasicVertexData<double>;
+
+
+/// <summary>
+/// Returns value that represents infinite distance - infinity for floating
+/// point types and maximal value for integer types.
+/// </summary>
+template <typename DistanceType>
+constexpr DistanceType infiniteDistance() {
+	return std::numeric_limits<DistanceType>::has_infinity 
+		? std::numeric_limits<DistanceType>::infinity() 
+		: std::numeric_limits<DistanceType>::max();
+}
+
+
 /// <summary>
 /// Creates instance of VertexData structure. Takes two input arguments,
 /// if any of them is not given, uses default values.
@@ -38,6 +59,34 @@ struct VertexData {
 /// Number of vertex. If not given, this functions sets it to default
 /// value of -1.
 /// </param>
-inline VertexData createVertexDataInstance(double distance = std::numeric_limits<double>::infinity(), int number = -1) {
-	return VertexData { distance, number };
+template <typename DistanceType = double>
+inline BasicVertexData<DistanceType> createVertexDataInstance(DistanceType distance = infiniteDistance<DistanceType>(), int number = -1) {
+	return BasicVertexData<DistanceType> { distance, number };
+}
+
+
+/// <summary>
+/// Checks if candidate should replace current predecessor of a vertex that both of
+/// them reach with equal distance. Predecessor with smaller distance from source vertex
+/// wins, then the one with smaller number - algorithm that processes one vertex per
+/// iteration takes vertices in this order and keeps the first predecessor, so all
+/// implementations that relax edges in other order choose the same paths.
+/// </summary>
+/// <returns>
+/// Boolean that indicates if candidate is preferred.
+/// </returns>
+/// <param name="candidateDistance">
+/// Distance from source vertex to candidate.
+/// </param>
+/// <param name="candidate">
+/// Number of candidate vertex.
+/// </param>
+/// <param name="predecessorDistance">
+/// Distance from source vertex to current predecessor.
+/// </param>
+/// <param name="predecessor">
+/// Number of current predecessor.
+/// </param>
+inline bool checkIfPredecessorIsPreferred(double candidateDistance, int candidate, double predecessorDistance, int predecessor) {
+	return candidateDistance < predecessorDistance || (candidateDistance == predecessorDistance && candidate < predecessor);
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "VertexHeap.h"
+
+
+void VertexHeap::insertOrDecreaseKey(int vertex, double distance) {
+	if (m_positions[vertex] == -1) {
+		m_heap.push_back(createVertexDataInstance(distance, vertex));
+		m_positions[vertex] = static_cast<int>(m_heap.size()) - 1;
+	}
+	else {
+		m_heap[m_positions[vertex]].distance = distance;
+	}
+	moveUp(m_positions[vertex]);
+}
+
+
+VertexData VertexHeap::extractMin() {
+	VertexData minimum = m_heap.front();
+	m_positions[minimum.vertexNumber] = -1;
+
+	VertexData last = m_heap.back();
+	m_heap.pop_back();
+	if (!m_heap.empty()) {
+		place(last, 0);
+		moveDown(0);
+	}
+	return minimum;
+}
+
+
+void VertexHeap::moveUp(int position) {
+	VertexData entry = m_heap[position];
+	while (position > 0) {
+		int parent = (position - 1) / arity;
+		if (!isLess(entry, m_heap[parent])) {
+			break;
+		}
+		place(m_heap[parent], position);
+		position = parent;
+	}
+	place(entry, position);
+}
+
+
+void VertexHeap::moveDown(int position) {
+	VertexData entry = m_heap[position];
+	int size = static_cast<int>(m_heap.size());
+	while (true) {
+
+		// find smallest child
+		int firstChild = position * arity + 1;
+		if (firstChild >= size) {
+			break;
+		}
+		int smallestChild = firstChild;
+		int lastChild = firstChild + arity < size ? firstChild + arity : size;
+		for (int child = firstChild + 1; child < lastChild; ++child) {
+			if (isLess(m_heap[child], m_heap[smallestChild])) {
+				smallestChild = child;
+			}
+		}
+
+		if (!isLess(m_heap[smallestChild], entry)) {
+			break;
+		}
+		place(m_heap[smallestChild], position);
+		position = smallestChild;
+	}
+	place(entry, position);
+}
+
+
+void VertexHeap::place(const VertexData& entry, int position) {
+	m_heap[position] = entry;
+	m_positions[entry.vertexNumber] = position;
+}
@@ -0,0 +1,112 @@
+/**
+*	@file VertexHeap.h
+*	@brief This file contains addressable priority queue of vertices used
+*	by heap-based Dijkstra algorithm implementations.
+*/
+
+#pragma once
+
+#include "VertexData.h"
+
+#include <vector>
+
+/// <summary>
+/// Addressable 4-ary min-heap of vertices ordered by distance. Position of
+/// every vertex in the heap is remembered, so its distance can be decreased
+/// in logarithmic time. Vertices with equal distances are ordered by vertex
+/// number - so vertices are extracted in exactly the same order in which
+/// DijkstraAlgorithmBackend::findVertexWithMinimalDistanceToCluster finds them.
+/// </summary>
+class VertexHeap final {
+
+public:
+
+	/// <summary>
+	/// Constructor of vertex heap. Prepares empty heap that can store vertices
+	/// numbered from 0 to numberOfVertices - 1.
+	/// </summary>
+	/// <param name="numberOfVertices">
+	/// Total number of vertices in processed graph.
+	/// </param>
+	explicit VertexHeap(int numberOfVertices) : m_positions(numberOfVertices, -1) {}
+
+
+	/// <summary>
+	/// Checks if there are no vertices in the heap.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if heap is empty.
+	/// </returns>
+	inline bool isEmpty() const {
+		return m_heap.empty();
+	}
+
+
+	/// <summary>
+	/// Checks if given vertex is currently stored in the heap.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if vertex is in the heap.
+	/// </returns>
+	/// <param name="vertex">
+	/// Number of checked vertex.
+	/// </param>
+	inline bool contains(int vertex) const {
+		return m_positions[vertex] != -1;
+	}
+
+
+	/// <summary>
+	/// Returns vertex with minimal distance without removing it. Heap must not
+	/// be empty.
+	/// </summary>
+	/// <returns>
+	/// Distance and number of vertex at the top of the heap.
+	/// </returns>
+	inline const VertexData& getMin() const {
+		return m_heap.front();
+	}
+
+
+	/// <summary>
+	/// Inserts vertex into the heap or - if it is already there - sets its
+	/// distance to the new one. New distance should not be bigger than the
+	/// current one.
+	/// </summary>
+	/// <param name="vertex">
+	/// Number of vertex.
+	/// </param>
+	/// <param name="distance">
+	/// New distance of vertex.
+	/// </param>
+	void insertOrDecreaseKey(int vertex, double distance);
+
+
+	/// <summary>
+	/// Removes vertex with the smallest distance from the heap. Heap should not
+	/// be empty.
+	/// </summary>
+	/// <returns>
+	/// VertexData structure with removed vertex number and its distance.
+	/// </returns>
+	VertexData extractMin();
+
+private:
+
+	/// <summary>
+	/// Compares two heap entries - by distance first, then by vertex number.
+	/// </summary>
+	static inline bool isLess(const VertexData& lhs, const VertexData& rhs) {
+		return lhs.distance < rhs.distance || (lhs.distance == rhs.distance && lhs.vertexNumber < rhs.vertexNumber);
+	}
+
+	void moveUp(int position);
+	void moveDown(int position);
+	void place(const VertexData& entry, int position);
+
+	static constexpr int arity = 4;
+
+	std::vector<VertexData> m_heap;
+	std::vector<int> m_positions;
+
+};
@@ -0,0 +1,142 @@
+/**
+*	@file WeightTraits.h
+*	@brief This file contains traits of types that can be used to store
+*	weights of edges in dense Dijkstra algorithm implementations.
+*/
+
+#pragma once
+
+#include "ArrayView.h"
+#include "VertexData.h"
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Traits of weight type - type of distances computed from such weights, test
+/// that tells if weight represents an edge and conversion from double weights
+/// read from file. Specializations exist for double (default), float (half of
+/// memory traffic) and std::uint16_t (quarter of memory traffic, for graphs
+/// with integer weights). All of them are resolved at compile time, so there
+/// are no runtime branches in hot loops.
+/// </summary>
+template <typename WeightType>
+struct WeightTraits;
+
+
+template <>
+struct WeightTraits<double> {
+
+	using DistanceType = double;
+
+	static constexpr const char* name = "double";
+
+	/// <summary>
+	/// Weights lower than 0.001 are treated as no edge.
+	/// </summary>
+	static inline bool checkIfIsEdge(double weight) {
+		return !(weight < 0.001);
+	}
+
+	static inline bool convertWeight(double weight, double& convertedWeight) {
+		convertedWeight = weight;
+		return true;
+	}
+
+};
+
+
+template <>
+struct WeightTraits<float> {
+
+	using DistanceType = float;
+
+	static constexpr const char* name = "float";
+
+	/// <summary>
+	/// Weights lower than 0.001 are treated as no edge.
+	/// </summary>
+	static inline bool checkIfIsEdge(float weight) {
+		return !(weight < 0.001f);
+	}
+
+	static inline bool convertWeight(double weight, float& convertedWeight) {
+		convertedWeight = weight < 0.001 ? 0.0f : static_cast<float>(weight);
+		return true;
+	}
+
+};
+
+
+template <>
+struct WeightTraits<std::uint16_t> {
+
+	/// <summary>
+	/// Distances are sums of many weights, so they need wider type.
+	/// </summary>
+	using DistanceType = std::uint64_t;
+
+	static constexpr const char* name = "uint16";
+
+	/// <summary>
+	/// Weight 0 is treated as no edge.
+	/// </summary>
+	static inline bool checkIfIsEdge(std::uint16_t weight) {
+		return weight != 0;
+	}
+
+	/// <summary>
+	/// Only integer weights in range [1, 65535] (and "no edge" weights) can be
+	/// stored without changing results.
+	/// </summary>
+	static inline bool convertWeight(double weight, std::uint16_t& convertedWeight) {
+		convertedWeight = 0;
+		if (weight < 0.001) {
+			return true;
+		}
+		if (weight != std::floor(weight) || weight > 65535.0) {
+			return false;
+		}
+		convertedWeight = static_cast<std::uint16_t>(weight);
+		return true;
+	}
+
+};
+
+
+/// <summary>
+/// Converts weights read from file (doubles) to given weight type.
+/// </summary>
+/// <returns>
+/// Boolean that indicates if all weights could be converted without changing
+/// results of the algorithm.
+/// </returns>
+template <typename WeightType>
+inline bool convertWeights(const ArrayView<double>& weights, std::vector<WeightType>& convertedWeights) {
+	convertedWeights.resize(weights.size());
+	bool allConverted = true;
+	for (size_t i = 0; i < weights.size(); ++i) {
+		allConverted &= WeightTraits<WeightType>::convertWeight(weights[i], convertedWeights[i]);
+	}
+	return allConverted;
+}
+
+
+/// <summary>
+/// Converts results of the algorithm computed with any distance type to doubles,
+/// which are printed by ResultsPrinter. Infinite distances stay infinite.
+/// </summary>
+template <typename DistanceType>
+inline std::pair<const std::vector<double>, const std::vector<int>> convertDistancesToDoubles(
+	const std::pair<const std::vector<DistanceType>, const std::vector<int>>& results) {
+
+	std::vector<double> distances(results.first.size());
+	for (size_t i = 0; i < distances.size(); ++i) {
+		distances[i] = results.first[i] == infiniteDistance<DistanceType>()
+			? infiniteDistance<double>()
+			: static_cast<double>(results.first[i]);
+	}
+	return std::make_pair(std::move(distances), results.second);
+}
@@ -0,0 +1,92 @@
+#include "AdjacencyMatrix.h"
+#include "BinaryGraphFile.h"
+#include "SparseGraph.h"
+#include "Log.h"
+#include "CommandLineArgumentsExtractor.h"
+#include "Validator.h"
+
+#include <chrono>
+#include <iostream>
+
+#ifndef SHOULD_LOG
+#define SHOULD_LOG true
+#endif // !SHOULD_LOG
+
+
+int main(int argc, char* argv[]) {
+
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	// prepare Log class - initialize it with reference to standard output
+	Log<SHOULD_LOG> log(std::cout);
+
+	// validate command line arguments
+	auto validationResult = Validator::validateConverterCommandLineArguments(argc, argv);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		log.logMessage("Usage: DijkstraConverter INPUT OUTPUT [--sparse] [--edge-list] [--blocks=K]");
+		return 0;
+	}
+
+	// read data from command line arguments
+	std::string inputFilePath = argv[1];
+	std::string outputFilePath = argv[2];
+	bool inputIsEdgeList = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--edge-list");
+	bool useBlocks = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--blocks");
+	bool useSparseGraph = inputIsEdgeList || useBlocks || CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--sparse");
+	std::string numberOfBlocksOption = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--blocks", "");
+
+	if (useBlocks) {
+		validationResult = Validator::validateNumberOfBlocks(numberOfBlocksOption);
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			return 0;
+		}
+	}
+
+	// read graph data from file - text or binary
+	std::unique_ptr<AdjacencyMatrix> matrix;
+	std::unique_ptr<SparseGraph> sparseGraph;
+	int totalNumberOfVertices = 0;
+	if (useSparseGraph) {
+		sparseGraph = inputIsEdgeList ? SparseGraph::fromEdgeListFile(inputFilePath) : SparseGraph::fromFile(inputFilePath);
+		totalNumberOfVertices = sparseGraph->getNumberOfVertices();
+	}
+	else {
+		matrix = AdjacencyMatrix::fromFile(inputFilePath);
+		totalNumberOfVertices = matrix->getNumberOfVertices();
+	}
+
+	// perform additional validation
+	validationResult = Validator::validateVerticesNumbers(totalNumberOfVertices, 0);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		return 0;
+	}
+
+	auto tBeforeWriting = std::chrono::high_resolution_clock::now();
+
+	// write graph in binary format
+	bool written = false;
+	if (useSparseGraph) {
+		int numberOfBlocks = useBlocks ? std::stoi(numberOfBlocksOption) : 0;
+		log.logMessage("Writing sparse graph with ", totalNumberOfVertices, " vertices, ", sparseGraph->getNumberOfEdges(), " edges and ", numberOfBlocks, " column blocks");
+		written = BinaryGraphFile::writeSparseGraph(outputFilePath, *sparseGraph, numberOfBlocks);
+	}
+	else {
+		log.logMessage("Writing dense graph with ", totalNumberOfVertices, " vertices");
+		written = BinaryGraphFile::writeDenseGraph(outputFilePath, *matrix);
+	}
+
+	auto tEnd = std::chrono::high_resolution_clock::now();
+
+	// log information about elapsed time
+	if (written) {
+		std::chrono::duration<double> diffRead = tBeforeWriting - tStart;
+		std::chrono::duration<double> diffWrite = tEnd - tBeforeWriting;
+		log.logMessage("Reading input took: ", diffRead.count(), "s");
+		log.logMessage("Writing ", outputFilePath, " took: ", diffWrite.count(), "s");
+	}
+
+	return 0;
+}
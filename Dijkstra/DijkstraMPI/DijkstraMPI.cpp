@@ -1,28 +1,119 @@
 #include "DijkstraMPI.h"
 
-std::pair<const std::vector<double>, const std::vector<int>> DijkstraMPI::run(MPI_Comm& communicator) {
+#include <chrono>
 
-	// while there are any vertices that have not been processed
-	while (!m_dijkstraBackend.checkIfAllVerticesHaveBeenProcessed()) {
+template <typename GraphDataType>
+std::pair<const std::vector<typename DijkstraMPI<GraphDataType>::DistanceType>, const std::vector<int>> DijkstraMPI<GraphDataType>::run(MPI_Comm& communicator) {
 
-		// vertex that belongs to current node and is closest to cluster of already processed vertices
-		VertexData localMin = m_dijkstraBackend.findVertexWithMinimalDistanceToCluster();
+	MPI_Datatype vertexDataDatatype = MPITypeTraits<VertexDataType>::getDatatype();
+	MPI_Op minimumOperation = MPITypeTraits<VertexDataType>::getMinimumOperation();
+	return runWithReduction([&](const VertexDataType& localMin) {
+		VertexDataType globalMin;
+		MPI_Allreduce(&localMin, &globalMin, 1, vertexDataDatatype, minimumOperation, communicator);
+		return globalMin;
+	});
+}
 
-		// gather all local closest vertices and compute global one
-		VertexData globalMin = createVertexDataInstance();
-		MPI_Allreduce(&localMin, &globalMin, 1, MPI_DOUBLE_INT, MPI_MINLOC, communicator);
 
-		// safety check - if there was no valid closest vertex, we need to exit loop now
-		if (globalMin.vertexNumber == -1) {
-			break;
-		}
+template <typename GraphDataType>
+std::pair<const std::vector<typename DijkstraMPI<GraphDataType>::DistanceType>, const std::vector<int>> DijkstraMPI<GraphDataType>::run(NodeSharedMemory& nodeSharedMemory) {
+	return runWithReduction([&](const VertexDataType& localMin) {
+		return nodeSharedMemory.reduceMinimum(localMin);
+	});
+}
+
+
+template <typename GraphDataType>
+double DijkstraMPI<GraphDataType>::measureTimeOfLocalWork(MPI_Comm& communicator) {
+
+	MPI_Datatype vertexDataDatatype = MPITypeTraits<VertexDataType>::getDatatype();
+	MPI_Op minimumOperation = MPITypeTraits<VertexDataType>::getMinimumOperation();
+	std::chrono::duration<double> timeOfReductions(0);
+	auto tStart = std::chrono::high_resolution_clock::now();
+	runWithReduction([&](const VertexDataType& localMin) {
+		auto tBeforeReduction = std::chrono::high_resolution_clock::now();
+		VertexDataType globalMin;
+		MPI_Allreduce(&localMin, &globalMin, 1, vertexDataDatatype, minimumOperation, communicator);
+		timeOfReductions += std::chrono::high_resolution_clock::now() - tBeforeReduction;
+		return globalMin;
+	});
+	std::chrono::duration<double> timeOfRun = std::chrono::high_resolution_clock::now() - tStart;
+	return (timeOfRun - timeOfReductions).count();
+}
+
+
+template <typename GraphDataType>
+template <typename ReductionFunction>
+std::pair<const std::vector<typename DijkstraMPI<GraphDataType>::DistanceType>, const std::vector<int>> DijkstraMPI<GraphDataType>::runWithReduction(
+	ReductionFunction computeGlobalMinimum) {
+
+	int numberOfThreads = m_threadTeam.getNumberOfThreads();
+	std::vector<CacheLinePadded<VertexDataType>> localMinimaOfThreads(numberOfThreads);
+	VertexDataType globalMin = createVertexDataInstance<DistanceType>();
+
+	m_threadTeam.execute([&](int threadIndex) {
+
+		// every thread handles its own slice of vertices handled by this process
+		std::pair<int, int> handledVerticesSlice = ThreadTeam::computeSliceOfRange(m_verticesToHandleRange, numberOfThreads, threadIndex);
+
+		// vertex that belongs to current thread and is closest to cluster of already processed vertices
+		localMinimaOfThreads[threadIndex].value = m_dijkstraBackend.findVertexWithMinimalDistanceToCluster(handledVerticesSlice);
 
-		// mark vertex as processed
-		m_dijkstraBackend.markVertexAsProcessed(globalMin.vertexNumber);
+		while (true) {
+			m_threadTeam.synchronize();
 
-		// inner loop - computing new distances
-		m_dijkstraBackend.performInnerForLoop(globalMin, m_graphData);
-	}
+			// only thread 0 communicates with other processes and modifies cluster of processed vertices
+			if (threadIndex == 0) {
+				globalMin = createVertexDataInstance<DistanceType>();
+
+				// while there are any vertices that have not been processed
+				if (!m_dijkstraBackend.checkIfAllVerticesHaveBeenProcessed()) {
+
+					// combine local closest vertices of threads - slices are ordered, so ties go to smaller vertex
+					VertexDataType localMin = localMinimaOfThreads[0].value;
+					for (int i = 1; i < numberOfThreads; ++i) {
+						if (localMinimaOfThreads[i].value.distance < localMin.distance) {
+							localMin = localMinimaOfThreads[i].value;
+						}
+					}
+
+					// gather all local closest vertices and compute global one
+					globalMin = computeGlobalMinimum(localMin);
+
+					// mark vertex as processed
+					if (globalMin.vertexNumber != -1) {
+						m_dijkstraBackend.markVertexAsProcessed(globalMin.vertexNumber);
+					}
+
+					// result of reduction is the same in every process, so reaching target vertex is global stop
+					// signal - invalid closest vertex ends the loop everywhere without additional communication
+					if (globalMin.vertexNumber != -1 && globalMin.vertexNumber == m_targetVertexIndex) {
+						globalMin = createVertexDataInstance<DistanceType>();
+					}
+				}
+			}
+			m_threadTeam.synchronize();
+
+			// safety check - if there was no valid closest vertex (or all vertices have been processed), we need to exit loop now
+			if (globalMin.vertexNumber == -1) {
+				break;
+			}
+
+			// inner loop - computing new distances and finding local closest vertex for the next iteration
+			localMinimaOfThreads[threadIndex].value = m_dijkstraBackend.performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(globalMin, 
+				m_graphData, handledVerticesSlice);
+		}
+	});
 
 	return std::make_pair(m_dijkstraBackend.getDistances(), m_dijkstraBackend.getPredecessors());
-}
\ No newline at end of file
+}
+
+
+template class DijkstraMPI<std::vector<double>>;
+template class DijkstraMPI<ArrayView<double>>;
+template class DijkstraMPI<SparseGraph>;
+template class DijkstraMPI<TransposedMatrixChunk>;
+template class DijkstraMPI<std::vector<float>>;
+template class DijkstraMPI<std::vector<std::uint16_t>>;
+template class DijkstraMPI<BasicTransposedMatrixChunk<float>>;
+template class DijkstraMPI<BasicTransposedMatrixChunk<std::uint16_t>>;
\ No newline at end of file
@@ -6,16 +6,32 @@
 #pragma once
 
 #include "DijkstraAlgorithmBackend.h"
+#include "MPITypeTraits.h"
+#include "NodeSharedMemory.h"
+#include "ThreadTeam.h"
 #include "mpi.h"
 
 /// <summary>
 /// This class contains Dijkstra algorithm implementation created using MPI.
-/// It uses DijkstraAlgorithmBackend class. 
+/// It uses DijkstraAlgorithmBackend class. Template parameter is type of
+/// graph representation - it can be part of adjacency matrix in form of 1D
+/// vector of weights, TransposedMatrixChunk or part of SparseGraph. Handled
+/// vertices can be additionally divided between threads of the process - they
+/// combine their local minima in shared memory, so every process still takes
+/// part in only one MPI_Allreduce per iteration (or in hierarchical reduction of
+/// NodeSharedMemory, when processes of a node share their part of the graph). MPI
+/// datatype and reduction of closest vertices are chosen for type of distances by
+/// MPITypeTraits.
 /// </summary>
+template <typename GraphDataType>
 class DijkstraMPI
 {
 public:
 
+	using BackendType = BasicDijkstraAlgorithmBackend<typename GraphWeightType<GraphDataType>::Type>;
+	using DistanceType = typename BackendType::DistanceType;
+	using VertexDataType = typename BackendType::VertexDataType;
+
 	/// <summary>
 	/// DijkstraMPI class constructor. Prepares all class properties (adjacency
 	/// matrix chunk and algorithm backend).
@@ -32,12 +48,23 @@ public:
 	/// Integer number that represents index of source vertex. 
 	/// </param>
 	/// <param name="graphData">
-	/// Part of adjacency matrix that is being processed by this object - it should be
-	/// passed in a form of 1D vector of weights. Data from matrix should be aranged 
-	/// column-wise.
+	/// Part of graph that is being processed by this object - part of adjacency matrix
+	/// in a form of 1D vector of weights (data from matrix should be aranged column-wise)
+	/// or sparse graph that contains edges leading to handled vertices.
+	/// </param>
+	/// <param name="numberOfThreads">
+	/// Number of threads that handle vertices of this process. Only the calling thread
+	/// uses MPI, so MPI should be initialized with at least MPI_THREAD_FUNNELED.
 	/// </param>
-	DijkstraMPI(const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex, const std::vector<double>& graphData)
-		: m_dijkstraBackend(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex), m_graphData(graphData) {}
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex - all processes stop as soon as global closest vertex
+	/// is the target, so only distance and path to it are valid. If it is -1, all
+	/// vertices are processed.
+	/// </param>
+	DijkstraMPI(const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex, const GraphDataType& graphData, 
+		int numberOfThreads = 1, int targetVertexIndex = -1)
+		: m_dijkstraBackend(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex), m_graphData(graphData), 
+		m_verticesToHandleRange(verticesToHandleRange), m_targetVertexIndex(targetVertexIndex), m_threadTeam(numberOfThreads) {}
 
 
 	/// <summary>
@@ -52,11 +79,53 @@ public:
 	/// MPI communicator that allows communication between processes that take part in
 	/// algorithm execution.
 	/// </param>
-	std::pair<const std::vector<double>, const std::vector<int>> run(MPI_Comm& communicator);
+	std::pair<const std::vector<DistanceType>, const std::vector<int>> run(MPI_Comm& communicator);
+
+
+	/// <summary>
+	/// Runs Dijkstra algorithm the same way as run(MPI_Comm&), but closest vertices are
+	/// combined hierarchically - first by processes of each node in shared memory, then
+	/// by node leaders with MPI_Allreduce.
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors that represent Dijkstra algorithm results. First vector represents
+	/// distances from source vertex, second vector contains predecessors.
+	/// </returns>
+	/// <param name="nodeSharedMemory">
+	/// Object that groups processes taking part in algorithm execution by nodes.
+	/// </param>
+	std::pair<const std::vector<DistanceType>, const std::vector<int>> run(NodeSharedMemory& nodeSharedMemory);
+
+
+	/// <summary>
+	/// Runs Dijkstra algorithm the same way as run(MPI_Comm&) and measures time of work
+	/// of this process - time spent waiting for other processes in MPI_Allreduce is not
+	/// included. Results are discarded, so it is used as warm-up run that measures costs
+	/// of handled vertices.
+	/// </summary>
+	/// <returns>
+	/// Time of work of this process in seconds.
+	/// </returns>
+	/// <param name="communicator">
+	/// MPI communicator that allows communication between processes that take part in
+	/// algorithm execution.
+	/// </param>
+	double measureTimeOfLocalWork(MPI_Comm& communicator);
 
 private:
 
-	DijkstraAlgorithmBackend m_dijkstraBackend;
-	std::vector<double> m_graphData;
+	/// <summary>
+	/// Dijkstra algorithm main loop. Function passed as parameter receives closest vertex
+	/// of this process and returns global closest vertex - it is called by thread 0 only.
+	/// </summary>
+	template <typename ReductionFunction>
+	std::pair<const std::vector<DistanceType>, const std::vector<int>> runWithReduction(ReductionFunction computeGlobalMinimum);
+
+
+	BackendType m_dijkstraBackend;
+	const GraphDataType& m_graphData;
+	std::pair<int, int> m_verticesToHandleRange;
+	int m_targetVertexIndex;
+	ThreadTeam m_threadTeam;
 
 };
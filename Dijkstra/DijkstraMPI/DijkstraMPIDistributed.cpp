@@ -0,0 +1,201 @@
+#include "DijkstraMPIDistributed.h"
+#include "DijkstraAlgorithmBackend.h"
+
+#include <algorithm>
+#include <cstddef>
+
+
+DijkstraMPIDistributed::DijkstraMPIDistributed(const std::pair<int, int>& verticesToHandleRange, const std::vector<int>& numbersOfVerticesForEachProcess,
+	int sourceVertexIndex, const SparseGraph& graphData, double bucketWidth, int targetVertexIndex) :
+	m_verticesToHandleRange(verticesToHandleRange),
+	m_targetVertexIndex(targetVertexIndex),
+	m_graphData(graphData),
+	m_bucketWidth(bucketWidth),
+	m_distances(verticesToHandleRange.second - verticesToHandleRange.first + 1, infiniteDistance<double>()),
+	m_predecessors(verticesToHandleRange.second - verticesToHandleRange.first + 1, -1),
+	m_distancesOfPredecessors(verticesToHandleRange.second - verticesToHandleRange.first + 1, infiniteDistance<double>()),
+	m_queue(verticesToHandleRange.second - verticesToHandleRange.first + 1)
+{
+	// processes without vertices are not in communicator, so they are skipped
+	int firstVertex = 0;
+	for (int numberOfVertices : numbersOfVerticesForEachProcess) {
+		if (numberOfVertices > 0) {
+			m_firstVertexOfProcess.push_back(firstVertex);
+		}
+		firstVertex += numberOfVertices;
+	}
+	m_firstVertexOfProcess.push_back(firstVertex);
+	m_relaxationsForProcesses.resize(m_firstVertexOfProcess.size() - 1);
+
+	if (sourceVertexIndex >= verticesToHandleRange.first && sourceVertexIndex <= verticesToHandleRange.second) {
+		m_distances.at(sourceVertexIndex - verticesToHandleRange.first) = 0;
+		m_queue.insertOrDecreaseKey(sourceVertexIndex - verticesToHandleRange.first, 0);
+	}
+}
+
+
+std::pair<const std::vector<double>, const std::vector<int>> DijkstraMPIDistributed::run(MPI_Comm& communicator) {
+
+	MPI_Datatype relaxationDatatype = createRelaxationDatatype();
+	bool targetVertexIsHandled = m_targetVertexIndex >= m_verticesToHandleRange.first && m_targetVertexIndex <= m_verticesToHandleRange.second;
+	m_numberOfRounds = 0;
+	m_numberOfSentRelaxations = 0;
+
+	while (true) {
+
+		// all relaxations of previous round have been applied, so vertices closer than minimal queued distance are final
+		double localMinima[2] = {
+			m_queue.isEmpty() ? infiniteDistance<double>() : m_queue.getMin().distance,
+			targetVertexIsHandled ? m_distances[m_targetVertexIndex - m_verticesToHandleRange.first] : infiniteDistance<double>()
+		};
+		double minima[2];
+		MPI_Allreduce(localMinima, minima, 2, MPI_DOUBLE, MPI_MIN, communicator);
+		if (minima[0] == infiniteDistance<double>() || minima[1] < minima[0]) {
+			break;
+		}
+		++m_numberOfRounds;
+
+		processVerticesUpToBound(minima[0] + m_bucketWidth);
+		exchangeRelaxations(communicator, relaxationDatatype);
+	}
+
+	MPI_Type_free(&relaxationDatatype);
+	return std::make_pair(m_distances, m_predecessors);
+}
+
+
+double DijkstraMPIDistributed::computeDefaultBucketWidth(const SparseGraph& graphData, int totalNumberOfVertices, MPI_Comm& communicator) {
+
+	// minimal weight is negated, so both extremes are reduced with one MPI_MAX
+	ArrayView<double> weights = graphData.getWeights();
+	double localExtremes[2] = { 0.0, -infiniteDistance<double>() };
+	for (double weight : weights) {
+		localExtremes[0] = std::max(localExtremes[0], weight);
+		localExtremes[1] = std::max(localExtremes[1], -weight);
+	}
+	double extremes[2];
+	MPI_Allreduce(localExtremes, extremes, 2, MPI_DOUBLE, MPI_MAX, communicator);
+	std::int64_t localNumberOfEdges = graphData.getNumberOfEdges();
+	std::int64_t numberOfEdges = 0;
+	MPI_Allreduce(&localNumberOfEdges, &numberOfEdges, 1, MPI_INT64_T, MPI_SUM, communicator);
+
+	if (numberOfEdges == 0) {
+		return 1.0;
+	}
+	double averageDegree = static_cast<double>(numberOfEdges) / totalNumberOfVertices;
+	return std::max(-extremes[1], extremes[0] / std::max(1.0, averageDegree));
+}
+
+
+int DijkstraMPIDistributed::findOwner(int vertex) const {
+	return static_cast<int>(std::upper_bound(m_firstVertexOfProcess.begin(), m_firstVertexOfProcess.end(), vertex) - m_firstVertexOfProcess.begin()) - 1;
+}
+
+
+void DijkstraMPIDistributed::processVerticesUpToBound(double bound) {
+
+	ArrayView<int> offsets = m_graphData.getOffsets();
+	ArrayView<int> targets = m_graphData.getTargets();
+	ArrayView<double> weights = m_graphData.getWeights();
+	while (!m_queue.isEmpty() && m_queue.getMin().distance <= bound) {
+		int handledVertex = m_queue.extractMin().vertexNumber;
+		int vertex = m_verticesToHandleRange.first + handledVertex;
+		double distance = m_distances[handledVertex];
+
+		for (int e = offsets[handledVertex]; e < offsets[handledVertex + 1]; ++e) {
+			double altDistance = distance + weights[e];
+			if (targets[e] >= m_verticesToHandleRange.first && targets[e] <= m_verticesToHandleRange.second) {
+				relaxEdge(targets[e] - m_verticesToHandleRange.first, altDistance, vertex, distance);
+			}
+			else {
+				bufferRelaxation({ targets[e], vertex, altDistance, distance });
+			}
+		}
+	}
+}
+
+
+void DijkstraMPIDistributed::bufferRelaxation(const RelaxationRequest& relaxation) {
+
+	std::vector<RelaxationRequest>& relaxations = m_relaxationsForProcesses[findOwner(relaxation.target)];
+	auto position = m_positionsOfBufferedRelaxations.emplace(relaxation.target, relaxations.size());
+	if (position.second) {
+		relaxations.push_back(relaxation);
+		return;
+	}
+
+	// buffered relaxation is replaced by the one relaxEdge of the owner would prefer
+	RelaxationRequest& bufferedRelaxation = relaxations[position.first->second];
+	if (relaxation.distance < bufferedRelaxation.distance || (relaxation.distance == bufferedRelaxation.distance
+		&& checkIfPredecessorIsPreferred(relaxation.sourceDistance, relaxation.source, bufferedRelaxation.sourceDistance, bufferedRelaxation.source))) {
+		bufferedRelaxation = relaxation;
+	}
+}
+
+
+void DijkstraMPIDistributed::exchangeRelaxations(MPI_Comm& communicator, MPI_Datatype relaxationDatatype) {
+
+	int numberOfProcesses = static_cast<int>(m_relaxationsForProcesses.size());
+	std::vector<int> numbersOfSentRelaxations(numberOfProcesses, 0);
+	std::vector<int> numbersOfReceivedRelaxations(numberOfProcesses, 0);
+
+	// buffers already hold only the best relaxation of every vertex
+	m_sentRelaxations.clear();
+	for (int p = 0; p < numberOfProcesses; ++p) {
+		std::vector<RelaxationRequest>& relaxations = m_relaxationsForProcesses[p];
+		m_sentRelaxations.insert(m_sentRelaxations.end(), relaxations.begin(), relaxations.end());
+		numbersOfSentRelaxations[p] = static_cast<int>(relaxations.size());
+		relaxations.clear();
+	}
+	m_positionsOfBufferedRelaxations.clear();
+	m_numberOfSentRelaxations += static_cast<std::int64_t>(m_sentRelaxations.size());
+
+	MPI_Alltoall(numbersOfSentRelaxations.data(), 1, MPI_INT, numbersOfReceivedRelaxations.data(), 1, MPI_INT, communicator);
+	std::vector<int> sentRelaxationsDisplacements(numberOfProcesses, 0);
+	std::vector<int> receivedRelaxationsDisplacements(numberOfProcesses, 0);
+	for (int p = 1; p < numberOfProcesses; ++p) {
+		sentRelaxationsDisplacements[p] = sentRelaxationsDisplacements[p - 1] + numbersOfSentRelaxations[p - 1];
+		receivedRelaxationsDisplacements[p] = receivedRelaxationsDisplacements[p - 1] + numbersOfReceivedRelaxations[p - 1];
+	}
+	m_receivedRelaxations.resize(receivedRelaxationsDisplacements.back() + numbersOfReceivedRelaxations.back());
+	MPI_Alltoallv(m_sentRelaxations.data(), numbersOfSentRelaxations.data(), sentRelaxationsDisplacements.data(), relaxationDatatype,
+		m_receivedRelaxations.data(), numbersOfReceivedRelaxations.data(), receivedRelaxationsDisplacements.data(), relaxationDatatype, communicator);
+
+	for (const RelaxationRequest& relaxation : m_receivedRelaxations) {
+		relaxEdge(relaxation.target - m_verticesToHandleRange.first, relaxation.distance, relaxation.source, relaxation.sourceDistance);
+	}
+}
+
+
+void DijkstraMPIDistributed::relaxEdge(int handledVertex, double distance, int source, double sourceDistance) {
+
+	// relaxations come from several processes in any order and vertices can be processed more than once,
+	// so tie goes to predecessor with smaller distance, then smaller number - not to the first relaxation
+	if (distance < m_distances[handledVertex] || (distance == m_distances[handledVertex]
+		&& checkIfPredecessorIsPreferred(sourceDistance, source, m_distancesOfPredecessors[handledVertex], m_predecessors[handledVertex]))) {
+		if (distance < m_distances[handledVertex]) {
+			m_queue.insertOrDecreaseKey(handledVertex, distance);
+		}
+		m_distances[handledVertex] = distance;
+		m_predecessors[handledVertex] = source;
+		m_distancesOfPredecessors[handledVertex] = sourceDistance;
+	}
+}
+
+
+MPI_Datatype DijkstraMPIDistributed::createRelaxationDatatype() {
+
+	int blockLengths[4] = { 1, 1, 1, 1 };
+	MPI_Aint displacements[4] = { offsetof(RelaxationRequest, target), offsetof(RelaxationRequest, source),
+		offsetof(RelaxationRequest, distance), offsetof(RelaxationRequest, sourceDistance) };
+	MPI_Datatype types[4] = { MPI_INT, MPI_INT, MPI_DOUBLE, MPI_DOUBLE };
+	MPI_Datatype structType;
+	MPI_Type_create_struct(4, blockLengths, displacements, types, &structType);
+
+	// padding at the end of structure has to be included, so arrays of structures can be sent
+	MPI_Datatype datatype;
+	MPI_Type_create_resized(structType, 0, sizeof(RelaxationRequest), &datatype);
+	MPI_Type_commit(&datatype);
+	MPI_Type_free(&structType);
+	return datatype;
+}
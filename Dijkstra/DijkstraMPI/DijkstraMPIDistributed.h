@@ -0,0 +1,193 @@
+/**
+*	@file DijkstraMPIDistributed.h
+*	@brief This file contains MPI Dijkstra algorithm implementation in which
+*	processes own vertices together with edges leaving them.
+*/
+
+#pragma once
+
+#include "SparseGraph.h"
+#include "VertexHeap.h"
+#include "mpi.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class contains MPI Dijkstra algorithm implementation for sparse graphs divided
+/// into continous ranges of vertices (see --balance=partition) - every process stores only
+/// its vertices, edges leaving them and distances of its vertices, so memory of a process
+/// does not depend on size of the whole graph. Processes run rounds of delta-stepping: in
+/// every round they agree on minimal tentative distance L of queued vertices, then every
+/// process runs Dijkstra algorithm with its own priority queue on its vertices with distances
+/// not greater than L + delta. Edges leading to vertices of the process are relaxed at once,
+/// relaxations of other vertices are collected in buffers of their owners (only the best one
+/// for every vertex is kept) and sent in one MPI_Alltoallv at the end of the round. Vertex whose
+/// distance is decreased after it has been processed is queued again, so distances are the same
+/// as in other implementations. Predecessors too - when new distance is equal to current one,
+/// predecessor with smaller (distance, number) pair is kept.
+/// </summary>
+class DijkstraMPIDistributed
+{
+public:
+
+	/// <summary>
+	/// DijkstraMPIDistributed class constructor. Prepares distances and predecessors of
+	/// handled vertices and queues source vertex.
+	/// </summary>
+	/// <param name="verticesToHandleRange">
+	/// Range of vertices that should be handled by this object. Pair of integer
+	/// values a, b that represents range [a, b].
+	/// </param>
+	/// <param name="numbersOfVerticesForEachProcess">
+	/// Numbers of vertices handled by every process, the same in all processes. Processes
+	/// without vertices do not take part in the algorithm.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Integer number that represents index of source vertex.
+	/// </param>
+	/// <param name="graphData">
+	/// Rows of handled vertices (see SparseGraph::extractRowsOfVerticesInRange) - edges
+	/// leaving them, with original numbers of target vertices.
+	/// </param>
+	/// <param name="bucketWidth">
+	/// Width of bucket (delta) - positive number. See computeDefaultBucketWidth.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex - all processes stop after the round in which distance of
+	/// target vertex becomes final. If it is -1, all vertices are processed.
+	/// </param>
+	DijkstraMPIDistributed(const std::pair<int, int>& verticesToHandleRange, const std::vector<int>& numbersOfVerticesForEachProcess,
+		int sourceVertexIndex, const SparseGraph& graphData, double bucketWidth, int targetVertexIndex = -1);
+
+
+	/// <summary>
+	/// Runs Dijkstra algorithm using MPI. Each round takes MPI_Allreduce of minimal distance,
+	/// MPI_Alltoall of numbers of relaxations and MPI_Alltoallv of relaxations themselves.
+	/// Rounds are repeated until there are no queued vertices in any process (or target
+	/// vertex is closer than all of them).
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors that represent Dijkstra algorithm results. First vector represents
+	/// distances from source vertex, second vector contains predecessors.
+	/// </returns>
+	/// <param name="communicator">
+	/// MPI communicator with processes that handle vertices, ordered the same way as their
+	/// ranges of vertices.
+	/// </param>
+	std::pair<const std::vector<double>, const std::vector<int>> run(MPI_Comm& communicator);
+
+
+	/// <summary>
+	/// Computes bucket width based on weights of edges of all processes: maximal weight
+	/// divided by average degree of vertex, but not smaller than minimal weight (the same
+	/// way as DijkstraDeltaStepping). It is a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Bucket width that should be used for given graph.
+	/// </returns>
+	/// <param name="graphData">
+	/// Rows of vertices handled by this process.
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Integer number that represents total number of vertices in processed graph.
+	/// </param>
+	/// <param name="communicator">
+	/// MPI communicator with all processes that store parts of the graph.
+	/// </param>
+	static double computeDefaultBucketWidth(const SparseGraph& graphData, int totalNumberOfVertices, MPI_Comm& communicator);
+
+
+	/// <summary>
+	/// Returns number of rounds of communication performed by the last run.
+	/// </summary>
+	int getNumberOfRounds() const {
+		return m_numberOfRounds;
+	}
+
+
+	/// <summary>
+	/// Returns number of relaxations sent by this process to other processes during the
+	/// last run.
+	/// </summary>
+	std::int64_t getNumberOfSentRelaxations() const {
+		return m_numberOfSentRelaxations;
+	}
+
+private:
+
+	/// <summary>
+	/// Relaxation sent to owner of target vertex - proposal of new distance and
+	/// predecessor for it.
+	/// </summary>
+	struct RelaxationRequest {
+		int target;
+		int source;
+		double distance;
+		double sourceDistance;
+	};
+
+
+	/// <summary>
+	/// Returns index of process that owns given vertex.
+	/// </summary>
+	int findOwner(int vertex) const;
+
+
+	/// <summary>
+	/// Processes queued vertices with distances not greater than given bound in order of
+	/// distances - edges leading to handled vertices are relaxed at once, other ones are
+	/// put into buffers of their owners.
+	/// </summary>
+	void processVerticesUpToBound(double bound);
+
+
+	/// <summary>
+	/// Puts relaxation into buffer of owner of its target vertex. Buffer keeps only the
+	/// best relaxation of every vertex - the same one the owner would keep.
+	/// </summary>
+	void bufferRelaxation(const RelaxationRequest& relaxation);
+
+
+	/// <summary>
+	/// Sends relaxations collected in buffers to owners of their target vertices and
+	/// applies relaxations received from other processes.
+	/// </summary>
+	void exchangeRelaxations(MPI_Comm& communicator, MPI_Datatype relaxationDatatype);
+
+
+	/// <summary>
+	/// Relaxes edge leading to handled vertex - vertex is queued again if its distance
+	/// decreases.
+	/// </summary>
+	void relaxEdge(int handledVertex, double distance, int source, double sourceDistance);
+
+
+	/// <summary>
+	/// Creates MPI datatype that describes RelaxationRequest. Returned datatype is
+	/// committed and should be freed by the caller.
+	/// </summary>
+	static MPI_Datatype createRelaxationDatatype();
+
+
+	std::pair<int, int> m_verticesToHandleRange;
+	int m_targetVertexIndex;
+	const SparseGraph& m_graphData;
+	double m_bucketWidth;
+
+	std::vector<int> m_firstVertexOfProcess;
+	std::vector<double> m_distances;
+	std::vector<int> m_predecessors;
+	std::vector<double> m_distancesOfPredecessors;
+	VertexHeap m_queue;
+
+	std::vector<std::vector<RelaxationRequest>> m_relaxationsForProcesses;
+	std::unordered_map<int, size_t> m_positionsOfBufferedRelaxations;
+	std::vector<RelaxationRequest> m_sentRelaxations;
+	std::vector<RelaxationRequest> m_receivedRelaxations;
+	int m_numberOfRounds = 0;
+	std::int64_t m_numberOfSentRelaxations = 0;
+
+};
@@ -0,0 +1,197 @@
+#include "DijkstraMPIMultiSettle.h"
+
+#include <algorithm>
+
+
+template <typename GraphDataType>
+DijkstraMPIMultiSettle<GraphDataType>::DijkstraMPIMultiSettle(const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices,
+	int sourceVertexIndex, const GraphDataType& graphData, int targetVertexIndex) :
+	m_verticesToHandleRange(verticesToHandleRange),
+	m_totalNumberOfVertices(totalNumberOfVertices),
+	m_targetVertexIndex(targetVertexIndex),
+	m_graphData(graphData),
+	m_distances(verticesToHandleRange.second - verticesToHandleRange.first + 1, infiniteDistance<double>()),
+	m_predecessors(verticesToHandleRange.second - verticesToHandleRange.first + 1, -1),
+	m_distancesOfPredecessors(verticesToHandleRange.second - verticesToHandleRange.first + 1, infiniteDistance<double>()),
+	m_minimalWeightsOfEdgesEnteringVertices(verticesToHandleRange.second - verticesToHandleRange.first + 1, infiniteDistance<double>()),
+	m_processedVerticesBitmap((verticesToHandleRange.second - verticesToHandleRange.first + 64) / 64, 0)
+{
+	if (sourceVertexIndex >= verticesToHandleRange.first && sourceVertexIndex <= verticesToHandleRange.second) {
+		m_distances.at(sourceVertexIndex - verticesToHandleRange.first) = 0;
+	}
+}
+
+
+template <typename GraphDataType>
+std::pair<const std::vector<double>, const std::vector<int>> DijkstraMPIMultiSettle<GraphDataType>::run(MPI_Comm& communicator) {
+
+	int numberOfProcesses = 0;
+	MPI_Comm_size(communicator, &numberOfProcesses);
+	int numberOfHandledVertices = static_cast<int>(m_distances.size());
+	std::vector<double> minimalWeightsOfEdgesLeavingVertices = computeMinimalWeightsOfEdges(communicator);
+
+	std::vector<VertexData> locallyProcessedVertices;
+	std::vector<VertexData> processedVertices;
+	std::vector<int> numbersOfProcessedVertices(numberOfProcesses, 0);
+	std::vector<int> processedVerticesDisplacements(numberOfProcesses, 0);
+	m_numberOfRounds = 0;
+
+	while (true) {
+
+		// local thresholds - minimal distance and minimal distance increased by the lightest leaving edge
+		double localThresholds[2] = { infiniteDistance<double>(), infiniteDistance<double>() };
+		for (int i = 0; i < numberOfHandledVertices; ++i) {
+			if (!checkIfHandledVertexHasBeenProcessed(i)) {
+				localThresholds[0] = std::min(localThresholds[0], m_distances[i]);
+				localThresholds[1] = std::min(localThresholds[1], m_distances[i] + minimalWeightsOfEdgesLeavingVertices[i]);
+			}
+		}
+		double thresholds[2];
+		MPI_Allreduce(localThresholds, thresholds, 2, MPI_DOUBLE, MPI_MIN, communicator);
+
+		// all remaining vertices are unreachable (or all vertices have been processed)
+		double minimalDistance = thresholds[0];
+		if (minimalDistance == infiniteDistance<double>()) {
+			break;
+		}
+		++m_numberOfRounds;
+
+		// vertex is final if no path through unprocessed vertex can be as short as its current one - strict
+		// comparisons guarantee that all predecessors with equal distance have already been processed
+		locallyProcessedVertices.clear();
+		for (int i = 0; i < numberOfHandledVertices; ++i) {
+			if (checkIfHandledVertexHasBeenProcessed(i)) {
+				continue;
+			}
+			if (m_distances[i] == minimalDistance || m_distances[i] < thresholds[1]
+				|| m_distances[i] < minimalDistance + m_minimalWeightsOfEdgesEnteringVertices[i]) {
+				locallyProcessedVertices.push_back(createVertexDataInstance(m_distances[i], m_verticesToHandleRange.first + i));
+			}
+		}
+
+		// exchange vertices processed in this round - they are ordered by process, so by vertex number
+		int numberOfLocallyProcessedVertices = static_cast<int>(locallyProcessedVertices.size());
+		MPI_Allgather(&numberOfLocallyProcessedVertices, 1, MPI_INT, numbersOfProcessedVertices.data(), 1, MPI_INT, communicator);
+		for (int p = 1; p < numberOfProcesses; ++p) {
+			processedVerticesDisplacements[p] = processedVerticesDisplacements[p - 1] + numbersOfProcessedVertices[p - 1];
+		}
+		processedVertices.resize(processedVerticesDisplacements.back() + numbersOfProcessedVertices.back());
+		MPI_Allgatherv(locallyProcessedVertices.data(), numberOfLocallyProcessedVertices, MPITypeTraits<VertexData>::getDatatype(),
+			processedVertices.data(), numbersOfProcessedVertices.data(), processedVerticesDisplacements.data(),
+			MPITypeTraits<VertexData>::getDatatype(), communicator);
+
+		// mark vertices as processed before relaxing, so edges between them are skipped
+		bool targetVertexHasBeenProcessed = false;
+		for (const VertexData& vertex : locallyProcessedVertices) {
+			int handledVertex = vertex.vertexNumber - m_verticesToHandleRange.first;
+			m_processedVerticesBitmap[handledVertex / 64] |= std::uint64_t(1) << (handledVertex % 64);
+		}
+		for (const VertexData& vertex : processedVertices) {
+			relaxEdgesLeavingVertex(vertex);
+			targetVertexHasBeenProcessed |= vertex.vertexNumber == m_targetVertexIndex;
+		}
+
+		// every process received the same vertices, so all of them stop in the same round
+		if (targetVertexHasBeenProcessed) {
+			break;
+		}
+	}
+
+	return std::make_pair(m_distances, m_predecessors);
+}
+
+
+template <typename GraphDataType>
+template <typename Function>
+void DijkstraMPIMultiSettle<GraphDataType>::forEachEdgeLeavingVertex(int vertex, const std::vector<double>& graphData, Function function) const {
+
+	// weights of edges leaving vertex are stored every totalNumberOfVertices entries
+	const double* weights = graphData.data() + vertex;
+	for (int i = 0; i < static_cast<int>(m_distances.size()); ++i) {
+		if (WeightTraits<double>::checkIfIsEdge(weights[static_cast<size_t>(i) * m_totalNumberOfVertices])) {
+			function(i, weights[static_cast<size_t>(i) * m_totalNumberOfVertices]);
+		}
+	}
+}
+
+
+template <typename GraphDataType>
+template <typename Function>
+void DijkstraMPIMultiSettle<GraphDataType>::forEachEdgeLeavingVertex(int vertex, const TransposedMatrixChunk& graphData, Function function) const {
+
+	// weights of edges leaving vertex are stored next to each other
+	const double* weights = graphData.getWeightsOfEdgesLeavingVertex(vertex);
+	for (int i = 0; i < static_cast<int>(m_distances.size()); ++i) {
+		if (WeightTraits<double>::checkIfIsEdge(weights[i])) {
+			function(i, weights[i]);
+		}
+	}
+}
+
+
+template <typename GraphDataType>
+template <typename Function>
+void DijkstraMPIMultiSettle<GraphDataType>::forEachEdgeLeavingVertex(int vertex, const SparseGraph& graphData, Function function) const {
+
+	ArrayView<int> offsets = graphData.getOffsets();
+	ArrayView<int> targets = graphData.getTargets();
+	ArrayView<double> weights = graphData.getWeights();
+	for (int e = offsets[vertex]; e < offsets[vertex + 1]; ++e) {
+		if (targets[e] >= m_verticesToHandleRange.first && targets[e] <= m_verticesToHandleRange.second) {
+			function(targets[e] - m_verticesToHandleRange.first, weights[e]);
+		}
+	}
+}
+
+
+template <typename GraphDataType>
+std::vector<double> DijkstraMPIMultiSettle<GraphDataType>::computeMinimalWeightsOfEdges(MPI_Comm& communicator) {
+
+	// this process stores only edges leading to its own vertices - also edges leaving all other vertices
+	std::vector<double> localMinimalWeightsOfEdgesLeavingVertices(m_totalNumberOfVertices, infiniteDistance<double>());
+	for (int vertex = 0; vertex < m_totalNumberOfVertices; ++vertex) {
+		forEachEdgeLeavingVertex(vertex, m_graphData, [&](int handledVertex, double weight) {
+			localMinimalWeightsOfEdgesLeavingVertices[vertex] = std::min(localMinimalWeightsOfEdgesLeavingVertices[vertex], weight);
+			m_minimalWeightsOfEdgesEnteringVertices[handledVertex] = std::min(m_minimalWeightsOfEdgesEnteringVertices[handledVertex], weight);
+		});
+	}
+
+	// ranges of vertices follow order of processes, so reduced minima can be scattered in blocks
+	int numberOfProcesses = 0;
+	MPI_Comm_size(communicator, &numberOfProcesses);
+	int numberOfHandledVertices = static_cast<int>(m_distances.size());
+	std::vector<int> numbersOfHandledVertices(numberOfProcesses, 0);
+	MPI_Allgather(&numberOfHandledVertices, 1, MPI_INT, numbersOfHandledVertices.data(), 1, MPI_INT, communicator);
+
+	std::vector<double> minimalWeightsOfEdgesLeavingVertices(numberOfHandledVertices, infiniteDistance<double>());
+	MPI_Reduce_scatter(localMinimalWeightsOfEdgesLeavingVertices.data(), minimalWeightsOfEdgesLeavingVertices.data(),
+		numbersOfHandledVertices.data(), MPI_DOUBLE, MPI_MIN, communicator);
+	return minimalWeightsOfEdgesLeavingVertices;
+}
+
+
+template <typename GraphDataType>
+void DijkstraMPIMultiSettle<GraphDataType>::relaxEdgesLeavingVertex(const VertexData& processedVertex) {
+
+	forEachEdgeLeavingVertex(processedVertex.vertexNumber, m_graphData, [&](int handledVertex, double weight) {
+		if (checkIfHandledVertexHasBeenProcessed(handledVertex)) {
+			return;
+		}
+
+		// vertices settled in one round relax edges in order of their numbers, not distances - tie goes
+		// to predecessor with smaller distance, then smaller number, regardless of order of relaxations
+		double altDistance = weight + processedVertex.distance;
+		if (altDistance < m_distances[handledVertex] || (altDistance == m_distances[handledVertex]
+			&& checkIfPredecessorIsPreferred(processedVertex.distance, processedVertex.vertexNumber,
+				m_distancesOfPredecessors[handledVertex], m_predecessors[handledVertex]))) {
+			m_distances[handledVertex] = altDistance;
+			m_predecessors[handledVertex] = processedVertex.vertexNumber;
+			m_distancesOfPredecessors[handledVertex] = processedVertex.distance;
+		}
+	});
+}
+
+
+template class DijkstraMPIMultiSettle<std::vector<double>>;
+template class DijkstraMPIMultiSettle<SparseGraph>;
+template class DijkstraMPIMultiSettle<TransposedMatrixChunk>;
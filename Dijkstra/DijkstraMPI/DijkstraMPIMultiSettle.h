@@ -0,0 +1,147 @@
+/**
+*	@file DijkstraMPIMultiSettle.h
+*	@brief This file contains MPI Dijkstra algorithm implementation that settles
+*	many vertices in each round of communication.
+*/
+
+#pragma once
+
+#include "DijkstraAlgorithmBackend.h"
+#include "MPITypeTraits.h"
+#include "mpi.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class contains MPI Dijkstra algorithm implementation that does not exchange
+/// one closest vertex per iteration. In every round processes agree on two thresholds:
+/// minimal tentative distance L of unprocessed vertices and minimum of tentative distance
+/// plus weight of the lightest edge leaving the vertex (OUT criterion). Every unprocessed
+/// vertex with distance lower than that minimum or lower than L plus weight of the lightest
+/// edge entering it (IN criterion) can not be improved any more, so all such vertices are
+/// processed in the same round and exchanged in one MPI_Allgatherv. Distances are the same as
+/// in DijkstraMPI - also predecessors, as edges with equal distance keep predecessor that
+/// would be processed first by one-vertex-per-iteration algorithm. Template parameter is type
+/// of graph representation - part of adjacency matrix in form of 1D vector of weights,
+/// TransposedMatrixChunk or part of SparseGraph.
+/// </summary>
+template <typename GraphDataType>
+class DijkstraMPIMultiSettle
+{
+public:
+
+	/// <summary>
+	/// DijkstraMPIMultiSettle class constructor. Prepares distances and predecessors
+	/// of handled vertices.
+	/// </summary>
+	/// <param name="verticesToHandleRange">
+	/// Range of vertices that should be handled by this object. Pair of integer
+	/// values a, b that represents range [a, b].
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Integer number that represents total number of vertices in processed graph.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Integer number that represents index of source vertex.
+	/// </param>
+	/// <param name="graphData">
+	/// Part of graph that contains edges leading to handled vertices - part of adjacency
+	/// matrix arranged column-wise, TransposedMatrixChunk or sparse graph.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex - all processes stop after the round in which target vertex
+	/// is processed. If it is -1, all vertices are processed.
+	/// </param>
+	DijkstraMPIMultiSettle(const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex,
+		const GraphDataType& graphData, int targetVertexIndex = -1);
+
+
+	/// <summary>
+	/// Runs Dijkstra algorithm using MPI. Weights of the lightest edges entering and leaving
+	/// handled vertices are computed first, then rounds are repeated until there are no
+	/// reachable unprocessed vertices. Each round takes three collective operations:
+	/// MPI_Allreduce of thresholds, MPI_Allgather of numbers of processed vertices and
+	/// MPI_Allgatherv of the vertices themselves.
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors that represent Dijkstra algorithm results. First vector represents
+	/// distances from source vertex, second vector contains predecessors.
+	/// </returns>
+	/// <param name="communicator">
+	/// MPI communicator that allows communication between processes that take part in
+	/// algorithm execution.
+	/// </param>
+	std::pair<const std::vector<double>, const std::vector<int>> run(MPI_Comm& communicator);
+
+
+	/// <summary>
+	/// Returns number of rounds of communication performed by the last run.
+	/// </summary>
+	int getNumberOfRounds() const {
+		return m_numberOfRounds;
+	}
+
+private:
+
+	/// <summary>
+	/// Calls function for every edge of dense chunk (arranged column-wise) leaving given
+	/// vertex, passing number of handled vertex it leads to and weight of the edge.
+	/// </summary>
+	template <typename Function>
+	void forEachEdgeLeavingVertex(int vertex, const std::vector<double>& graphData, Function function) const;
+
+
+	/// <summary>
+	/// Calls function for every edge of row-wise arranged chunk leaving given vertex,
+	/// passing number of handled vertex it leads to and weight of the edge.
+	/// </summary>
+	template <typename Function>
+	void forEachEdgeLeavingVertex(int vertex, const TransposedMatrixChunk& graphData, Function function) const;
+
+
+	/// <summary>
+	/// Calls function for every edge of sparse graph chunk leaving given vertex and leading
+	/// to handled vertex, passing number of handled vertex and weight of the edge.
+	/// </summary>
+	template <typename Function>
+	void forEachEdgeLeavingVertex(int vertex, const SparseGraph& graphData, Function function) const;
+
+
+	/// <summary>
+	/// Computes weights of the lightest edges entering handled vertices (all of them are
+	/// stored by this process) and returns weights of the lightest edges leaving handled
+	/// vertices - edges leaving each vertex are divided between all processes, so their
+	/// local minima are reduced with one MPI_Reduce_scatter and every process receives
+	/// minima of its own vertices.
+	/// </summary>
+	std::vector<double> computeMinimalWeightsOfEdges(MPI_Comm& communicator);
+
+
+	/// <summary>
+	/// Relaxes edges leaving processed vertex. When new distance is equal to current one,
+	/// predecessor with smaller (distance, number) pair is kept, so choice of predecessor
+	/// does not depend on rounds in which vertices were processed.
+	/// </summary>
+	void relaxEdgesLeavingVertex(const VertexData& processedVertex);
+
+
+	inline bool checkIfHandledVertexHasBeenProcessed(int handledVertex) const {
+		return (m_processedVerticesBitmap[handledVertex / 64] >> (handledVertex % 64)) & 1;
+	}
+
+
+	std::pair<int, int> m_verticesToHandleRange;
+	int m_totalNumberOfVertices;
+	int m_targetVertexIndex;
+	const GraphDataType& m_graphData;
+
+	std::vector<double> m_distances;
+	std::vector<int> m_predecessors;
+	std::vector<double> m_distancesOfPredecessors;
+	std::vector<double> m_minimalWeightsOfEdgesEnteringVertices;
+	std::vector<std::uint64_t> m_processedVerticesBitmap;
+	int m_numberOfRounds = 0;
+
+};
@@ -0,0 +1,68 @@
+#include "DijkstraMPIMultiSource.h"
+
+
+template <typename GraphDataType>
+DijkstraMPIMultiSource<GraphDataType>::DijkstraMPIMultiSource(const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices,
+	const std::vector<int>& sourceVerticesIndices, const GraphDataType& graphData) : m_graphData(graphData)
+{
+	m_dijkstraBackends.reserve(sourceVerticesIndices.size());
+	for (int sourceVertexIndex : sourceVerticesIndices) {
+		m_dijkstraBackends.emplace_back(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex);
+	}
+}
+
+
+template <typename GraphDataType>
+std::vector<std::pair<const std::vector<double>, const std::vector<int>>> DijkstraMPIMultiSource<GraphDataType>::run(MPI_Comm& communicator) {
+
+	int numberOfSearches = static_cast<int>(m_dijkstraBackends.size());
+
+	// vertices that belong to current node and are closest to clusters of already processed vertices - one for each search
+	std::vector<VertexData> localMins;
+	for (DijkstraAlgorithmBackend& dijkstraBackend : m_dijkstraBackends) {
+		localMins.push_back(dijkstraBackend.findVertexWithMinimalDistanceToCluster());
+	}
+	std::vector<VertexData> globalMins(numberOfSearches, createVertexDataInstance());
+
+	// while there are any searches that have not finished
+	int numberOfUnfinishedSearches = numberOfSearches;
+	std::vector<bool> finishedSearches(numberOfSearches, false);
+	while (numberOfUnfinishedSearches > 0) {
+
+		// gather local closest vertices of all searches and compute global ones in one collective operation
+		MPI_Allreduce(localMins.data(), globalMins.data(), numberOfSearches, MPITypeTraits<VertexData>::getDatatype(),
+			MPITypeTraits<VertexData>::getMinimumOperation(), communicator);
+
+		for (int s = 0; s < numberOfSearches; ++s) {
+			if (finishedSearches[s]) {
+				continue;
+			}
+
+			// search is finished if there was no valid closest vertex - finished searches send invalid vertices from now on
+			if (globalMins[s].vertexNumber == -1) {
+				finishedSearches[s] = true;
+				--numberOfUnfinishedSearches;
+				continue;
+			}
+
+			// mark vertex as processed
+			m_dijkstraBackends[s].markVertexAsProcessed(globalMins[s].vertexNumber);
+
+			// inner loop - computing new distances and finding local closest vertex for the next round
+			localMins[s] = m_dijkstraBackends[s].checkIfAllVerticesHaveBeenProcessed()
+				? createVertexDataInstance()
+				: m_dijkstraBackends[s].performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(globalMins[s], m_graphData);
+		}
+	}
+
+	std::vector<std::pair<const std::vector<double>, const std::vector<int>>> results;
+	for (DijkstraAlgorithmBackend& dijkstraBackend : m_dijkstraBackends) {
+		results.emplace_back(dijkstraBackend.getDistances(), dijkstraBackend.getPredecessors());
+	}
+	return results;
+}
+
+
+template class DijkstraMPIMultiSource<std::vector<double>>;
+template class DijkstraMPIMultiSource<SparseGraph>;
+template class DijkstraMPIMultiSource<TransposedMatrixChunk>;
\ No newline at end of file
@@ -0,0 +1,72 @@
+/**
+*	@file DijkstraMPIMultiSource.h
+*	@brief This file contains MPI Dijkstra algorithm implementation that runs
+*	searches from several source vertices at once.
+*/
+
+#pragma once
+
+#include "DijkstraAlgorithmBackend.h"
+#include "MPITypeTraits.h"
+#include "mpi.h"
+
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class contains MPI Dijkstra algorithm implementation that runs searches
+/// from k source vertices in lockstep. It uses one DijkstraAlgorithmBackend per
+/// source. In every round local closest vertices of all searches are reduced in
+/// a single MPI_Allreduce (k VertexData entries with MPI_MINLOC) and then all k
+/// distance arrays are relaxed against the same graph chunk. Template parameter
+/// is type of graph representation - the same as in DijkstraMPI.
+/// </summary>
+template <typename GraphDataType>
+class DijkstraMPIMultiSource
+{
+public:
+
+	/// <summary>
+	/// DijkstraMPIMultiSource class constructor. Prepares algorithm backend for
+	/// every source vertex.
+	/// </summary>
+	/// <param name="verticesToHandleRange">
+	/// Range of vertices that should be handled by this object. Pair of integer
+	/// values a, b that represents range [a, b].
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Integer number that represents total number of vertices in processed
+	/// graph.
+	/// </param>
+	/// <param name="sourceVerticesIndices">
+	/// Indices of source vertices - one search is run for each of them.
+	/// </param>
+	/// <param name="graphData">
+	/// Part of graph that is being processed by this object. Please note that this
+	/// object stores reference to it - it is valid as long as graph itself is valid.
+	/// </param>
+	DijkstraMPIMultiSource(const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, const std::vector<int>& sourceVerticesIndices,
+		const GraphDataType& graphData);
+
+
+	/// <summary>
+	/// Dijkstra algorithm implementation. Runs searches from all source vertices using
+	/// MPI. Handles vertices that have been assigned to node that runs this function.
+	/// </summary>
+	/// <returns>
+	/// Vector with results of every search (in the same order as source vertices). Each
+	/// result is a pair of vectors - first vector represents distances from source vertex,
+	/// second vector contains predecessors.
+	/// </returns>
+	/// <param name="communicator">
+	/// MPI communicator that allows communication between processes that take part in
+	/// algorithm execution.
+	/// </param>
+	std::vector<std::pair<const std::vector<double>, const std::vector<int>>> run(MPI_Comm& communicator);
+
+private:
+
+	std::vector<DijkstraAlgorithmBackend> m_dijkstraBackends;
+	const GraphDataType& m_graphData;
+
+};
@@ -1,4 +1,5 @@
 #include "DijkstraMPISetup.h"
+#include "BinaryGraphFile.h"
 
 
 std::vector<int> DijkstraMPISetup::divideGraphMatrixIntoChunks(int numberOfVertices, int numberOfProcesses) {
@@ -30,9 +31,300 @@ std::vector<int> DijkstraMPISetup::computeBufferSizesForEachProcess(const std::v
 }
 
 
-std::pair<int, int> DijkstraMPISetup::computeRangeOfVerticesToHandle(int matrixSide, int numberOfProcesses, int processRank, int numberOfColumnsToHandle) {
-	int averageNumberOfColumnsPerProcess = matrixSide / numberOfProcesses;
-	int numberOfLeftColumns = matrixSide - averageNumberOfColumnsPerProcess * numberOfProcesses;
-	int firstVertexIndex = processRank * averageNumberOfColumnsPerProcess + (processRank < numberOfLeftColumns ? processRank : numberOfLeftColumns);
-	return std::make_pair(firstVertexIndex, firstVertexIndex + numberOfColumnsToHandle - 1);
+std::pair<int, int> DijkstraMPISetup::computeRangeOfVerticesToHandle(const std::vector<int>& numbersOfColumnsForEachProcess, int processRank) {
+	int firstVertexIndex = std::accumulate(numbersOfColumnsForEachProcess.begin(), numbersOfColumnsForEachProcess.begin() + processRank, 0);
+	return std::make_pair(firstVertexIndex, firstVertexIndex + numbersOfColumnsForEachProcess.at(processRank) - 1);
+}
+
+
+std::vector<double> DijkstraMPISetup::computeCostsOfVertices(const SparseGraph& graph, bool countEdgesLeavingVertices) {
+	std::vector<double> costsOfVertices(graph.getNumberOfVertices(), 1.0);
+	if (countEdgesLeavingVertices) {
+		for (int v = 0; v < graph.getNumberOfVertices(); ++v) {
+			costsOfVertices[v] += graph.getOffsets()[v + 1] - graph.getOffsets()[v];
+		}
+		return costsOfVertices;
+	}
+	for (int target : graph.getTargets()) {
+		costsOfVertices[target] += 1.0;
+	}
+	return costsOfVertices;
+}
+
+
+std::vector<int> DijkstraMPISetup::divideVerticesByCosts(const std::vector<double>& costsOfVertices, int numberOfProcesses) {
+	int numberOfVertices = static_cast<int>(costsOfVertices.size());
+	double totalCost = std::accumulate(costsOfVertices.begin(), costsOfVertices.end(), 0.0);
+	if (numberOfVertices < numberOfProcesses || !(totalCost > 0)) {
+		return divideGraphMatrixIntoChunks(numberOfVertices, numberOfProcesses);
+	}
+
+	// range of every process ends at vertex closest to its share of total cost
+	std::vector<int> numbersOfColumnsForEachProcess(numberOfProcesses, 0);
+	double accumulatedCost = 0;
+	int vertex = 0;
+	for (int p = 0; p < numberOfProcesses; ++p) {
+		int firstVertex = vertex;
+		double costLimit = totalCost * (p + 1) / numberOfProcesses;
+		int lastAllowedVertex = p == numberOfProcesses - 1 ? numberOfVertices : numberOfVertices - (numberOfProcesses - p - 1);
+
+		// every process takes at least one vertex and leaves at least one for every next process
+		while (vertex < lastAllowedVertex && (vertex == firstVertex || p == numberOfProcesses - 1 || accumulatedCost + costsOfVertices[vertex] / 2 <= costLimit)) {
+			accumulatedCost += costsOfVertices[vertex];
+			++vertex;
+		}
+		numbersOfColumnsForEachProcess[p] = vertex - firstVertex;
+	}
+	return numbersOfColumnsForEachProcess;
+}
+
+
+std::vector<double> DijkstraMPISetup::scaleCostsOfVerticesToMeasuredTimes(std::vector<double> costsOfVertices, const std::vector<int>& numbersOfColumnsForEachProcess,
+	const std::vector<double>& measuredTimes) {
+
+	int firstVertex = 0;
+	for (size_t p = 0; p < numbersOfColumnsForEachProcess.size(); ++p) {
+		double costOfProcess = std::accumulate(costsOfVertices.begin() + firstVertex, costsOfVertices.begin() + firstVertex + numbersOfColumnsForEachProcess[p], 0.0);
+		double scale = costOfProcess > 0 ? measuredTimes.at(p) / costOfProcess : 0.0;
+		for (int v = firstVertex; v < firstVertex + numbersOfColumnsForEachProcess[p]; ++v) {
+			costsOfVertices[v] *= scale;
+		}
+		firstVertex += numbersOfColumnsForEachProcess[p];
+	}
+	return costsOfVertices;
+}
+
+
+double DijkstraMPISetup::computeImbalance(const std::vector<double>& costsOfVertices, const std::vector<int>& numbersOfColumnsForEachProcess) {
+	double totalCost = 0;
+	double highestCost = 0;
+	int firstVertex = 0;
+	for (int numberOfColumns : numbersOfColumnsForEachProcess) {
+		double costOfProcess = std::accumulate(costsOfVertices.begin() + firstVertex, costsOfVertices.begin() + firstVertex + numberOfColumns, 0.0);
+		totalCost += costOfProcess;
+		highestCost = std::max(highestCost, costOfProcess);
+		firstVertex += numberOfColumns;
+	}
+	return totalCost > 0 ? highestCost * numbersOfColumnsForEachProcess.size() / totalCost : 1.0;
+}
+
+
+std::vector<int> DijkstraMPISetup::countVerticesOfParts(const std::vector<int>& parts, int numberOfProcesses) {
+	std::vector<int> numbersOfColumnsForEachProcess(numberOfProcesses, 0);
+	for (int part : parts) {
+		++numbersOfColumnsForEachProcess[part];
+	}
+	return numbersOfColumnsForEachProcess;
+}
+
+
+std::vector<int> DijkstraMPISetup::renumberVerticesByParts(const std::vector<int>& parts, const std::vector<int>& numbersOfColumnsForEachProcess) {
+
+	// next number of every part starts at the beginning of its range
+	std::vector<int> nextNumbers = computeDisplacements(numbersOfColumnsForEachProcess, 1);
+	std::vector<int> newNumbers(parts.size());
+	for (size_t v = 0; v < parts.size(); ++v) {
+		newNumbers[v] = nextNumbers[parts[v]]++;
+	}
+	return newNumbers;
+}
+
+
+std::vector<std::unique_ptr<SparseGraph>> DijkstraMPISetup::divideSparseGraphIntoChunks(const SparseGraph& graph, const std::vector<int>& numbersOfColumnsForEachProcess) {
+	std::vector<int> firstVertices = computeDisplacements(numbersOfColumnsForEachProcess, 1);
+	std::vector<std::unique_ptr<SparseGraph>> chunks;
+	for (size_t i = 0; i < numbersOfColumnsForEachProcess.size(); ++i) {
+		chunks.push_back(graph.extractEdgesWithTargetsInRange(std::make_pair(firstVertices.at(i), firstVertices.at(i) + numbersOfColumnsForEachProcess.at(i) - 1)));
+	}
+	return chunks;
+}
+
+
+std::unique_ptr<SparseGraph> DijkstraMPISetup::scatterSparseGraphChunks(const SparseGraph* graph, const std::vector<int>& numbersOfColumnsForEachProcess,
+	int totalNumberOfVertices, MPI_Comm communicator) {
+
+	int processRank = 0;
+	MPI_Comm_rank(communicator, &processRank);
+
+	// root process arranges chunks one after another
+	std::vector<int> numbersOfEdgesForEachProcess;
+	std::vector<int> edgesDisplacements;
+	std::vector<int> offsets;
+	std::vector<int> targets;
+	std::vector<double> weights;
+	if (processRank == 0) {
+		std::vector<std::unique_ptr<SparseGraph>> chunks = divideSparseGraphIntoChunks(*graph, numbersOfColumnsForEachProcess);
+		for (auto& chunk : chunks) {
+			numbersOfEdgesForEachProcess.push_back(chunk->getNumberOfEdges());
+			offsets.insert(offsets.end(), chunk->getOffsets().begin(), chunk->getOffsets().end());
+			targets.insert(targets.end(), chunk->getTargets().begin(), chunk->getTargets().end());
+			weights.insert(weights.end(), chunk->getWeights().begin(), chunk->getWeights().end());
+			chunk.reset();
+		}
+		edgesDisplacements = computeDisplacements(numbersOfEdgesForEachProcess, 1);
+	}
+
+	int numberOfEdgesToHandle = -1;
+	MPI_Scatter(numbersOfEdgesForEachProcess.data(), 1, MPI_INT, &numberOfEdgesToHandle, 1, MPI_INT, 0, communicator);
+
+	std::vector<int> offsetsChunk(totalNumberOfVertices + 1, 0);
+	MPI_Scatter(offsets.data(), totalNumberOfVertices + 1, MPI_INT, 
+		offsetsChunk.data(), totalNumberOfVertices + 1, MPI_INT, 0, communicator);
+
+	std::vector<int> targetsChunk(numberOfEdgesToHandle, 0);
+	MPI_Scatterv(targets.data(), numbersOfEdgesForEachProcess.data(), edgesDisplacements.data(),
+		MPI_INT, targetsChunk.data(), numberOfEdgesToHandle, MPI_INT, 0, communicator);
+
+	std::vector<double> weightsChunk(numberOfEdgesToHandle, 0.0);
+	MPI_Scatterv(weights.data(), numbersOfEdgesForEachProcess.data(), edgesDisplacements.data(),
+		MPI_DOUBLE, weightsChunk.data(), numberOfEdgesToHandle, MPI_DOUBLE, 0, communicator);
+
+	return SparseGraph::fromCompressedArrays(std::move(offsetsChunk), std::move(targetsChunk), std::move(weightsChunk));
+}
+
+
+MPI_Datatype DijkstraMPISetup::createTransposedColumnDatatype(int totalNumberOfVertices, int numberOfColumnsToHandle) {
+
+	// one column - consecutive entries go to consecutive rows of the chunk
+	MPI_Datatype columnDatatype;
+	MPI_Type_vector(totalNumberOfVertices, 1, numberOfColumnsToHandle, MPI_DOUBLE, &columnDatatype);
+
+	// next column starts just one entry later
+	MPI_Datatype transposedColumnDatatype;
+	MPI_Type_create_resized(columnDatatype, 0, sizeof(double), &transposedColumnDatatype);
+	MPI_Type_commit(&transposedColumnDatatype);
+	MPI_Type_free(&columnDatatype);
+	return transposedColumnDatatype;
+}
+
+
+std::unique_ptr<SparseGraph> DijkstraMPISetup::scatterSparseGraphRows(const SparseGraph* graph, const std::vector<int>& numbersOfColumnsForEachProcess,
+	MPI_Comm communicator) {
+
+	int numberOfProcesses = 0;
+	int processRank = 0;
+	MPI_Comm_size(communicator, &numberOfProcesses);
+	MPI_Comm_rank(communicator, &processRank);
+
+	// every process gets its rows with offsets starting from 0 - one offset more than vertices
+	std::vector<int> numbersOfEdgesForEachProcess(numberOfProcesses, 0);
+	std::vector<int> edgesDisplacements;
+	std::vector<int> numbersOfOffsetsForEachProcess(numberOfProcesses, 0);
+	std::vector<int> offsetsDisplacements;
+	std::vector<int> offsets;
+	if (processRank == 0) {
+		ArrayView<int> graphOffsets = graph->getOffsets();
+		for (int p = 0; p < numberOfProcesses; ++p) {
+			std::pair<int, int> verticesRange = computeRangeOfVerticesToHandle(numbersOfColumnsForEachProcess, p);
+			numbersOfEdgesForEachProcess[p] = graphOffsets[verticesRange.second + 1] - graphOffsets[verticesRange.first];
+			numbersOfOffsetsForEachProcess[p] = numbersOfColumnsForEachProcess[p] + 1;
+			for (int v = verticesRange.first; v <= verticesRange.second + 1; ++v) {
+				offsets.push_back(graphOffsets[v] - graphOffsets[verticesRange.first]);
+			}
+		}
+		edgesDisplacements = computeDisplacements(numbersOfEdgesForEachProcess, 1);
+		offsetsDisplacements = computeDisplacements(numbersOfOffsetsForEachProcess, 1);
+	}
+
+	int numberOfEdgesToHandle = -1;
+	MPI_Scatter(numbersOfEdgesForEachProcess.data(), 1, MPI_INT, &numberOfEdgesToHandle, 1, MPI_INT, 0, communicator);
+
+	// rows of consecutive processes are consecutive parts of targets and weights, so they are sent without copying
+	std::vector<int> offsetsChunk(numbersOfColumnsForEachProcess[processRank] + 1, 0);
+	MPI_Scatterv(offsets.data(), numbersOfOffsetsForEachProcess.data(), offsetsDisplacements.data(),
+		MPI_INT, offsetsChunk.data(), static_cast<int>(offsetsChunk.size()), MPI_INT, 0, communicator);
+
+	std::vector<int> targetsChunk(numberOfEdgesToHandle, 0);
+	MPI_Scatterv(processRank == 0 ? graph->getTargets().data() : nullptr, numbersOfEdgesForEachProcess.data(), edgesDisplacements.data(),
+		MPI_INT, targetsChunk.data(), numberOfEdgesToHandle, MPI_INT, 0, communicator);
+
+	std::vector<double> weightsChunk(numberOfEdgesToHandle, 0.0);
+	MPI_Scatterv(processRank == 0 ? graph->getWeights().data() : nullptr, numbersOfEdgesForEachProcess.data(), edgesDisplacements.data(),
+		MPI_DOUBLE, weightsChunk.data(), numberOfEdgesToHandle, MPI_DOUBLE, 0, communicator);
+
+	return SparseGraph::fromCompressedArrays(std::move(offsetsChunk), std::move(targetsChunk), std::move(weightsChunk));
+}
+
+
+std::pair<int, int> DijkstraMPISetup::computeProcessGridDimensions(int numberOfProcesses) {
+	int dimensions[2] = { 0, 0 };
+	MPI_Dims_create(numberOfProcesses, 2, dimensions);
+	return std::make_pair(dimensions[0], dimensions[1]);
+}
+
+
+std::vector<std::pair<int, int>> DijkstraMPISetup::divideVerticesIntoRanges(int numberOfVertices, int numberOfParts) {
+	std::vector<int> numbersOfVertices = divideGraphMatrixIntoChunks(numberOfVertices, numberOfParts);
+	std::vector<int> firstVertices = computeDisplacements(numbersOfVertices, 1);
+	std::vector<std::pair<int, int>> ranges;
+	for (int i = 0; i < numberOfParts; ++i) {
+		ranges.push_back(std::make_pair(firstVertices.at(i), firstVertices.at(i) + numbersOfVertices.at(i) - 1));
+	}
+	return ranges;
+}
+
+
+MPI_Datatype DijkstraMPISetup::createMatrixBlockDatatype(int totalNumberOfVertices, const std::pair<int, int>& rowsRange, const std::pair<int, int>& columnsRange) {
+	int sizes[2] = { totalNumberOfVertices, totalNumberOfVertices };
+	int subsizes[2] = { rowsRange.second - rowsRange.first + 1, columnsRange.second - columnsRange.first + 1 };
+	int starts[2] = { rowsRange.first, columnsRange.first };
+
+	MPI_Datatype blockDatatype;
+	MPI_Type_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, MPI_DOUBLE, &blockDatatype);
+	MPI_Type_commit(&blockDatatype);
+	return blockDatatype;
+}
+
+
+std::unique_ptr<SparseGraph> DijkstraMPISetup::convertRowWiseChunkToSparseGraph(const std::vector<double>& rowWiseChunk, const std::pair<int, int>& verticesToHandleRange) {
+	int numberOfColumns = verticesToHandleRange.second - verticesToHandleRange.first + 1;
+	int numberOfVertices = numberOfColumns > 0 ? static_cast<int>(rowWiseChunk.size() / numberOfColumns) : 0;
+
+	std::vector<int> offsets(1, 0);
+	std::vector<int> targets;
+	std::vector<double> weights;
+	for (int i = 0; i < numberOfVertices; ++i) {
+		for (int j = 0; j < numberOfColumns; ++j) {
+			double weight = rowWiseChunk[static_cast<size_t>(i) * numberOfColumns + j];
+			if (weight >= 0.001) {
+				targets.push_back(verticesToHandleRange.first + j);
+				weights.push_back(weight);
+			}
+		}
+		offsets.push_back(static_cast<int>(targets.size()));
+	}
+	return SparseGraph::fromCompressedArrays(std::move(offsets), std::move(targets), std::move(weights));
+}
+
+
+std::vector<double> DijkstraMPISetup::extractMatrixChunk(const ArrayView<double>& columnWiseMatrix, int totalNumberOfVertices, const std::pair<int, int>& verticesToHandleRange, bool arrangeRowWise) {
+	int numberOfColumns = verticesToHandleRange.second - verticesToHandleRange.first + 1;
+	const double* firstColumn = columnWiseMatrix.data() + static_cast<size_t>(verticesToHandleRange.first) * totalNumberOfVertices;
+	if (!arrangeRowWise) {
+		return std::vector<double>(firstColumn, firstColumn + static_cast<size_t>(numberOfColumns) * totalNumberOfVertices);
+	}
+
+	std::vector<double> rowWiseChunk(static_cast<size_t>(numberOfColumns) * totalNumberOfVertices, 0);
+	for (int j = 0; j < numberOfColumns; ++j) {
+		for (int i = 0; i < totalNumberOfVertices; ++i) {
+			rowWiseChunk[static_cast<size_t>(i) * numberOfColumns + j] = firstColumn[static_cast<size_t>(j) * totalNumberOfVertices + i];
+		}
+	}
+	return rowWiseChunk;
+}
+
+
+std::unique_ptr<SparseGraph> DijkstraMPISetup::extractSparseGraphChunkFromBinaryFile(const std::string& filePath, const SparseGraph& graph, 
+	int numberOfProcesses, int processRank, const std::pair<int, int>& verticesToHandleRange) {
+
+	// block of the index can be used only if it contains exactly handled vertices
+	std::unique_ptr<MappedFile> mappedFile = MappedFile::open(filePath);
+	const BinaryGraphFile::Header* header = mappedFile ? BinaryGraphFile::readHeader(*mappedFile, filePath) : nullptr;
+	if (header != nullptr && header->layout == BinaryGraphFile::CompressedSparseRows && header->numberOfBlocks == static_cast<std::uint32_t>(numberOfProcesses)) {
+		const BinaryGraphFile::BlockIndexEntry& entry = BinaryGraphFile::getBlockIndexEntry(*mappedFile, processRank);
+		if (entry.firstVertex == verticesToHandleRange.first && entry.lastVertex == verticesToHandleRange.second) {
+			return SparseGraph::fromBinaryFile(filePath, processRank);
+		}
+	}
+	return graph.extractEdgesWithTargetsInRange(verticesToHandleRange);
 }
\ No newline at end of file
@@ -8,14 +8,20 @@
 
 #pragma once
 
+#include "ArrayView.h"
+#include "SparseGraph.h"
+#include "mpi.h"
+
+#include <memory>
+#include <string>
 #include <vector>
 #include <numeric>
 #include <algorithm>
 
 /// <summary>
 /// This class contains static methods used by root process to divide adjacency
-/// matrix into chunks. Each chunk is handled by one process. Please note that
-/// all methods are static.
+/// matrix into chunks. Each chunk is handled by one process. Vertices can be divided
+/// equally or by costs of handling them. Please note that all methods are static.
 /// </summary>
 class DijkstraMPISetup final
 {
@@ -85,26 +91,334 @@ public:
 
 	/// <summary>
 	/// Static method responsible for computing range of vertices that process
-	/// with given id will handle. 
+	/// with given id will handle. Processes handle consecutive ranges, but numbers
+	/// of vertices in them do not have to be equal.
 	/// </summary>
 	/// <returns>
 	/// Pair of integers that represents range of vertices given process will 
 	/// handle. This range/interval can be written as [a, b] (it is closed).
 	/// </returns>
-	/// <param name="matrixSide">
-	/// Size of adjacency matrix (in other words, number of all vertices in 
-	/// processed graph). 
+	/// <param name="numbersOfColumnsForEachProcess">
+	/// Numbers of adjacency matrix columns (graph vertices) each process should 
+	/// handle. Should be arranged using ranks given by MPI.
+	/// </param>
+	/// <param name="processRank">
+	/// Current process rank (value from MPI_Comm_rank function).
+	/// </param>
+	static std::pair<int, int> computeRangeOfVerticesToHandle(const std::vector<int>& numbersOfColumnsForEachProcess, int processRank);
+
+
+	/// <summary>
+	/// Static method responsible for computing costs of handling vertices of sparse
+	/// graph - every vertex costs one unit for being searched through in every iteration
+	/// and one more for every edge leading to it (edge is relaxed by process that
+	/// handles its target) or, when processes own edges leaving their vertices, for
+	/// every edge leaving it.
+	/// </summary>
+	/// <returns>
+	/// Vector of costs, one for each vertex.
+	/// </returns>
+	/// <param name="graph">
+	/// Whole graph stored in sparse form.
+	/// </param>
+	/// <param name="countEdgesLeavingVertices">
+	/// Boolean that indicates if edges are counted for their sources instead of targets.
+	/// </param>
+	static std::vector<double> computeCostsOfVertices(const SparseGraph& graph, bool countEdgesLeavingVertices = false);
+
+
+	/// <summary>
+	/// Static method responsible for dividing vertices into continous ranges with
+	/// costs as close to equal as possible. Every process gets at least one vertex
+	/// (unless there are fewer vertices than processes - then vertices are divided
+	/// the same way as by divideGraphMatrixIntoChunks).
+	/// </summary>
+	/// <returns>
+	/// Vector that contains number of vertices each process will handle.
+	/// </returns>
+	/// <param name="costsOfVertices">
+	/// Costs of handling vertices, one for each vertex.
 	/// </param>
 	/// <param name="numberOfProcesses">
 	/// Total number of processes that take part in algorithm execution.
 	/// </param>
-	/// <param name="processRank">
-	/// Current process rank (value from MPI_Comm_rank function).
+	static std::vector<int> divideVerticesByCosts(const std::vector<double>& costsOfVertices, int numberOfProcesses);
+
+
+	/// <summary>
+	/// Static method responsible for scaling costs of vertices to times measured by
+	/// processes that handled them - costs of vertices of every process are multiplied,
+	/// so that their sum is equal to time measured by this process. It corrects both
+	/// inaccurate model of costs and differences in speed of processes.
+	/// </summary>
+	/// <returns>
+	/// Vector of scaled costs, one for each vertex.
+	/// </returns>
+	/// <param name="costsOfVertices">
+	/// Costs of handling vertices, one for each vertex.
+	/// </param>
+	/// <param name="numbersOfColumnsForEachProcess">
+	/// Numbers of vertices handled by each process during measurement.
+	/// </param>
+	/// <param name="measuredTimes">
+	/// Times measured by each process.
+	/// </param>
+	static std::vector<double> scaleCostsOfVerticesToMeasuredTimes(std::vector<double> costsOfVertices, const std::vector<int>& numbersOfColumnsForEachProcess,
+		const std::vector<double>& measuredTimes);
+
+
+	/// <summary>
+	/// Static method responsible for computing imbalance of division of vertices -
+	/// ratio of the highest cost of a process to average cost of a process.
+	/// </summary>
+	/// <returns>
+	/// Imbalance, 1 if division is perfectly balanced.
+	/// </returns>
+	/// <param name="costsOfVertices">
+	/// Costs of handling vertices, one for each vertex.
+	/// </param>
+	/// <param name="numbersOfColumnsForEachProcess">
+	/// Numbers of vertices each process handles.
+	/// </param>
+	static double computeImbalance(const std::vector<double>& costsOfVertices, const std::vector<int>& numbersOfColumnsForEachProcess);
+
+
+	/// <summary>
+	/// Static method responsible for counting vertices of every part of graph partition
+	/// (see MultilevelPartitioner) - part p is handled by process p.
+	/// </summary>
+	/// <returns>
+	/// Vector that contains number of vertices each process will handle.
+	/// </returns>
+	/// <param name="parts">
+	/// Part of every vertex.
+	/// </param>
+	/// <param name="numberOfProcesses">
+	/// Total number of processes that take part in algorithm execution (number of parts).
+	/// </param>
+	static std::vector<int> countVerticesOfParts(const std::vector<int>& parts, int numberOfProcesses);
+
+
+	/// <summary>
+	/// Static method responsible for renumbering vertices of graph partition, so that every
+	/// process handles continous range of vertices - vertices of part 0 come first, then
+	/// vertices of part 1 and so on. Vertices of every part keep their order.
+	/// </summary>
+	/// <returns>
+	/// Vector with new number of every vertex.
+	/// </returns>
+	/// <param name="parts">
+	/// Part of every vertex.
+	/// </param>
+	/// <param name="numbersOfColumnsForEachProcess">
+	/// Numbers of vertices of every part (see countVerticesOfParts).
+	/// </param>
+	static std::vector<int> renumberVerticesByParts(const std::vector<int>& parts, const std::vector<int>& numbersOfColumnsForEachProcess);
+
+
+	/// <summary>
+	/// Static method responsible for dividing sparse graph into chunks that will be
+	/// handled by separate processes. Each chunk contains only those edges that lead
+	/// to vertices handled by given process (the same vertices as in dense version).
+	/// </summary>
+	/// <returns>
+	/// Vector of sparse graphs arranged using ranks given by MPI.
+	/// </returns>
+	/// <param name="graph">
+	/// Whole graph stored in sparse form.
+	/// </param>
+	/// <param name="numberOfColumnsForEachProcess">
+	/// Numbers of graph vertices each process should handle. Should be arranged using 
+	/// ranks given by MPI.
+	/// </param>
+	static std::vector<std::unique_ptr<SparseGraph>> divideSparseGraphIntoChunks(const SparseGraph& graph, const std::vector<int>& numbersOfColumnsForEachProcess);
+
+
+	/// <summary>
+	/// Static method responsible for sending sparse graph chunks from root process to all
+	/// processes - every process receives full offsets array, but only edges leading to
+	/// vertices it handles. It is a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Sparse graph chunk of current process.
+	/// </returns>
+	/// <param name="graph">
+	/// Whole graph stored in sparse form - used only by root process (rank 0).
+	/// </param>
+	/// <param name="numbersOfColumnsForEachProcess">
+	/// Numbers of graph vertices each process should handle - used only by root process.
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Total number of vertices in processed graph.
+	/// </param>
+	/// <param name="communicator">
+	/// MPI communicator with all processes.
+	/// </param>
+	static std::unique_ptr<SparseGraph> scatterSparseGraphChunks(const SparseGraph* graph, const std::vector<int>& numbersOfColumnsForEachProcess,
+		int totalNumberOfVertices, MPI_Comm communicator);
+
+
+	/// <summary>
+	/// Static method responsible for sending rows of sparse graph from root process to all
+	/// processes - every process receives only edges leaving vertices it handles (see
+	/// SparseGraph::extractRowsOfVerticesInRange), so no process except root stores
+	/// arrays proportional to size of the whole graph. It is a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Rows of vertices handled by current process.
+	/// </returns>
+	/// <param name="graph">
+	/// Whole graph stored in sparse form - used only by root process (rank 0).
+	/// </param>
+	/// <param name="numbersOfColumnsForEachProcess">
+	/// Numbers of graph vertices each process should handle - the same in all processes.
+	/// </param>
+	/// <param name="communicator">
+	/// MPI communicator with all processes.
+	/// </param>
+	static std::unique_ptr<SparseGraph> scatterSparseGraphRows(const SparseGraph* graph, const std::vector<int>& numbersOfColumnsForEachProcess,
+		MPI_Comm communicator);
+
+
+	/// <summary>
+	/// Static method responsible for creating MPI datatype that transposes adjacency
+	/// matrix chunk while it is being received. Root process sends columns of the matrix
+	/// (exactly as for column-wise chunks) and receiving process uses this datatype -
+	/// each received column is spread over consecutive rows of the chunk, so chunk is
+	/// arranged row-wise the moment MPI_Scatterv completes. Count passed to MPI_Scatterv
+	/// should be equal to number of columns to handle. Returned datatype is committed
+	/// and should be freed by the caller.
+	/// </summary>
+	/// <returns>
+	/// Committed MPI datatype that represents one column of row-wise arranged chunk.
+	/// </returns>
+	/// <param name="totalNumberOfVertices">
+	/// Total number of vertices in processed graph (length of the column).
 	/// </param>
 	/// <param name="numberOfColumnsToHandle">
 	/// Number of adjacency matrix columns (vertices) current process should handle.
 	/// </param>
-	static std::pair<int, int> computeRangeOfVerticesToHandle(int matrixSide, int numberOfProcesses, int processRank, int numberOfColumnsToHandle);
+	static MPI_Datatype createTransposedColumnDatatype(int totalNumberOfVertices, int numberOfColumnsToHandle);
+
+
+	/// <summary>
+	/// Static method responsible for choosing dimensions of two-dimensional grid of
+	/// processes - as close to square as possible (uses MPI_Dims_create). In such grid
+	/// adjacency matrix is divided into blocks of rows and columns instead of columns only.
+	/// </summary>
+	/// <returns>
+	/// Pair of integers - number of rows and number of columns of the grid. Their product
+	/// is equal to number of processes.
+	/// </returns>
+	/// <param name="numberOfProcesses">
+	/// Total number of processes that take part in algorithm execution.
+	/// </param>
+	static std::pair<int, int> computeProcessGridDimensions(int numberOfProcesses);
+
+
+	/// <summary>
+	/// Static method responsible for dividing range of vertices [0, numberOfVertices - 1]
+	/// into given number of continous parts - the same way divideGraphMatrixIntoChunks
+	/// does it. Useful for dividing both rows and columns in two-dimensional grid.
+	/// </summary>
+	/// <returns>
+	/// Vector of ranges [a, b] (closed, empty if b = a - 1), one for each part.
+	/// </returns>
+	/// <param name="numberOfVertices">
+	/// Total number of vertices in the graph.
+	/// </param>
+	/// <param name="numberOfParts">
+	/// Number of parts, for example number of rows of process grid.
+	/// </param>
+	static std::vector<std::pair<int, int>> divideVerticesIntoRanges(int numberOfVertices, int numberOfParts);
+
+
+	/// <summary>
+	/// Static method responsible for creating MPI datatype that describes one block of
+	/// matrix stored row-wise (for example in file) - rows and columns from given ranges.
+	/// It can be used as file view in MPI-IO. Returned datatype is committed and should be
+	/// freed by the caller. Both ranges should not be empty.
+	/// </summary>
+	/// <returns>
+	/// Committed MPI datatype that represents block of matrix of doubles.
+	/// </returns>
+	/// <param name="totalNumberOfVertices">
+	/// Total number of vertices in processed graph (number of rows and columns of matrix).
+	/// </param>
+	/// <param name="rowsRange">
+	/// Range of rows [a, b] that belong to the block.
+	/// </param>
+	/// <param name="columnsRange">
+	/// Range of columns [a, b] that belong to the block.
+	/// </param>
+	static MPI_Datatype createMatrixBlockDatatype(int totalNumberOfVertices, const std::pair<int, int>& rowsRange, const std::pair<int, int>& columnsRange);
+
+
+	/// <summary>
+	/// Static method responsible for converting row-wise arranged adjacency matrix chunk
+	/// into sparse graph chunk - the same one that divideSparseGraphIntoChunks would create
+	/// for this process. Weights lower than 0.001 are treated as no edge.
+	/// </summary>
+	/// <returns>
+	/// Sparse graph with all vertices, but only edges leading to vertices from given range.
+	/// </returns>
+	/// <param name="rowWiseChunk">
+	/// Adjacency matrix chunk arranged row-wise - weights of edges leaving consecutive vertices.
+	/// </param>
+	/// <param name="verticesToHandleRange">
+	/// Range of vertices [a, b] that correspond to columns of the chunk.
+	/// </param>
+	static std::unique_ptr<SparseGraph> convertRowWiseChunkToSparseGraph(const std::vector<double>& rowWiseChunk, const std::pair<int, int>& verticesToHandleRange);
+
+
+	/// <summary>
+	/// Static method responsible for copying columns of handled vertices from whole
+	/// adjacency matrix - for example mapped from binary graph file by every process.
+	/// </summary>
+	/// <returns>
+	/// Adjacency matrix chunk arranged column-wise, or row-wise if requested.
+	/// </returns>
+	/// <param name="columnWiseMatrix">
+	/// Whole adjacency matrix arranged column-wise.
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Total number of vertices in processed graph.
+	/// </param>
+	/// <param name="verticesToHandleRange">
+	/// Range of vertices [a, b] handled by current process.
+	/// </param>
+	/// <param name="arrangeRowWise">
+	/// Boolean that indicates if chunk should be arranged row-wise (as TransposedMatrixChunk).
+	/// </param>
+	static std::vector<double> extractMatrixChunk(const ArrayView<double>& columnWiseMatrix, int totalNumberOfVertices, const std::pair<int, int>& verticesToHandleRange, bool arrangeRowWise);
+
+
+	/// <summary>
+	/// Static method responsible for creating sparse graph chunk of current process from
+	/// binary graph file. If file contains column-block index prepared for this number of
+	/// processes, block of current process is mapped directly; otherwise edges leading to
+	/// handled vertices are extracted from the whole graph.
+	/// </summary>
+	/// <returns>
+	/// Sparse graph with all vertices, but only edges leading to handled vertices.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to binary graph file.
+	/// </param>
+	/// <param name="graph">
+	/// Whole graph mapped from the same file.
+	/// </param>
+	/// <param name="numberOfProcesses">
+	/// Total number of processes that take part in algorithm execution.
+	/// </param>
+	/// <param name="processRank">
+	/// Current process rank (value from MPI_Comm_rank function).
+	/// </param>
+	/// <param name="verticesToHandleRange">
+	/// Range of vertices [a, b] handled by current process.
+	/// </param>
+	static std::unique_ptr<SparseGraph> extractSparseGraphChunkFromBinaryFile(const std::string& filePath, const SparseGraph& graph, 
+		int numberOfProcesses, int processRank, const std::pair<int, int>& verticesToHandleRange);
 
 };
 
@@ -0,0 +1,229 @@
+#include "FloydWarshallMPI.h"
+#include "DijkstraMPISetup.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+
+FloydWarshallMPI::FloydWarshallMPI(int totalNumberOfVertices, MPI_Comm communicator) : m_totalNumberOfVertices(totalNumberOfVertices) {
+
+	// create grid of processes without reordering - first process of the grid is first process of communicator
+	int numberOfProcesses = 0;
+	MPI_Comm_size(communicator, &numberOfProcesses);
+	std::pair<int, int> gridDimensions = DijkstraMPISetup::computeProcessGridDimensions(numberOfProcesses);
+	int dimensions[2] = { gridDimensions.first, gridDimensions.second };
+	int periods[2] = { 0, 0 };
+	MPI_Cart_create(communicator, 2, dimensions, periods, 0, &m_gridCommunicator);
+
+	int gridRank = 0;
+	int coordinates[2] = { 0, 0 };
+	MPI_Comm_rank(m_gridCommunicator, &gridRank);
+	MPI_Cart_coords(m_gridCommunicator, gridRank, 2, coordinates);
+	m_gridRow = coordinates[0];
+	m_gridColumn = coordinates[1];
+
+	// processes in one row of the grid - their ranks are equal to their columns, and vice versa
+	int rowRemainingDimensions[2] = { 0, 1 };
+	int columnRemainingDimensions[2] = { 1, 0 };
+	MPI_Cart_sub(m_gridCommunicator, rowRemainingDimensions, &m_rowCommunicator);
+	MPI_Cart_sub(m_gridCommunicator, columnRemainingDimensions, &m_columnCommunicator);
+
+	m_rowsRanges = DijkstraMPISetup::divideVerticesIntoRanges(totalNumberOfVertices, gridDimensions.first);
+	m_columnsRanges = DijkstraMPISetup::divideVerticesIntoRanges(totalNumberOfVertices, gridDimensions.second);
+	m_numberOfRows = getRowsRange().second - getRowsRange().first + 1;
+	m_numberOfColumns = getColumnsRange().second - getColumnsRange().first + 1;
+}
+
+
+FloydWarshallMPI::~FloydWarshallMPI() {
+	MPI_Comm_free(&m_columnCommunicator);
+	MPI_Comm_free(&m_rowCommunicator);
+	MPI_Comm_free(&m_gridCommunicator);
+}
+
+
+void FloydWarshallMPI::loadAdjacencyMatrix(AdjacencyMatrixReader* reader) {
+
+	// rows are sent in batches, so first process does not store more than this number of weights at once
+	const long long maximalNumberOfWeightsInBatch = 1 << 24;
+
+	int gridRank = 0;
+	int numberOfProcesses = 0;
+	MPI_Comm_rank(m_gridCommunicator, &gridRank);
+	MPI_Comm_size(m_gridCommunicator, &numberOfProcesses);
+	m_block.assign(static_cast<size_t>(m_numberOfRows) * m_numberOfColumns, 0);
+
+	std::vector<int> ownersOfBlocks = findOwnersOfBlocks();
+	int numberOfGridColumns = static_cast<int>(m_columnsRanges.size());
+	int numberOfRowsInBatch = static_cast<int>(std::max(1LL, maximalNumberOfWeightsInBatch / std::max(1, m_totalNumberOfVertices)));
+
+	// every batch of rows is divided between processes of one row of the grid
+	std::vector<double> row;
+	std::vector<double> sendBuffer;
+	for (int gridRow = 0; gridRow < static_cast<int>(m_rowsRanges.size()); ++gridRow) {
+		const std::pair<int, int>& rowsRange = m_rowsRanges.at(gridRow);
+		for (int firstRow = rowsRange.first; firstRow <= rowsRange.second; firstRow += numberOfRowsInBatch) {
+			int numberOfRows = std::min(numberOfRowsInBatch, rowsRange.second - firstRow + 1);
+
+			// pieces of rows are grouped by processes that handle their columns
+			std::vector<int> sendCounts(numberOfProcesses, 0);
+			std::vector<int> sendDisplacements(numberOfProcesses, 0);
+			if (gridRank == 0) {
+				sendBuffer.assign(static_cast<size_t>(numberOfRows) * m_totalNumberOfVertices, 0);
+				for (int i = 0; i < numberOfRows && reader->readNextRow(row); ++i) {
+					for (int gridColumn = 0; gridColumn < numberOfGridColumns; ++gridColumn) {
+						const std::pair<int, int>& columnsRange = m_columnsRanges.at(gridColumn);
+						int numberOfColumns = columnsRange.second - columnsRange.first + 1;
+						std::copy(row.begin() + columnsRange.first, row.begin() + columnsRange.second + 1,
+							sendBuffer.begin() + static_cast<size_t>(numberOfRows) * columnsRange.first + static_cast<size_t>(i) * numberOfColumns);
+					}
+				}
+				for (int gridColumn = 0; gridColumn < numberOfGridColumns; ++gridColumn) {
+					const std::pair<int, int>& columnsRange = m_columnsRanges.at(gridColumn);
+					int owner = ownersOfBlocks.at(gridRow * numberOfGridColumns + gridColumn);
+					sendCounts[owner] = numberOfRows * (columnsRange.second - columnsRange.first + 1);
+					sendDisplacements[owner] = numberOfRows * columnsRange.first;
+				}
+			}
+
+			// processes from other rows of the grid take part in scatter, but receive nothing
+			int receiveCount = m_gridRow == gridRow ? numberOfRows * m_numberOfColumns : 0;
+			double* receiveBuffer = m_block.data() + (m_gridRow == gridRow ? static_cast<size_t>(firstRow - rowsRange.first) * m_numberOfColumns : 0);
+			MPI_Scatterv(sendBuffer.data(), sendCounts.data(), sendDisplacements.data(), MPI_DOUBLE,
+				receiveBuffer, receiveCount, MPI_DOUBLE, 0, m_gridCommunicator);
+		}
+	}
+
+	convertWeightsToDistances();
+}
+
+
+void FloydWarshallMPI::loadAdjacencyMatrix(ParallelMatrixReader& reader) {
+	m_block = reader.distributeBlocks(m_rowsRanges, m_columnsRanges, findOwnersOfBlocks());
+	convertWeightsToDistances();
+}
+
+
+void FloydWarshallMPI::run() {
+
+	std::vector<double> pivotRow(m_numberOfColumns, 0);
+	std::vector<double> pivotColumn(m_numberOfRows, 0);
+
+	for (int k = 0; k < m_totalNumberOfVertices; ++k) {
+
+		// owners of row k send its part to other processes in their columns of the grid
+		int gridRowOfPivot = findPartOfVertex(m_rowsRanges, k);
+		if (m_gridRow == gridRowOfPivot) {
+			const double* row = m_block.data() + static_cast<size_t>(k - getRowsRange().first) * m_numberOfColumns;
+			std::copy(row, row + m_numberOfColumns, pivotRow.begin());
+		}
+		MPI_Bcast(pivotRow.data(), m_numberOfColumns, MPI_DOUBLE, gridRowOfPivot, m_columnCommunicator);
+
+		// owners of column k send its part to other processes in their rows of the grid
+		int gridColumnOfPivot = findPartOfVertex(m_columnsRanges, k);
+		if (m_gridColumn == gridColumnOfPivot) {
+			for (int i = 0; i < m_numberOfRows; ++i) {
+				pivotColumn[i] = m_block[static_cast<size_t>(i) * m_numberOfColumns + (k - getColumnsRange().first)];
+			}
+		}
+		MPI_Bcast(pivotColumn.data(), m_numberOfRows, MPI_DOUBLE, gridColumnOfPivot, m_rowCommunicator);
+
+		// paths that go through vertex k - row k and column k do not change in this iteration
+		for (int i = 0; i < m_numberOfRows; ++i) {
+			double distanceToPivot = pivotColumn[i];
+			if (distanceToPivot == std::numeric_limits<double>::infinity()) {
+				continue;
+			}
+			double* row = m_block.data() + static_cast<size_t>(i) * m_numberOfColumns;
+			for (int j = 0; j < m_numberOfColumns; ++j) {
+				double altDistance = distanceToPivot + pivotRow[j];
+				row[j] = altDistance < row[j] ? altDistance : row[j];
+			}
+		}
+	}
+}
+
+
+bool FloydWarshallMPI::writeDistancesToFile(const std::string& filePath) {
+
+	MPI_File file;
+	if (MPI_File_open(m_gridCommunicator, filePath.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+		std::cout << "Nie mozna utworzyc pliku " << filePath << "." << std::endl;
+		return false;
+	}
+	MPI_File_set_size(file, 0);
+
+	// header is written by first process only
+	const int headerSize = 24;
+	int gridRank = 0;
+	MPI_Comm_rank(m_gridCommunicator, &gridRank);
+	if (gridRank == 0) {
+		char header[headerSize];
+		std::uint32_t version = 1;
+		std::uint32_t sizeOfDistance = sizeof(double);
+		std::int64_t numberOfVertices = m_totalNumberOfVertices;
+		std::memcpy(header, "APSPDIST", 8);
+		std::memcpy(header + 8, &version, sizeof(version));
+		std::memcpy(header + 12, &sizeOfDistance, sizeof(sizeOfDistance));
+		std::memcpy(header + 16, &numberOfVertices, sizeof(numberOfVertices));
+		MPI_File_write_at(file, 0, header, headerSize, MPI_BYTE, MPI_STATUS_IGNORE);
+	}
+
+	// every process sees only its own block of distance table
+	if (m_numberOfRows > 0 && m_numberOfColumns > 0) {
+		MPI_Datatype blockDatatype = DijkstraMPISetup::createMatrixBlockDatatype(m_totalNumberOfVertices, getRowsRange(), getColumnsRange());
+		MPI_File_set_view(file, headerSize, MPI_DOUBLE, blockDatatype, "native", MPI_INFO_NULL);
+		MPI_File_write_all(file, m_block.data(), static_cast<int>(m_block.size()), MPI_DOUBLE, MPI_STATUS_IGNORE);
+		MPI_Type_free(&blockDatatype);
+	}
+	else {
+		MPI_File_set_view(file, headerSize, MPI_DOUBLE, MPI_DOUBLE, "native", MPI_INFO_NULL);
+		MPI_File_write_all(file, nullptr, 0, MPI_DOUBLE, MPI_STATUS_IGNORE);
+	}
+
+	MPI_File_close(&file);
+	return true;
+}
+
+
+int FloydWarshallMPI::findPartOfVertex(const std::vector<std::pair<int, int>>& ranges, int vertex) {
+	int part = 0;
+	while (vertex > ranges.at(part).second) {
+		++part;
+	}
+	return part;
+}
+
+
+std::vector<int> FloydWarshallMPI::findOwnersOfBlocks() const {
+	std::vector<int> ownersOfBlocks;
+	for (int gridRow = 0; gridRow < static_cast<int>(m_rowsRanges.size()); ++gridRow) {
+		for (int gridColumn = 0; gridColumn < static_cast<int>(m_columnsRanges.size()); ++gridColumn) {
+			int coordinates[2] = { gridRow, gridColumn };
+			int ownerRank = 0;
+			MPI_Cart_rank(m_gridCommunicator, coordinates, &ownerRank);
+			ownersOfBlocks.push_back(ownerRank);
+		}
+	}
+	return ownersOfBlocks;
+}
+
+
+void FloydWarshallMPI::convertWeightsToDistances() {
+
+	// missing edges are infinitely long, distance from vertex to itself is 0
+	for (int i = 0; i < m_numberOfRows; ++i) {
+		for (int j = 0; j < m_numberOfColumns; ++j) {
+			double& distance = m_block[static_cast<size_t>(i) * m_numberOfColumns + j];
+			if (getRowsRange().first + i == getColumnsRange().first + j) {
+				distance = 0;
+			}
+			else if (distance < 0.001) {
+				distance = std::numeric_limits<double>::infinity();
+			}
+		}
+	}
+}
@@ -0,0 +1,165 @@
+/**
+*	@file FloydWarshallMPI.h
+*	@brief This file contains MPI implementation of all-pairs shortest paths
+*	(Floyd-Warshall algorithm) working on two-dimensional grid of processes.
+*/
+
+#pragma once
+
+#include "AdjacencyMatrixReader.h"
+#include "ParallelMatrixReader.h"
+#include "mpi.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class contains all-pairs shortest paths implementation created using MPI.
+/// Processes form two-dimensional grid and every process stores only its own
+/// block of distance matrix (rows and columns from its ranges), so no process
+/// ever holds more than about N^2 / p distances. In iteration k of Floyd-Warshall
+/// algorithm the part of row k is broadcast along every column of the grid, the
+/// part of column k along every row of the grid, and then every process updates
+/// its block. Please note that this class is final - to use it, consider
+/// composition (not inheritance).
+/// </summary>
+/// <remarks>
+/// Distance table file starts with 24-byte header: 8 characters <c>APSPDIST</c>,
+/// 32-bit format version (1), 32-bit size of one distance in bytes (8) and 64-bit
+/// number of vertices N. Then N * N doubles follow, row after row - entry [i][j] is
+/// distance from vertex i to vertex j (infinity if j can not be reached). All numbers
+/// are written in native byte order of the machine.
+/// </remarks>
+class FloydWarshallMPI final {
+
+public:
+
+	/// <summary>
+	/// FloydWarshallMPI class constructor. Creates grid of processes and communicators
+	/// of its rows and columns, and computes ranges of rows and columns of distance
+	/// matrix that belong to this process. It is a collective operation.
+	/// </summary>
+	/// <param name="totalNumberOfVertices">
+	/// Integer number that represents total number of vertices in processed graph.
+	/// </param>
+	/// <param name="communicator">
+	/// MPI communicator with all processes that take part in algorithm execution.
+	/// </param>
+	FloydWarshallMPI(int totalNumberOfVertices, MPI_Comm communicator);
+
+
+	/// <summary>
+	/// Destructor - frees communicators of the grid.
+	/// </summary>
+	~FloydWarshallMPI();
+
+
+	FloydWarshallMPI(const FloydWarshallMPI&) = delete;
+	FloydWarshallMPI& operator=(const FloydWarshallMPI&) = delete;
+
+
+	/// <summary>
+	/// Distributes adjacency matrix between processes - first process of the grid reads
+	/// it row after row and scatters every batch of rows between processes of one row of
+	/// the grid (MPI_Scatterv), so whole matrix is never stored in memory. Weights lower
+	/// than 0.001 are treated as no edge. It is a collective operation.
+	/// </summary>
+	/// <param name="reader">
+	/// Reader of adjacency matrix file - used only by first process of the grid, others
+	/// can pass nullptr.
+	/// </param>
+	void loadAdjacencyMatrix(AdjacencyMatrixReader* reader);
+
+
+	/// <summary>
+	/// Distributes adjacency matrix between processes - every process parses its own part
+	/// of text file and weights are sent directly to owners of their blocks. Weights lower
+	/// than 0.001 are treated as no edge. It is a collective operation.
+	/// </summary>
+	/// <param name="reader">
+	/// Parallel reader of adjacency matrix file, created with the same communicator as
+	/// the grid.
+	/// </param>
+	void loadAdjacencyMatrix(ParallelMatrixReader& reader);
+
+
+	/// <summary>
+	/// All-pairs shortest paths implementation. Runs Floyd-Warshall algorithm on blocks
+	/// of distance matrix. It is a collective operation.
+	/// </summary>
+	void run();
+
+
+	/// <summary>
+	/// Writes distance table to binary file using MPI-IO - every process writes its own
+	/// block. See class description for the format. It is a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file has been written.
+	/// </returns>
+	/// <param name="filePath">
+	/// Path to output file. Existing file is overwritten.
+	/// </param>
+	bool writeDistancesToFile(const std::string& filePath);
+
+
+	/// <summary>
+	/// Returns dimensions of process grid - number of rows and number of columns.
+	/// </summary>
+	inline std::pair<int, int> getProcessGridDimensions() const {
+		return std::make_pair(static_cast<int>(m_rowsRanges.size()), static_cast<int>(m_columnsRanges.size()));
+	}
+
+
+	/// <summary>
+	/// Returns range of rows [a, b] of distance matrix that belong to this process.
+	/// </summary>
+	inline const std::pair<int, int>& getRowsRange() const {
+		return m_rowsRanges.at(m_gridRow);
+	}
+
+
+	/// <summary>
+	/// Returns range of columns [a, b] of distance matrix that belong to this process.
+	/// </summary>
+	inline const std::pair<int, int>& getColumnsRange() const {
+		return m_columnsRanges.at(m_gridColumn);
+	}
+
+private:
+
+	/// <summary>
+	/// Finds part (row or column of the grid) that given vertex belongs to.
+	/// </summary>
+	static int findPartOfVertex(const std::vector<std::pair<int, int>>& ranges, int vertex);
+
+
+	/// <summary>
+	/// Returns ranks of processes that handle blocks of distance matrix - block in row r
+	/// and column c of the grid belongs to process at index r * number of columns + c.
+	/// </summary>
+	std::vector<int> findOwnersOfBlocks() const;
+
+
+	/// <summary>
+	/// Turns weights in block into initial distances - missing edges are infinitely long,
+	/// distance from vertex to itself is 0.
+	/// </summary>
+	void convertWeightsToDistances();
+
+
+	int m_totalNumberOfVertices;
+	MPI_Comm m_gridCommunicator;
+	MPI_Comm m_rowCommunicator;
+	MPI_Comm m_columnCommunicator;
+	int m_gridRow = 0;
+	int m_gridColumn = 0;
+	std::vector<std::pair<int, int>> m_rowsRanges;
+	std::vector<std::pair<int, int>> m_columnsRanges;
+
+	int m_numberOfRows = 0;
+	int m_numberOfColumns = 0;
+	std::vector<double> m_block;
+
+};
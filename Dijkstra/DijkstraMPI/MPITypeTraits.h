@@ -0,0 +1,136 @@
+/**
+*	@file MPITypeTraits.h
+*	@brief This file contains traits that map C++ types used by algorithm
+*	implementations to MPI datatypes and reduction operations.
+*/
+
+#pragma once
+
+#include "VertexData.h"
+#include "mpi.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/// <summary>
+/// Traits of type sent with MPI - getDatatype() returns MPI datatype that
+/// describes it. Specializations exist for types of weights, distances and
+/// vertex numbers used in this project.
+/// </summary>
+template <typename T>
+struct MPITypeTraits;
+
+
+template <>
+struct MPITypeTraits<double> {
+	static MPI_Datatype getDatatype() {
+		return MPI_DOUBLE;
+	}
+};
+
+
+template <>
+struct MPITypeTraits<float> {
+	static MPI_Datatype getDatatype() {
+		return MPI_FLOAT;
+	}
+};
+
+
+template <>
+struct MPITypeTraits<int> {
+	static MPI_Datatype getDatatype() {
+		return MPI_INT;
+	}
+};
+
+
+template <>
+struct MPITypeTraits<std::uint64_t> {
+	static MPI_Datatype getDatatype() {
+		return MPI_UINT64_T;
+	}
+};
+
+
+template <>
+struct MPITypeTraits<std::uint16_t> {
+	static MPI_Datatype getDatatype() {
+		return MPI_UINT16_T;
+	}
+};
+
+
+/// <summary>
+/// Traits of VertexData - besides datatype, getMinimumOperation() returns
+/// reduction that finds vertex with minimal distance (ties go to vertex with
+/// smaller number, exactly like MPI_MINLOC does). Predefined MPI_DOUBLE_INT and
+/// MPI_FLOAT_INT pairs with MPI_MINLOC are used when they match the structure,
+/// for other combinations struct datatype and user operation are created on
+/// first use and live until MPI_Finalize.
+/// </summary>
+template <typename DistanceType>
+struct MPITypeTraits<BasicVertexData<DistanceType>> {
+
+	using VertexDataType = BasicVertexData<DistanceType>;
+
+	static MPI_Datatype getDatatype() {
+		if constexpr (checkIfHasPredefinedPair()) {
+			return std::is_same<DistanceType, double>::value ? MPI_DOUBLE_INT : MPI_FLOAT_INT;
+		}
+		else {
+			static MPI_Datatype datatype = createDatatype();
+			return datatype;
+		}
+	}
+
+	static MPI_Op getMinimumOperation() {
+		if constexpr (checkIfHasPredefinedPair()) {
+			return MPI_MINLOC;
+		}
+		else {
+			static MPI_Op operation = createMinimumOperation();
+			return operation;
+		}
+	}
+
+private:
+
+	static constexpr bool checkIfHasPredefinedPair() {
+		return std::is_same<DistanceType, double>::value || std::is_same<DistanceType, float>::value;
+	}
+
+	static MPI_Datatype createDatatype() {
+		int blockLengths[2] = { 1, 1 };
+		MPI_Aint displacements[2] = { offsetof(VertexDataType, distance), offsetof(VertexDataType, vertexNumber) };
+		MPI_Datatype types[2] = { MPITypeTraits<DistanceType>::getDatatype(), MPITypeTraits<int>::getDatatype() };
+		MPI_Datatype structType;
+		MPI_Type_create_struct(2, blockLengths, displacements, types, &structType);
+
+		// padding at the end of structure has to be included, so arrays of structures can be sent
+		MPI_Datatype datatype;
+		MPI_Type_create_resized(structType, 0, sizeof(VertexDataType), &datatype);
+		MPI_Type_commit(&datatype);
+		MPI_Type_free(&structType);
+		return datatype;
+	}
+
+	static MPI_Op createMinimumOperation() {
+		MPI_Op operation;
+		MPI_Op_create(&minimum, 1, &operation);
+		return operation;
+	}
+
+	static void minimum(void* input, void* inputOutput, int* length, MPI_Datatype*) {
+		const VertexDataType* lhs = static_cast<const VertexDataType*>(input);
+		VertexDataType* rhs = static_cast<VertexDataType*>(inputOutput);
+		for (int i = 0; i < *length; ++i) {
+			if (lhs[i].distance < rhs[i].distance
+				|| (lhs[i].distance == rhs[i].distance && lhs[i].vertexNumber < rhs[i].vertexNumber)) {
+				rhs[i] = lhs[i];
+			}
+		}
+	}
+
+};
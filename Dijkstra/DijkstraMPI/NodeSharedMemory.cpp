@@ -0,0 +1,108 @@
+#include "NodeSharedMemory.h"
+
+#include <vector>
+
+
+MPI_Comm NodeSharedMemory::createNodeOrderedCommunicator(MPI_Comm communicator) {
+
+	int rank = 0;
+	int numberOfProcesses = 0;
+	MPI_Comm_rank(communicator, &rank);
+	MPI_Comm_size(communicator, &numberOfProcesses);
+
+	// every process learns rank of the leader of its node - it becomes the key of the whole node
+	MPI_Comm nodeCommunicator;
+	MPI_Comm_split_type(communicator, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeCommunicator);
+	int rankOnNode = 0;
+	MPI_Comm_rank(nodeCommunicator, &rankOnNode);
+	int leaderRank = rank;
+	MPI_Bcast(&leaderRank, 1, MPI_INT, 0, nodeCommunicator);
+	MPI_Comm_free(&nodeCommunicator);
+
+	MPI_Comm orderedCommunicator;
+	MPI_Comm_split(communicator, 0, leaderRank * numberOfProcesses + rankOnNode, &orderedCommunicator);
+	return orderedCommunicator;
+}
+
+
+NodeSharedMemory::NodeSharedMemory(MPI_Comm communicator) {
+
+	int rank = 0;
+	MPI_Comm_rank(communicator, &rank);
+	MPI_Comm_split_type(communicator, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &m_nodeCommunicator);
+	MPI_Comm_rank(m_nodeCommunicator, &m_rankOnNode);
+	MPI_Comm_size(m_nodeCommunicator, &m_numberOfProcessesOnNode);
+	MPI_Comm_split(communicator, m_rankOnNode == 0 ? 0 : MPI_UNDEFINED, rank, &m_leadersCommunicator);
+
+	// slots of all processes of the node and one for global minimum are allocated by node leader
+	MPI_Aint sizeOfSlots = m_rankOnNode == 0 ? (m_numberOfProcessesOnNode + 1) * static_cast<MPI_Aint>(sizeof(*m_reductionSlots)) : 0;
+	void* baseAddress = nullptr;
+	MPI_Win_allocate_shared(sizeOfSlots, 1, MPI_INFO_NULL, m_nodeCommunicator, &baseAddress, &m_reductionWindow);
+	MPI_Aint sizeOfLeaderSlots = 0;
+	int displacementUnit = 0;
+	MPI_Win_shared_query(m_reductionWindow, 0, &sizeOfLeaderSlots, &displacementUnit, &baseAddress);
+	m_reductionSlots = static_cast<CacheLinePadded<unsigned char[64]>*>(baseAddress);
+
+	// window is accessed with loads and stores only - synchronization needs passive target epoch
+	MPI_Win_lock_all(MPI_MODE_NOCHECK, m_reductionWindow);
+}
+
+
+NodeSharedMemory::~NodeSharedMemory() {
+	if (m_matrixWindow != MPI_WIN_NULL) {
+		MPI_Win_unlock_all(m_matrixWindow);
+		MPI_Win_free(&m_matrixWindow);
+	}
+	MPI_Win_unlock_all(m_reductionWindow);
+	MPI_Win_free(&m_reductionWindow);
+	if (m_leadersCommunicator != MPI_COMM_NULL) {
+		MPI_Comm_free(&m_leadersCommunicator);
+	}
+	MPI_Comm_free(&m_nodeCommunicator);
+}
+
+
+ArrayView<double> NodeSharedMemory::distributeMatrixColumns(const ArrayView<double>& columnWiseMatrix, int totalNumberOfVertices, int numberOfColumnsToHandle) {
+
+	// segments of processes of the node are allocated one after another, so columns of the whole node are continous
+	MPI_Aint sizeOfColumns = static_cast<MPI_Aint>(numberOfColumnsToHandle) * totalNumberOfVertices * sizeof(double);
+	double* columns = nullptr;
+	MPI_Win_allocate_shared(sizeOfColumns, sizeof(double), MPI_INFO_NULL, m_nodeCommunicator, &columns, &m_matrixWindow);
+	MPI_Win_lock_all(MPI_MODE_NOCHECK, m_matrixWindow);
+
+	int numberOfColumnsOnNode = 0;
+	MPI_Reduce(&numberOfColumnsToHandle, &numberOfColumnsOnNode, 1, MPI_INT, MPI_SUM, 0, m_nodeCommunicator);
+
+	// node leader receives columns of all processes of its node, starting at its own segment
+	if (m_rankOnNode == 0) {
+		int numberOfNodes = 0;
+		int leaderRank = 0;
+		MPI_Comm_size(m_leadersCommunicator, &numberOfNodes);
+		MPI_Comm_rank(m_leadersCommunicator, &leaderRank);
+
+		std::vector<int> numbersOfColumnsForEachNode(numberOfNodes, 0);
+		std::vector<int> columnsDisplacements(numberOfNodes, 0);
+		MPI_Gather(&numberOfColumnsOnNode, 1, MPI_INT, numbersOfColumnsForEachNode.data(), 1, MPI_INT, 0, m_leadersCommunicator);
+		for (int i = 1; i < numberOfNodes; ++i) {
+			columnsDisplacements[i] = columnsDisplacements[i - 1] + numbersOfColumnsForEachNode[i - 1];
+		}
+
+		// whole column is one element, so counts do not overflow for large graphs
+		MPI_Datatype columnDatatype;
+		MPI_Type_contiguous(totalNumberOfVertices, MPI_DOUBLE, &columnDatatype);
+		MPI_Type_commit(&columnDatatype);
+		MPI_Scatterv(leaderRank == 0 ? columnWiseMatrix.data() : nullptr, numbersOfColumnsForEachNode.data(), columnsDisplacements.data(), columnDatatype,
+			columns, numberOfColumnsOnNode, columnDatatype, 0, m_leadersCommunicator);
+		MPI_Type_free(&columnDatatype);
+	}
+	synchronizeNode(m_matrixWindow);
+
+	return ArrayView<double>(columns, static_cast<size_t>(numberOfColumnsToHandle) * totalNumberOfVertices);
+}
+
+
+void NodeSharedMemory::synchronizeNode(MPI_Win window) {
+	MPI_Win_sync(window);
+	MPI_Barrier(m_nodeCommunicator);
+	MPI_Win_sync(window);
+}
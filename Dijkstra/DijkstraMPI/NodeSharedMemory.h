@@ -0,0 +1,166 @@
+/**
+*	@file NodeSharedMemory.h
+*	@brief This file contains class that lets processes running on the same node
+*	share one copy of their part of the graph and combine their minima in shared
+*	memory, using MPI-3 shared memory windows.
+*/
+
+#pragma once
+
+#include "ArrayView.h"
+#include "MPITypeTraits.h"
+#include "ThreadTeam.h"
+#include "mpi.h"
+
+/// <summary>
+/// This class groups processes by nodes (MPI_Comm_split_type with MPI_COMM_TYPE_SHARED).
+/// Columns of adjacency matrix handled by all processes of a node are stored in one shared
+/// memory window - only node leader (process with the lowest rank on the node) receives them
+/// from first process, in one message, and every process reads its own columns directly from
+/// the window. Closest vertices are reduced hierarchically: processes write their local minima
+/// to shared memory, node leader combines them and takes part in MPI_Allreduce with other node
+/// leaders only, then it writes global minimum back to shared memory. Processes of a node have
+/// to handle continous ranges of vertices, so communicator passed to constructor should be
+/// created from communicator returned by createNodeOrderedCommunicator.
+/// </summary>
+class NodeSharedMemory final {
+
+public:
+
+	/// <summary>
+	/// Creates communicator with the same processes as given one, ordered so that processes
+	/// running on the same node have consecutive ranks. Nodes are ordered by the lowest rank
+	/// of their processes and processes of a node keep their order, so first process stays
+	/// the first one. It is a collective operation.
+	/// </summary>
+	/// <returns>
+	/// New communicator - it should be freed with MPI_Comm_free.
+	/// </returns>
+	/// <param name="communicator">
+	/// Communicator with processes that should be ordered.
+	/// </param>
+	static MPI_Comm createNodeOrderedCommunicator(MPI_Comm communicator);
+
+
+	/// <summary>
+	/// NodeSharedMemory class constructor. Splits processes of communicator by nodes, creates
+	/// communicator of node leaders and allocates shared memory used by reductions. It is a
+	/// collective operation.
+	/// </summary>
+	/// <param name="communicator">
+	/// Communicator with processes that take part in algorithm execution, ordered by nodes.
+	/// </param>
+	NodeSharedMemory(MPI_Comm communicator);
+
+
+	/// <summary>
+	/// NodeSharedMemory class destructor. Frees shared memory windows and communicators - it
+	/// is a collective operation, so all processes have to destroy their objects.
+	/// </summary>
+	~NodeSharedMemory();
+
+
+	NodeSharedMemory(const NodeSharedMemory&) = delete;
+	NodeSharedMemory& operator=(const NodeSharedMemory&) = delete;
+
+
+	/// <summary>
+	/// Allocates shared memory for columns handled by processes of this node and sends them
+	/// from first process (which stores whole adjacency matrix) to node leaders - one message
+	/// of continous columns per node. It is a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Columns handled by this process (arranged column-wise), stored in shared memory.
+	/// </returns>
+	/// <param name="columnWiseMatrix">
+	/// Whole adjacency matrix arranged column-wise - used only by first process.
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Number of vertices of the graph.
+	/// </param>
+	/// <param name="numberOfColumnsToHandle">
+	/// Number of columns handled by this process.
+	/// </param>
+	ArrayView<double> distributeMatrixColumns(const ArrayView<double>& columnWiseMatrix, int totalNumberOfVertices, int numberOfColumnsToHandle);
+
+
+	/// <summary>
+	/// Computes global closest vertex - local minima of processes of the node are combined
+	/// in shared memory, then node leaders reduce them with MPI_Allreduce. Ties go to vertex
+	/// with smaller number, the same way as in MPI_Allreduce of all processes. It is
+	/// a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Global closest vertex, the same in every process.
+	/// </returns>
+	/// <param name="localMinimum">
+	/// Closest vertex of this process.
+	/// </param>
+	template <typename VertexDataType>
+	VertexDataType reduceMinimum(const VertexDataType& localMinimum);
+
+
+	/// <summary>
+	/// Returns number of processes running on the node of this process.
+	/// </summary>
+	inline int getNumberOfProcessesOnNode() const {
+		return m_numberOfProcessesOnNode;
+	}
+
+
+	/// <summary>
+	/// Returns boolean that indicates if this process is leader of its node.
+	/// </summary>
+	inline bool checkIfIsNodeLeader() const {
+		return m_rankOnNode == 0;
+	}
+
+private:
+
+	/// <summary>
+	/// Makes writes of this process visible to other processes of the node and waits
+	/// until all of them do the same.
+	/// </summary>
+	void synchronizeNode(MPI_Win window);
+
+
+	MPI_Comm m_nodeCommunicator = MPI_COMM_NULL;
+	MPI_Comm m_leadersCommunicator = MPI_COMM_NULL;
+	int m_rankOnNode = 0;
+	int m_numberOfProcessesOnNode = 1;
+
+	MPI_Win m_reductionWindow = MPI_WIN_NULL;
+	CacheLinePadded<unsigned char[64]>* m_reductionSlots = nullptr;
+
+	MPI_Win m_matrixWindow = MPI_WIN_NULL;
+
+};
+
+
+template <typename VertexDataType>
+VertexDataType NodeSharedMemory::reduceMinimum(const VertexDataType& localMinimum) {
+
+	static_assert(sizeof(VertexDataType) <= sizeof(m_reductionSlots->value), "Vertex data does not fit in reduction slot");
+
+	// every process writes its own slot - slots are in separate cache lines
+	*reinterpret_cast<VertexDataType*>(m_reductionSlots[m_rankOnNode].value) = localMinimum;
+	synchronizeNode(m_reductionWindow);
+
+	// node leader combines minima of the node and reduces them with other leaders - the last slot receives global minimum
+	if (m_rankOnNode == 0) {
+		VertexDataType nodeMinimum = localMinimum;
+		for (int i = 1; i < m_numberOfProcessesOnNode; ++i) {
+			const VertexDataType& minimum = *reinterpret_cast<const VertexDataType*>(m_reductionSlots[i].value);
+			if (minimum.distance < nodeMinimum.distance
+				|| (minimum.distance == nodeMinimum.distance && minimum.vertexNumber < nodeMinimum.vertexNumber)) {
+				nodeMinimum = minimum;
+			}
+		}
+		MPI_Allreduce(&nodeMinimum, reinterpret_cast<VertexDataType*>(m_reductionSlots[m_numberOfProcessesOnNode].value), 1,
+			MPITypeTraits<VertexDataType>::getDatatype(), MPITypeTraits<VertexDataType>::getMinimumOperation(), m_leadersCommunicator);
+	}
+	synchronizeNode(m_reductionWindow);
+
+	// slots are not written again before every process passes the first synchronization of the next reduction
+	return *reinterpret_cast<const VertexDataType*>(m_reductionSlots[m_numberOfProcessesOnNode].value);
+}
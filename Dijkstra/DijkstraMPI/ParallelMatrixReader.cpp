@@ -0,0 +1,261 @@
+#include "ParallelMatrixReader.h"
+#include "DijkstraMPISetup.h"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+
+ParallelMatrixReader::ParallelMatrixReader(const std::string& filePath, MPI_Comm communicator) : m_communicator(communicator) {
+
+	int processRank = 0;
+	int numberOfProcesses = 0;
+	MPI_Comm_rank(m_communicator, &processRank);
+	MPI_Comm_size(m_communicator, &numberOfProcesses);
+
+	MPI_File file;
+	if (MPI_File_open(m_communicator, filePath.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+		if (processRank == 0) {
+			std::cout << "Plik " << filePath << " nie istnieje." << std::endl;
+		}
+		return;
+	}
+
+	// every process gets continous byte range of the same size
+	MPI_Offset fileSize = 0;
+	MPI_File_get_size(file, &fileSize);
+	MPI_Offset begin = fileSize * processRank / numberOfProcesses;
+	MPI_Offset end = fileSize * (processRank + 1) / numberOfProcesses;
+
+	// one character before the range shows if first number started in previous range
+	MPI_Offset readBegin = begin > 0 ? begin - 1 : begin;
+	std::vector<char> buffer;
+	readByteRange(file, readBegin, end, buffer);
+
+	// last number that starts in the range is read to its end
+	bool numberEnded = begin == end || isWhitespace(buffer.back());
+	for (MPI_Offset readEnd = end; !numberEnded && readEnd < fileSize; ) {
+		char extension[64];
+		int count = static_cast<int>(std::min<MPI_Offset>(sizeof(extension), fileSize - readEnd));
+		MPI_File_read_at(file, readEnd, extension, count, MPI_CHAR, MPI_STATUS_IGNORE);
+		for (int i = 0; i < count && !numberEnded; ++i) {
+			buffer.push_back(extension[i]);
+			numberEnded = isWhitespace(extension[i]);
+		}
+		readEnd += count;
+	}
+	MPI_File_close(&file);
+	buffer.push_back('\0');
+
+	int parsedCorrectly = parseNumbers(buffer, static_cast<size_t>(begin - readBegin), static_cast<size_t>(end - readBegin));
+	buffer.clear();
+	buffer.shrink_to_fit();
+	MPI_Allreduce(MPI_IN_PLACE, &parsedCorrectly, 1, MPI_INT, MPI_LAND, m_communicator);
+
+	// position of first parsed number in file - sum of numbers parsed by processes with lower ranks
+	long long numberOfParsedNumbers = static_cast<long long>(m_weights.size());
+	long long numberOfPreviousNumbers = 0;
+	long long totalNumberOfNumbers = 0;
+	MPI_Exscan(&numberOfParsedNumbers, &numberOfPreviousNumbers, 1, MPI_LONG_LONG, MPI_SUM, m_communicator);
+	MPI_Allreduce(&numberOfParsedNumbers, &totalNumberOfNumbers, 1, MPI_LONG_LONG, MPI_SUM, m_communicator);
+	if (processRank == 0) {
+		numberOfPreviousNumbers = 0;
+	}
+
+	// first number in file is number of vertices, weights follow it row after row
+	double numberOfVertices = -1;
+	if (numberOfPreviousNumbers == 0 && !m_weights.empty()) {
+		numberOfVertices = m_weights.front();
+		m_weights.erase(m_weights.begin());
+	}
+	MPI_Allreduce(MPI_IN_PLACE, &numberOfVertices, 1, MPI_DOUBLE, MPI_MAX, m_communicator);
+	m_indexOfFirstWeight = numberOfPreviousNumbers > 0 ? numberOfPreviousNumbers - 1 : 0;
+
+	if (!parsedCorrectly || numberOfVertices != std::floor(numberOfVertices) || numberOfVertices > INT_MAX) {
+		if (processRank == 0) {
+			std::cout << "Plik " << filePath << " zawiera niepoprawne dane." << std::endl;
+		}
+		m_weights.clear();
+		return;
+	}
+	if (numberOfVertices <= 0) {
+		m_weights.clear();
+		return;
+	}
+	if (totalNumberOfNumbers - 1 < static_cast<long long>(numberOfVertices) * static_cast<long long>(numberOfVertices)) {
+		if (processRank == 0) {
+			std::cout << "Plik " << filePath << " zawiera za malo danych." << std::endl;
+		}
+		m_weights.clear();
+		return;
+	}
+	m_numberOfVertices = static_cast<int>(numberOfVertices);
+}
+
+
+std::vector<double> ParallelMatrixReader::distributeColumns(const std::vector<int>& numbersOfColumnsForEachProcess, bool arrangeRowWise) {
+
+	int processRank = 0;
+	MPI_Comm_rank(m_communicator, &processRank);
+
+	std::vector<int> firstColumns = DijkstraMPISetup::computeDisplacements(numbersOfColumnsForEachProcess, 1);
+	std::vector<int> ownersOfColumns(m_numberOfVertices, 0);
+	for (size_t owner = 0; owner < numbersOfColumnsForEachProcess.size(); ++owner) {
+		std::fill_n(ownersOfColumns.begin() + firstColumns.at(owner), numbersOfColumnsForEachProcess.at(owner), static_cast<int>(owner));
+	}
+
+	// numbers after last row of matrix are ignored
+	long long numberOfMatrixEntries = static_cast<long long>(m_numberOfVertices) * m_numberOfVertices;
+	size_t numberOfWeightsToSend = static_cast<size_t>(std::max(0LL, std::min(static_cast<long long>(m_weights.size()), numberOfMatrixEntries - m_indexOfFirstWeight)));
+	int firstColumn = m_numberOfVertices > 0 ? static_cast<int>(m_indexOfFirstWeight % m_numberOfVertices) : 0;
+
+	// weights are grouped by processes that handle their columns, order inside each group is kept
+	std::vector<int> sendCounts(numbersOfColumnsForEachProcess.size(), 0);
+	for (size_t i = 0, column = firstColumn; i < numberOfWeightsToSend; ++i) {
+		++sendCounts[ownersOfColumns[column]];
+		column = column + 1 < ownersOfColumns.size() ? column + 1 : 0;
+	}
+	std::vector<int> sendDisplacements = DijkstraMPISetup::computeDisplacements(sendCounts, 1);
+	std::vector<int> positions = sendDisplacements;
+	std::vector<double> sendBuffer(numberOfWeightsToSend, 0);
+	for (size_t i = 0, column = firstColumn; i < numberOfWeightsToSend; ++i) {
+		sendBuffer[positions[ownersOfColumns[column]]++] = m_weights[i];
+		column = column + 1 < ownersOfColumns.size() ? column + 1 : 0;
+	}
+	m_weights.clear();
+	m_weights.shrink_to_fit();
+
+	// ranges of processes are ordered, so received weights form consecutive rows of the chunk
+	std::vector<int> receiveCounts(numbersOfColumnsForEachProcess.size(), 0);
+	MPI_Alltoall(sendCounts.data(), 1, MPI_INT, receiveCounts.data(), 1, MPI_INT, m_communicator);
+	std::vector<int> receiveDisplacements = DijkstraMPISetup::computeDisplacements(receiveCounts, 1);
+
+	int numberOfColumnsToHandle = numbersOfColumnsForEachProcess.at(processRank);
+	std::vector<double> rowWiseChunk(static_cast<size_t>(numberOfColumnsToHandle) * m_numberOfVertices, 0);
+	MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDisplacements.data(), MPI_DOUBLE,
+		rowWiseChunk.data(), receiveCounts.data(), receiveDisplacements.data(), MPI_DOUBLE, m_communicator);
+	if (arrangeRowWise) {
+		return rowWiseChunk;
+	}
+
+	sendBuffer.clear();
+	sendBuffer.shrink_to_fit();
+	std::vector<double> matrixChunk(rowWiseChunk.size(), 0);
+	for (int i = 0; i < m_numberOfVertices; ++i) {
+		for (int j = 0; j < numberOfColumnsToHandle; ++j) {
+			matrixChunk[static_cast<size_t>(j) * m_numberOfVertices + i] = rowWiseChunk[static_cast<size_t>(i) * numberOfColumnsToHandle + j];
+		}
+	}
+	return matrixChunk;
+}
+
+
+std::vector<double> ParallelMatrixReader::distributeBlocks(const std::vector<std::pair<int, int>>& rowsRanges, const std::vector<std::pair<int, int>>& columnsRanges,
+	const std::vector<int>& ownersOfBlocks) {
+
+	int numberOfProcesses = 0;
+	MPI_Comm_size(m_communicator, &numberOfProcesses);
+
+	// row and column of the grid that every vertex belongs to
+	std::vector<int> gridRowsOfVertices(m_numberOfVertices, 0);
+	std::vector<int> gridColumnsOfVertices(m_numberOfVertices, 0);
+	for (size_t gridRow = 0; gridRow < rowsRanges.size(); ++gridRow) {
+		std::fill(gridRowsOfVertices.begin() + rowsRanges[gridRow].first, gridRowsOfVertices.begin() + rowsRanges[gridRow].second + 1, static_cast<int>(gridRow));
+	}
+	for (size_t gridColumn = 0; gridColumn < columnsRanges.size(); ++gridColumn) {
+		std::fill(gridColumnsOfVertices.begin() + columnsRanges[gridColumn].first, gridColumnsOfVertices.begin() + columnsRanges[gridColumn].second + 1, static_cast<int>(gridColumn));
+	}
+	int numberOfGridColumns = static_cast<int>(columnsRanges.size());
+
+	// numbers after last row of matrix are ignored
+	long long numberOfMatrixEntries = static_cast<long long>(m_numberOfVertices) * m_numberOfVertices;
+	size_t numberOfWeightsToSend = static_cast<size_t>(std::max(0LL, std::min(static_cast<long long>(m_weights.size()), numberOfMatrixEntries - m_indexOfFirstWeight)));
+	int firstRow = m_numberOfVertices > 0 ? static_cast<int>(m_indexOfFirstWeight / m_numberOfVertices) : 0;
+	int firstColumn = m_numberOfVertices > 0 ? static_cast<int>(m_indexOfFirstWeight % m_numberOfVertices) : 0;
+
+	// weights are grouped by processes that handle their blocks, order inside each group is kept
+	std::vector<int> ownersOfWeights(numberOfWeightsToSend, 0);
+	std::vector<int> sendCounts(numberOfProcesses, 0);
+	for (size_t i = 0, row = firstRow, column = firstColumn; i < numberOfWeightsToSend; ++i) {
+		ownersOfWeights[i] = ownersOfBlocks[gridRowsOfVertices[row] * numberOfGridColumns + gridColumnsOfVertices[column]];
+		++sendCounts[ownersOfWeights[i]];
+		if (++column == static_cast<size_t>(m_numberOfVertices)) {
+			column = 0;
+			++row;
+		}
+	}
+	std::vector<int> sendDisplacements = DijkstraMPISetup::computeDisplacements(sendCounts, 1);
+	std::vector<int> positions = sendDisplacements;
+	std::vector<double> sendBuffer(numberOfWeightsToSend, 0);
+	for (size_t i = 0; i < numberOfWeightsToSend; ++i) {
+		sendBuffer[positions[ownersOfWeights[i]]++] = m_weights[i];
+	}
+	m_weights.clear();
+	m_weights.shrink_to_fit();
+	ownersOfWeights.clear();
+	ownersOfWeights.shrink_to_fit();
+
+	// processes with lower ranks parsed earlier parts of file, so received weights form consecutive rows of the block
+	std::vector<int> receiveCounts(numberOfProcesses, 0);
+	MPI_Alltoall(sendCounts.data(), 1, MPI_INT, receiveCounts.data(), 1, MPI_INT, m_communicator);
+	std::vector<int> receiveDisplacements = DijkstraMPISetup::computeDisplacements(receiveCounts, 1);
+
+	std::vector<double> block(static_cast<size_t>(receiveDisplacements.back()) + receiveCounts.back(), 0);
+	MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDisplacements.data(), MPI_DOUBLE,
+		block.data(), receiveCounts.data(), receiveDisplacements.data(), MPI_DOUBLE, m_communicator);
+	return block;
+}
+
+
+void ParallelMatrixReader::readByteRange(MPI_File file, MPI_Offset begin, MPI_Offset end, std::vector<char>& buffer) {
+
+	// single read is limited by int count, so long ranges are read in parts
+	const MPI_Offset maximalPartSize = 1 << 30;
+	buffer.assign(static_cast<size_t>(end - begin), 0);
+	long long numberOfParts = (end - begin + maximalPartSize - 1) / maximalPartSize;
+	MPI_Allreduce(MPI_IN_PLACE, &numberOfParts, 1, MPI_LONG_LONG, MPI_MAX, m_communicator);
+
+	for (long long part = 0; part < numberOfParts; ++part) {
+		MPI_Offset partBegin = std::min(begin + part * maximalPartSize, end);
+		int count = static_cast<int>(std::min(maximalPartSize, end - partBegin));
+		MPI_File_read_at_all(file, partBegin, buffer.data() + (partBegin - begin), count, MPI_CHAR, MPI_STATUS_IGNORE);
+	}
+}
+
+
+bool ParallelMatrixReader::parseNumbers(const std::vector<char>& buffer, size_t begin, size_t end) {
+
+	// number that started in previous range is parsed by previous process
+	size_t i = begin;
+	if (begin > 0 && !isWhitespace(buffer[begin - 1])) {
+		while (i < end && !isWhitespace(buffer[i])) {
+			++i;
+		}
+	}
+
+	while (true) {
+		while (i < end && isWhitespace(buffer[i])) {
+			++i;
+		}
+		if (i >= end) {
+			return true;
+		}
+
+		char* numberEnd = nullptr;
+		double value = std::strtod(buffer.data() + i, &numberEnd);
+		size_t next = static_cast<size_t>(numberEnd - buffer.data());
+		if (next == i || (buffer[next] != '\0' && !isWhitespace(buffer[next]))) {
+			return false;
+		}
+		m_weights.push_back(value);
+		i = next;
+	}
+}
+
+
+bool ParallelMatrixReader::isWhitespace(char character) {
+	return std::isspace(static_cast<unsigned char>(character)) != 0;
+}
@@ -0,0 +1,129 @@
+/**
+*	@file ParallelMatrixReader.h
+*	@brief This file contains class responsible for reading adjacency matrix
+*	file by all processes at once, using MPI-IO.
+*/
+
+#pragma once
+
+#include "mpi.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class reads adjacency matrix data file in parallel. File is divided into
+/// continous byte ranges of equal size and every process reads and parses only its
+/// own range. Numbers are then sent directly to processes that handle their columns,
+/// so no process ever stores whole matrix and parsing is not serialized on first
+/// process. Please note that this class is final - to use it, consider composition
+/// (not inheritance).
+/// </summary>
+/// <remarks>
+/// Number is parsed by the process whose byte range contains its first character.
+/// Global position of every number in the file (and so its row and column) is known
+/// after counting numbers parsed by processes with lower ranks.
+/// </remarks>
+class ParallelMatrixReader final {
+
+public:
+
+	/// <summary>
+	/// Constructor - opens data file using MPI-IO, reads byte range that belongs to this
+	/// process and parses numbers that start in it. If file could not be opened or its
+	/// content is not valid, proper information is printed by first process and number
+	/// of vertices is set to 0. It is a collective operation.
+	/// </summary>
+	/// <param name="filePath">
+	/// String with path to file that contains adjacency matrix information.
+	/// </param>
+	/// <param name="communicator">
+	/// MPI communicator with all processes that take part in reading.
+	/// </param>
+	ParallelMatrixReader(const std::string& filePath, MPI_Comm communicator);
+
+
+	/// <summary>
+	/// Returns number of graph vertices - same number as number of rows
+	/// or columns in adjacency matrix
+	/// </summary>
+	inline int getNumberOfVertices() const {
+		return m_numberOfVertices;
+	}
+
+
+	/// <summary>
+	/// Sends parsed weights to processes that handle their columns (using MPI_Alltoallv)
+	/// and returns chunk of adjacency matrix that belongs to this process - arranged the
+	/// same way as chunk received from first process with MPI_Scatterv. Parsed weights
+	/// are released afterwards. It is a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Adjacency matrix chunk - consecutive columns (weights of edges leading to handled
+	/// vertices), or consecutive rows of the chunk if it should be arranged row-wise.
+	/// </returns>
+	/// <param name="numbersOfColumnsForEachProcess">
+	/// Numbers of adjacency matrix columns (graph vertices) each process should handle.
+	/// Should be arranged using ranks given by MPI.
+	/// </param>
+	/// <param name="arrangeRowWise">
+	/// Boolean that indicates if chunk should be arranged row-wise (as TransposedMatrixChunk).
+	/// </param>
+	std::vector<double> distributeColumns(const std::vector<int>& numbersOfColumnsForEachProcess, bool arrangeRowWise);
+
+
+	/// <summary>
+	/// Sends parsed weights to processes that handle their blocks of adjacency matrix
+	/// (using MPI_Alltoallv) and returns block that belongs to this process, row after
+	/// row. Matrix is divided into blocks by given ranges of rows and columns, as on
+	/// two-dimensional grid of processes. Parsed weights are released afterwards. It is
+	/// a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Block of adjacency matrix - consecutive rows of the block.
+	/// </returns>
+	/// <param name="rowsRanges">
+	/// Ranges of rows [a, b] of every row of the grid.
+	/// </param>
+	/// <param name="columnsRanges">
+	/// Ranges of columns [a, b] of every column of the grid.
+	/// </param>
+	/// <param name="ownersOfBlocks">
+	/// Ranks of processes that handle blocks - block in row r and column c of the grid
+	/// belongs to process ownersOfBlocks[r * number of columns of the grid + c].
+	/// </param>
+	std::vector<double> distributeBlocks(const std::vector<std::pair<int, int>>& rowsRanges, const std::vector<std::pair<int, int>>& columnsRanges,
+		const std::vector<int>& ownersOfBlocks);
+
+private:
+
+	/// <summary>
+	/// Reads given byte range of file into buffer - all processes take part in the same
+	/// number of collective reads, even if their ranges are of different size.
+	/// </summary>
+	void readByteRange(MPI_File file, MPI_Offset begin, MPI_Offset end, std::vector<char>& buffer);
+
+
+	/// <summary>
+	/// Parses numbers that start in range [begin, end) of buffer. Number that starts in
+	/// range but ends outside of it is parsed to its end.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if all numbers have been parsed correctly.
+	/// </returns>
+	bool parseNumbers(const std::vector<char>& buffer, size_t begin, size_t end);
+
+
+	/// <summary>
+	/// Checks if given character separates numbers.
+	/// </summary>
+	static bool isWhitespace(char character);
+
+
+	MPI_Comm m_communicator;
+	int m_numberOfVertices = 0;
+	long long m_indexOfFirstWeight = 0;
+	std::vector<double> m_weights;
+
+};
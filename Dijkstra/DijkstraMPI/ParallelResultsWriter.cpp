@@ -0,0 +1,53 @@
+#include "ParallelResultsWriter.h"
+#include "ResultsFile.h"
+
+#include <iostream>
+#include <vector>
+
+
+bool ParallelResultsWriter::writeResults(const std::string& filePath, const std::vector<double>& distances, const std::vector<int>& predecessors,
+	const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex, int targetVertexIndex,
+	bool useCompression, MPI_Comm communicator)
+{
+	int processRank = 0;
+	MPI_Comm_rank(communicator, &processRank);
+
+	MPI_File file;
+	if (MPI_File_open(communicator, filePath.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+		if (processRank == 0) {
+			std::cout << "Nie mozna utworzyc pliku " << filePath << "." << std::endl;
+		}
+		return false;
+	}
+	MPI_File_set_size(file, 0);
+
+	// header is written by first process only, but all processes need offsets of sections
+	ResultsFile::Header header = ResultsFile::createHeader(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex,
+		useCompression ? ResultsFile::Compressed : ResultsFile::Plain);
+	MPI_File_write_at_all(file, 0, &header, processRank == 0 ? sizeof(header) : 0, MPI_BYTE, MPI_STATUS_IGNORE);
+
+	// every process writes continous range of both arrays
+	int numberOfVerticesToHandle = verticesToHandleRange.second - verticesToHandleRange.first + 1;
+	MPI_Offset distancesOffset = header.distancesOffset + static_cast<MPI_Offset>(verticesToHandleRange.first) * sizeof(double);
+	MPI_File_write_at_all(file, distancesOffset, distances.data(), numberOfVerticesToHandle, MPI_DOUBLE, MPI_STATUS_IGNORE);
+	if (useCompression) {
+
+		// compressed parts have different sizes - part of this process starts after parts of processes with lower ranks
+		std::vector<char> buffer;
+		ResultsFile::compressPredecessors(ArrayView<int>(predecessors.data(), numberOfVerticesToHandle), verticesToHandleRange.first, buffer);
+		long long sizeOfCompressedPart = static_cast<long long>(buffer.size());
+		long long sizeOfPreviousParts = 0;
+		MPI_Exscan(&sizeOfCompressedPart, &sizeOfPreviousParts, 1, MPI_LONG_LONG, MPI_SUM, communicator);
+		if (processRank == 0) {
+			sizeOfPreviousParts = 0;
+		}
+		MPI_File_write_at_all(file, header.predecessorsOffset + sizeOfPreviousParts, buffer.data(), static_cast<int>(buffer.size()), MPI_BYTE, MPI_STATUS_IGNORE);
+	}
+	else {
+		MPI_Offset predecessorsOffset = header.predecessorsOffset + static_cast<MPI_Offset>(verticesToHandleRange.first) * sizeof(int);
+		MPI_File_write_at_all(file, predecessorsOffset, predecessors.data(), numberOfVerticesToHandle, MPI_INT, MPI_STATUS_IGNORE);
+	}
+
+	MPI_File_close(&file);
+	return true;
+}
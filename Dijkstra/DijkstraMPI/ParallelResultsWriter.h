@@ -0,0 +1,73 @@
+/**
+*	@file ParallelResultsWriter.h
+*	@brief This file contains class responsible for writing algorithm results
+*	to binary file by all processes at once, using MPI-IO.
+*/
+
+#pragma once
+
+#include "mpi.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class writes results of DijkstraMPI to binary results file (see ResultsFile).
+/// Every process writes distances and predecessors of vertices it handles directly
+/// at their offsets in the file with collective MPI-IO, so results are not gathered
+/// by first process and are not formatted as text. Compressed predecessors of every
+/// process are written after compressed predecessors of processes with lower ranks.
+/// Please note that all methods are static.
+/// </summary>
+class ParallelResultsWriter final {
+
+public:
+
+	/// <summary>
+	/// Default constructor. Because this class contains only static methods, it
+	/// has been deleted.
+	/// </summary>
+	ParallelResultsWriter() = delete;
+
+
+	/// <summary>
+	/// Writes results file - header is written by first process, every process writes
+	/// its own continous range of both arrays. If file could not be created, proper
+	/// information is printed. It is a collective operation.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file has been written.
+	/// </returns>
+	/// <param name="filePath">
+	/// Path to output file. Existing file is overwritten.
+	/// </param>
+	/// <param name="distances">
+	/// Distances to vertices handled by this process.
+	/// </param>
+	/// <param name="predecessors">
+	/// Predecessors of vertices handled by this process.
+	/// </param>
+	/// <param name="verticesToHandleRange">
+	/// Range of vertices [a, b] handled by this process.
+	/// </param>
+	/// <param name="totalNumberOfVertices">
+	/// Number of vertices of the whole graph.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Number of source vertex.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex, or -1 if search has not been stopped at target vertex.
+	/// </param>
+	/// <param name="useCompression">
+	/// Boolean that indicates if predecessors should be compressed.
+	/// </param>
+	/// <param name="communicator">
+	/// MPI communicator with all processes that handle vertices.
+	/// </param>
+	static bool writeResults(const std::string& filePath, const std::vector<double>& distances, const std::vector<int>& predecessors,
+		const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex, int targetVertexIndex,
+		bool useCompression, MPI_Comm communicator);
+
+};
@@ -8,26 +8,210 @@
 #include "mpi.h"
 
 #include "AdjacencyMatrix.h"
+#include "AdjacencyMatrixReader.h"
+#include "BinaryGraphFile.h"
+#include "SparseGraph.h"
+#include "TransposedMatrixChunk.h"
 #include "Log.h"
+#include "RelaxationKernels.h"
+#include "ResultsFile.h"
 #include "ResultsPrinter.h"
 #include "CommandLineArgumentsExtractor.h"
 #include "DijkstraMPISetup.h"
 #include "DijkstraMPI.h"
+#include "DijkstraMPIDistributed.h"
+#include "DijkstraMPIMultiSettle.h"
+#include "DijkstraMPIMultiSource.h"
+#include "FloydWarshallMPI.h"
+#include "MultilevelPartitioner.h"
+#include "NodeSharedMemory.h"
+#include "ParallelMatrixReader.h"
+#include "ParallelResultsWriter.h"
 #include "Validator.h"
+#include "WeightTraits.h"
 
 #ifndef SHOULD_LOG
 #define SHOULD_LOG true
 #endif // !SHOULD_LOG
 
 
+/// <summary>
+/// Runs all-pairs shortest paths mode - distributes adjacency matrix over two-dimensional
+/// grid of processes, runs Floyd-Warshall algorithm and writes binary distance table.
+/// Returns false if distance table has not been written.
+/// </summary>
+bool runAllPairsShortestPaths(int argc, char* argv[], int processRank, Log<SHOULD_LOG>& log)
+{
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	// text file can be parsed by all processes at once, otherwise first process reads it row after row
+	std::string inputFilePath = CommandLineArgumentsExtractor::extractInputFileNameFromCommandLineArguments(argc, argv);
+	bool useParallelRead = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--parallel-read")
+		&& !BinaryGraphFile::checkIfFileIsBinaryGraph(inputFilePath);
+	std::unique_ptr<ParallelMatrixReader> parallelReader;
+	std::unique_ptr<AdjacencyMatrixReader> reader;
+	int totalNumberOfVertices = -1;
+	if (useParallelRead) {
+		parallelReader.reset(new ParallelMatrixReader(inputFilePath, MPI_COMM_WORLD));
+		totalNumberOfVertices = parallelReader->getNumberOfVertices();
+	}
+	else if (processRank == 0) {
+		reader.reset(new AdjacencyMatrixReader(inputFilePath));
+		totalNumberOfVertices = reader->getNumberOfVertices();
+	}
+	MPI_Bcast(&totalNumberOfVertices, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+	auto validationResult = Validator::validateVerticesNumbers(totalNumberOfVertices, 0);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		return false;
+	}
+
+	FloydWarshallMPI floydWarshall(totalNumberOfVertices, MPI_COMM_WORLD);
+	log.logMessage("Process grid ", floydWarshall.getProcessGridDimensions().first, " x ", floydWarshall.getProcessGridDimensions().second,
+		", this process will handle rows [", floydWarshall.getRowsRange().first, ", ", floydWarshall.getRowsRange().second, 
+		"] and columns [", floydWarshall.getColumnsRange().first, ", ", floydWarshall.getColumnsRange().second, "]");
+	if (useParallelRead) {
+		floydWarshall.loadAdjacencyMatrix(*parallelReader);
+		parallelReader.reset();
+	}
+	else {
+		floydWarshall.loadAdjacencyMatrix(reader.get());
+		reader.reset();
+	}
+
+	auto tBeforeAlgorithmStart = std::chrono::high_resolution_clock::now();
+
+	// run Floyd-Warshall algorithm
+	floydWarshall.run();
+
+	auto tBeforePrinting = std::chrono::high_resolution_clock::now();
+
+	// write distance table to file
+	std::string outputFilePath = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--apsp", "distancesMPI.bin");
+	if (!floydWarshall.writeDistancesToFile(outputFilePath)) {
+		return false;
+	}
+
+	auto tEnd = std::chrono::high_resolution_clock::now();
+
+	if (processRank == 0) {
+
+		// log information about elapsed time
+		std::chrono::duration<double> diffTotal = tEnd - tStart;
+		std::chrono::duration<double> diffSetup = tBeforeAlgorithmStart - tStart;
+		std::chrono::duration<double> diffAlgo = tBeforePrinting - tBeforeAlgorithmStart;
+		std::chrono::duration<double> diffPrint = tEnd - tBeforePrinting;
+		log.logMessage("Total elapsed time: ", diffTotal.count(), "s");
+		log.logMessage("Setup took: ", diffSetup.count(), "s");
+		log.logMessage("Algorithm took: ", diffAlgo.count(), "s");
+		log.logMessage("Writing distance table to ", outputFilePath, " took: ", diffPrint.count(), "s");
+	}
+	return true;
+}
+
+
+/// <summary>
+/// Returns path of binary results file of search from given source vertex - with several
+/// source vertices, number of source vertex is inserted before extension of the file.
+/// </summary>
+std::string createBinaryResultsFilePath(const std::string& filePath, int sourceVertexIndex, bool useSeveralSourceVertices)
+{
+	if (!useSeveralSourceVertices) {
+		return filePath;
+	}
+	size_t extensionPosition = filePath.find_last_of('.');
+	if (extensionPosition == std::string::npos || extensionPosition < filePath.find_last_of('/') + 1) {
+		extensionPosition = filePath.size();
+	}
+	return filePath.substr(0, extensionPosition) + "_" + std::to_string(sourceVertexIndex) + filePath.substr(extensionPosition);
+}
+
+
+/// <summary>
+/// Runs DijkstraMPI on chunk of adjacency matrix with converted weights. Distances are
+/// converted back to doubles, so they are gathered and printed the same way for every
+/// type of weights.
+/// </summary>
+template <typename WeightType>
+std::pair<const std::vector<double>, const std::vector<int>> runWithConvertedWeights(std::vector<WeightType>& matrixChunk, bool useTransposedChunks,
+	const std::pair<int, int>& verticesToHandleRange, int totalNumberOfVertices, int sourceVertexIndex, int numberOfThreads, int targetVertexIndex,
+	MPI_Comm& communicator)
+{
+	if (useTransposedChunks) {
+		int numberOfColumnsToHandle = verticesToHandleRange.second - verticesToHandleRange.first + 1;
+		return convertDistancesToDoubles(DijkstraMPI<BasicTransposedMatrixChunk<WeightType>>(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex,
+			BasicTransposedMatrixChunk<WeightType>(std::move(matrixChunk), numberOfColumnsToHandle), numberOfThreads, targetVertexIndex).run(communicator));
+	}
+	return convertDistancesToDoubles(DijkstraMPI<std::vector<WeightType>>(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex,
+		matrixChunk, numberOfThreads, targetVertexIndex).run(communicator));
+}
+
+
+/// <summary>
+/// Maps results of search in renumbered graph back to original numbers of vertices - distance
+/// and predecessor of vertex v are taken from its new number, predecessors get original numbers.
+/// </summary>
+void restoreOriginalNumbersOfVertices(std::vector<double>& distances, std::vector<int>& predecessors, const std::vector<int>& newNumbersOfVertices)
+{
+	std::vector<int> originalNumbersOfVertices(newNumbersOfVertices.size());
+	for (size_t v = 0; v < newNumbersOfVertices.size(); ++v) {
+		originalNumbersOfVertices[newNumbersOfVertices[v]] = static_cast<int>(v);
+	}
+
+	std::vector<double> renumberedDistances = std::move(distances);
+	std::vector<int> renumberedPredecessors = std::move(predecessors);
+	distances.resize(renumberedDistances.size());
+	predecessors.resize(renumberedPredecessors.size());
+	for (size_t v = 0; v < newNumbersOfVertices.size(); ++v) {
+		int predecessor = renumberedPredecessors[newNumbersOfVertices[v]];
+		distances[v] = renumberedDistances[newNumbersOfVertices[v]];
+		predecessors[v] = predecessor == -1 ? -1 : originalNumbersOfVertices[predecessor];
+	}
+}
+
+
+/// <summary>
+/// Runs warm-up search on current division of sparse graph, in which every process measures time
+/// of its own work, then divides vertices again, so that measured costs are balanced, and sends
+/// new chunks to all processes. Every process has to handle at least one vertex.
+/// </summary>
+std::unique_ptr<SparseGraph> repartitionUsingMeasuredCosts(const SparseGraph* graph, std::vector<int>& numbersOfColumnsForEachProcess, const SparseGraph& sparseGraphChunk,
+	int totalNumberOfVertices, int sourceVertexIndex, int numberOfThreads, int targetVertexIndex, MPI_Comm communicator, Log<SHOULD_LOG>& log)
+{
+	int numberOfProcesses = 0;
+	int processRank = 0;
+	MPI_Comm_size(communicator, &numberOfProcesses);
+	MPI_Comm_rank(communicator, &processRank);
+
+	// warm-up run - results are discarded
+	std::pair<int, int> verticesToHandleRange = DijkstraMPISetup::computeRangeOfVerticesToHandle(numbersOfColumnsForEachProcess, processRank);
+	double timeOfLocalWork = DijkstraMPI<SparseGraph>(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, sparseGraphChunk,
+		numberOfThreads, targetVertexIndex).measureTimeOfLocalWork(communicator);
+
+	std::vector<double> measuredTimes(numberOfProcesses, 0);
+	MPI_Gather(&timeOfLocalWork, 1, MPI_DOUBLE, measuredTimes.data(), 1, MPI_DOUBLE, 0, communicator);
+	if (processRank == 0) {
+		std::vector<double> costsOfVertices = DijkstraMPISetup::scaleCostsOfVerticesToMeasuredTimes(DijkstraMPISetup::computeCostsOfVertices(*graph),
+			numbersOfColumnsForEachProcess, measuredTimes);
+		log.logMessage("Imbalance measured in warm-up run: ", DijkstraMPISetup::computeImbalance(costsOfVertices, numbersOfColumnsForEachProcess));
+		numbersOfColumnsForEachProcess = DijkstraMPISetup::divideVerticesByCosts(costsOfVertices, numberOfProcesses);
+		log.logMessage("Expected imbalance of division by measured costs: ", DijkstraMPISetup::computeImbalance(costsOfVertices, numbersOfColumnsForEachProcess));
+	}
+	MPI_Bcast(numbersOfColumnsForEachProcess.data(), numberOfProcesses, MPI_INT, 0, communicator);
+	return DijkstraMPISetup::scatterSparseGraphChunks(graph, numbersOfColumnsForEachProcess, totalNumberOfVertices, communicator);
+}
+
+
 int main(int argc, char* argv[])
 {
 	auto tStart = std::chrono::high_resolution_clock::now();
 
-	// initialize MPI
+	// initialize MPI - only main thread of each process communicates with other processes
 	int numberOfProcesses = 0;
 	int processRank = 0;
-	MPI_Init(&argc, &argv);
+	int providedThreadSupport = MPI_THREAD_SINGLE;
+	MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &providedThreadSupport);
 	MPI_Comm_size(MPI_COMM_WORLD, &numberOfProcesses);
 	MPI_Comm_rank(MPI_COMM_WORLD, &processRank);
 
@@ -42,117 +226,556 @@ int main(int argc, char* argv[])
 		return 0;
 	}
 
+	// all-pairs shortest paths mode uses two-dimensional grid of processes
+	if (CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--apsp")) {
+		bool distancesWritten = runAllPairsShortestPaths(argc, argv, processRank, log);
+		MPI_Finalize();
+		return distancesWritten ? 0 : 1;
+	}
+
 	// prepare structures used to transfer data from process 0 using MPI
 	std::vector<int> numbersOfColumnsForEachProcess;
 	std::vector<int> matrixChunksDisplacements;
 	std::vector<int> bufferSizes;
-	std::vector<double> graphData;
+	std::unique_ptr<AdjacencyMatrix> matrix;
+	ArrayView<double> graphData;
+	std::vector<double> matrixChunk;
+	std::unique_ptr<SparseGraph> sparseGraphChunk;
 	int totalNumberOfVertices = -1;
 
+	std::unique_ptr<SparseGraph> sparseGraph;
+	std::vector<int> newNumbersOfVertices;
+
+	// validate additional source vertices
+	if (CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--sources")) {
+		validationResult = Validator::validateSourceVertices(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--sources", ""));
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			MPI_Finalize();
+			return 0;
+		}
+	}
+
 	// read data from command line arguments
-	int sourceVertexIndex = CommandLineArgumentsExtractor::extractSourceVertexIndexFromCommandLineArguments(argv);
+	std::vector<int> sourceVerticesIndices = CommandLineArgumentsExtractor::extractSourceVerticesIndicesFromCommandLineArguments(argc, argv);
+	int sourceVertexIndex = sourceVerticesIndices.front();
+	bool inputIsEdgeList = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--edge-list");
+	bool useDistributedEngine = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--distributed");
+	bool useSparseGraph = inputIsEdgeList || useDistributedEngine || CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--sparse");
+	bool useTransposedChunks = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--transposed");
+	bool useParallelRead = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--parallel-read");
+	bool useMultiSettle = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--multi-settle");
+	bool useNodeSharedMemory = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--shared-memory");
+	bool compressResults = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--compress-results");
+	bool useBinaryResults = compressResults || CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--binary-results");
+	std::string numberOfThreadsOption = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--threads", "1");
+	std::string weightTypeName = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--weights", "double");
+	std::string balanceModeName = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--balance", "");
+	std::string bucketWidthOption = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--distributed", "");
+
+	validationResult = Validator::validateWeightType(weightTypeName);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		MPI_Finalize();
+		return 0;
+	}
 
-	if (processRank == 0) {
+	if (CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--balance")) {
+		validationResult = Validator::validateBalanceMode(balanceModeName);
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			MPI_Finalize();
+			return 0;
+		}
+	}
+
+	// bucket width of distributed engine is computed from weights unless user gives it
+	if (!bucketWidthOption.empty()) {
+		validationResult = Validator::validateBucketWidth(bucketWidthOption);
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			MPI_Finalize();
+			return 0;
+		}
+	}
 
-		// read data from command line arguments
-		std::string filePath = CommandLineArgumentsExtractor::extractInputFileNameFromCommandLineArguments(argc, argv);
+	validationResult = Validator::validateNumberOfThreads(numberOfThreadsOption);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		MPI_Finalize();
+		return 0;
+	}
 
-		// read graph data from file
-		std::unique_ptr<AdjacencyMatrix> matrix = AdjacencyMatrix::fromFile(filePath);
-		graphData = matrix->asContinousVector();
-		totalNumberOfVertices = matrix->getNumberOfVertices();
+	int numberOfThreads = std::stoi(numberOfThreadsOption);
+	if (numberOfThreads > 1 && providedThreadSupport < MPI_THREAD_FUNNELED) {
+		log.logMessage("MPI library does not support threads, only one thread will be used.");
+		numberOfThreads = 1;
+	}
+	if (useMultiSettle && sourceVerticesIndices.size() > 1) {
+		log.logMessage("Multi-settle rounds are not used by searches from several source vertices.");
+		useMultiSettle = false;
+	}
+	if (useDistributedEngine && sourceVerticesIndices.size() > 1) {
+		log.logMessage("Distributed engine searches from one source vertex, it will not be used.");
+		useDistributedEngine = false;
+	}
+	if (useMultiSettle && useDistributedEngine) {
+		log.logMessage("Multi-settle rounds are not used by distributed engine.");
+		useMultiSettle = false;
+	}
+	if (numberOfThreads > 1 && (sourceVerticesIndices.size() > 1 || useMultiSettle || useDistributedEngine)) {
+		log.logMessage("Searches from several source vertices, multi-settle rounds and distributed engine use one thread per process.");
+		numberOfThreads = 1;
+	}
+	if (weightTypeName != "double" && (useSparseGraph || sourceVerticesIndices.size() > 1 || useMultiSettle)) {
+		log.logMessage("Sparse graphs, searches from several source vertices and multi-settle rounds use double weights.");
+		weightTypeName = "double";
+	}
 
-		// prepare structures used to transfer data from process 0 using MPI
+	// search can stop as soon as target vertex is reached
+	bool useTargetVertex = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--target");
+	if (useTargetVertex) {
+		validationResult = Validator::validateTargetVertex(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--target", ""));
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			MPI_Finalize();
+			return 0;
+		}
+	}
+	if (useTargetVertex && sourceVerticesIndices.size() > 1) {
+		log.logMessage("Target vertex is not used by searches from several source vertices.");
+		useTargetVertex = false;
+	}
+	int targetVertexIndex = useTargetVertex ? std::stoi(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--target", "")) : -1;
+	if (useParallelRead && inputIsEdgeList) {
+		log.logMessage("Edge list can not be read in parallel, it will be read by first process.");
+		useParallelRead = false;
+	}
+	if (useParallelRead && useDistributedEngine && !BinaryGraphFile::checkIfFileIsBinaryGraph(CommandLineArgumentsExtractor::extractInputFileNameFromCommandLineArguments(argc, argv))) {
+		log.logMessage("Distributed engine takes its rows in parallel only from binary files, text file will be read by first process.");
+		useParallelRead = false;
+	}
+	if (useNodeSharedMemory && (useSparseGraph || useTransposedChunks || useParallelRead || useMultiSettle
+		|| weightTypeName != "double" || sourceVerticesIndices.size() > 1)) {
+		log.logMessage("Shared memory mode uses dense adjacency matrix with double weights read by first process, it will not be used.");
+		useNodeSharedMemory = false;
+	}
+
+	if (!balanceModeName.empty() && (!useSparseGraph || useParallelRead)) {
+		log.logMessage("Vertices are balanced only for sparse graphs read by first process, they will be divided equally.");
+		balanceModeName.clear();
+	}
+	if (balanceModeName == "measured" && (sourceVerticesIndices.size() > 1 || useDistributedEngine)) {
+		log.logMessage("Searches from several source vertices and distributed engine do not use measured costs, vertices will be balanced by edges.");
+		balanceModeName = "edges";
+	}
+
+	// in shared memory mode processes are ordered by nodes, so every node handles continous range of vertices
+	MPI_Comm processesCommunicator = MPI_COMM_WORLD;
+	int processIndex = processRank;
+	if (useNodeSharedMemory) {
+		processesCommunicator = NodeSharedMemory::createNodeOrderedCommunicator(MPI_COMM_WORLD);
+		MPI_Comm_rank(processesCommunicator, &processIndex);
+	}
+
+	std::unique_ptr<ParallelMatrixReader> parallelReader;
+	std::string inputFilePath = CommandLineArgumentsExtractor::extractInputFileNameFromCommandLineArguments(argc, argv);
+	bool inputIsBinary = useParallelRead && BinaryGraphFile::checkIfFileIsBinaryGraph(inputFilePath);
+	if (inputIsBinary) {
+
+		// binary file is mapped by every process - only pages of its own part are read later
+		if (useSparseGraph) {
+			sparseGraphChunk = SparseGraph::fromBinaryFile(inputFilePath);
+			totalNumberOfVertices = sparseGraphChunk->getNumberOfVertices();
+		}
+		else {
+			matrix = AdjacencyMatrix::fromFile(inputFilePath);
+			totalNumberOfVertices = matrix->getNumberOfVertices();
+		}
+		numbersOfColumnsForEachProcess = DijkstraMPISetup::divideGraphMatrixIntoChunks(totalNumberOfVertices, numberOfProcesses);
+	}
+	else if (useParallelRead) {
+
+		// every process reads and parses its own part of the file
+		parallelReader.reset(new ParallelMatrixReader(inputFilePath, MPI_COMM_WORLD));
+		totalNumberOfVertices = parallelReader->getNumberOfVertices();
 		numbersOfColumnsForEachProcess = DijkstraMPISetup::divideGraphMatrixIntoChunks(totalNumberOfVertices, numberOfProcesses);
-		matrixChunksDisplacements = DijkstraMPISetup::computeDisplacements(numbersOfColumnsForEachProcess, totalNumberOfVertices);
-		bufferSizes = DijkstraMPISetup::computeBufferSizesForEachProcess(numbersOfColumnsForEachProcess, totalNumberOfVertices);
+	}
+	else if (processRank == 0) {
+
+		if (useSparseGraph) {
+
+			// read graph data from file
+			sparseGraph = inputIsEdgeList ? SparseGraph::fromEdgeListFile(inputFilePath) : SparseGraph::fromFile(inputFilePath);
+			totalNumberOfVertices = sparseGraph->getNumberOfVertices();
+			log.logMessage("Graph stored in sparse form with ", sparseGraph->getNumberOfEdges(), " edges");
+
+			// vertices are divided equally, so that processes relax similar numbers of edges or so that few edges connect processes
+			if (balanceModeName.empty()) {
+				numbersOfColumnsForEachProcess = DijkstraMPISetup::divideGraphMatrixIntoChunks(totalNumberOfVertices, numberOfProcesses);
+			}
+			else if (balanceModeName == "partition") {
+				std::vector<int> parts = MultilevelPartitioner::partitionGraph(*sparseGraph, totalNumberOfVertices >= numberOfProcesses ? numberOfProcesses : 1);
+				numbersOfColumnsForEachProcess = DijkstraMPISetup::countVerticesOfParts(parts, numberOfProcesses);
+				log.logMessage("Edge cut of partition: ", MultilevelPartitioner::computeEdgeCut(*sparseGraph, parts), " of ", sparseGraph->getNumberOfEdges(),
+					" edges, imbalance: ", MultilevelPartitioner::computeImbalance(parts, numberOfProcesses));
+
+				// vertices of every part get continous numbers - searches run on renumbered graph
+				newNumbersOfVertices = DijkstraMPISetup::renumberVerticesByParts(parts, numbersOfColumnsForEachProcess);
+				sparseGraph = sparseGraph->createRenumberedGraph(newNumbersOfVertices);
+			}
+			else {
+				std::vector<double> costsOfVertices = DijkstraMPISetup::computeCostsOfVertices(*sparseGraph, useDistributedEngine);
+				log.logMessage("Imbalance of equal division: ", DijkstraMPISetup::computeImbalance(costsOfVertices,
+					DijkstraMPISetup::divideGraphMatrixIntoChunks(totalNumberOfVertices, numberOfProcesses)));
+				numbersOfColumnsForEachProcess = DijkstraMPISetup::divideVerticesByCosts(costsOfVertices, numberOfProcesses);
+				log.logMessage("Imbalance of division by edges: ", DijkstraMPISetup::computeImbalance(costsOfVertices, numbersOfColumnsForEachProcess));
+			}
+		}
+		else {
 
+			// read graph data from file
+			matrix = AdjacencyMatrix::fromFile(inputFilePath);
+			graphData = matrix->asContinousVector();
+			totalNumberOfVertices = matrix->getNumberOfVertices();
+
+			// prepare structures used to transfer data from process 0 using MPI
+			numbersOfColumnsForEachProcess = DijkstraMPISetup::divideGraphMatrixIntoChunks(totalNumberOfVertices, numberOfProcesses);
+			matrixChunksDisplacements = DijkstraMPISetup::computeDisplacements(numbersOfColumnsForEachProcess, totalNumberOfVertices);
+			bufferSizes = DijkstraMPISetup::computeBufferSizesForEachProcess(numbersOfColumnsForEachProcess, totalNumberOfVertices);
+		}
 	}
 
 	// broadcast graph size using MPI
 	MPI_Bcast(&totalNumberOfVertices, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
 	// perform additional validation
-	validationResult = Validator::validateVerticesNumbers(totalNumberOfVertices, sourceVertexIndex);
-	if (!validationResult.first) {
-		log.logMessage(validationResult.second);
+	for (int source : sourceVerticesIndices) {
+		validationResult = Validator::validateVerticesNumbers(totalNumberOfVertices, source);
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			MPI_Finalize();
+			return 0;
+		}
+	}
+	if (targetVertexIndex >= totalNumberOfVertices) {
+		log.logMessage("This target vertex is not valid. Exiting.");
 		MPI_Finalize();
 		return 0;
 	}
 
-	// send graph data to all processes
-	int numberOfColumnsToHandle = -1;
-	MPI_Scatter(numbersOfColumnsForEachProcess.data(), 1, MPI_INT, &numberOfColumnsToHandle, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	// searches run on partitioned graph with new numbers of vertices, results get original numbers before they are written
+	bool usePartition = balanceModeName == "partition";
+	std::vector<int> originalSourceVerticesIndices = sourceVerticesIndices;
+	int originalTargetVertexIndex = targetVertexIndex;
+	if (usePartition) {
+		if (processRank == 0) {
+			for (int& source : sourceVerticesIndices) {
+				source = newNumbersOfVertices[source];
+			}
+			targetVertexIndex = targetVertexIndex == -1 ? -1 : newNumbersOfVertices[targetVertexIndex];
+		}
+		MPI_Bcast(sourceVerticesIndices.data(), static_cast<int>(sourceVerticesIndices.size()), MPI_INT, 0, MPI_COMM_WORLD);
+		MPI_Bcast(&targetVertexIndex, 1, MPI_INT, 0, MPI_COMM_WORLD);
+		sourceVertexIndex = sourceVerticesIndices.front();
+	}
+
+	// send graph data to all processes - every process knows ranges of all processes
+	numbersOfColumnsForEachProcess.resize(numberOfProcesses);
+	MPI_Bcast(numbersOfColumnsForEachProcess.data(), numberOfProcesses, MPI_INT, 0, processesCommunicator);
+	int numberOfColumnsToHandle = numbersOfColumnsForEachProcess[processIndex];
+
+	if (inputIsBinary) {
+
+		// every process takes only its own columns from mapped file
+		std::pair<int, int> verticesToHandleRange = DijkstraMPISetup::computeRangeOfVerticesToHandle(numbersOfColumnsForEachProcess, processIndex);
+		if (useSparseGraph) {
+			sparseGraphChunk = useDistributedEngine
+				? sparseGraphChunk->extractRowsOfVerticesInRange(verticesToHandleRange)
+				: DijkstraMPISetup::extractSparseGraphChunkFromBinaryFile(inputFilePath, *sparseGraphChunk, numberOfProcesses, processRank, verticesToHandleRange);
+			log.logMessage("Graph chunk stored in sparse form with ", sparseGraphChunk->getNumberOfEdges(), " edges");
+		}
+		else {
+			matrixChunk = DijkstraMPISetup::extractMatrixChunk(matrix->asContinousVector(), totalNumberOfVertices, verticesToHandleRange, useTransposedChunks);
+			matrix.reset();
+		}
+	}
+	else if (useParallelRead) {
+
+		// weights are sent directly to processes that handle their columns - sparse chunk is built from row-wise chunk
+		matrixChunk = parallelReader->distributeColumns(numbersOfColumnsForEachProcess, useSparseGraph || useTransposedChunks);
+		parallelReader.reset();
+		if (useSparseGraph) {
+			sparseGraphChunk = DijkstraMPISetup::convertRowWiseChunkToSparseGraph(matrixChunk, 
+				DijkstraMPISetup::computeRangeOfVerticesToHandle(numbersOfColumnsForEachProcess, processIndex));
+			matrixChunk.clear();
+			log.logMessage("Graph chunk stored in sparse form with ", sparseGraphChunk->getNumberOfEdges(), " edges");
+		}
+	}
+	else if (useSparseGraph) {
+
+		// every process gets full offsets array, but only edges leading to vertices it handles - or only rows of its vertices in distributed engine
+		sparseGraphChunk = useDistributedEngine
+			? DijkstraMPISetup::scatterSparseGraphRows(sparseGraph.get(), numbersOfColumnsForEachProcess, processesCommunicator)
+			: DijkstraMPISetup::scatterSparseGraphChunks(sparseGraph.get(), numbersOfColumnsForEachProcess, totalNumberOfVertices, processesCommunicator);
+		if (balanceModeName == "measured" && totalNumberOfVertices >= numberOfProcesses) {
+			sparseGraphChunk = repartitionUsingMeasuredCosts(sparseGraph.get(), numbersOfColumnsForEachProcess, *sparseGraphChunk, totalNumberOfVertices, 
+				sourceVertexIndex, numberOfThreads, targetVertexIndex, processesCommunicator, log);
+			numberOfColumnsToHandle = numbersOfColumnsForEachProcess[processIndex];
+		}
+		sparseGraph.reset();
+	}
+	else if (useNodeSharedMemory) {
 
-	std::vector<double> matrixChunk (numberOfColumnsToHandle * totalNumberOfVertices, 0.0);
-	MPI_Scatterv(graphData.data(), bufferSizes.data(), matrixChunksDisplacements.data(),
-		MPI_DOUBLE, matrixChunk.data(), numberOfColumnsToHandle * totalNumberOfVertices, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-	graphData.clear();
+		// columns are sent to node leaders only, after processes are grouped by nodes
+	}
+	else if (useTransposedChunks) {
+
+		// columns are sent as usual, but each of them is received into a column of row-wise arranged chunk
+		MPI_Datatype transposedColumnDatatype = DijkstraMPISetup::createTransposedColumnDatatype(totalNumberOfVertices, numberOfColumnsToHandle);
+		matrixChunk.resize(numberOfColumnsToHandle * totalNumberOfVertices, 0.0);
+		MPI_Scatterv(graphData.data(), bufferSizes.data(), matrixChunksDisplacements.data(),
+			MPI_DOUBLE, matrixChunk.data(), numberOfColumnsToHandle, transposedColumnDatatype, 0, MPI_COMM_WORLD);
+		MPI_Type_free(&transposedColumnDatatype);
+		graphData = ArrayView<double>();
+		matrix.reset();
+	}
+	else {
+		matrixChunk.resize(numberOfColumnsToHandle * totalNumberOfVertices, 0.0);
+		MPI_Scatterv(graphData.data(), bufferSizes.data(), matrixChunksDisplacements.data(),
+			MPI_DOUBLE, matrixChunk.data(), numberOfColumnsToHandle * totalNumberOfVertices, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+		graphData = ArrayView<double>();
+		matrix.reset();
+	}
+
+	// weights of dense chunk are converted to type chosen by user - every process converts its own chunk
+	std::vector<float> floatMatrixChunk;
+	std::vector<std::uint16_t> uint16MatrixChunk;
+	if (weightTypeName != "double") {
+		int converted = weightTypeName == "float" 
+			? convertWeights(matrixChunk, floatMatrixChunk) 
+			: convertWeights(matrixChunk, uint16MatrixChunk);
+		matrixChunk = std::vector<double>();
+
+		// all processes have to agree, so none of them starts the algorithm alone
+		MPI_Allreduce(MPI_IN_PLACE, &converted, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+		if (!converted) {
+			log.logMessage("Graph contains weights that can not be stored as ", weightTypeName, ".");
+			MPI_Finalize();
+			return 0;
+		}
+		log.logMessage("Weights stored as ", weightTypeName);
+	}
 
 	// create new communicator - to distinguish idle processes from those that calculate algorithm
 	MPI_Comm activeProcessesCommunicator;
-	MPI_Comm_split(MPI_COMM_WORLD, numberOfColumnsToHandle > 0, processRank, &activeProcessesCommunicator);
+	MPI_Comm_split(processesCommunicator, numberOfColumnsToHandle > 0, processIndex, &activeProcessesCommunicator);
 
 	if (numberOfColumnsToHandle > 0) {
 
-		std::pair<int, int> verticesToHandleRange = DijkstraMPISetup::computeRangeOfVerticesToHandle(totalNumberOfVertices, numberOfProcesses, processRank, numberOfColumnsToHandle);
+		std::pair<int, int> verticesToHandleRange = DijkstraMPISetup::computeRangeOfVerticesToHandle(numbersOfColumnsForEachProcess, processIndex);
 		log.logMessage("This process will handle ", numberOfColumnsToHandle, " vertices in range [", verticesToHandleRange.first, ", ", verticesToHandleRange.second, "]");
 
-		auto tBeforeAlgorithmStart = std::chrono::high_resolution_clock::now();
-
-		// run Dijkstra algorithm
-		DijkstraMPI dijkstraAlgorith(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, matrixChunk);
-		auto dijkstraResult = dijkstraAlgorith.run(activeProcessesCommunicator);
-
-		std::vector<int> resultsDisplacements;
-		if (processRank == 0) {
-			numbersOfColumnsForEachProcess.erase(std::remove(numbersOfColumnsForEachProcess.begin(), numbersOfColumnsForEachProcess.end(), 0), numbersOfColumnsForEachProcess.end());
-			resultsDisplacements = DijkstraMPISetup::computeDisplacements(numbersOfColumnsForEachProcess, 1);
+		// processes of every node store one copy of their columns in shared memory
+		std::unique_ptr<NodeSharedMemory> nodeSharedMemory;
+		ArrayView<double> sharedMatrixChunk;
+		if (useNodeSharedMemory) {
+			nodeSharedMemory.reset(new NodeSharedMemory(activeProcessesCommunicator));
+			sharedMatrixChunk = nodeSharedMemory->distributeMatrixColumns(graphData, totalNumberOfVertices, numberOfColumnsToHandle);
+			graphData = ArrayView<double>();
+			matrix.reset();
+			if (nodeSharedMemory->checkIfIsNodeLeader()) {
+				log.logMessage("Columns of ", nodeSharedMemory->getNumberOfProcessesOnNode(), " processes of this node are stored in shared memory");
+			}
 		}
 
-		// prepare structures for gathering results
-		std::vector<double> globalDistances(totalNumberOfVertices, 0);
-		std::vector<int> globalPredecessors(totalNumberOfVertices, -1);
-
-		// gather results
-		MPI_Gatherv(dijkstraResult.first.data(), numberOfColumnsToHandle, MPI_DOUBLE,
-			globalDistances.data(), numbersOfColumnsForEachProcess.data(), resultsDisplacements.data(),
-			MPI_DOUBLE, 0, activeProcessesCommunicator);
-
-		MPI_Gatherv(dijkstraResult.second.data(), numberOfColumnsToHandle, MPI_INT,
-			globalPredecessors.data(), numbersOfColumnsForEachProcess.data(), resultsDisplacements.data(),
-			MPI_INT, 0, activeProcessesCommunicator);
+		// select vectorized kernels - the best instruction set is used unless user chooses other one
+		std::string instructionSetName = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--isa", "");
+		if (!instructionSetName.empty() && !RelaxationKernels::selectInstructionSet(instructionSetName)) {
+			log.logMessage("Instruction set ", instructionSetName, " is not supported.");
+		}
+		log.logMessage("Using ", RelaxationKernels::getInstructionSetName(), " kernels and ", numberOfThreads, " threads");
 
-		auto tBeforePrinting = std::chrono::high_resolution_clock::now();
+		auto tBeforeAlgorithmStart = std::chrono::high_resolution_clock::now();
 
-		if (processRank == 0) {
+		// run Dijkstra algorithm - searches from several source vertices are run in lockstep
+		std::vector<std::pair<const std::vector<double>, const std::vector<int>>> dijkstraResults;
+		if (useDistributedEngine) {
+
+			// every process relaxes edges leaving its vertices and sends relaxations of other vertices to their owners
+			double bucketWidth = bucketWidthOption.empty()
+				? DijkstraMPIDistributed::computeDefaultBucketWidth(*sparseGraphChunk, totalNumberOfVertices, activeProcessesCommunicator)
+				: std::stod(bucketWidthOption);
+			DijkstraMPIDistributed dijkstra(verticesToHandleRange, numbersOfColumnsForEachProcess, sourceVertexIndex, *sparseGraphChunk, bucketWidth, targetVertexIndex);
+			dijkstraResults.push_back(dijkstra.run(activeProcessesCommunicator));
+
+			std::int64_t numberOfSentRelaxations = dijkstra.getNumberOfSentRelaxations();
+			std::int64_t totalNumberOfSentRelaxations = 0;
+			MPI_Reduce(&numberOfSentRelaxations, &totalNumberOfSentRelaxations, 1, MPI_INT64_T, MPI_SUM, 0, activeProcessesCommunicator);
+			if (processRank == 0) {
+				log.logMessage("Vertices processed in ", dijkstra.getNumberOfRounds(), " rounds of communication with bucket width ", bucketWidth,
+					", ", totalNumberOfSentRelaxations, " relaxations sent between processes");
+			}
+		}
+		else if (useMultiSettle) {
+
+			// every round processes all vertices whose distances can not be improved any more
+			int numberOfRounds = 0;
+			if (useSparseGraph) {
+				DijkstraMPIMultiSettle<SparseGraph> dijkstra(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, *sparseGraphChunk, targetVertexIndex);
+				dijkstraResults.push_back(dijkstra.run(activeProcessesCommunicator));
+				numberOfRounds = dijkstra.getNumberOfRounds();
+			}
+			else if (useTransposedChunks) {
+				TransposedMatrixChunk transposedMatrixChunk(std::move(matrixChunk), numberOfColumnsToHandle);
+				DijkstraMPIMultiSettle<TransposedMatrixChunk> dijkstra(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, transposedMatrixChunk, targetVertexIndex);
+				dijkstraResults.push_back(dijkstra.run(activeProcessesCommunicator));
+				numberOfRounds = dijkstra.getNumberOfRounds();
+			}
+			else {
+				DijkstraMPIMultiSettle<std::vector<double>> dijkstra(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, matrixChunk, targetVertexIndex);
+				dijkstraResults.push_back(dijkstra.run(activeProcessesCommunicator));
+				numberOfRounds = dijkstra.getNumberOfRounds();
+			}
+			if (processRank == 0) {
+				log.logMessage("Vertices processed in ", numberOfRounds, " rounds of communication");
+			}
+		}
+		else if (sourceVerticesIndices.size() > 1) {
+			log.logMessage("Running searches from ", sourceVerticesIndices.size(), " source vertices");
+			dijkstraResults = useSparseGraph
+				? DijkstraMPIMultiSource<SparseGraph>(verticesToHandleRange, totalNumberOfVertices, sourceVerticesIndices, 
+					*sparseGraphChunk).run(activeProcessesCommunicator)
+				: useTransposedChunks
+				? DijkstraMPIMultiSource<TransposedMatrixChunk>(verticesToHandleRange, totalNumberOfVertices, sourceVerticesIndices, 
+					TransposedMatrixChunk(std::move(matrixChunk), numberOfColumnsToHandle)).run(activeProcessesCommunicator)
+				: DijkstraMPIMultiSource<std::vector<double>>(verticesToHandleRange, totalNumberOfVertices, sourceVerticesIndices, 
+					matrixChunk).run(activeProcessesCommunicator);
+		}
+		else {
+			dijkstraResults.push_back(useNodeSharedMemory
+				? DijkstraMPI<ArrayView<double>>(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, sharedMatrixChunk,
+					numberOfThreads, targetVertexIndex).run(*nodeSharedMemory)
+				: useSparseGraph
+				? DijkstraMPI<SparseGraph>(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, *sparseGraphChunk, 
+					numberOfThreads, targetVertexIndex).run(activeProcessesCommunicator)
+				: weightTypeName == "float"
+				? runWithConvertedWeights(floatMatrixChunk, useTransposedChunks, verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex,
+					numberOfThreads, targetVertexIndex, activeProcessesCommunicator)
+				: weightTypeName == "uint16"
+				? runWithConvertedWeights(uint16MatrixChunk, useTransposedChunks, verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex,
+					numberOfThreads, targetVertexIndex, activeProcessesCommunicator)
+				: useTransposedChunks
+				? DijkstraMPI<TransposedMatrixChunk>(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, 
+					TransposedMatrixChunk(std::move(matrixChunk), numberOfColumnsToHandle), numberOfThreads, targetVertexIndex).run(activeProcessesCommunicator)
+				: DijkstraMPI<std::vector<double>>(verticesToHandleRange, totalNumberOfVertices, sourceVertexIndex, matrixChunk, 
+					numberOfThreads, targetVertexIndex).run(activeProcessesCommunicator));
+		}
 
+		// every process writes its own part of results - nothing is gathered (unless vertices have to get original numbers)
+		if (useBinaryResults && !usePartition) {
 			auto tBeforePrinting = std::chrono::high_resolution_clock::now();
 
-			// print results to file
-			std::ofstream file("resultsMPI.txt");
-			ResultsPrinter resultsPrinter(file);
-			resultsPrinter.printResultingDistances(globalDistances, sourceVertexIndex);
-			resultsPrinter.printResultingPaths(globalPredecessors, sourceVertexIndex);
+			std::string binaryResultsFilePath = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--binary-results", "resultsMPI.bin");
+			for (size_t s = 0; s < dijkstraResults.size(); ++s) {
+				ParallelResultsWriter::writeResults(createBinaryResultsFilePath(binaryResultsFilePath, sourceVerticesIndices[s], dijkstraResults.size() > 1),
+					dijkstraResults[s].first, dijkstraResults[s].second, verticesToHandleRange, totalNumberOfVertices, sourceVerticesIndices[s],
+					targetVertexIndex, compressResults, activeProcessesCommunicator);
+			}
 
 			auto tEnd = std::chrono::high_resolution_clock::now();
 
-			// log information about elapsed time
-			std::chrono::duration<double> diff = tEnd - tStart;
-			std::chrono::duration<double> diffTotal = tEnd - tStart;
-			std::chrono::duration<double> diffSetup = tBeforeAlgorithmStart - tStart;
-			std::chrono::duration<double> diffAlgo = tBeforePrinting - tBeforeAlgorithmStart;
-			std::chrono::duration<double> diffPrint = tEnd - tBeforePrinting;
-			log.logMessage("Total elapsed time: ", diffTotal.count(), "s");
-			log.logMessage("Setup took: ", diffSetup.count(), "s");
-			log.logMessage("Algorithm took: ", diffAlgo.count(), "s");
-			log.logMessage("Printing solution took: ", diffPrint.count(), "s");
+			if (processRank == 0) {
+
+				// log information about elapsed time
+				std::chrono::duration<double> diffTotal = tEnd - tStart;
+				std::chrono::duration<double> diffSetup = tBeforeAlgorithmStart - tStart;
+				std::chrono::duration<double> diffAlgo = tBeforePrinting - tBeforeAlgorithmStart;
+				std::chrono::duration<double> diffPrint = tEnd - tBeforePrinting;
+				log.logMessage("Total elapsed time: ", diffTotal.count(), "s");
+				log.logMessage("Setup took: ", diffSetup.count(), "s");
+				log.logMessage("Algorithm took: ", diffAlgo.count(), "s");
+				log.logMessage("Writing binary results took: ", diffPrint.count(), "s");
+			}
 		}
+		else {
+			std::vector<int> resultsDisplacements;
+			if (processRank == 0) {
+				numbersOfColumnsForEachProcess.erase(std::remove(numbersOfColumnsForEachProcess.begin(), numbersOfColumnsForEachProcess.end(), 0), numbersOfColumnsForEachProcess.end());
+				resultsDisplacements = DijkstraMPISetup::computeDisplacements(numbersOfColumnsForEachProcess, 1);
+			}
+
+			// prepare structures for gathering results - one pair of arrays for each source vertex
+			std::vector<std::vector<double>> globalDistances(dijkstraResults.size(), std::vector<double>(totalNumberOfVertices, 0));
+			std::vector<std::vector<int>> globalPredecessors(dijkstraResults.size(), std::vector<int>(totalNumberOfVertices, -1));
+
+			// gather results
+			for (size_t s = 0; s < dijkstraResults.size(); ++s) {
+				MPI_Gatherv(dijkstraResults[s].first.data(), numberOfColumnsToHandle, MPI_DOUBLE,
+					globalDistances[s].data(), numbersOfColumnsForEachProcess.data(), resultsDisplacements.data(),
+					MPI_DOUBLE, 0, activeProcessesCommunicator);
+
+				MPI_Gatherv(dijkstraResults[s].second.data(), numberOfColumnsToHandle, MPI_INT,
+					globalPredecessors[s].data(), numbersOfColumnsForEachProcess.data(), resultsDisplacements.data(),
+					MPI_INT, 0, activeProcessesCommunicator);
+			}
 
+			auto tBeforePrinting = std::chrono::high_resolution_clock::now();
+
+			if (processRank == 0) {
+
+				auto tBeforePrinting = std::chrono::high_resolution_clock::now();
+
+				if (usePartition) {
+					for (size_t s = 0; s < dijkstraResults.size(); ++s) {
+						restoreOriginalNumbersOfVertices(globalDistances[s], globalPredecessors[s], newNumbersOfVertices);
+					}
+					sourceVerticesIndices = originalSourceVerticesIndices;
+					targetVertexIndex = originalTargetVertexIndex;
+				}
+
+				// print results to file - results of several searches go to separate files
+				for (size_t s = 0; s < dijkstraResults.size(); ++s) {
+					if (useBinaryResults) {
+						std::string binaryResultsFilePath = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--binary-results", "resultsMPI.bin");
+						ResultsFile::writeToFile(createBinaryResultsFilePath(binaryResultsFilePath, sourceVerticesIndices[s], dijkstraResults.size() > 1),
+							globalDistances[s], globalPredecessors[s], sourceVerticesIndices[s], targetVertexIndex, compressResults);
+						continue;
+					}
+					std::ofstream file(dijkstraResults.size() > 1 
+						? "resultsMPI_" + std::to_string(sourceVerticesIndices[s]) + ".txt" 
+						: std::string("resultsMPI.txt"));
+					ResultsPrinter resultsPrinter(file);
+					if (useTargetVertex) {
+						resultsPrinter.printResultForTargetVertex(globalDistances[s], globalPredecessors[s], sourceVerticesIndices[s], targetVertexIndex);
+					}
+					else {
+						resultsPrinter.printResultingDistances(globalDistances[s], sourceVerticesIndices[s]);
+						resultsPrinter.printResultingPaths(globalPredecessors[s], sourceVerticesIndices[s]);
+					}
+				}
+
+				auto tEnd = std::chrono::high_resolution_clock::now();
+
+				// log information about elapsed time
+				std::chrono::duration<double> diff = tEnd - tStart;
+				std::chrono::duration<double> diffTotal = tEnd - tStart;
+				std::chrono::duration<double> diffSetup = tBeforeAlgorithmStart - tStart;
+				std::chrono::duration<double> diffAlgo = tBeforePrinting - tBeforeAlgorithmStart;
+				std::chrono::duration<double> diffPrint = tEnd - tBeforePrinting;
+				log.logMessage("Total elapsed time: ", diffTotal.count(), "s");
+				log.logMessage("Setup took: ", diffSetup.count(), "s");
+				log.logMessage("Algorithm took: ", diffAlgo.count(), "s");
+				log.logMessage("Printing solution took: ", diffPrint.count(), "s");
+			}
+		}
 	}
 
 	// finish using MPI
 	MPI_Comm_free(&activeProcessesCommunicator);
+	if (processesCommunicator != MPI_COMM_WORLD) {
+		MPI_Comm_free(&processesCommunicator);
+	}
 	MPI_Finalize();
 
     return 0;
@@ -0,0 +1,80 @@
+#include "PathExtractor.h"
+#include "ResultsFile.h"
+
+#include <algorithm>
+
+
+std::unique_ptr<PathExtractor> PathExtractor::fromFile(const std::string& filePath) {
+
+	std::unique_ptr<MappedFile> file = MappedFile::open(filePath);
+	if (!file) {
+		return nullptr;
+	}
+	const ResultsFile::Header* header = ResultsFile::readHeader(*file, filePath);
+	if (header == nullptr) {
+		return nullptr;
+	}
+
+	std::unique_ptr<PathExtractor> extractor(new PathExtractor());
+	extractor->m_distances = ResultsFile::getDistances(*file);
+	if (header->predecessorsEncoding == ResultsFile::Compressed) {
+		if (!ResultsFile::decompressPredecessors(*file, filePath, extractor->m_decompressedPredecessors)) {
+			return nullptr;
+		}
+		extractor->m_predecessors = extractor->m_decompressedPredecessors;
+	}
+	else {
+		extractor->m_predecessors = ResultsFile::getPredecessors(*file);
+	}
+	extractor->m_sourceVertexIndex = static_cast<int>(header->sourceVertex);
+	extractor->m_targetVertexIndex = static_cast<int>(header->targetVertex);
+	extractor->m_knownPaths[extractor->m_sourceVertexIndex] = KnownPath{ 0, 1 };
+	extractor->m_rememberedPaths.push_back(extractor->m_sourceVertexIndex);
+	extractor->m_file = std::move(file);
+	return extractor;
+}
+
+
+ArrayView<int> PathExtractor::extractPath(int targetVertexIndex) {
+
+	// walk up predecessors until vertex with known path is reached - number of steps is
+	// limited, so predecessors that form a cycle do not stop extraction
+	m_walkedVertices.clear();
+	int currentVertex = targetVertexIndex;
+	auto knownPath = m_knownPaths.find(currentVertex);
+	while (currentVertex != -1 && knownPath == m_knownPaths.end() && m_walkedVertices.size() < m_predecessors.size()) {
+		m_walkedVertices.push_back(currentVertex);
+		currentVertex = m_predecessors[currentVertex];
+		knownPath = m_knownPaths.find(currentVertex);
+	}
+
+	// vertices that do not lead to source vertex are unreachable
+	if (knownPath == m_knownPaths.end() || knownPath->second.length == 0) {
+		for (int vertex : m_walkedVertices) {
+			m_knownPaths[vertex] = KnownPath{ 0, 0 };
+		}
+		return ArrayView<int>();
+	}
+
+	// known path is reused as a prefix - if it is the last remembered path, new vertices are just appended
+	KnownPath prefix = knownPath->second;
+	if (m_walkedVertices.empty()) {
+		return ArrayView<int>(m_rememberedPaths.data() + prefix.start, prefix.length);
+	}
+	size_t start = prefix.start;
+	if (prefix.start + prefix.length != m_rememberedPaths.size()) {
+		start = m_rememberedPaths.size();
+		size_t requiredCapacity = start + prefix.length + m_walkedVertices.size();
+		if (requiredCapacity > m_rememberedPaths.capacity()) {
+			m_rememberedPaths.reserve(std::max(requiredCapacity, 2 * m_rememberedPaths.capacity()));
+		}
+		for (size_t i = prefix.start; i < prefix.start + prefix.length; ++i) {
+			m_rememberedPaths.push_back(m_rememberedPaths[i]);
+		}
+	}
+	for (auto it = m_walkedVertices.rbegin(); it != m_walkedVertices.rend(); ++it) {
+		m_rememberedPaths.push_back(*it);
+		m_knownPaths[*it] = KnownPath{ start, m_rememberedPaths.size() - start };
+	}
+	return ArrayView<int>(m_rememberedPaths.data() + start, m_rememberedPaths.size() - start);
+}
@@ -0,0 +1,122 @@
+/**
+*	@file PathExtractor.h
+*	@brief This file contains PathExtractor class that extracts shortest paths
+*	from binary results file.
+*/
+
+#pragma once
+
+#include "ArrayView.h"
+#include "MappedFile.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// This class extracts shortest paths from source vertex to given vertices from
+/// binary results file (see ResultsFile). File is mapped into memory, so only pages
+/// with distances and predecessors of vertices on extracted paths are read - path is
+/// extracted in time proportional to its length (compressed predecessors have to
+/// be decompressed once first). Please note that this class is final - to use it,
+/// consider composition (not inheritance).
+/// </summary>
+/// <remarks>
+/// Extracted paths are remembered. Path to every vertex on the path is its prefix,
+/// so it is remembered too - as part of the same path. When walk up predecessors
+/// reaches vertex whose path is already known, the walk stops and the known path
+/// is reused, so paths with common prefixes (for example, paths to thousands of
+/// targets) are extracted much faster than one after another.
+/// </remarks>
+class PathExtractor final {
+
+public:
+
+	/// <summary>
+	/// Static factory method that maps results file. If file does not exist or is not
+	/// valid, proper information is printed.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer to created object or nullptr if file can not be used.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to results file.
+	/// </param>
+	static std::unique_ptr<PathExtractor> fromFile(const std::string& filePath);
+
+
+	/// <summary>
+	/// Returns shortest path from source vertex to given vertex.
+	/// </summary>
+	/// <returns>
+	/// View of vertices of the path, starting with source vertex - empty if vertex is
+	/// unreachable. It is valid until next path is extracted.
+	/// </returns>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex - it should be lower than number of vertices.
+	/// </param>
+	ArrayView<int> extractPath(int targetVertexIndex);
+
+
+	/// <summary>
+	/// Returns distance from source vertex to given vertex.
+	/// </summary>
+	inline double getDistance(int vertex) const {
+		return m_distances[vertex];
+	}
+
+
+	/// <summary>
+	/// Returns number of vertices.
+	/// </summary>
+	inline int getNumberOfVertices() const {
+		return static_cast<int>(m_distances.size());
+	}
+
+
+	/// <summary>
+	/// Returns number of source vertex.
+	/// </summary>
+	inline int getSourceVertexIndex() const {
+		return m_sourceVertexIndex;
+	}
+
+
+	/// <summary>
+	/// Returns number of target vertex the search has been stopped at, or -1 - then
+	/// paths to all vertices are valid.
+	/// </summary>
+	inline int getTargetVertexIndex() const {
+		return m_targetVertexIndex;
+	}
+
+private:
+
+	/// <summary>
+	/// Known path to vertex - part of remembered path, starting at the beginning of it.
+	/// Length 0 means that vertex is unreachable.
+	/// </summary>
+	struct KnownPath {
+		size_t start;
+		size_t length;
+	};
+
+
+	/// <summary>
+	/// Default constructor. It is private, as objects of this class should not be created
+	/// on their own - for creating instances in code, please use static factory methods.
+	/// </summary>
+	PathExtractor() = default;
+
+
+	std::unique_ptr<MappedFile> m_file;
+	ArrayView<double> m_distances;
+	ArrayView<int> m_predecessors;
+	std::vector<int> m_decompressedPredecessors;
+	int m_sourceVertexIndex = -1;
+	int m_targetVertexIndex = -1;
+	std::vector<int> m_rememberedPaths;
+	std::unordered_map<int, KnownPath> m_knownPaths;
+	std::vector<int> m_walkedVertices;
+};
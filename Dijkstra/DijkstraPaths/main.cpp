@@ -0,0 +1,109 @@
+#include "PathExtractor.h"
+#include "ResultsPrinter.h"
+#include "Log.h"
+#include "CommandLineArgumentsExtractor.h"
+#include "Validator.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef SHOULD_LOG
+#define SHOULD_LOG true
+#endif // !SHOULD_LOG
+
+
+/// <summary>
+/// Reads target vertices - numbers that follow path to results file and numbers from file
+/// given in --targets option. If file can not be read, proper information is printed.
+/// </summary>
+bool readTargetVertices(int argc, char* argv[], std::vector<long long>& targetVertices)
+{
+	for (int i = 2; i < argc; ++i) {
+		if (std::string(argv[i]).compare(0, 2, "--") != 0) {
+			targetVertices.push_back(std::stoll(argv[i]));
+		}
+	}
+
+	if (CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--targets")) {
+		std::string filePath = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--targets", "");
+		std::ifstream file(filePath);
+		if (!file.is_open()) {
+			std::cout << "Plik " << filePath << " nie istnieje." << std::endl;
+			return false;
+		}
+		long long targetVertex = 0;
+		while (file >> targetVertex) {
+			targetVertices.push_back(targetVertex);
+		}
+		if (!file.eof()) {
+			std::cout << "Plik " << filePath << " zawiera niepoprawne dane." << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int main(int argc, char* argv[]) {
+
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	// prepare Log class - initialize it with reference to standard output
+	Log<SHOULD_LOG> log(std::cout);
+
+	// validate command line arguments
+	auto validationResult = Validator::validatePathsCommandLineArguments(argc, argv);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		log.logMessage("Usage: DijkstraPaths RESULTS [TARGET...] [--targets=FILE] [--output=FILE]");
+		return 0;
+	}
+
+	// read data from command line arguments
+	std::string resultsFilePath = argv[1];
+	std::string outputFilePath = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--output", "paths.txt");
+	std::vector<long long> targetVertices;
+	if (!readTargetVertices(argc, argv, targetVertices)) {
+		return 0;
+	}
+
+	// map results file - compressed predecessors are decompressed
+	std::unique_ptr<PathExtractor> extractor = PathExtractor::fromFile(resultsFilePath);
+	if (!extractor) {
+		return 0;
+	}
+	log.logMessage("Results of search from vertex ", extractor->getSourceVertexIndex(), " in graph with ", extractor->getNumberOfVertices(), " vertices");
+
+	auto tBeforeExtraction = std::chrono::high_resolution_clock::now();
+
+	// extract and print paths - search stopped at target vertex has valid path only to it
+	std::ofstream file(outputFilePath);
+	ResultsPrinter resultsPrinter(file);
+	int numberOfExtractedPaths = 0;
+	for (long long targetVertex : targetVertices) {
+		if (targetVertex < 0 || targetVertex >= extractor->getNumberOfVertices()) {
+			log.logMessage("Target vertex ", targetVertex, " is not valid.");
+			continue;
+		}
+		if (extractor->getTargetVertexIndex() != -1 && targetVertex != extractor->getTargetVertexIndex()) {
+			log.logMessage("Results contain only path to vertex ", extractor->getTargetVertexIndex(), ", vertex ", targetVertex, " is skipped.");
+			continue;
+		}
+		int vertex = static_cast<int>(targetVertex);
+		resultsPrinter.printPathToTargetVertex(extractor->getDistance(vertex), extractor->extractPath(vertex), extractor->getSourceVertexIndex(), vertex);
+		++numberOfExtractedPaths;
+	}
+
+	auto tEnd = std::chrono::high_resolution_clock::now();
+
+	// log information about elapsed time
+	std::chrono::duration<double> diffRead = tBeforeExtraction - tStart;
+	std::chrono::duration<double> diffExtract = tEnd - tBeforeExtraction;
+	log.logMessage("Reading results took: ", diffRead.count(), "s");
+	log.logMessage("Extracting ", numberOfExtractedPaths, " paths to ", outputFilePath, " took: ", diffExtract.count(), "s");
+
+	return 0;
+}
@@ -0,0 +1,211 @@
+#include "DijkstraIncremental.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+
+DijkstraIncremental::DijkstraIncremental(const SparseGraph& graphData, const SparseGraph& reversedGraphData, int sourceVertexIndex,
+	std::vector<double> distances, std::vector<int> predecessors) :
+	m_graphData(graphData),
+	m_reversedGraphData(reversedGraphData),
+	m_sourceVertexIndex(sourceVertexIndex),
+	m_heap(graphData.getNumberOfVertices()),
+	m_distances(std::move(distances)),
+	m_predecessors(std::move(predecessors)),
+	m_affected(graphData.getNumberOfVertices(), false),
+	m_markedForRepair(graphData.getNumberOfVertices(), false)
+{
+}
+
+
+std::pair<const std::vector<double>, const std::vector<int>> DijkstraIncremental::run(const std::vector<Edge>& changedEdges) {
+
+	resetAffectedVertices(changedEdges);
+	queueBoundaryVertices(changedEdges);
+	processQueuedVertices();
+	repairPredecessors(changedEdges);
+
+	return std::make_pair(m_distances, m_predecessors);
+}
+
+
+bool DijkstraIncremental::readChangedEdgesFromFile(const std::string& filePath, int numberOfVertices, std::vector<Edge>& changedEdges) {
+
+	std::ifstream infile(filePath, std::ifstream::in);
+	if (!infile.is_open()) {
+		std::cout << "Plik " << filePath << " nie istnieje." << std::endl;
+		return false;
+	}
+
+	// file is read line after line, so line with wrong data can be reported - empty lines are skipped
+	std::string line;
+	for (int lineNumber = 1; std::getline(infile, line); ++lineNumber) {
+		if (line.find_first_not_of(" \t\r") == std::string::npos) {
+			continue;
+		}
+
+		std::istringstream lineStream(line);
+		Edge edge;
+		std::string remainingText;
+		if (!(lineStream >> edge.source >> edge.target >> edge.weight) || lineStream >> remainingText) {
+			std::cout << "Plik " << filePath << " zawiera niepoprawne dane w linii " << lineNumber << "." << std::endl;
+			changedEdges.clear();
+			return false;
+		}
+		if (edge.source < 0 || edge.source >= numberOfVertices || edge.target < 0 || edge.target >= numberOfVertices) {
+			std::cout << "Krawedz " << edge.source << " -> " << edge.target << " wykracza poza graf, pomijam." << std::endl;
+			continue;
+		}
+		changedEdges.push_back(edge);
+	}
+	return true;
+}
+
+
+void DijkstraIncremental::resetAffectedVertices(const std::vector<Edge>& changedEdges) {
+
+	ArrayView<int> offsets = m_graphData.getOffsets();
+	ArrayView<int> targets = m_graphData.getTargets();
+
+	// changed edge of shortest path tree may have become longer or may not exist any more - whether
+	// it is shorter is not checked, because such vertex is queued again anyway
+	for (const Edge& edge : changedEdges) {
+		if (m_predecessors[edge.target] == edge.source && !m_affected[edge.target]) {
+			m_affected[edge.target] = true;
+			m_affectedVertices.push_back(edge.target);
+		}
+	}
+
+	// children of vertex in the tree are its neighbours which predecessor it is - the list grows while it is visited
+	for (size_t i = 0; i < m_affectedVertices.size(); ++i) {
+		int vertex = m_affectedVertices[i];
+		for (int e = offsets[vertex]; e < offsets[vertex + 1]; ++e) {
+			if (m_predecessors[targets[e]] == vertex && !m_affected[targets[e]]) {
+				m_affected[targets[e]] = true;
+				m_affectedVertices.push_back(targets[e]);
+			}
+		}
+	}
+
+	for (int vertex : m_affectedVertices) {
+		m_distances[vertex] = std::numeric_limits<double>::infinity();
+		m_predecessors[vertex] = -1;
+	}
+}
+
+
+void DijkstraIncremental::queueBoundaryVertices(const std::vector<Edge>& changedEdges) {
+
+	// affected vertex can be reached through any unaffected neighbour - distances of unaffected
+	// vertices are lengths of existing paths, so they are never too small
+	ArrayView<int> reversedOffsets = m_reversedGraphData.getOffsets();
+	ArrayView<int> sources = m_reversedGraphData.getTargets();
+	ArrayView<double> reversedWeights = m_reversedGraphData.getWeights();
+	for (int vertex : m_affectedVertices) {
+		for (int e = reversedOffsets[vertex]; e < reversedOffsets[vertex + 1]; ++e) {
+			double altDistance = reversedWeights[e] + m_distances[sources[e]];
+			if (!m_affected[sources[e]] && altDistance < m_distances[vertex]) {
+				m_distances[vertex] = altDistance;
+				m_heap.insertOrDecreaseKey(vertex, altDistance);
+			}
+		}
+	}
+
+	// weights are taken from the changed graph, so repeated changes of the same edge are handled the same way
+	ArrayView<int> offsets = m_graphData.getOffsets();
+	ArrayView<int> targets = m_graphData.getTargets();
+	ArrayView<double> weights = m_graphData.getWeights();
+	for (const Edge& edge : changedEdges) {
+		if (m_affected[edge.source] || m_distances[edge.source] == std::numeric_limits<double>::infinity()) {
+			continue;
+		}
+		auto rowBegin = targets.begin() + offsets[edge.source];
+		auto rowEnd = targets.begin() + offsets[edge.source + 1];
+		auto changedEdgeRange = std::equal_range(rowBegin, rowEnd, edge.target);
+		for (auto target = changedEdgeRange.first; target != changedEdgeRange.second; ++target) {
+			double altDistance = weights[target - targets.begin()] + m_distances[edge.source];
+			if (altDistance < m_distances[edge.target]) {
+				m_distances[edge.target] = altDistance;
+				m_heap.insertOrDecreaseKey(edge.target, altDistance);
+			}
+		}
+	}
+}
+
+
+void DijkstraIncremental::processQueuedVertices() {
+
+	ArrayView<int> offsets = m_graphData.getOffsets();
+	ArrayView<int> targets = m_graphData.getTargets();
+	ArrayView<double> weights = m_graphData.getWeights();
+
+	// vertices are queued only when their distances decrease, so search stops where old distances are still valid
+	while (!m_heap.isEmpty()) {
+		int processedVertex = m_heap.extractMin().vertexNumber;
+		double distanceOfProcessedVertex = m_distances[processedVertex];
+		m_processedVertices.push_back(processedVertex);
+		++m_numberOfProcessedVertices;
+
+		for (int e = offsets[processedVertex]; e < offsets[processedVertex + 1]; ++e) {
+			double altDistance = weights[e] + distanceOfProcessedVertex;
+			if (altDistance < m_distances[targets[e]]) {
+				m_distances[targets[e]] = altDistance;
+				m_heap.insertOrDecreaseKey(targets[e], altDistance);
+			}
+		}
+	}
+}
+
+
+void DijkstraIncremental::repairPredecessors(const std::vector<Edge>& changedEdges) {
+
+	// predecessor can change only if distance of vertex, its incoming edges or distance of one of
+	// its neighbours has changed - distances of other vertices are the same as before
+	ArrayView<int> offsets = m_graphData.getOffsets();
+	ArrayView<int> targets = m_graphData.getTargets();
+	auto markVertexAndNeighboursForRepair = [&](int vertex) {
+		markVertexForRepair(vertex);
+		for (int e = offsets[vertex]; e < offsets[vertex + 1]; ++e) {
+			markVertexForRepair(targets[e]);
+		}
+	};
+	for (int vertex : m_affectedVertices) {
+		markVertexAndNeighboursForRepair(vertex);
+	}
+	for (int vertex : m_processedVertices) {
+		markVertexAndNeighboursForRepair(vertex);
+	}
+	for (const Edge& edge : changedEdges) {
+		markVertexForRepair(edge.target);
+	}
+
+	// predecessor is chosen again from all sources of edges on shortest paths to the vertex, no matter
+	// in which order they were processed by repair - tie goes to source with smaller distance, then smaller number
+	ArrayView<int> reversedOffsets = m_reversedGraphData.getOffsets();
+	ArrayView<int> sources = m_reversedGraphData.getTargets();
+	ArrayView<double> reversedWeights = m_reversedGraphData.getWeights();
+	for (int vertex : m_verticesToRepair) {
+		int predecessor = -1;
+		if (vertex != m_sourceVertexIndex && m_distances[vertex] != std::numeric_limits<double>::infinity()) {
+			for (int e = reversedOffsets[vertex]; e < reversedOffsets[vertex + 1]; ++e) {
+				int source = sources[e];
+				if (reversedWeights[e] + m_distances[source] == m_distances[vertex]
+					&& (predecessor == -1 || checkIfPredecessorIsPreferred(m_distances[source], source, m_distances[predecessor], predecessor))) {
+					predecessor = source;
+				}
+			}
+		}
+		m_predecessors[vertex] = predecessor;
+	}
+}
+
+
+void DijkstraIncremental::markVertexForRepair(int vertex) {
+	if (!m_markedForRepair[vertex]) {
+		m_markedForRepair[vertex] = true;
+		m_verticesToRepair.push_back(vertex);
+	}
+}
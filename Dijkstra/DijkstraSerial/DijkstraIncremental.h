@@ -0,0 +1,161 @@
+/**
+*	@file DijkstraIncremental.h
+*	@brief This file contains algorithm that repairs results of Dijkstra
+*	algorithm after edges of sparse graph have been changed.
+*/
+
+
+#pragma once
+
+#include "SparseGraph.h"
+#include "VertexHeap.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class repairs distances and predecessors computed for sparse graph after
+/// a batch of its edges has been inserted, deleted or has changed weight - in the
+/// spirit of dynamic algorithm of Ramalingam and Reps, only vertices affected by the
+/// changes are processed. Vertices whose path in previous shortest path tree goes
+/// through a changed edge lose their distances; they are queued with the best distance
+/// offered by unaffected neighbours, targets of changed edges are queued if the change
+/// shortens their paths, and Dijkstra algorithm with VertexHeap runs from all of them,
+/// stopping where distances do not decrease. Finally, predecessors are chosen again for
+/// vertices whose distance, incoming edges or neighbours' distances have changed - among
+/// neighbours that give the same distance, the one with smaller (distance, number) pair
+/// is chosen, so results are exactly the same as results of DijkstraSerial run on the
+/// changed graph.
+/// </summary>
+class DijkstraIncremental
+{
+public:
+
+	/// <summary>
+	/// DijkstraIncremental class constructor. Takes results that should be repaired.
+	/// </summary>
+	/// <param name="graphData">
+	/// Sparse graph after changes (see SparseGraph::createGraphWithChangedEdges). Please
+	/// note that this object stores reference to it.
+	/// </param>
+	/// <param name="reversedGraphData">
+	/// The same graph with reversed edges - incoming edges of every vertex. Please note
+	/// that this object stores reference to it.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Integer number that represents index of source vertex.
+	/// </param>
+	/// <param name="distances">
+	/// Distances from source vertex computed for the graph before changes. Search must
+	/// not have been stopped at target vertex.
+	/// </param>
+	/// <param name="predecessors">
+	/// Predecessors computed for the graph before changes.
+	/// </param>
+	DijkstraIncremental(const SparseGraph& graphData, const SparseGraph& reversedGraphData, int sourceVertexIndex,
+		std::vector<double> distances, std::vector<int> predecessors);
+
+
+	/// <summary>
+	/// Repairs results after given changes of edges.
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors that represent Dijkstra algorithm results for changed graph. First
+	/// vector represents distances from source vertex, second vector contains predecessors.
+	/// </returns>
+	/// <param name="changedEdges">
+	/// Edges that have been changed - the same ones that were used to create the changed
+	/// graph. Their weights are not used, so decreases and increases do not have to be
+	/// distinguished.
+	/// </param>
+	std::pair<const std::vector<double>, const std::vector<int>> run(const std::vector<Edge>& changedEdges);
+
+
+	/// <summary>
+	/// Reads changes of edges from text file - each line contains one edge in form of:
+	/// source target weight. Weight lower than 0.001 means that edge is deleted. If file
+	/// could not be opened or contains line with wrong data, proper information (with
+	/// number of the line) is printed and no changes are returned.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if whole file has been read.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to file with changes.
+	/// </param>
+	/// <param name="numberOfVertices">
+	/// Number of vertices of the graph - edges with other vertices are skipped.
+	/// </param>
+	/// <param name="changedEdges">
+	/// Vector that receives changed edges.
+	/// </param>
+	static bool readChangedEdgesFromFile(const std::string& filePath, int numberOfVertices, std::vector<Edge>& changedEdges);
+
+
+	/// <summary>
+	/// Returns number of vertices that lost their distances during last run, because
+	/// their previous paths went through changed edges.
+	/// </summary>
+	inline int getNumberOfAffectedVertices() const {
+		return static_cast<int>(m_affectedVertices.size());
+	}
+
+
+	/// <summary>
+	/// Returns number of vertices processed by Dijkstra algorithm during last run.
+	/// </summary>
+	inline int getNumberOfProcessedVertices() const {
+		return m_numberOfProcessedVertices;
+	}
+
+private:
+
+	/// <summary>
+	/// Marks vertices whose path in previous shortest path tree goes through one of
+	/// changed edges - the whole subtree of target of such edge - and resets their
+	/// distances.
+	/// </summary>
+	void resetAffectedVertices(const std::vector<Edge>& changedEdges);
+
+
+	/// <summary>
+	/// Queues affected vertices and targets of changed edges with the best distances
+	/// offered by vertices that have not been affected.
+	/// </summary>
+	void queueBoundaryVertices(const std::vector<Edge>& changedEdges);
+
+
+	/// <summary>
+	/// Runs Dijkstra algorithm from queued vertices - remembers every processed vertex.
+	/// </summary>
+	void processQueuedVertices();
+
+
+	/// <summary>
+	/// Chooses predecessors again for vertices which could have got other predecessor:
+	/// affected and processed vertices, their neighbours and targets of changed edges.
+	/// </summary>
+	void repairPredecessors(const std::vector<Edge>& changedEdges);
+
+
+	/// <summary>
+	/// Adds vertex to the list of vertices whose predecessors are chosen again, unless
+	/// it is already there.
+	/// </summary>
+	void markVertexForRepair(int vertex);
+
+
+	const SparseGraph& m_graphData;
+	const SparseGraph& m_reversedGraphData;
+	int m_sourceVertexIndex;
+	int m_numberOfProcessedVertices = 0;
+	VertexHeap m_heap;
+	std::vector<double> m_distances;
+	std::vector<int> m_predecessors;
+	std::vector<bool> m_affected;
+	std::vector<bool> m_markedForRepair;
+	std::vector<int> m_affectedVertices;
+	std::vector<int> m_processedVertices;
+	std::vector<int> m_verticesToRepair;
+};
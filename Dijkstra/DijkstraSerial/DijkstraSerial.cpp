@@ -1,14 +1,15 @@
 #include "DijkstraSerial.h"
 
 
-std::pair<const std::vector<double>, const std::vector<int>> DijkstraSerial::run() {
+template <typename GraphDataType>
+std::pair<const std::vector<typename DijkstraSerial<GraphDataType>::DistanceType>, const std::vector<int>> DijkstraSerial<GraphDataType>::run() {
+
+	// vertex that is closest to cluster of already processed vertices
+	VertexDataType vertexWithMinDistanceToCluster = m_dijkstraBackend.findVertexWithMinimalDistanceToCluster();
 
 	// while there are any vertices that have not been processed
 	while (!m_dijkstraBackend.checkIfAllVerticesHaveBeenProcessed()) {
 
-		// vertex that is closest to cluster of already processed vertices
-		VertexData vertexWithMinDistanceToCluster = m_dijkstraBackend.findVertexWithMinimalDistanceToCluster();
-
 		// safety check - if there was no valid closest vertex, we need to exit loop now
 		if (vertexWithMinDistanceToCluster.vertexNumber == -1) {
 			break;
@@ -17,9 +18,23 @@ std::pair<const std::vector<double>, const std::vector<int>> DijkstraSerial::run
 		// mark vertex as processed
 		m_dijkstraBackend.markVertexAsProcessed(vertexWithMinDistanceToCluster.vertexNumber);
 
-		// inner loop - computing new distances
-		m_dijkstraBackend.performInnerForLoop(vertexWithMinDistanceToCluster, m_graphData);
+		// distance to target vertex will not change any more
+		if (vertexWithMinDistanceToCluster.vertexNumber == m_targetVertexIndex) {
+			break;
+		}
+
+		// inner loop - computing new distances and finding vertex closest to cluster for the next iteration
+		vertexWithMinDistanceToCluster = m_dijkstraBackend.performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(vertexWithMinDistanceToCluster, m_graphData);
 	}
 
 	return std::make_pair(m_dijkstraBackend.getDistances(), m_dijkstraBackend.getPredecessors());
-}
\ No newline at end of file
+}
+
+
+template class DijkstraSerial<ArrayView<double>>;
+template class DijkstraSerial<SparseGraph>;
+template class DijkstraSerial<TransposedMatrixChunk>;
+template class DijkstraSerial<ArrayView<float>>;
+template class DijkstraSerial<ArrayView<std::uint16_t>>;
+template class DijkstraSerial<BasicTransposedMatrixChunk<float>>;
+template class DijkstraSerial<BasicTransposedMatrixChunk<std::uint16_t>>;
\ No newline at end of file
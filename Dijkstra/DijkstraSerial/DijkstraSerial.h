@@ -10,12 +10,21 @@
 
 /// <summary>
 /// This class contains serial Dijkstra algorithm implementation.
-/// It uses DijkstraAlgorithmBackend class. 
+/// It uses DijkstraAlgorithmBackend class. Template parameter is type of
+/// graph representation - it can be adjacency matrix in form of 1D vector
+/// of weights, TransposedMatrixChunk or SparseGraph. Dense graphs can store
+/// weights of any type supported by WeightTraits - distances are computed in
+/// type defined by its traits.
 /// </summary>
+template <typename GraphDataType>
 class DijkstraSerial
 {
 public:
 
+	using BackendType = BasicDijkstraAlgorithmBackend<typename GraphWeightType<GraphDataType>::Type>;
+	using DistanceType = typename BackendType::DistanceType;
+	using VertexDataType = typename BackendType::VertexDataType;
+
 	/// <summary>
 	/// DijkstraSerial class constructor. Prepares all class properties (adjacency
 	/// matrix chunk and algorithm backend).
@@ -28,12 +37,17 @@ public:
 	/// Integer number that represents index of source vertex. 
 	/// </param>
 	/// <param name="graphData">
-	/// Adjacency matrix that is being processed by this object - it should be
-	/// passed in a form of 1D vector of weights. Data from matrix should be aranged 
-	/// column-wise.
+	/// Graph that is being processed by this object - adjacency matrix in a form of 
+	/// 1D vector of weights (data from matrix should be aranged column-wise) or
+	/// sparse graph.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex - search stops as soon as it is processed, so only
+	/// distance and path to it are valid. If it is -1, all vertices are processed.
 	/// </param>
-	DijkstraSerial(int totalNumberOfVertices, int sourceVertexIndex, const std::vector<double>& graphData) 
-		: m_dijkstraBackend(std::make_pair(0, totalNumberOfVertices - 1), totalNumberOfVertices, sourceVertexIndex), m_graphData(graphData) {}
+	DijkstraSerial(int totalNumberOfVertices, int sourceVertexIndex, const GraphDataType& graphData, int targetVertexIndex = -1) 
+		: m_dijkstraBackend(std::make_pair(0, totalNumberOfVertices - 1), totalNumberOfVertices, sourceVertexIndex), m_graphData(graphData),
+		m_targetVertexIndex(targetVertexIndex) {}
 
 
 	/// <summary>
@@ -44,11 +58,12 @@ public:
 	/// Pair of vectors that represent Dijkstra algorithm results. First vector represents
 	/// distances from source vertex, second vector contains predecessors.
 	/// </returns>
-	std::pair<const std::vector<double>, const std::vector<int>> run();
+	std::pair<const std::vector<DistanceType>, const std::vector<int>> run();
 
 private:
 
-	DijkstraAlgorithmBackend m_dijkstraBackend;
-	std::vector<double> m_graphData;
+	BackendType m_dijkstraBackend;
+	const GraphDataType& m_graphData;
+	int m_targetVertexIndex;
 };
 
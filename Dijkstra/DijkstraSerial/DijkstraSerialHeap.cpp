@@ -0,0 +1,65 @@
+#include "DijkstraSerialHeap.h"
+
+#include <limits>
+
+
+DijkstraSerialHeap::DijkstraSerialHeap(int totalNumberOfVertices, int sourceVertexIndex, const SparseGraph& graphData, int targetVertexIndex,
+	const LandmarkTable* landmarkTable) :
+	m_graphData(graphData),
+	m_targetVertexIndex(targetVertexIndex),
+	m_landmarkTable(landmarkTable),
+	m_heap(totalNumberOfVertices),
+	m_distances(totalNumberOfVertices, std::numeric_limits<double>::infinity()),
+	m_predecessors(totalNumberOfVertices, -1),
+	m_processedVertices(totalNumberOfVertices, false)
+{
+	m_distances.at(sourceVertexIndex) = 0;
+	m_heap.insertOrDecreaseKey(sourceVertexIndex, 0);
+}
+
+
+std::pair<const std::vector<double>, const std::vector<int>> DijkstraSerialHeap::run() {
+
+	ArrayView<int> offsets = m_graphData.getOffsets();
+	ArrayView<int> targets = m_graphData.getTargets();
+	ArrayView<double> weights = m_graphData.getWeights();
+
+	// heap contains only reachable vertices that have not been processed yet - their keys are distances,
+	// increased by lower bounds of distances to target vertex if landmarks are used
+	while (!m_heap.isEmpty()) {
+
+		// vertex with the smallest key - without landmarks it is the closest to cluster of processed vertices
+		int processedVertex = m_heap.extractMin().vertexNumber;
+		double distanceOfProcessedVertex = m_distances[processedVertex];
+		m_processedVertices[processedVertex] = true;
+		++m_numberOfProcessedVertices;
+
+		// distance to target vertex will not change any more
+		if (processedVertex == m_targetVertexIndex) {
+			break;
+		}
+
+		// relax outgoing edges of processed vertex
+		for (int e = offsets[processedVertex]; e < offsets[processedVertex + 1]; ++e) {
+			int target = targets[e];
+			if (m_processedVertices[target]) {
+				continue;
+			}
+
+			double altDistance = weights[e] + distanceOfProcessedVertex;
+			if (altDistance < m_distances[target]) {
+
+				// vertices from which target vertex can not be reached are never processed
+				double lowerBound = m_landmarkTable ? m_landmarkTable->computeLowerBound(target, m_targetVertexIndex) : 0;
+				if (lowerBound == std::numeric_limits<double>::infinity()) {
+					continue;
+				}
+				m_distances[target] = altDistance;
+				m_predecessors[target] = processedVertex;
+				m_heap.insertOrDecreaseKey(target, altDistance + lowerBound);
+			}
+		}
+	}
+
+	return std::make_pair(m_distances, m_predecessors);
+}
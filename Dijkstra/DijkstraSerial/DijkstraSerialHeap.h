@@ -0,0 +1,87 @@
+/**
+*	@file DijkstraSerialHeap.h
+*	@brief This file contains serial, heap-based Dijkstra algorithm 
+*	implementation for sparse graphs.
+*/
+
+
+#pragma once
+
+#include "LandmarkTable.h"
+#include "SparseGraph.h"
+#include "VertexHeap.h"
+
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class contains serial Dijkstra algorithm implementation that uses
+/// addressable heap and adjacency lists of sparse graph. It works in 
+/// O((V + E) log V) time instead of O(V^2), so it should be used with sparse
+/// graphs. Results are exactly the same as results of DijkstraSerial.
+/// With target vertex and LandmarkTable, it becomes goal-directed A* search
+/// (ALT): vertices are extracted from heap in order of distance from source
+/// plus lower bound of distance to target, so vertices that lead away from
+/// target are rarely processed.
+/// </summary>
+class DijkstraSerialHeap
+{
+public:
+
+	/// <summary>
+	/// DijkstraSerialHeap class constructor. Prepares distance and predecessors
+	/// arrays and heap that contains only source vertex.
+	/// </summary>
+	/// <param name="totalNumberOfVertices">
+	/// Integer number that represents total number of vertices in processed 
+	/// graph. 
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Integer number that represents index of source vertex. 
+	/// </param>
+	/// <param name="graphData">
+	/// Sparse graph that is being processed by this object. Please note that this
+	/// object stores reference to it - it is valid as long as graph itself is valid.
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex - search stops as soon as it is processed, so only
+	/// distance and path to it are valid. If it is -1, all vertices are processed.
+	/// </param>
+	/// <param name="landmarkTable">
+	/// Table of landmarks computed for the same graph, used to direct search towards
+	/// target vertex - can be used only with target vertex. If it is nullptr, plain
+	/// Dijkstra algorithm is run. Please note that this object stores pointer to it.
+	/// </param>
+	DijkstraSerialHeap(int totalNumberOfVertices, int sourceVertexIndex, const SparseGraph& graphData, int targetVertexIndex = -1,
+		const LandmarkTable* landmarkTable = nullptr);
+
+
+	/// <summary>
+	/// Dijkstra algorithm implementation. Runs serial, heap-based implementation of 
+	/// Dijkstra algorithm. Handles all graph vertices.
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors that represent Dijkstra algorithm results. First vector represents
+	/// distances from source vertex, second vector contains predecessors.
+	/// </returns>
+	std::pair<const std::vector<double>, const std::vector<int>> run();
+
+
+	/// <summary>
+	/// Returns number of vertices processed during last run.
+	/// </summary>
+	inline int getNumberOfProcessedVertices() const {
+		return m_numberOfProcessedVertices;
+	}
+
+private:
+
+	const SparseGraph& m_graphData;
+	int m_targetVertexIndex;
+	const LandmarkTable* m_landmarkTable;
+	int m_numberOfProcessedVertices = 0;
+	VertexHeap m_heap;
+	std::vector<double> m_distances;
+	std::vector<int> m_predecessors;
+	std::vector<bool> m_processedVertices;
+};
@@ -0,0 +1,176 @@
+#include "LandmarkTable.h"
+#include "DijkstraSerialHeap.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+	const char landmarkTableSignature[8] = { 'D', 'J', 'K', 'L', 'A', 'N', 'D', 'M' };
+	const std::uint32_t formatVersion = 1;
+	const std::uint32_t byteOrderMark = 0x01020304;
+	const std::uint64_t sectionAlignment = 64;
+
+	static_assert(sizeof(LandmarkTable::Header) == 64, "Header of landmark table file must be 64 bytes long");
+
+	std::uint64_t alignOffset(std::uint64_t offset) {
+		return (offset + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+	}
+
+	void writeSection(std::ostream& file, const void* data, std::uint64_t size) {
+		file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+		std::vector<char> padding(alignOffset(position) - position, 0);
+		file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+	}
+
+}
+
+
+std::unique_ptr<LandmarkTable> LandmarkTable::compute(const SparseGraph& graph, int numberOfLandmarks) {
+
+	std::unique_ptr<LandmarkTable> table(new LandmarkTable());
+	int numberOfVertices = graph.getNumberOfVertices();
+	std::unique_ptr<SparseGraph> reversedGraph = graph.createReversedGraph();
+	table->m_numberOfLandmarks = std::min(numberOfLandmarks, numberOfVertices);
+	table->m_numberOfVertices = numberOfVertices;
+	table->m_numberOfEdges = graph.getNumberOfEdges();
+	table->m_graphChecksum = graph.computeChecksum();
+	table->m_distancesFromLandmarks.resize(static_cast<size_t>(numberOfVertices) * table->m_numberOfLandmarks);
+	table->m_distancesToLandmarks.resize(static_cast<size_t>(numberOfVertices) * table->m_numberOfLandmarks);
+
+	// vertex is as far from landmarks as it is from the closest of them, in any direction -
+	// unreachable vertices are the farthest ones, so they get their own landmarks
+	std::vector<double> distancesToClosestLandmark(numberOfVertices, std::numeric_limits<double>::infinity());
+	std::vector<bool> isLandmark(numberOfVertices, false);
+	auto searchFromVertex = [&](int vertex) {
+		auto distancesFromVertex = DijkstraSerialHeap(numberOfVertices, vertex, graph).run().first;
+		auto distancesToVertex = DijkstraSerialHeap(numberOfVertices, vertex, *reversedGraph).run().first;
+		for (int v = 0; v < numberOfVertices; ++v) {
+			distancesToClosestLandmark[v] = std::min(distancesToClosestLandmark[v], std::min(distancesFromVertex[v], distancesToVertex[v]));
+		}
+		return std::make_pair(std::move(distancesFromVertex), std::move(distancesToVertex));
+	};
+	auto findFarthestVertex = [&]() {
+		int farthestVertex = -1;
+		for (int v = 0; v < numberOfVertices; ++v) {
+			if (!isLandmark[v] && (farthestVertex == -1 || distancesToClosestLandmark[v] > distancesToClosestLandmark[farthestVertex])) {
+				farthestVertex = v;
+			}
+		}
+		return farthestVertex;
+	};
+
+	// the first landmark is the vertex farthest from vertex 0, which itself is not a landmark
+	int landmark = 0;
+	if (table->m_numberOfLandmarks > 0) {
+		searchFromVertex(0);
+		landmark = findFarthestVertex();
+		std::fill(distancesToClosestLandmark.begin(), distancesToClosestLandmark.end(), std::numeric_limits<double>::infinity());
+	}
+	for (int k = 0; k < table->m_numberOfLandmarks; ++k) {
+		isLandmark[landmark] = true;
+		table->m_landmarks.push_back(landmark);
+		auto distances = searchFromVertex(landmark);
+		for (int v = 0; v < numberOfVertices; ++v) {
+			table->m_distancesFromLandmarks[static_cast<size_t>(v) * table->m_numberOfLandmarks + k] = distances.first[v];
+			table->m_distancesToLandmarks[static_cast<size_t>(v) * table->m_numberOfLandmarks + k] = distances.second[v];
+		}
+		landmark = findFarthestVertex();
+	}
+
+	table->m_landmarksView = table->m_landmarks;
+	table->m_distancesFromLandmarksView = table->m_distancesFromLandmarks;
+	table->m_distancesToLandmarksView = table->m_distancesToLandmarks;
+	return table;
+}
+
+
+std::unique_ptr<LandmarkTable> LandmarkTable::fromFile(const std::string& filePath, const SparseGraph& graph) {
+
+	std::unique_ptr<MappedFile> file = MappedFile::open(filePath);
+	if (!file) {
+		return nullptr;
+	}
+
+	if (file->getSize() < sizeof(Header) || std::memcmp(file->getData(), landmarkTableSignature, sizeof(landmarkTableSignature)) != 0) {
+		std::cout << "Plik " << filePath << " nie jest plikiem tablicy punktow orientacyjnych." << std::endl;
+		return nullptr;
+	}
+	const Header* header = reinterpret_cast<const Header*>(file->getData());
+	if (header->version != formatVersion || header->byteOrderMark != byteOrderMark) {
+		std::cout << "Plik " << filePath << " ma nieobslugiwana wersje formatu lub kolejnosc bajtow." << std::endl;
+		return nullptr;
+	}
+
+	// table computed for other graph would give wrong bounds
+	if (header->numberOfVertices != graph.getNumberOfVertices() || header->numberOfEdges != graph.getNumberOfEdges()
+		|| header->graphChecksum != graph.computeChecksum()) {
+		std::cout << "Plik " << filePath << " zostal utworzony dla innego grafu." << std::endl;
+		return nullptr;
+	}
+
+	std::uint64_t numberOfDistances = static_cast<std::uint64_t>(header->numberOfVertices) * header->numberOfLandmarks;
+	bool isValid = header->numberOfLandmarks <= static_cast<std::uint64_t>(header->numberOfVertices)
+		&& header->distancesFromLandmarksOffset >= alignOffset(sizeof(Header) + header->numberOfLandmarks * sizeof(int))
+		&& header->distancesToLandmarksOffset >= header->distancesFromLandmarksOffset + numberOfDistances * sizeof(double)
+		&& header->distancesFromLandmarksOffset % sectionAlignment == 0 && header->distancesToLandmarksOffset % sectionAlignment == 0
+		&& header->distancesToLandmarksOffset + numberOfDistances * sizeof(double) <= file->getSize();
+	if (!isValid) {
+		std::cout << "Plik " << filePath << " zawiera niepoprawne dane." << std::endl;
+		return nullptr;
+	}
+
+	std::unique_ptr<LandmarkTable> table(new LandmarkTable());
+	table->m_numberOfLandmarks = static_cast<int>(header->numberOfLandmarks);
+	table->m_numberOfVertices = header->numberOfVertices;
+	table->m_numberOfEdges = header->numberOfEdges;
+	table->m_graphChecksum = header->graphChecksum;
+	table->m_landmarksView = ArrayView<int>(reinterpret_cast<const int*>(file->getData() + sizeof(Header)), header->numberOfLandmarks);
+	table->m_distancesFromLandmarksView = ArrayView<double>(
+		reinterpret_cast<const double*>(file->getData() + header->distancesFromLandmarksOffset), static_cast<size_t>(numberOfDistances));
+	table->m_distancesToLandmarksView = ArrayView<double>(
+		reinterpret_cast<const double*>(file->getData() + header->distancesToLandmarksOffset), static_cast<size_t>(numberOfDistances));
+	table->m_mappedFile = std::move(file);
+	return table;
+}
+
+
+std::string LandmarkTable::getSidecarFilePath(const std::string& graphFilePath) {
+	return graphFilePath + ".landmarks";
+}
+
+
+bool LandmarkTable::writeToFile(const std::string& filePath) const {
+
+	std::ofstream file(filePath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+	if (!file.is_open()) {
+		std::cout << "Nie mozna utworzyc pliku " << filePath << "." << std::endl;
+		return false;
+	}
+
+	Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, landmarkTableSignature, sizeof(landmarkTableSignature));
+	header.version = formatVersion;
+	header.byteOrderMark = byteOrderMark;
+	header.numberOfLandmarks = static_cast<std::uint32_t>(m_numberOfLandmarks);
+	header.numberOfVertices = m_numberOfVertices;
+	header.numberOfEdges = m_numberOfEdges;
+	header.graphChecksum = m_graphChecksum;
+	header.distancesFromLandmarksOffset = alignOffset(sizeof(Header) + m_landmarksView.size() * sizeof(int));
+	header.distancesToLandmarksOffset = alignOffset(header.distancesFromLandmarksOffset + m_distancesFromLandmarksView.size() * sizeof(double));
+
+	writeSection(file, &header, sizeof(header));
+	writeSection(file, m_landmarksView.data(), m_landmarksView.size() * sizeof(int));
+	writeSection(file, m_distancesFromLandmarksView.data(), m_distancesFromLandmarksView.size() * sizeof(double));
+	writeSection(file, m_distancesToLandmarksView.data(), m_distancesToLandmarksView.size() * sizeof(double));
+
+	if (!file.good()) {
+		std::cout << "Nie mozna zapisac pliku " << filePath << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
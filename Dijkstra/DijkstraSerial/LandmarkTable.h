@@ -0,0 +1,175 @@
+/**
+*	@file LandmarkTable.h
+*	@brief This file contains LandmarkTable class that stores distances between
+*	landmarks and all vertices of the graph, used by goal-directed (ALT) search.
+*/
+
+
+#pragma once
+
+#include "ArrayView.h"
+#include "MappedFile.h"
+#include "SparseGraph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// This class stores distances from a few chosen vertices (landmarks) to all
+/// vertices of the graph and from all vertices to landmarks. Triangle inequality
+/// gives lower bound of distance between any two vertices, which is used by
+/// DijkstraSerialHeap as A* potential (ALT algorithm - A*, landmarks, triangle
+/// inequality). Table is computed once per graph and saved to sidecar file next
+/// to the graph, so later searches only map it into memory.
+/// </summary>
+/// <remarks>
+/// Sidecar file starts with 64-byte header (see Header structure) that contains
+/// number of vertices, number of edges and checksum of the graph the table was
+/// computed for - table of different graph (or of other version of the same file)
+/// is never used. Sections that follow it start at offsets that are multiples of
+/// 64 bytes: K 32-bit numbers of landmarks, N * K doubles with distances from
+/// landmarks and N * K doubles with distances to landmarks. Distances are arranged
+/// vertex after vertex, so all K distances of one vertex are continous in memory.
+/// </remarks>
+class LandmarkTable final {
+
+public:
+
+	/// <summary>
+	/// Header of sidecar file - first 64 bytes of the file.
+	/// </summary>
+	struct Header {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t byteOrderMark;
+		std::uint32_t numberOfLandmarks;
+		std::uint32_t reserved;
+		std::int64_t numberOfVertices;
+		std::int64_t numberOfEdges;
+		std::uint64_t graphChecksum;
+		std::uint64_t distancesFromLandmarksOffset;
+		std::uint64_t distancesToLandmarksOffset;
+	};
+
+
+	/// <summary>
+	/// Static factory method that chooses landmarks and computes distances between
+	/// them and all vertices with DijkstraSerialHeap - on the graph (distances from
+	/// landmarks) and on reversed graph (distances to landmarks). Landmarks are
+	/// chosen with farthest-point selection: every next landmark is the vertex
+	/// that is the farthest from all landmarks chosen so far.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer to created object.
+	/// </returns>
+	/// <param name="graph">
+	/// Sparse graph for which the table is computed.
+	/// </param>
+	/// <param name="numberOfLandmarks">
+	/// Number of landmarks - it is reduced to number of vertices for small graphs.
+	/// </param>
+	static std::unique_ptr<LandmarkTable> compute(const SparseGraph& graph, int numberOfLandmarks);
+
+
+	/// <summary>
+	/// Static factory method that maps sidecar file into memory. If file does not
+	/// exist, is not valid or has been computed for other graph, proper information
+	/// is printed.
+	/// </summary>
+	/// <returns>
+	/// Unique pointer to created object or nullptr if table can not be used.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to sidecar file.
+	/// </param>
+	/// <param name="graph">
+	/// Sparse graph that is going to be searched with the table.
+	/// </param>
+	static std::unique_ptr<LandmarkTable> fromFile(const std::string& filePath, const SparseGraph& graph);
+
+
+	/// <summary>
+	/// Returns path of sidecar file of given graph file.
+	/// </summary>
+	static std::string getSidecarFilePath(const std::string& graphFilePath);
+
+
+	/// <summary>
+	/// Writes table to sidecar file. If file can not be written, proper information
+	/// is printed.
+	/// </summary>
+	/// <returns>
+	/// Boolean that indicates if file has been written.
+	/// </returns>
+	/// <param name="filePath">
+	/// String with path to sidecar file.
+	/// </param>
+	bool writeToFile(const std::string& filePath) const;
+
+
+	/// <summary>
+	/// Computes lower bound of distance from vertex to target vertex - the maximum
+	/// of bounds given by all landmarks. For landmark L distance d(v, t) is not
+	/// smaller than d(L, t) - d(L, v) and d(v, L) - d(t, L). Infinite bound means
+	/// that target vertex can not be reached from the vertex.
+	/// </summary>
+	inline double computeLowerBound(int vertex, int targetVertex) const {
+		const double* fromLandmarksToVertex = m_distancesFromLandmarksView.data() + static_cast<size_t>(vertex) * m_numberOfLandmarks;
+		const double* fromLandmarksToTarget = m_distancesFromLandmarksView.data() + static_cast<size_t>(targetVertex) * m_numberOfLandmarks;
+		const double* fromVertexToLandmarks = m_distancesToLandmarksView.data() + static_cast<size_t>(vertex) * m_numberOfLandmarks;
+		const double* fromTargetToLandmarks = m_distancesToLandmarksView.data() + static_cast<size_t>(targetVertex) * m_numberOfLandmarks;
+
+		// bounds that subtract infinity from infinity say nothing and are skipped
+		double lowerBound = 0;
+		for (int k = 0; k < m_numberOfLandmarks; ++k) {
+			if (fromLandmarksToVertex[k] != std::numeric_limits<double>::infinity()) {
+				lowerBound = std::max(lowerBound, fromLandmarksToTarget[k] - fromLandmarksToVertex[k]);
+			}
+			if (fromTargetToLandmarks[k] != std::numeric_limits<double>::infinity()) {
+				lowerBound = std::max(lowerBound, fromVertexToLandmarks[k] - fromTargetToLandmarks[k]);
+			}
+		}
+		return lowerBound;
+	}
+
+
+	/// <summary>
+	/// Returns numbers of chosen landmarks.
+	/// </summary>
+	inline ArrayView<int> getLandmarks() const {
+		return m_landmarksView;
+	}
+
+
+	/// <summary>
+	/// Returns number of landmarks.
+	/// </summary>
+	inline int getNumberOfLandmarks() const {
+		return m_numberOfLandmarks;
+	}
+
+private:
+
+	/// <summary>
+	/// Default constructor. It is private, as objects of this class should not be created
+	/// on their own - for creating instances in code, please use static factory methods.
+	/// </summary>
+	LandmarkTable() = default;
+
+
+	int m_numberOfLandmarks = 0;
+	std::int64_t m_numberOfVertices = 0;
+	std::int64_t m_numberOfEdges = 0;
+	std::uint64_t m_graphChecksum = 0;
+	std::vector<int> m_landmarks;
+	std::vector<double> m_distancesFromLandmarks;
+	std::vector<double> m_distancesToLandmarks;
+	std::unique_ptr<MappedFile> m_mappedFile;
+	ArrayView<int> m_landmarksView;
+	ArrayView<double> m_distancesFromLandmarksView;
+	ArrayView<double> m_distancesToLandmarksView;
+};
@@ -1,18 +1,223 @@
 #include "AdjacencyMatrix.h"
+#include "ContractionHierarchyBuilder.h"
+#include "ContractionHierarchyQuery.h"
+#include "ConvertedAdjacencyMatrix.h"
+#include "DijkstraBidirectional.h"
+#include "DijkstraIncremental.h"
+#include "SparseGraph.h"
+#include "TransposedMatrixChunk.h"
 #include "Log.h"
+#include "RelaxationKernels.h"
+#include "ResultsFile.h"
 #include "ResultsPrinter.h"
 #include "CommandLineArgumentsExtractor.h"
 #include "Validator.h"
 #include "DijkstraSerial.h"
+#include "DijkstraSerialHeap.h"
+#include "LandmarkTable.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
+#include <random>
+#include <thread>
 
 #ifndef SHOULD_LOG
 #define SHOULD_LOG true
 #endif // !SHOULD_LOG
 
 
+/// <summary>
+/// Runs DijkstraSerial on adjacency matrix with converted weights. Distances are converted
+/// back to doubles, so results are printed the same way for every type of weights.
+/// </summary>
+template <typename WeightType>
+std::pair<const std::vector<double>, const std::vector<int>> runWithConvertedWeights(const ConvertedAdjacencyMatrix<WeightType>& matrix,
+	int totalNumberOfVertices, int sourceVertexIndex, int targetVertexIndex)
+{
+	if (matrix.checkIfIsTransposed()) {
+		return convertDistancesToDoubles(DijkstraSerial<BasicTransposedMatrixChunk<WeightType>>(totalNumberOfVertices, sourceVertexIndex,
+			matrix.getTransposedMatrix(), targetVertexIndex).run());
+	}
+
+	// algorithm stores reference to the view, so it has to outlive it
+	ArrayView<WeightType> columnWiseWeights = matrix.getColumnWiseWeights();
+	return convertDistancesToDoubles(DijkstraSerial<ArrayView<WeightType>>(totalNumberOfVertices, sourceVertexIndex, columnWiseWeights,
+		targetVertexIndex).run());
+}
+
+
+/// <summary>
+/// Runs bidirectional search between source and target vertex and logs how many
+/// vertices it had to process.
+/// </summary>
+template <typename GraphDataType, typename ReversedGraphDataType>
+std::pair<const std::vector<double>, const std::vector<int>> runBidirectionalSearch(int totalNumberOfVertices, int sourceVertexIndex,
+	int targetVertexIndex, const GraphDataType& graphData, const ReversedGraphDataType& reversedGraphData, int numberOfThreads, Log<SHOULD_LOG>& log)
+{
+	DijkstraBidirectional<GraphDataType, ReversedGraphDataType> dijkstraBidirectional(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex,
+		graphData, reversedGraphData, numberOfThreads);
+	auto results = dijkstraBidirectional.run();
+	log.logMessage("Bidirectional search processed ", dijkstraBidirectional.getNumberOfProcessedVertices(), " of ", totalNumberOfVertices, " vertices");
+	return results;
+}
+
+
+/// <summary>
+/// Runs heap-based algorithm and, if it searches for target vertex, logs how many
+/// vertices it had to process.
+/// </summary>
+std::pair<const std::vector<double>, const std::vector<int>> runHeapSearch(int totalNumberOfVertices, int sourceVertexIndex,
+	int targetVertexIndex, const SparseGraph& graphData, const LandmarkTable* landmarkTable, Log<SHOULD_LOG>& log)
+{
+	DijkstraSerialHeap dijkstraSerialHeap(totalNumberOfVertices, sourceVertexIndex, graphData, targetVertexIndex, landmarkTable);
+	auto results = dijkstraSerialHeap.run();
+	if (targetVertexIndex != -1) {
+		log.logMessage(landmarkTable ? "ALT search" : "Search", " processed ", dijkstraSerialHeap.getNumberOfProcessedVertices(),
+			" of ", totalNumberOfVertices, " vertices");
+	}
+	return results;
+}
+
+
+/// <summary>
+/// Finds shortest path between source and target vertex with contraction hierarchy
+/// and logs how many vertices it had to process.
+/// </summary>
+std::pair<const std::vector<double>, const std::vector<int>> runHierarchySearch(int sourceVertexIndex, int targetVertexIndex,
+	const ContractionHierarchy& hierarchy, Log<SHOULD_LOG>& log)
+{
+	ContractionHierarchyQuery contractionHierarchyQuery(hierarchy, sourceVertexIndex, targetVertexIndex);
+	auto results = contractionHierarchyQuery.run();
+	log.logMessage("Contraction hierarchy search processed ", contractionHierarchyQuery.getNumberOfProcessedVertices(), " of ",
+		hierarchy.getNumberOfVertices(), " vertices");
+	return results;
+}
+
+
+/// <summary>
+/// Reads results computed for the graph before changes. They have to contain all
+/// vertices of the graph and the same source vertex.
+/// </summary>
+bool readPreviousResults(const std::string& filePath, int totalNumberOfVertices, int sourceVertexIndex, std::vector<double>& distances,
+	std::vector<int>& predecessors, Log<SHOULD_LOG>& log)
+{
+	std::unique_ptr<MappedFile> file = MappedFile::open(filePath);
+	const ResultsFile::Header* header = file ? ResultsFile::readHeader(*file, filePath) : nullptr;
+	if (header == nullptr) {
+		return false;
+	}
+	if (header->numberOfVertices != totalNumberOfVertices || header->sourceVertex != sourceVertexIndex || header->targetVertex != -1) {
+		log.logMessage("Previous results have to be computed for all vertices of the same graph and the same source vertex.");
+		return false;
+	}
+
+	ArrayView<double> previousDistances = ResultsFile::getDistances(*file);
+	distances.assign(previousDistances.begin(), previousDistances.end());
+	if (header->predecessorsEncoding == ResultsFile::Compressed) {
+		return ResultsFile::decompressPredecessors(*file, filePath, predecessors);
+	}
+	ArrayView<int> previousPredecessors = ResultsFile::getPredecessors(*file);
+	predecessors.assign(previousPredecessors.begin(), previousPredecessors.end());
+	return true;
+}
+
+
+/// <summary>
+/// Repairs previous results after changes of edges and logs how many vertices it had
+/// to process.
+/// </summary>
+std::pair<const std::vector<double>, const std::vector<int>> runIncrementalUpdate(int totalNumberOfVertices, int sourceVertexIndex,
+	const SparseGraph& graphData, const SparseGraph& reversedGraphData, std::vector<double> previousDistances, std::vector<int> previousPredecessors,
+	const std::vector<Edge>& changedEdges, Log<SHOULD_LOG>& log)
+{
+	DijkstraIncremental dijkstraIncremental(graphData, reversedGraphData, sourceVertexIndex, std::move(previousDistances), std::move(previousPredecessors));
+	auto results = dijkstraIncremental.run(changedEdges);
+	log.logMessage("Incremental update processed ", dijkstraIncremental.getNumberOfProcessedVertices(), " of ", totalNumberOfVertices,
+		" vertices, ", dijkstraIncremental.getNumberOfAffectedVertices(), " of them lost their paths");
+	return results;
+}
+
+
+/// <summary>
+/// Generates random batch of changes of edges, similar to traffic updates: 60% of
+/// changes scale weight of existing edge by a random factor from [0.5, 2], 20% delete
+/// existing edge and 20% insert edge between random vertices.
+/// </summary>
+std::vector<Edge> generateRandomChanges(const SparseGraph& graphData, int numberOfChanges, std::mt19937& generator) {
+
+	ArrayView<int> offsets = graphData.getOffsets();
+	ArrayView<int> targets = graphData.getTargets();
+	ArrayView<double> weights = graphData.getWeights();
+	std::uniform_int_distribution<int> kindOfChange(0, 9);
+	std::uniform_int_distribution<int> randomVertex(0, graphData.getNumberOfVertices() - 1);
+	std::uniform_int_distribution<int> randomEdge(0, std::max(0, graphData.getNumberOfEdges() - 1));
+	std::uniform_real_distribution<double> randomFactor(0.5, 2.0);
+
+	std::vector<Edge> changedEdges;
+	changedEdges.reserve(numberOfChanges);
+	for (int i = 0; i < numberOfChanges; ++i) {
+		int kind = kindOfChange(generator);
+		if (graphData.getNumberOfEdges() == 0 || kind >= 8) {
+			double weight = graphData.getNumberOfEdges() == 0 ? 1.0 : weights[randomEdge(generator)];
+			int source = randomVertex(generator);
+			int target = randomVertex(generator);
+			changedEdges.push_back({ source, target, std::max(0.001, weight * randomFactor(generator)) });
+			continue;
+		}
+
+		// source of edge is the vertex whose row contains it
+		int e = randomEdge(generator);
+		int source = static_cast<int>(std::upper_bound(offsets.begin(), offsets.end(), e) - offsets.begin()) - 1;
+		double weight = kind < 6 ? std::max(0.001, weights[e] * randomFactor(generator)) : 0.0;
+		changedEdges.push_back({ source, targets[e], weight });
+	}
+	return changedEdges;
+}
+
+
+/// <summary>
+/// Compares repair of results after random batches of changes with recomputing them
+/// from scratch by heap-based algorithm. Batches grow ten times up to given size, every
+/// batch is applied to the original graph.
+/// </summary>
+void runUpdatesBenchmark(int totalNumberOfVertices, int sourceVertexIndex, const SparseGraph& graphData, int maximalSizeOfBatch, Log<SHOULD_LOG>& log) {
+
+	auto previousResults = DijkstraSerialHeap(totalNumberOfVertices, sourceVertexIndex, graphData).run();
+
+	// generator with fixed seed, so every run uses the same batches
+	std::mt19937 generator(5489);
+	int sizeOfBatch = 1;
+	while (true) {
+		std::vector<Edge> changedEdges = generateRandomChanges(graphData, sizeOfBatch, generator);
+		std::unique_ptr<SparseGraph> changedGraph = graphData.createGraphWithChangedEdges(changedEdges);
+		std::unique_ptr<SparseGraph> reversedChangedGraph = changedGraph->createReversedGraph();
+		std::vector<double> previousDistances = previousResults.first;
+		std::vector<int> previousPredecessors = previousResults.second;
+
+		auto tBeforeRepair = std::chrono::high_resolution_clock::now();
+		DijkstraIncremental dijkstraIncremental(*changedGraph, *reversedChangedGraph, sourceVertexIndex, std::move(previousDistances),
+			std::move(previousPredecessors));
+		auto repairedResults = dijkstraIncremental.run(changedEdges);
+		auto tBeforeRecomputing = std::chrono::high_resolution_clock::now();
+		auto recomputedResults = DijkstraSerialHeap(totalNumberOfVertices, sourceVertexIndex, *changedGraph).run();
+		auto tEnd = std::chrono::high_resolution_clock::now();
+
+		std::chrono::duration<double> diffRepair = tBeforeRecomputing - tBeforeRepair;
+		std::chrono::duration<double> diffRecomputing = tEnd - tBeforeRecomputing;
+		bool resultsAreIdentical = repairedResults.first == recomputedResults.first && repairedResults.second == recomputedResults.second;
+		log.logMessage("Batch of ", sizeOfBatch, " changes: repair took ", diffRepair.count(), "s (", dijkstraIncremental.getNumberOfProcessedVertices(),
+			" vertices processed), full recompute took ", diffRecomputing.count(), "s, speedup ", diffRecomputing.count() / diffRepair.count(),
+			", results ", resultsAreIdentical ? "identical" : "DIFFERENT");
+
+		if (sizeOfBatch == maximalSizeOfBatch) {
+			break;
+		}
+		sizeOfBatch = std::min(sizeOfBatch * 10, maximalSizeOfBatch);
+	}
+}
+
+
 int main(int argc, char* argv[]) {
 
 	auto tStart = std::chrono::high_resolution_clock::now();
@@ -30,12 +235,180 @@ int main(int argc, char* argv[]) {
 	// read data from command line arguments
 	int sourceVertexIndex = CommandLineArgumentsExtractor::extractSourceVertexIndexFromCommandLineArguments(argv);
 	std::string filePath = CommandLineArgumentsExtractor::extractInputFileNameFromCommandLineArguments(argc, argv);
+	bool inputIsEdgeList = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--edge-list");
+	bool buildLandmarks = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--build-landmarks");
+	bool useLandmarks = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--alt");
+	bool buildHierarchy = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--build-ch");
+	bool useHierarchy = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--ch");
+	bool useHeap = useLandmarks || CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--heap");
+	bool useIncrementalUpdate = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--update");
+	bool benchmarkUpdates = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--benchmark-updates");
+	bool useSparseGraph = inputIsEdgeList || useHeap || buildLandmarks || buildHierarchy || useHierarchy || useIncrementalUpdate || benchmarkUpdates
+		|| CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--sparse");
+	bool useTransposedMatrix = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--transposed");
+	bool compressResults = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--compress-results");
+	bool useBinaryResults = compressResults || CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--binary-results");
+	std::string weightTypeName = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--weights", "double");
+
+	validationResult = Validator::validateWeightType(weightTypeName);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		return 0;
+	}
+	if (useSparseGraph && weightTypeName != "double") {
+		log.logMessage("Sparse graph always stores double weights.");
+		weightTypeName = "double";
+	}
+
+	// search can stop as soon as target vertex is reached - bidirectional search needs target too
+	bool useTargetVertex = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--target");
+	bool useBidirectionalSearch = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--bidirectional");
+	if (useTargetVertex || useBidirectionalSearch || useLandmarks || useHierarchy) {
+		validationResult = Validator::validateTargetVertex(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--target", ""));
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			return 0;
+		}
+	}
+	int targetVertexIndex = useTargetVertex ? std::stoi(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--target", "")) : -1;
+	if (useHierarchy && (useHeap || useBidirectionalSearch)) {
+		log.logMessage("Contraction hierarchy search is not used with --heap, --alt and --bidirectional.");
+		useHierarchy = false;
+	}
+	if (useBidirectionalSearch && useHeap) {
+		log.logMessage("Bidirectional search is not used with --heap.");
+		useBidirectionalSearch = false;
+	}
+	std::string numberOfLandmarksOption = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--build-landmarks", "8");
+	if (buildLandmarks) {
+		validationResult = Validator::validateNumberOfLandmarks(numberOfLandmarksOption);
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			return 0;
+		}
+	}
+	if ((useIncrementalUpdate || benchmarkUpdates) && (useHeap || useHierarchy || useBidirectionalSearch)) {
+		log.logMessage("Incremental update is not used with --heap, --alt, --ch and --bidirectional.");
+		useIncrementalUpdate = false;
+		benchmarkUpdates = false;
+	}
+	std::string sizeOfBatchOption = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--benchmark-updates", "10000");
+	if (benchmarkUpdates) {
+		validationResult = Validator::validateSizeOfBatch(sizeOfBatchOption);
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			return 0;
+		}
+	}
+	if (useBidirectionalSearch && weightTypeName != "double") {
+		log.logMessage("Bidirectional search uses double weights.");
+		weightTypeName = "double";
+	}
 
 	// read graph data from file
-	std::unique_ptr<AdjacencyMatrix> matrix = AdjacencyMatrix::fromFile(filePath);
-	std::vector<double> graphData = matrix->asContinousVector();
-	int totalNumberOfVertices = matrix->getNumberOfVertices();
-	matrix.reset();
+	std::unique_ptr<AdjacencyMatrix> matrix;
+	ArrayView<double> graphData;
+	std::unique_ptr<SparseGraph> sparseGraph;
+	std::unique_ptr<TransposedMatrixChunk> transposedMatrix;
+	std::unique_ptr<ConvertedAdjacencyMatrix<float>> floatMatrix;
+	std::unique_ptr<ConvertedAdjacencyMatrix<std::uint16_t>> uint16Matrix;
+	std::unique_ptr<SparseGraph> reversedSparseGraph;
+	std::unique_ptr<TransposedMatrixChunk> reversedMatrix;
+	ArrayView<double> reversedGraphData;
+	int totalNumberOfVertices = 0;
+	if (useSparseGraph) {
+		sparseGraph = inputIsEdgeList ? SparseGraph::fromEdgeListFile(filePath) : SparseGraph::fromFile(filePath);
+		totalNumberOfVertices = sparseGraph->getNumberOfVertices();
+		log.logMessage("Graph stored in sparse form with ", sparseGraph->getNumberOfEdges(), " edges");
+	}
+	else {
+		matrix = AdjacencyMatrix::fromFile(filePath);
+		graphData = matrix->asContinousVector();
+		totalNumberOfVertices = matrix->getNumberOfVertices();
+		if (weightTypeName != "double") {
+
+			// weights of smaller type mean less memory traffic in inner loop
+			bool converted = false;
+			if (weightTypeName == "float") {
+				floatMatrix = ConvertedAdjacencyMatrix<float>::fromColumnWiseData(graphData, totalNumberOfVertices, useTransposedMatrix);
+				converted = floatMatrix != nullptr;
+			}
+			else {
+				uint16Matrix = ConvertedAdjacencyMatrix<std::uint16_t>::fromColumnWiseData(graphData, totalNumberOfVertices, useTransposedMatrix);
+				converted = uint16Matrix != nullptr;
+			}
+			graphData = ArrayView<double>();
+			matrix.reset();
+			if (!converted) {
+				log.logMessage("Graph contains weights that can not be stored as ", weightTypeName, ".");
+				return 0;
+			}
+			log.logMessage("Weights stored as ", weightTypeName);
+		}
+		else if (useTransposedMatrix) {
+			transposedMatrix.reset(new TransposedMatrixChunk(TransposedMatrixChunk::fromColumnWiseData(graphData, totalNumberOfVertices)));
+			graphData = ArrayView<double>();
+			matrix.reset();
+		}
+	}
+
+	// backward search of bidirectional algorithm needs reversed graph - row-wise matrix read column-wise
+	// is reversed matrix, so for dense graphs the same data is used in other layout
+	if (useBidirectionalSearch) {
+		if (useSparseGraph) {
+			reversedSparseGraph = sparseGraph->createReversedGraph();
+		}
+		else if (useTransposedMatrix) {
+			reversedGraphData = transposedMatrix->getWeights();
+		}
+		else {
+			reversedMatrix.reset(new TransposedMatrixChunk(std::vector<double>(graphData.begin(), graphData.end()), totalNumberOfVertices));
+		}
+	}
+
+	// landmarks are computed once per graph and saved next to it - later searches only map the table
+	std::unique_ptr<LandmarkTable> landmarkTable;
+	std::string landmarkTableFilePath = LandmarkTable::getSidecarFilePath(filePath);
+	if (buildLandmarks) {
+		auto tBeforePreprocessing = std::chrono::high_resolution_clock::now();
+		landmarkTable = LandmarkTable::compute(*sparseGraph, std::stoi(numberOfLandmarksOption));
+		std::chrono::duration<double> diffPreprocessing = std::chrono::high_resolution_clock::now() - tBeforePreprocessing;
+		log.logMessage("Landmarks preprocessing took: ", diffPreprocessing.count(), "s");
+		if (landmarkTable->writeToFile(landmarkTableFilePath)) {
+			log.logMessage("Table of ", landmarkTable->getNumberOfLandmarks(), " landmarks saved to ", landmarkTableFilePath);
+		}
+	}
+	if (useLandmarks && !landmarkTable) {
+		landmarkTable = LandmarkTable::fromFile(landmarkTableFilePath, *sparseGraph);
+		if (!landmarkTable) {
+			log.logMessage("Landmarks can not be used - run with --build-landmarks first. Searching without them.");
+		}
+	}
+	if (!useLandmarks) {
+		landmarkTable.reset();
+	}
+
+	// contraction hierarchy is built once per graph by all hardware threads and saved next to it
+	std::unique_ptr<ContractionHierarchy> hierarchy;
+	std::string hierarchyFilePath = ContractionHierarchy::getSidecarFilePath(filePath);
+	if (buildHierarchy) {
+		auto tBeforePreprocessing = std::chrono::high_resolution_clock::now();
+		ContractionHierarchyBuilder builder(*sparseGraph, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+		hierarchy = builder.build();
+		std::chrono::duration<double> diffPreprocessing = std::chrono::high_resolution_clock::now() - tBeforePreprocessing;
+		log.logMessage("Contraction hierarchy with ", hierarchy->getNumberOfShortcuts(), " shortcuts built in ", builder.getNumberOfRounds(),
+			" rounds, took: ", diffPreprocessing.count(), "s");
+		if (hierarchy->writeToFile(hierarchyFilePath)) {
+			log.logMessage("Contraction hierarchy saved to ", hierarchyFilePath);
+		}
+	}
+	if (useHierarchy && !hierarchy) {
+		hierarchy = ContractionHierarchy::fromFile(hierarchyFilePath, *sparseGraph);
+		if (!hierarchy) {
+			log.logMessage("Contraction hierarchy can not be used - run with --build-ch first. Searching without it.");
+			useHierarchy = false;
+		}
+	}
 
 	// perform additional validation
 	validationResult = Validator::validateVerticesNumbers(totalNumberOfVertices, sourceVertexIndex);
@@ -43,20 +416,82 @@ int main(int argc, char* argv[]) {
 		log.logMessage(validationResult.second);
 		return 0;
 	}
+	if (targetVertexIndex >= totalNumberOfVertices) {
+		log.logMessage("This target vertex is not valid. Exiting.");
+		return 0;
+	}
+
+	// previous results are repaired on the changed graph - incoming edges of its vertices are needed too
+	std::vector<Edge> changedEdges;
+	std::vector<double> previousDistances;
+	std::vector<int> previousPredecessors;
+	if (useIncrementalUpdate) {
+		if (!DijkstraIncremental::readChangedEdgesFromFile(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--update", ""),
+			totalNumberOfVertices, changedEdges)
+			|| !readPreviousResults(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--previous-results", "resultsSerial.bin"),
+				totalNumberOfVertices, sourceVertexIndex, previousDistances, previousPredecessors, log)) {
+			return 0;
+		}
+		sparseGraph = sparseGraph->createGraphWithChangedEdges(changedEdges);
+		reversedSparseGraph = sparseGraph->createReversedGraph();
+		log.logMessage("Graph changed by ", changedEdges.size(), " edges, now it has ", sparseGraph->getNumberOfEdges(), " edges");
+	}
+	if (benchmarkUpdates) {
+		runUpdatesBenchmark(totalNumberOfVertices, sourceVertexIndex, *sparseGraph, std::stoi(sizeOfBatchOption), log);
+		return 0;
+	}
+
+	// select vectorized kernels - the best instruction set is used unless user chooses other one
+	std::string instructionSetName = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--isa", "");
+	if (!instructionSetName.empty() && !RelaxationKernels::selectInstructionSet(instructionSetName)) {
+		log.logMessage("Instruction set ", instructionSetName, " is not supported.");
+	}
+	log.logMessage("Using ", RelaxationKernels::getInstructionSetName(), " kernels");
 
 	auto tBeforeAlgorithmStart = std::chrono::high_resolution_clock::now();
 
 	// run Dijkstra algorithm
-	DijkstraSerial dijkstraAlgorithm(totalNumberOfVertices, sourceVertexIndex, graphData);
-	auto dijkstraResults = dijkstraAlgorithm.run();
+	auto dijkstraResults = useIncrementalUpdate
+		? runIncrementalUpdate(totalNumberOfVertices, sourceVertexIndex, *sparseGraph, *reversedSparseGraph, std::move(previousDistances),
+			std::move(previousPredecessors), changedEdges, log)
+		: useHierarchy
+		? runHierarchySearch(sourceVertexIndex, targetVertexIndex, *hierarchy, log)
+		: useHeap
+		? runHeapSearch(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex, *sparseGraph, landmarkTable.get(), log)
+		: useBidirectionalSearch && useSparseGraph
+		? runBidirectionalSearch(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex, *sparseGraph, *reversedSparseGraph, 1, log)
+		: useBidirectionalSearch && useTransposedMatrix
+		? runBidirectionalSearch(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex, *transposedMatrix, reversedGraphData, 1, log)
+		: useBidirectionalSearch
+		? runBidirectionalSearch(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex, graphData, *reversedMatrix, 1, log)
+		: useSparseGraph
+		? DijkstraSerial<SparseGraph>(totalNumberOfVertices, sourceVertexIndex, *sparseGraph, targetVertexIndex).run()
+		: floatMatrix
+		? runWithConvertedWeights(*floatMatrix, totalNumberOfVertices, sourceVertexIndex, targetVertexIndex)
+		: uint16Matrix
+		? runWithConvertedWeights(*uint16Matrix, totalNumberOfVertices, sourceVertexIndex, targetVertexIndex)
+		: useTransposedMatrix
+		? DijkstraSerial<TransposedMatrixChunk>(totalNumberOfVertices, sourceVertexIndex, *transposedMatrix, targetVertexIndex).run()
+		: DijkstraSerial<ArrayView<double>>(totalNumberOfVertices, sourceVertexIndex, graphData, targetVertexIndex).run();
 
 	auto tBeforePrinting = std::chrono::high_resolution_clock::now();
 
-	// print results to file
-	std::ofstream file("resultsSerial.txt");
-	ResultsPrinter resultsPrinter(file);
-	resultsPrinter.printResultingDistances(dijkstraResults.first, sourceVertexIndex);
-	resultsPrinter.printResultingPaths(dijkstraResults.second, sourceVertexIndex);
+	// print results to file - binary results file contains only distances and predecessors
+	if (useBinaryResults) {
+		ResultsFile::writeToFile(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--binary-results", "resultsSerial.bin"),
+			dijkstraResults.first, dijkstraResults.second, sourceVertexIndex, targetVertexIndex, compressResults);
+	}
+	else {
+		std::ofstream file("resultsSerial.txt");
+		ResultsPrinter resultsPrinter(file);
+		if (useTargetVertex) {
+			resultsPrinter.printResultForTargetVertex(dijkstraResults.first, dijkstraResults.second, sourceVertexIndex, targetVertexIndex);
+		}
+		else {
+			resultsPrinter.printResultingDistances(dijkstraResults.first, sourceVertexIndex);
+			resultsPrinter.printResultingPaths(dijkstraResults.second, sourceVertexIndex);
+		}
+	}
 
 	auto tEnd = std::chrono::high_resolution_clock::now();
 
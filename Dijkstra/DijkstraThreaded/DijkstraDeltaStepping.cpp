@@ -0,0 +1,209 @@
+#include "DijkstraDeltaStepping.h"
+
+#include <algorithm>
+#include <limits>
+
+
+DijkstraDeltaStepping::DijkstraDeltaStepping(int totalNumberOfVertices, int sourceVertexIndex, const SparseGraph& graphData, double bucketWidth, int numberOfThreads) :
+	m_graphData(graphData),
+	m_bucketWidth(bucketWidth),
+	m_distances(totalNumberOfVertices, std::numeric_limits<double>::infinity()),
+	m_predecessors(totalNumberOfVertices, -1),
+	m_predecessorsDistances(totalNumberOfVertices, std::numeric_limits<double>::infinity()),
+	m_bucketOfVertex(totalNumberOfVertices, -1),
+	m_removedFromCurrentBucket(totalNumberOfVertices, 0),
+	m_threadTeam(numberOfThreads)
+{
+	// tentative distances of vertices in buckets never differ by more than maximal weight, so buckets can be reused cyclically
+	ArrayView<double> weights = m_graphData.getWeights();
+	double maximalWeight = weights.empty() ? 0.0 : *std::max_element(weights.begin(), weights.end());
+	m_numberOfBuckets = static_cast<std::int64_t>(maximalWeight / m_bucketWidth) + 2;
+
+	// every thread owns one slice of vertices
+	int numberOfThreadsInTeam = m_threadTeam.getNumberOfThreads();
+	for (int i = 0; i < numberOfThreadsInTeam; ++i) {
+		m_firstVertexOfThread.push_back(ThreadTeam::computeSliceOfRange(std::make_pair(0, totalNumberOfVertices - 1), numberOfThreadsInTeam, i).first);
+	}
+	m_firstVertexOfThread.push_back(totalNumberOfVertices);
+
+	m_threadData.resize(numberOfThreadsInTeam);
+	for (CacheLinePadded<ThreadData>& threadData : m_threadData) {
+		threadData.value.buckets.resize(m_numberOfBuckets);
+		threadData.value.requestsForThreads.resize(numberOfThreadsInTeam);
+	}
+
+	m_distances.at(sourceVertexIndex) = 0;
+	m_predecessorsDistances.at(sourceVertexIndex) = 0;
+	insertIntoBucket(findOwner(sourceVertexIndex), sourceVertexIndex);
+}
+
+
+std::pair<const std::vector<double>, const std::vector<int>> DijkstraDeltaStepping::run() {
+
+	// values published by threads - two sets are used alternately, so threads can read one of them
+	// while others already write the next one
+	int numberOfThreads = m_threadTeam.getNumberOfThreads();
+	std::vector<CacheLinePadded<std::int64_t>> publishedBuckets[2] = {
+		std::vector<CacheLinePadded<std::int64_t>>(numberOfThreads),
+		std::vector<CacheLinePadded<std::int64_t>>(numberOfThreads)
+	};
+
+	m_threadTeam.execute([&](int threadIndex) {
+
+		// every thread publishes index of its bucket (or -1) and computes smallest one on its own, without locks
+		int exchangeNumber = 0;
+		auto findSmallestBucketOfAllThreads = [&](std::int64_t bucketOfThread) {
+			std::vector<CacheLinePadded<std::int64_t>>& buckets = publishedBuckets[exchangeNumber++ % 2];
+			buckets[threadIndex].value = bucketOfThread;
+			m_threadTeam.synchronize();
+
+			std::int64_t smallestBucket = -1;
+			for (int i = 0; i < numberOfThreads; ++i) {
+				if (buckets[i].value != -1 && (smallestBucket == -1 || buckets[i].value < smallestBucket)) {
+					smallestBucket = buckets[i].value;
+				}
+			}
+			return smallestBucket;
+		};
+
+		std::vector<int> frontier;
+		std::int64_t currentBucket = 0;
+		while (true) {
+
+			// find smallest bucket that is not empty in any thread - if there is none, all reachable vertices have been processed
+			currentBucket = findSmallestBucketOfAllThreads(findSmallestNonEmptyBucket(threadIndex, currentBucket));
+			if (currentBucket == -1) {
+				break;
+			}
+
+			// light edges are relaxed in phases, as long as any vertices are put back into current bucket
+			do {
+				extractBucket(threadIndex, currentBucket, frontier);
+				relaxEdges(threadIndex, frontier, true);
+				m_threadTeam.synchronize();
+				processRequests(threadIndex);
+			} while (findSmallestBucketOfAllThreads(findSmallestNonEmptyBucket(threadIndex, currentBucket) == currentBucket ? currentBucket : -1) != -1);
+
+			// heavy edges can not lead to current bucket, so they are relaxed once, when distances are final
+			ThreadData& threadData = m_threadData[threadIndex].value;
+			relaxEdges(threadIndex, threadData.verticesRemovedFromBucket, false);
+			for (int vertex : threadData.verticesRemovedFromBucket) {
+				m_removedFromCurrentBucket[vertex] = 0;
+			}
+			threadData.verticesRemovedFromBucket.clear();
+			m_threadTeam.synchronize();
+			processRequests(threadIndex);
+		}
+	});
+
+	return std::make_pair(m_distances, m_predecessors);
+}
+
+
+double DijkstraDeltaStepping::computeDefaultBucketWidth(const SparseGraph& graphData) {
+	ArrayView<double> weights = graphData.getWeights();
+	if (weights.empty()) {
+		return 1.0;
+	}
+
+	double maximalWeight = *std::max_element(weights.begin(), weights.end());
+	double minimalWeight = *std::min_element(weights.begin(), weights.end());
+	double averageDegree = static_cast<double>(graphData.getNumberOfEdges()) / graphData.getNumberOfVertices();
+	return std::max(minimalWeight, maximalWeight / std::max(1.0, averageDegree));
+}
+
+
+int DijkstraDeltaStepping::findOwner(int vertex) const {
+	return static_cast<int>(std::upper_bound(m_firstVertexOfThread.begin(), m_firstVertexOfThread.end(), vertex) - m_firstVertexOfThread.begin()) - 1;
+}
+
+
+void DijkstraDeltaStepping::insertIntoBucket(int threadIndex, int vertex) {
+	std::int64_t bucket = static_cast<std::int64_t>(m_distances[vertex] / m_bucketWidth);
+	if (m_bucketOfVertex[vertex] != bucket) {
+		m_bucketOfVertex[vertex] = bucket;
+		m_threadData[threadIndex].value.buckets[bucket % m_numberOfBuckets].push_back(vertex);
+	}
+}
+
+
+std::int64_t DijkstraDeltaStepping::findSmallestNonEmptyBucket(int threadIndex, std::int64_t firstBucket) {
+	ThreadData& threadData = m_threadData[threadIndex].value;
+	for (std::int64_t bucket = firstBucket; bucket < firstBucket + m_numberOfBuckets; ++bucket) {
+
+		// vertices that have been moved to other bucket leave outdated entries
+		std::vector<int>& verticesInBucket = threadData.buckets[bucket % m_numberOfBuckets];
+		verticesInBucket.erase(std::remove_if(verticesInBucket.begin(), verticesInBucket.end(),
+			[&](int vertex) { return m_bucketOfVertex[vertex] != bucket; }), verticesInBucket.end());
+
+		if (!verticesInBucket.empty()) {
+			return bucket;
+		}
+	}
+	return -1;
+}
+
+
+void DijkstraDeltaStepping::extractBucket(int threadIndex, std::int64_t bucket, std::vector<int>& frontier) {
+	ThreadData& threadData = m_threadData[threadIndex].value;
+	std::vector<int>& verticesInBucket = threadData.buckets[bucket % m_numberOfBuckets];
+
+	frontier.clear();
+	for (int vertex : verticesInBucket) {
+		if (m_bucketOfVertex[vertex] != bucket) {
+			continue;
+		}
+		m_bucketOfVertex[vertex] = -1;
+		frontier.push_back(vertex);
+		if (!m_removedFromCurrentBucket[vertex]) {
+			m_removedFromCurrentBucket[vertex] = 1;
+			threadData.verticesRemovedFromBucket.push_back(vertex);
+		}
+	}
+	verticesInBucket.clear();
+}
+
+
+void DijkstraDeltaStepping::relaxEdges(int threadIndex, const std::vector<int>& vertices, bool lightEdges) {
+	ArrayView<int> offsets = m_graphData.getOffsets();
+	ArrayView<int> targets = m_graphData.getTargets();
+	ArrayView<double> weights = m_graphData.getWeights();
+	std::vector<std::vector<RelaxationRequest>>& requestsForThreads = m_threadData[threadIndex].value.requestsForThreads;
+
+	for (int vertex : vertices) {
+		for (int e = offsets[vertex]; e < offsets[vertex + 1]; ++e) {
+			if ((weights[e] <= m_bucketWidth) != lightEdges) {
+				continue;
+			}
+			RelaxationRequest request = { targets[e], vertex, m_distances[vertex] + weights[e], m_distances[vertex] };
+			requestsForThreads[findOwner(targets[e])].push_back(request);
+		}
+	}
+}
+
+
+void DijkstraDeltaStepping::processRequests(int threadIndex) {
+	for (CacheLinePadded<ThreadData>& senderData : m_threadData) {
+		std::vector<RelaxationRequest>& requests = senderData.value.requestsForThreads[threadIndex];
+		for (const RelaxationRequest& request : requests) {
+
+			// shorter distance always wins - if distances are equal, predecessor is chosen the way DijkstraSerial
+			// does it: the one that would be processed first (with smaller distance, then with smaller number)
+			int target = request.target;
+			bool isDistanceShorter = request.distance < m_distances[target];
+			bool isPredecessorBetter = request.distance == m_distances[target]
+				&& (request.sourceDistance < m_predecessorsDistances[target]
+					|| (request.sourceDistance == m_predecessorsDistances[target] && request.source < m_predecessors[target]));
+
+			if (isDistanceShorter || isPredecessorBetter) {
+				m_distances[target] = request.distance;
+				m_predecessors[target] = request.source;
+				m_predecessorsDistances[target] = request.sourceDistance;
+				if (isDistanceShorter) {
+					insertIntoBucket(threadIndex, target);
+				}
+			}
+		}
+		requests.clear();
+	}
+}
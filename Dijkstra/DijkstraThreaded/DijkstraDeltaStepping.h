@@ -0,0 +1,159 @@
+/**
+*	@file DijkstraDeltaStepping.h
+*	@brief This file contains multithreaded delta-stepping implementation of
+*	single source shortest paths for sparse graphs.
+*/
+
+
+#pragma once
+
+#include "SparseGraph.h"
+#include "ThreadTeam.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class contains delta-stepping algorithm (Meyer and Sanders) working on
+/// sparse graph with persistent ThreadTeam. Vertices are kept in buckets of
+/// width delta and all vertices of the smallest bucket are processed at once:
+/// light edges (weight not greater than delta) are relaxed in phases until the
+/// bucket is empty, then heavy edges of all vertices removed from it are relaxed
+/// once. Every thread owns a range of vertices and is the only one that modifies
+/// their distances - relaxations are sent to owners through per-thread request
+/// buffers, so no atomic operations are needed. Results (including predecessors)
+/// are exactly the same as results of DijkstraSerial.
+/// </summary>
+class DijkstraDeltaStepping
+{
+public:
+
+	/// <summary>
+	/// DijkstraDeltaStepping class constructor. Prepares distance and predecessors
+	/// arrays, buckets of every thread and starts threads that will run the algorithm.
+	/// </summary>
+	/// <param name="totalNumberOfVertices">
+	/// Integer number that represents total number of vertices in processed
+	/// graph.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Integer number that represents index of source vertex.
+	/// </param>
+	/// <param name="graphData">
+	/// Sparse graph that is being processed by this object. Please note that this
+	/// object stores reference to it - it is valid as long as graph itself is valid.
+	/// </param>
+	/// <param name="bucketWidth">
+	/// Width of bucket (delta) - positive number. See computeDefaultBucketWidth.
+	/// </param>
+	/// <param name="numberOfThreads">
+	/// Number of threads that run the algorithm (including calling thread).
+	/// </param>
+	DijkstraDeltaStepping(int totalNumberOfVertices, int sourceVertexIndex, const SparseGraph& graphData, double bucketWidth, int numberOfThreads);
+
+
+	/// <summary>
+	/// Dijkstra algorithm implementation. Runs delta-stepping algorithm. Handles all
+	/// graph vertices.
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors that represent algorithm results. First vector represents
+	/// distances from source vertex, second vector contains predecessors.
+	/// </returns>
+	std::pair<const std::vector<double>, const std::vector<int>> run();
+
+
+	/// <summary>
+	/// Computes bucket width based on weights of edges: maximal weight divided by
+	/// average degree of vertex (as suggested by Meyer and Sanders), but not smaller
+	/// than minimal weight - so every vertex has on average about one heavy edge
+	/// per light phase and buckets are never narrower than the lightest edge.
+	/// </summary>
+	/// <returns>
+	/// Bucket width that should be used for given graph.
+	/// </returns>
+	static double computeDefaultBucketWidth(const SparseGraph& graphData);
+
+private:
+
+	/// <summary>
+	/// Request sent to owner of target vertex - proposal of new distance and
+	/// predecessor for it.
+	/// </summary>
+	struct RelaxationRequest {
+		int target;
+		int source;
+		double distance;
+		double sourceDistance;
+	};
+
+
+	/// <summary>
+	/// Data used by only one thread, kept in separate cache lines.
+	/// </summary>
+	struct ThreadData {
+		std::vector<std::vector<int>> buckets;
+		std::vector<int> verticesRemovedFromBucket;
+		std::vector<std::vector<RelaxationRequest>> requestsForThreads;
+	};
+
+
+	/// <summary>
+	/// Returns index of thread that owns given vertex.
+	/// </summary>
+	int findOwner(int vertex) const;
+
+
+	/// <summary>
+	/// Puts vertex owned by given thread into bucket that corresponds to its
+	/// current distance (unless it is already there).
+	/// </summary>
+	void insertIntoBucket(int threadIndex, int vertex);
+
+
+	/// <summary>
+	/// Finds smallest bucket of given thread (starting from firstBucket) that contains
+	/// any vertices. Removes outdated entries of buckets on the way.
+	/// </summary>
+	/// <returns>
+	/// Index of found bucket or -1 if all buckets are empty.
+	/// </returns>
+	std::int64_t findSmallestNonEmptyBucket(int threadIndex, std::int64_t firstBucket);
+
+
+	/// <summary>
+	/// Removes all vertices from bucket of given thread and stores them in frontier.
+	/// They are also remembered as removed from current bucket, so heavy edges can be
+	/// relaxed later.
+	/// </summary>
+	void extractBucket(int threadIndex, std::int64_t bucket, std::vector<int>& frontier);
+
+
+	/// <summary>
+	/// Creates relaxation requests for light (or heavy) edges leaving given vertices
+	/// and puts them into buffers of threads that own target vertices.
+	/// </summary>
+	void relaxEdges(int threadIndex, const std::vector<int>& vertices, bool lightEdges);
+
+
+	/// <summary>
+	/// Applies all requests that other threads (and this one) sent to given thread.
+	/// </summary>
+	void processRequests(int threadIndex);
+
+
+	const SparseGraph& m_graphData;
+	double m_bucketWidth;
+	std::int64_t m_numberOfBuckets;
+
+	std::vector<double> m_distances;
+	std::vector<int> m_predecessors;
+	std::vector<double> m_predecessorsDistances;
+	std::vector<std::int64_t> m_bucketOfVertex;
+	std::vector<char> m_removedFromCurrentBucket;
+
+	std::vector<int> m_firstVertexOfThread;
+	std::vector<CacheLinePadded<ThreadData>> m_threadData;
+	ThreadTeam m_threadTeam;
+};
@@ -0,0 +1,66 @@
+#include "DijkstraThreaded.h"
+
+
+template <typename GraphDataType>
+std::pair<const std::vector<typename DijkstraThreaded<GraphDataType>::DistanceType>, const std::vector<int>> DijkstraThreaded<GraphDataType>::run() {
+
+	// local closest vertices of threads - two sets are used alternately, so threads can read one of them
+	// while others already write next iteration results to the other one
+	int numberOfThreads = m_threadTeam.getNumberOfThreads();
+	std::vector<CacheLinePadded<VertexDataType>> localMinimaOfThreads[2] = {
+		std::vector<CacheLinePadded<VertexDataType>>(numberOfThreads),
+		std::vector<CacheLinePadded<VertexDataType>>(numberOfThreads)
+	};
+
+	m_threadTeam.execute([&](int threadIndex) {
+
+		// every thread owns slice of vertices - it is the only one that relaxes them and marks them as processed
+		std::pair<int, int> ownedVerticesSlice = ThreadTeam::computeSliceOfRange(std::make_pair(0, m_totalNumberOfVertices - 1), numberOfThreads, threadIndex);
+
+		// vertex that belongs to current thread and is closest to cluster of already processed vertices
+		localMinimaOfThreads[0][threadIndex].value = m_dijkstraBackend.findVertexWithMinimalDistanceToCluster(ownedVerticesSlice);
+
+		for (int iteration = 0; ; ++iteration) {
+			std::vector<CacheLinePadded<VertexDataType>>& localMinima = localMinimaOfThreads[iteration % 2];
+			m_threadTeam.synchronize();
+
+			// every thread computes global closest vertex on its own - slices are ordered, so ties go to smaller vertex
+			VertexDataType globalMin = localMinima[0].value;
+			for (int i = 1; i < numberOfThreads; ++i) {
+				if (localMinima[i].value.distance < globalMin.distance) {
+					globalMin = localMinima[i].value;
+				}
+			}
+
+			// if there was no valid closest vertex, all reachable vertices have been processed
+			if (globalMin.vertexNumber == -1) {
+				break;
+			}
+
+			// mark vertex as processed - only its owner does it, other threads never look at it again
+			if (globalMin.vertexNumber >= ownedVerticesSlice.first && globalMin.vertexNumber <= ownedVerticesSlice.second) {
+				m_dijkstraBackend.markVertexAsProcessed(globalMin.vertexNumber);
+			}
+
+			// every thread knows global closest vertex, so all of them stop together when it is the target
+			if (globalMin.vertexNumber == m_targetVertexIndex) {
+				break;
+			}
+
+			// inner loop - computing new distances and finding local closest vertex for the next iteration
+			localMinimaOfThreads[(iteration + 1) % 2][threadIndex].value = m_dijkstraBackend.performInnerForLoopAndFindVertexWithMinimalDistanceToCluster(globalMin,
+				m_graphData, ownedVerticesSlice);
+		}
+	});
+
+	return std::make_pair(m_dijkstraBackend.getDistances(), m_dijkstraBackend.getPredecessors());
+}
+
+
+template class DijkstraThreaded<ArrayView<double>>;
+template class DijkstraThreaded<SparseGraph>;
+template class DijkstraThreaded<TransposedMatrixChunk>;
+template class DijkstraThreaded<ArrayView<float>>;
+template class DijkstraThreaded<ArrayView<std::uint16_t>>;
+template class DijkstraThreaded<BasicTransposedMatrixChunk<float>>;
+template class DijkstraThreaded<BasicTransposedMatrixChunk<std::uint16_t>>;
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+*	@file DijkstraThreaded.h
+*	@brief This file contains multithreaded, shared-memory Dijkstra algorithm
+*	implementation.
+*/
+
+
+#pragma once
+
+#include "DijkstraAlgorithmBackend.h"
+#include "ThreadTeam.h"
+
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// This class contains multithreaded Dijkstra algorithm implementation for one
+/// machine with shared memory. It uses DijkstraAlgorithmBackend class - every
+/// thread of persistent ThreadTeam owns a slice of vertices and relaxes only
+/// them, but all threads share one backend and one copy of the graph. Template
+/// parameter is type of graph representation - it can be adjacency matrix in
+/// form of 1D vector of weights, TransposedMatrixChunk or SparseGraph. Dense graphs can store
+/// weights of any type supported by WeightTraits - distances are computed in
+/// type defined by its traits.
+/// </summary>
+template <typename GraphDataType>
+class DijkstraThreaded
+{
+public:
+
+	using BackendType = BasicDijkstraAlgorithmBackend<typename GraphWeightType<GraphDataType>::Type>;
+	using DistanceType = typename BackendType::DistanceType;
+	using VertexDataType = typename BackendType::VertexDataType;
+
+	/// <summary>
+	/// DijkstraThreaded class constructor. Prepares algorithm backend and starts
+	/// threads that will run the algorithm.
+	/// </summary>
+	/// <param name="totalNumberOfVertices">
+	/// Integer number that represents total number of vertices in processed
+	/// graph.
+	/// </param>
+	/// <param name="sourceVertexIndex">
+	/// Integer number that represents index of source vertex.
+	/// </param>
+	/// <param name="graphData">
+	/// Graph that is being processed by this object - adjacency matrix in a form of
+	/// 1D vector of weights (data from matrix should be aranged column-wise), row-wise
+	/// TransposedMatrixChunk or sparse graph. Please note that this object stores
+	/// reference to it - it is valid as long as graph itself is valid.
+	/// </param>
+	/// <param name="numberOfThreads">
+	/// Number of threads that run the algorithm (including calling thread).
+	/// </param>
+	/// <param name="targetVertexIndex">
+	/// Number of target vertex - search stops as soon as it is processed, so only
+	/// distance and path to it are valid. If it is -1, all vertices are processed.
+	/// </param>
+	DijkstraThreaded(int totalNumberOfVertices, int sourceVertexIndex, const GraphDataType& graphData, int numberOfThreads, int targetVertexIndex = -1)
+		: m_dijkstraBackend(std::make_pair(0, totalNumberOfVertices - 1), totalNumberOfVertices, sourceVertexIndex), m_graphData(graphData),
+		m_totalNumberOfVertices(totalNumberOfVertices), m_targetVertexIndex(targetVertexIndex), m_threadTeam(numberOfThreads) {}
+
+
+	/// <summary>
+	/// Dijkstra algorithm implementation. Runs multithreaded implementation of Dijkstra
+	/// algorithm. Handles all graph vertices.
+	/// </summary>
+	/// <returns>
+	/// Pair of vectors that represent Dijkstra algorithm results. First vector represents
+	/// distances from source vertex, second vector contains predecessors.
+	/// </returns>
+	std::pair<const std::vector<DistanceType>, const std::vector<int>> run();
+
+private:
+
+	BackendType m_dijkstraBackend;
+	const GraphDataType& m_graphData;
+	int m_totalNumberOfVertices;
+	int m_targetVertexIndex;
+	ThreadTeam m_threadTeam;
+};
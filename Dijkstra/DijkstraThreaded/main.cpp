@@ -0,0 +1,273 @@
+#include "AdjacencyMatrix.h"
+#include "ConvertedAdjacencyMatrix.h"
+#include "DijkstraBidirectional.h"
+#include "SparseGraph.h"
+#include "TransposedMatrixChunk.h"
+#include "Log.h"
+#include "RelaxationKernels.h"
+#include "ResultsFile.h"
+#include "ResultsPrinter.h"
+#include "CommandLineArgumentsExtractor.h"
+#include "Validator.h"
+#include "DijkstraThreaded.h"
+#include "DijkstraDeltaStepping.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#ifndef SHOULD_LOG
+#define SHOULD_LOG true
+#endif // !SHOULD_LOG
+
+
+/// <summary>
+/// Runs DijkstraThreaded on adjacency matrix with converted weights. Distances are converted
+/// back to doubles, so results are printed the same way for every type of weights.
+/// </summary>
+template <typename WeightType>
+std::pair<const std::vector<double>, const std::vector<int>> runWithConvertedWeights(const ConvertedAdjacencyMatrix<WeightType>& matrix,
+	int totalNumberOfVertices, int sourceVertexIndex, int numberOfThreads, int targetVertexIndex)
+{
+	if (matrix.checkIfIsTransposed()) {
+		return convertDistancesToDoubles(DijkstraThreaded<BasicTransposedMatrixChunk<WeightType>>(totalNumberOfVertices, sourceVertexIndex,
+			matrix.getTransposedMatrix(), numberOfThreads, targetVertexIndex).run());
+	}
+
+	// algorithm stores reference to the view, so it has to outlive it
+	ArrayView<WeightType> columnWiseWeights = matrix.getColumnWiseWeights();
+	return convertDistancesToDoubles(DijkstraThreaded<ArrayView<WeightType>>(totalNumberOfVertices, sourceVertexIndex, columnWiseWeights, numberOfThreads,
+		targetVertexIndex).run());
+}
+
+
+/// <summary>
+/// Runs bidirectional search between source and target vertex and logs how many
+/// vertices it had to process.
+/// </summary>
+template <typename GraphDataType, typename ReversedGraphDataType>
+std::pair<const std::vector<double>, const std::vector<int>> runBidirectionalSearch(int totalNumberOfVertices, int sourceVertexIndex,
+	int targetVertexIndex, const GraphDataType& graphData, const ReversedGraphDataType& reversedGraphData, int numberOfThreads, Log<SHOULD_LOG>& log)
+{
+	DijkstraBidirectional<GraphDataType, ReversedGraphDataType> dijkstraBidirectional(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex,
+		graphData, reversedGraphData, numberOfThreads);
+	auto results = dijkstraBidirectional.run();
+	log.logMessage("Bidirectional search processed ", dijkstraBidirectional.getNumberOfProcessedVertices(), " of ", totalNumberOfVertices, " vertices");
+	return results;
+}
+
+
+int main(int argc, char* argv[]) {
+
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	// prepare Log class - initialize it with reference to standard output
+	Log<SHOULD_LOG> log(std::cout);
+
+	// validate command line arguments
+	auto validationResult = Validator::validateCommandLineArguments(argc, argv);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		return 0;
+	}
+
+	// by default every hardware thread is used
+	std::string numberOfThreadsOption = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--threads",
+		std::to_string(std::max(1u, std::thread::hardware_concurrency())));
+	validationResult = Validator::validateNumberOfThreads(numberOfThreadsOption);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		return 0;
+	}
+
+	// read data from command line arguments
+	int sourceVertexIndex = CommandLineArgumentsExtractor::extractSourceVertexIndexFromCommandLineArguments(argv);
+	std::string filePath = CommandLineArgumentsExtractor::extractInputFileNameFromCommandLineArguments(argc, argv);
+	bool inputIsEdgeList = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--edge-list");
+	bool useDeltaStepping = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--delta-stepping");
+	bool useSparseGraph = inputIsEdgeList || useDeltaStepping || CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--sparse");
+	bool useTransposedMatrix = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--transposed");
+	bool compressResults = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--compress-results");
+	bool useBinaryResults = compressResults || CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--binary-results");
+	int numberOfThreads = std::stoi(numberOfThreadsOption);
+	std::string weightTypeName = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--weights", "double");
+
+	validationResult = Validator::validateWeightType(weightTypeName);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		return 0;
+	}
+	if (useSparseGraph && weightTypeName != "double") {
+		log.logMessage("Sparse graph always stores double weights.");
+		weightTypeName = "double";
+	}
+
+	// search can stop as soon as target vertex is reached - bidirectional search needs target too
+	bool useTargetVertex = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--target");
+	bool useBidirectionalSearch = CommandLineArgumentsExtractor::checkIfOptionIsPresent(argc, argv, "--bidirectional");
+	if (useTargetVertex || useBidirectionalSearch) {
+		validationResult = Validator::validateTargetVertex(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--target", ""));
+		if (!validationResult.first) {
+			log.logMessage(validationResult.second);
+			return 0;
+		}
+	}
+	int targetVertexIndex = useTargetVertex ? std::stoi(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--target", "")) : -1;
+	if (useBidirectionalSearch && useDeltaStepping) {
+		log.logMessage("Bidirectional search is not used with --delta-stepping.");
+		useBidirectionalSearch = false;
+	}
+	if (useBidirectionalSearch && weightTypeName != "double") {
+		log.logMessage("Bidirectional search uses double weights.");
+		weightTypeName = "double";
+	}
+
+	// read graph data from file - all threads share one copy of it
+	std::unique_ptr<AdjacencyMatrix> matrix;
+	ArrayView<double> graphData;
+	std::unique_ptr<SparseGraph> sparseGraph;
+	std::unique_ptr<TransposedMatrixChunk> transposedMatrix;
+	std::unique_ptr<ConvertedAdjacencyMatrix<float>> floatMatrix;
+	std::unique_ptr<ConvertedAdjacencyMatrix<std::uint16_t>> uint16Matrix;
+	std::unique_ptr<SparseGraph> reversedSparseGraph;
+	std::unique_ptr<TransposedMatrixChunk> reversedMatrix;
+	ArrayView<double> reversedGraphData;
+	int totalNumberOfVertices = 0;
+	if (useSparseGraph) {
+		sparseGraph = inputIsEdgeList ? SparseGraph::fromEdgeListFile(filePath) : SparseGraph::fromFile(filePath);
+		totalNumberOfVertices = sparseGraph->getNumberOfVertices();
+		log.logMessage("Graph stored in sparse form with ", sparseGraph->getNumberOfEdges(), " edges");
+	}
+	else {
+		matrix = AdjacencyMatrix::fromFile(filePath, numberOfThreads);
+		graphData = matrix->asContinousVector();
+		totalNumberOfVertices = matrix->getNumberOfVertices();
+		if (weightTypeName != "double") {
+
+			// weights of smaller type mean less memory traffic in inner loop
+			bool converted = false;
+			if (weightTypeName == "float") {
+				floatMatrix = ConvertedAdjacencyMatrix<float>::fromColumnWiseData(graphData, totalNumberOfVertices, useTransposedMatrix);
+				converted = floatMatrix != nullptr;
+			}
+			else {
+				uint16Matrix = ConvertedAdjacencyMatrix<std::uint16_t>::fromColumnWiseData(graphData, totalNumberOfVertices, useTransposedMatrix);
+				converted = uint16Matrix != nullptr;
+			}
+			graphData = ArrayView<double>();
+			matrix.reset();
+			if (!converted) {
+				log.logMessage("Graph contains weights that can not be stored as ", weightTypeName, ".");
+				return 0;
+			}
+			log.logMessage("Weights stored as ", weightTypeName);
+		}
+		else if (useTransposedMatrix) {
+			transposedMatrix.reset(new TransposedMatrixChunk(TransposedMatrixChunk::fromColumnWiseData(graphData, totalNumberOfVertices)));
+			graphData = ArrayView<double>();
+			matrix.reset();
+		}
+	}
+
+	// backward search of bidirectional algorithm needs reversed graph - row-wise matrix read column-wise
+	// is reversed matrix, so for dense graphs the same data is used in other layout
+	if (useBidirectionalSearch) {
+		if (useSparseGraph) {
+			reversedSparseGraph = sparseGraph->createReversedGraph();
+		}
+		else if (useTransposedMatrix) {
+			reversedGraphData = transposedMatrix->getWeights();
+		}
+		else {
+			reversedMatrix.reset(new TransposedMatrixChunk(std::vector<double>(graphData.begin(), graphData.end()), totalNumberOfVertices));
+		}
+	}
+
+	// perform additional validation
+	validationResult = Validator::validateVerticesNumbers(totalNumberOfVertices, sourceVertexIndex);
+	if (!validationResult.first) {
+		log.logMessage(validationResult.second);
+		return 0;
+	}
+	if (targetVertexIndex >= totalNumberOfVertices) {
+		log.logMessage("This target vertex is not valid. Exiting.");
+		return 0;
+	}
+
+	// bucket width of delta-stepping is computed from weights unless user gives it
+	double bucketWidth = 0.0;
+	if (useDeltaStepping) {
+		std::string bucketWidthOption = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--delta-stepping", "");
+		if (!bucketWidthOption.empty()) {
+			validationResult = Validator::validateBucketWidth(bucketWidthOption);
+			if (!validationResult.first) {
+				log.logMessage(validationResult.second);
+				return 0;
+			}
+		}
+		bucketWidth = bucketWidthOption.empty() ? DijkstraDeltaStepping::computeDefaultBucketWidth(*sparseGraph) : std::stod(bucketWidthOption);
+		log.logMessage("Using delta-stepping with bucket width ", bucketWidth);
+	}
+
+	// select vectorized kernels - the best instruction set is used unless user chooses other one
+	std::string instructionSetName = CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--isa", "");
+	if (!instructionSetName.empty() && !RelaxationKernels::selectInstructionSet(instructionSetName)) {
+		log.logMessage("Instruction set ", instructionSetName, " is not supported.");
+	}
+	log.logMessage("Using ", RelaxationKernels::getInstructionSetName(), " kernels and ", numberOfThreads, " threads");
+
+	auto tBeforeAlgorithmStart = std::chrono::high_resolution_clock::now();
+
+	// run Dijkstra algorithm
+	auto dijkstraResults = useDeltaStepping
+		? DijkstraDeltaStepping(totalNumberOfVertices, sourceVertexIndex, *sparseGraph, bucketWidth, numberOfThreads).run()
+		: useBidirectionalSearch && useSparseGraph
+		? runBidirectionalSearch(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex, *sparseGraph, *reversedSparseGraph, numberOfThreads, log)
+		: useBidirectionalSearch && useTransposedMatrix
+		? runBidirectionalSearch(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex, *transposedMatrix, reversedGraphData, numberOfThreads, log)
+		: useBidirectionalSearch
+		? runBidirectionalSearch(totalNumberOfVertices, sourceVertexIndex, targetVertexIndex, graphData, *reversedMatrix, numberOfThreads, log)
+		: useSparseGraph
+		? DijkstraThreaded<SparseGraph>(totalNumberOfVertices, sourceVertexIndex, *sparseGraph, numberOfThreads, targetVertexIndex).run()
+		: floatMatrix
+		? runWithConvertedWeights(*floatMatrix, totalNumberOfVertices, sourceVertexIndex, numberOfThreads, targetVertexIndex)
+		: uint16Matrix
+		? runWithConvertedWeights(*uint16Matrix, totalNumberOfVertices, sourceVertexIndex, numberOfThreads, targetVertexIndex)
+		: useTransposedMatrix
+		? DijkstraThreaded<TransposedMatrixChunk>(totalNumberOfVertices, sourceVertexIndex, *transposedMatrix, numberOfThreads, targetVertexIndex).run()
+		: DijkstraThreaded<ArrayView<double>>(totalNumberOfVertices, sourceVertexIndex, graphData, numberOfThreads, targetVertexIndex).run();
+
+	auto tBeforePrinting = std::chrono::high_resolution_clock::now();
+
+	// print results to file - binary results file contains only distances and predecessors
+	if (useBinaryResults) {
+		ResultsFile::writeToFile(CommandLineArgumentsExtractor::extractOptionValue(argc, argv, "--binary-results", "resultsThreaded.bin"),
+			dijkstraResults.first, dijkstraResults.second, sourceVertexIndex, targetVertexIndex, compressResults);
+	}
+	else {
+		std::ofstream file("resultsThreaded.txt");
+		ResultsPrinter resultsPrinter(file);
+		if (useTargetVertex) {
+			resultsPrinter.printResultForTargetVertex(dijkstraResults.first, dijkstraResults.second, sourceVertexIndex, targetVertexIndex);
+		}
+		else {
+			resultsPrinter.printResultingDistances(dijkstraResults.first, sourceVertexIndex);
+			resultsPrinter.printResultingPaths(dijkstraResults.second, sourceVertexIndex);
+		}
+	}
+
+	auto tEnd = std::chrono::high_resolution_clock::now();
+
+	// log information about elapsed time
+	std::chrono::duration<double> diffTotal = tEnd - tStart;
+	std::chrono::duration<double> diffSetup = tBeforeAlgorithmStart - tStart;
+	std::chrono::duration<double> diffAlgo = tBeforePrinting - tBeforeAlgorithmStart;
+	std::chrono::duration<double> diffPrint = tEnd - tBeforePrinting;
+	log.logMessage("Total elapsed time: ", diffTotal.count(), "s");
+	log.logMessage("Setup took: ", diffSetup.count(), "s");
+	log.logMessage("Algorithm took: ", diffAlgo.count(), "s");
+	log.logMessage("Printing solution took: ", diffPrint.count(), "s");
+
+	return 0;
+}
@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+# helpers shared by tests of Dijkstra algorithm implementations - random
+# graphs, files in formats read by executables and running the executables
+
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+# random directed graph as adjacency matrix - weights[i][j] is weight of edge
+# i -> j, 0 means no edge; integer weights from a small range give many paths
+# of equal length, so rules for choosing predecessors are tested too
+def generateGraph(numberOfVertices, numberOfEdges, seed, integerWeights=False):
+    rng = random.Random(seed)
+    weights = [ [0] * numberOfVertices for i in range(0, numberOfVertices) ]
+    numberOfEdges = min(numberOfEdges, numberOfVertices * (numberOfVertices - 1))
+    added = 0
+    while added < numberOfEdges:
+        i = rng.randrange(numberOfVertices)
+        j = rng.randrange(numberOfVertices)
+        if i != j and weights[i][j] == 0:
+            weights[i][j] = rng.randint(1, 3) if integerWeights else round(rng.uniform(0.01, 10), 2)
+            added += 1
+    return weights
+
+
+# save graph as adjacency matrix file: number of vertices, then rows
+def writeMatrix(fileName, weights):
+    with open(fileName, 'w') as file:
+        file.write( "{0}\n".format(len(weights)) )
+        for row in weights:
+            file.write( " ".join("{0:g}".format(w) for w in row) + "\n" )
+
+
+# save graph as edge list file: number of vertices, then lines "source target weight"
+def writeEdgeList(fileName, weights):
+    with open(fileName, 'w') as file:
+        file.write( "{0}\n".format(len(weights)) )
+        for i in range(0, len(weights)):
+            for j in range(0, len(weights)):
+                if weights[i][j] > 0:
+                    file.write( "{0} {1} {2:g}\n".format(i, j, weights[i][j]) )
+
+
+# split text results into lines with distances and lines with paths
+def splitResults(text):
+    distances, paths = text.split("============= PATHS =============")
+    return distances.strip().split("\n"), paths.strip().split("\n")
+
+
+# only lines with distances, to compare searches which can choose another path
+# of the same length
+def distancesOf(text):
+    return "\n".join(splitResults(text)[0]) if text is not None else None
+
+
+# distances and predecessors written in text results - predecessor is the
+# vertex before the last one on path, -1 for source and unreachable vertices
+def parseResults(text):
+    distanceLines, pathLines = splitResults(text)
+    distances = [ float(line.split(": ")[1]) for line in distanceLines[1:] ]
+    predecessors = []
+    for line in pathLines:
+        path = [ int(v) for v in line.split(",") if v.strip() ] if not line.startswith("Vertex") else []
+        predecessors.append(path[-2] if len(path) > 1 else -1)
+    return distances, predecessors
+
+
+class Executables:
+
+    def __init__(self, buildDir, mpiexec):
+        self.buildDir = os.path.abspath(buildDir)
+        self.mpiexec = mpiexec.split()
+        self.workDir = tempfile.mkdtemp(prefix='dijkstra_test_')
+
+    def path(self, name):
+        return os.path.join(self.buildDir, name, name)
+
+    def file(self, name):
+        return os.path.join(self.workDir, name)
+
+    def remove(self):
+        shutil.rmtree(self.workDir, ignore_errors=True)
+
+    # content of text file from work directory, None if it does not exist
+    def read(self, name):
+        if not os.path.exists(self.file(name)):
+            return None
+        with open(self.file(name)) as file:
+            return file.read()
+
+    # run command in work directory, remove old results first
+    def run(self, command, resultsFile=None):
+        if resultsFile and os.path.exists(self.file(resultsFile)):
+            os.remove(self.file(resultsFile))
+        process = subprocess.run(command, cwd=self.workDir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        self.lastOutput = process.stdout.decode(errors='replace')
+        self.lastReturnCode = process.returncode
+        return self.read(resultsFile) if resultsFile else None
+
+    def runSerial(self, vertex, inputFile, options=[], resultsFile='resultsSerial.txt'):
+        return self.run([self.path('DijkstraSerial'), str(vertex), inputFile] + options, resultsFile)
+
+    def runThreaded(self, vertex, inputFile, options=[], resultsFile='resultsThreaded.txt'):
+        return self.run([self.path('DijkstraThreaded'), str(vertex), inputFile] + options, resultsFile)
+
+    def runMPI(self, numberOfProcesses, vertex, inputFile, options=[], resultsFile='resultsMPI.txt'):
+        return self.run(self.mpiexec + ['-n', str(numberOfProcesses), self.path('DijkstraMPI'), str(vertex), inputFile] + options, resultsFile)
+
+    def runConverter(self, inputFile, outputFile, options=[]):
+        self.run([self.path('DijkstraConverter'), inputFile, outputFile] + options)
+        return os.path.exists(outputFile)
+
+    def runPaths(self, resultsFile, targets):
+        return self.run([self.path('DijkstraPaths'), resultsFile] + [ str(t) for t in targets ], 'paths.txt')
+
+
+class Checker:
+
+    def __init__(self):
+        self.numberOfChecks = 0
+        self.failures = []
+
+    def check(self, name, condition, details=""):
+        self.numberOfChecks += 1
+        if not condition:
+            self.failures.append(name)
+            print("FAIL " + name)
+            if details:
+                print(details.rstrip()[-2000:])
+        return condition
+
+    # results have to be identical - compare files as text, show first different line
+    def checkEqual(self, name, expected, actual, details=""):
+        if expected is not None and actual is not None and expected != actual:
+            expectedLines = expected.split("\n")
+            actualLines = actual.split("\n")
+            line = next(i for i in range(0, max(len(expectedLines), len(actualLines)))
+                if i >= len(expectedLines) or i >= len(actualLines) or expectedLines[i] != actualLines[i])
+            details = "line {0}: expected '{1}', got '{2}'".format(line + 1,
+                expectedLines[line] if line < len(expectedLines) else "", actualLines[line] if line < len(actualLines) else "")
+        self.check(name, expected is not None and expected == actual, details)
+
+    def finish(self):
+        print("{0} checks, {1} failed".format(self.numberOfChecks, len(self.failures)))
+        sys.exit(1 if self.failures else 0)
@@ -0,0 +1,214 @@
+#!/usr/bin/env python
+# result-equivalence tests of Dijkstra algorithm implementations - every engine
+# and storage option has to give exactly the same results file as the baseline,
+# dense DijkstraSerial, on the same graph (including paths chosen when several
+# paths have equal length)
+
+import argparse
+import random
+
+from common import Executables, Checker, generateGraph, writeMatrix, writeEdgeList, distancesOf
+
+parser = argparse.ArgumentParser(description =
+    'Result-equivalence tests of Dijkstra algorithm implementations')
+parser.add_argument('buildDir', metavar='DIR', type=str, nargs=1,
+    help='directory with built executables (Dijkstra directory of the build)')
+parser.add_argument('group', metavar='GROUP', type=str, nargs=1,
+    choices=['serial', 'threaded', 'mpi', 'queries', 'updates'], help='group of engines to test')
+parser.add_argument('--mpiexec', metavar='COMMAND', type=str, nargs=1,
+    default=['mpiexec'], help='command that runs MPI programs')
+
+args = parser.parse_args()
+
+SOURCES = [0, 7]
+
+
+def main():
+    executables = Executables(args.buildDir[0], args.mpiexec[0])
+    checker = Checker()
+    try:
+        graphs = prepareGraphs(executables)
+        {
+            'serial': testSerial,
+            'threaded': testThreaded,
+            'mpi': testMPI,
+            'queries': testQueries,
+            'updates': testUpdates
+        }[args.group[0]](executables, checker, graphs)
+    finally:
+        executables.remove()
+    checker.finish()
+
+
+# graphs used by all tests: random weights, integer weights with many paths of
+# equal length and graph with few edges, in which some vertices are unreachable
+def prepareGraphs(executables):
+    graphs = {}
+    for name, weights in [ ('random', generateGraph(150, 900, 1)),
+                           ('ties', generateGraph(100, 500, 2, integerWeights=True)),
+                           ('unreachable', generateGraph(60, 70, 3)) ]:
+        graph = { 'weights': weights, 'matrix': executables.file(name + '.dat'),
+                  'edges': executables.file(name + '.edges'), 'baselines': {} }
+        writeMatrix(graph['matrix'], weights)
+        writeEdgeList(graph['edges'], weights)
+        for source in SOURCES:
+            graph['baselines'][source] = executables.runSerial(source, graph['matrix'])
+        graphs[name] = graph
+    return graphs
+
+
+# integer weights can be stored in float and uint16 without rounding
+def isInteger(graph):
+    return all(w == int(w) for row in graph['weights'] for w in row)
+
+
+def testSerial(executables, checker, graphs):
+    for name, graph in graphs.items():
+        for source in SOURCES:
+            variants = [ ['--sparse'], ['--heap'], ['--transposed'], ['--isa=scalar'], ['--isa=sse2'],
+                ['--isa=avx2'], ['--isa=avx512'] ]
+            if isInteger(graph):
+                variants += [ ['--weights=float'], ['--weights=uint16'], ['--weights=uint16', '--transposed'] ]
+            for options in variants:
+                results = executables.runSerial(source, graph['matrix'], options)
+                checker.checkEqual("serial {0} {1} {2}".format(name, source, " ".join(options)),
+                    graph['baselines'][source], results, executables.lastOutput)
+
+            results = executables.runSerial(source, graph['edges'], ['--edge-list'])
+            checker.checkEqual("serial {0} {1} --edge-list".format(name, source),
+                graph['baselines'][source], results, executables.lastOutput)
+            results = executables.runSerial(source, graph['edges'], ['--edge-list', '--heap'])
+            checker.checkEqual("serial {0} {1} --edge-list --heap".format(name, source),
+                graph['baselines'][source], results, executables.lastOutput)
+
+
+def testThreaded(executables, checker, graphs):
+    for name, graph in graphs.items():
+        for source in SOURCES:
+            variants = [ ['--threads=1'], ['--threads=3'], ['--threads=3', '--transposed'], ['--threads=3', '--sparse'],
+                ['--threads=3', '--delta-stepping'], ['--threads=2', '--delta-stepping=0.5'], ['--threads=4', '--delta-stepping=100'] ]
+            if isInteger(graph):
+                variants += [ ['--threads=3', '--weights=uint16'], ['--threads=2', '--weights=float', '--transposed'] ]
+            for options in variants:
+                results = executables.runThreaded(source, graph['matrix'], options)
+                checker.checkEqual("threaded {0} {1} {2}".format(name, source, " ".join(options)),
+                    graph['baselines'][source], results, executables.lastOutput)
+
+
+def testMPI(executables, checker, graphs):
+    variants = [ [], ['--transposed'], ['--sparse'], ['--threads=2'], ['--parallel-read'], ['--parallel-read', '--transposed'],
+        ['--multi-settle'], ['--multi-settle', '--sparse'], ['--multi-settle', '--transposed'], ['--distributed'], ['--distributed=0.5'],
+        ['--sparse', '--balance=edges'], ['--sparse', '--balance=measured'], ['--distributed', '--balance=edges'], ['--shared-memory'] ]
+    for name, graph in graphs.items():
+        for source in SOURCES:
+            for numberOfProcesses in [1, 3, 4]:
+                graphVariants = variants + ([ ['--weights=uint16'], ['--weights=float', '--transposed'] ] if isInteger(graph) else [])
+                for options in graphVariants:
+                    results = executables.runMPI(numberOfProcesses, source, graph['matrix'], options)
+                    checker.checkEqual("mpi -n {0} {1} {2} {3}".format(numberOfProcesses, name, source, " ".join(options)),
+                        graph['baselines'][source], results, executables.lastOutput)
+
+                # renumbering of vertices changes order of processing vertices with equal distances, so paths can differ
+                for options in [ ['--sparse', '--balance=partition'], ['--distributed', '--balance=partition'] ]:
+                    results = executables.runMPI(numberOfProcesses, source, graph['matrix'], options)
+                    checker.checkEqual("mpi -n {0} {1} {2} {3} (distances)".format(numberOfProcesses, name, source, " ".join(options)),
+                        distancesOf(graph['baselines'][source]), distancesOf(results), executables.lastOutput)
+
+        # searches from several sources write results of each of them to separate file
+        executables.runMPI(3, SOURCES[0], graph['matrix'], ['--sources=' + ",".join(str(s) for s in SOURCES[1:])], None)
+        for source in SOURCES:
+            results = executables.read('resultsMPI_{0}.txt'.format(source))
+            checker.checkEqual("mpi -n 3 {0} --sources {1}".format(name, source), graph['baselines'][source], results)
+
+
+def testQueries(executables, checker, graphs):
+    for name, graph in graphs.items():
+        executables.runSerial(0, graph['edges'], ['--edge-list', '--build-landmarks=4'])
+        executables.runSerial(0, graph['edges'], ['--edge-list', '--build-ch'])
+        numberOfVertices = len(graph['weights'])
+        for source in SOURCES:
+            for target in [ source, (source + 1) % numberOfVertices, numberOfVertices // 2, numberOfVertices - 1 ]:
+                baseline = executables.runSerial(source, graph['matrix'], ['--target={0}'.format(target)])
+                query = "{0} {1} -> {2}".format(name, source, target)
+
+                # these searches process vertices in the same order as the baseline
+                runs = [
+                    ('serial --sparse', lambda o: executables.runSerial(source, graph['matrix'], ['--sparse'] + o)),
+                    ('serial --heap', lambda o: executables.runSerial(source, graph['matrix'], ['--heap'] + o)),
+                    ('threaded --threads=3', lambda o: executables.runThreaded(source, graph['matrix'], ['--threads=3'] + o)),
+                    ('mpi -n 3', lambda o: executables.runMPI(3, source, graph['matrix'], o)),
+                    ('mpi -n 3 --multi-settle', lambda o: executables.runMPI(3, source, graph['matrix'], ['--multi-settle'] + o)),
+                    ('mpi -n 3 --distributed', lambda o: executables.runMPI(3, source, graph['matrix'], ['--distributed'] + o)) ]
+                for engine, run in runs:
+                    results = run(['--target={0}'.format(target)])
+                    checker.checkEqual("{0} {1}".format(engine, query), baseline, results, executables.lastOutput)
+
+                # goal-directed searches can choose another path of the same length
+                runs = [
+                    ('serial --bidirectional', lambda o: executables.runSerial(source, graph['matrix'], ['--bidirectional'] + o)),
+                    ('threaded --bidirectional', lambda o: executables.runThreaded(source, graph['matrix'], ['--bidirectional', '--threads=2'] + o)),
+                    ('serial --alt', lambda o: executables.runSerial(source, graph['edges'], ['--edge-list', '--alt'] + o)),
+                    ('serial --ch', lambda o: executables.runSerial(source, graph['edges'], ['--edge-list', '--ch'] + o)) ]
+                for engine, run in runs:
+                    results = run(['--target={0}'.format(target)])
+                    checker.checkEqual("{0} {1} (distance)".format(engine, query),
+                        distancesOf(baseline), distancesOf(results), executables.lastOutput)
+
+
+# random batch of changes - new weights of existing edges, deletions (weight 0)
+# and new edges; every edge is changed at most once
+def generateChanges(weights, numberOfChanges, rng):
+    numberOfVertices = len(weights)
+    edges = [ (i, j) for i in range(0, numberOfVertices) for j in range(0, numberOfVertices) if weights[i][j] > 0 ]
+    integerWeights = all(w == int(w) for row in weights for w in row)
+    changes = {}
+    while len(changes) < numberOfChanges:
+        kind = rng.random()
+        if kind < 0.6:
+            edge = rng.choice(edges)
+            weight = rng.randint(1, 3) if integerWeights else round(weights[edge[0]][edge[1]] * rng.uniform(0.5, 2), 2)
+        elif kind < 0.8:
+            edge = rng.choice(edges)
+            weight = 0
+        else:
+            edge = (rng.randrange(numberOfVertices), rng.randrange(numberOfVertices))
+            weight = rng.randint(1, 3) if integerWeights else round(rng.uniform(0.01, 10), 2)
+        if edge[0] != edge[1]:
+            changes[edge] = weight
+    return changes
+
+
+def testUpdates(executables, checker, graphs):
+    rng = random.Random(4)
+    for name, graph in graphs.items():
+        for source in SOURCES:
+            for numberOfChanges in [1, 5, 30, 200]:
+                executables.runSerial(source, graph['edges'], ['--edge-list', '--binary-results=previous.bin'], None)
+
+                changes = generateChanges(graph['weights'], numberOfChanges, rng)
+                with open(executables.file('changes.txt'), 'w') as file:
+                    for edge, weight in changes.items():
+                        file.write( "{0} {1} {2:g}\n".format(edge[0], edge[1], weight) )
+                changedWeights = [ list(row) for row in graph['weights'] ]
+                for edge, weight in changes.items():
+                    changedWeights[edge[0]][edge[1]] = weight
+
+                # repaired results have to be the same as results of search from scratch on changed graph
+                writeMatrix(executables.file('changed.dat'), changedWeights)
+                baseline = executables.runSerial(source, executables.file('changed.dat'))
+                results = executables.runSerial(source, graph['edges'],
+                    ['--edge-list', '--update=changes.txt', '--previous-results=previous.bin'])
+                checker.checkEqual("update {0} {1} {2} changes".format(name, source, numberOfChanges),
+                    baseline, results, executables.lastOutput)
+
+    # file with wrong data is not applied at all
+    with open(executables.file('changes.txt'), 'w') as file:
+        file.write( "1 2 3\n\n4 5 x\n" )
+    graph = graphs['random']
+    executables.runSerial(0, graph['edges'], ['--edge-list', '--binary-results=previous.bin'], None)
+    results = executables.runSerial(0, graph['edges'], ['--edge-list', '--update=changes.txt', '--previous-results=previous.bin'])
+    checker.check("update with wrong data in line 3", results is None and "w linii 3" in executables.lastOutput, executables.lastOutput)
+
+
+if __name__ == '__main__':
+    main()
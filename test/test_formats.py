@@ -0,0 +1,280 @@
+#!/usr/bin/env python
+# round-trip tests of binary files - graphs written by DijkstraConverter
+# (DJKGRAPH), results written by search executables (DJKRSLTS, plain and
+# compressed predecessors) and all-pairs distance tables (APSPDIST)
+
+import argparse
+import struct
+
+from common import Executables, Checker, generateGraph, writeMatrix, writeEdgeList, splitResults, parseResults
+
+parser = argparse.ArgumentParser(description =
+    'Round-trip tests of binary files of Dijkstra algorithm implementations')
+parser.add_argument('buildDir', metavar='DIR', type=str, nargs=1,
+    help='directory with built executables (Dijkstra directory of the build)')
+parser.add_argument('--mpiexec', metavar='COMMAND', type=str, nargs=1,
+    default=['mpiexec'], help='command that runs MPI programs')
+
+args = parser.parse_args()
+
+BYTE_ORDER_MARK = 0x01020304
+
+
+def main():
+    executables = Executables(args.buildDir[0], args.mpiexec[0])
+    checker = Checker()
+    try:
+        for name, weights in [ ('random', generateGraph(90, 500, 11)),
+                               ('ties', generateGraph(70, 300, 12, integerWeights=True)),
+                               ('unreachable', generateGraph(50, 60, 13)) ]:
+            writeMatrix(executables.file(name + '.dat'), weights)
+            writeEdgeList(executables.file(name + '.edges'), weights)
+            baselines = { source: executables.runSerial(source, executables.file(name + '.dat')) for source in [0, 5] }
+            testGraphFiles(executables, checker, name, weights, baselines)
+            testResultsFiles(executables, checker, name, baselines)
+            testDistanceTables(executables, checker, name, weights)
+        testVarints(checker)
+    finally:
+        executables.remove()
+    checker.finish()
+
+
+def readFile(fileName):
+    with open(fileName, 'rb') as file:
+        return file.read()
+
+
+def readArray(data, offset, itemFormat, count):
+    return list(struct.unpack_from("={0}{1}".format(count, itemFormat), data, offset))
+
+
+def alignOffset(offset):
+    return (offset + 63) // 64 * 64
+
+
+# compressed sparse rows written at offset - every section starts at offset
+# that is a multiple of 64 bytes
+def readCompressedArrays(data, offset, numberOfVertices, numberOfEdges):
+    offsets = readArray(data, offset, 'i', numberOfVertices + 1)
+    targetsOffset = alignOffset(offset + (numberOfVertices + 1) * 4)
+    targets = readArray(data, targetsOffset, 'i', numberOfEdges)
+    weightsOffset = alignOffset(targetsOffset + numberOfEdges * 4)
+    weights = readArray(data, weightsOffset, 'd', numberOfEdges)
+    return offsets, targets, weights
+
+
+def compressedArraysToMatrix(numberOfVertices, offsets, targets, weights):
+    matrix = [ [0] * numberOfVertices for i in range(0, numberOfVertices) ]
+    for i in range(0, numberOfVertices):
+        for e in range(offsets[i], offsets[i + 1]):
+            matrix[i][targets[e]] = weights[e]
+    return matrix
+
+
+# graph file has to contain exactly the converted graph and every executable
+# has to give the same results for it as for the text file
+def testGraphFiles(executables, checker, name, weights, baselines):
+    numberOfVertices = len(weights)
+    numberOfEdges = sum(1 for row in weights for w in row if w > 0)
+    numberOfBlocks = 3
+    conversions = [ ('dense', name + '.dat', []), ('sparse', name + '.dat', ['--sparse']),
+        ('edge list', name + '.edges', ['--edge-list']), ('blocks', name + '.dat', ['--blocks={0}'.format(numberOfBlocks)]) ]
+    for conversion, inputFile, options in conversions:
+        test = "DJKGRAPH {0} {1}".format(name, conversion)
+        graphFile = executables.file(name + '.bin')
+        if not checker.check(test + " converted", executables.runConverter(executables.file(inputFile), graphFile, options), executables.lastOutput):
+            continue
+        data = readFile(graphFile)
+        magic, version, layout, byteOrderMark, _, vertices, edges, dataOffset, blockIndexOffset, blocks, _ = struct.unpack_from("=8sIIIIqqQQII", data, 0)
+        # dense graph does not count its edges
+        checker.check(test + " header", magic == b'DJKGRAPH' and version == 1 and byteOrderMark == BYTE_ORDER_MARK
+            and vertices == numberOfVertices and edges == (0 if conversion == 'dense' else numberOfEdges) and dataOffset % 64 == 0,
+            "{0} {1} {2} {3} {4} {5}".format(magic, version, byteOrderMark, vertices, edges, dataOffset))
+
+        if conversion == 'dense':
+            checker.check(test + " layout", layout == 1 and blocks == 0)
+            columns = readArray(data, dataOffset, 'd', numberOfVertices * numberOfVertices)
+            matrix = [ [ columns[j * numberOfVertices + i] for j in range(0, numberOfVertices) ] for i in range(0, numberOfVertices) ]
+            checker.check(test + " weights", matrix == weights)
+        else:
+            checker.check(test + " layout", layout == 2 and blocks == (numberOfBlocks if conversion == 'blocks' else 0))
+            offsets, targets, graphWeights = readCompressedArrays(data, dataOffset, numberOfVertices, numberOfEdges)
+            checker.check(test + " weights", compressedArraysToMatrix(numberOfVertices, offsets, targets, graphWeights) == weights)
+
+            # blocks of target vertices - the first ones are one vertex longer, together they contain all edges
+            blocksMatrix = [ [0] * numberOfVertices for i in range(0, numberOfVertices) ]
+            firstVertex = 0
+            for b in range(0, blocks):
+                first, last, blockEdges, blockOffset = struct.unpack_from("=iiqQ", data, blockIndexOffset + b * 24)
+                blockSize = numberOfVertices // blocks + (1 if b < numberOfVertices % blocks else 0)
+                checker.check("{0} block {1} range".format(test, b), first == firstVertex and last == firstVertex + blockSize - 1,
+                    "{0} {1}".format(first, last))
+                blockMatrix = compressedArraysToMatrix(numberOfVertices, *readCompressedArrays(data, blockOffset, numberOfVertices, blockEdges))
+                checker.check("{0} block {1} targets".format(test, b),
+                    all(first <= j <= last for row in blockMatrix for j in range(0, numberOfVertices) if row[j] > 0))
+                for i in range(0, numberOfVertices):
+                    for j in range(first, last + 1):
+                        blocksMatrix[i][j] = blockMatrix[i][j]
+                firstVertex += blockSize
+            if blocks > 0:
+                checker.check(test + " blocks weights", blocksMatrix == weights)
+
+        runs = [ ('serial', lambda s, o: executables.runSerial(s, graphFile, o)),
+                 ('threaded', lambda s, o: executables.runThreaded(s, graphFile, ['--threads=2'] + o)),
+                 ('mpi -n 3', lambda s, o: executables.runMPI(3, s, graphFile, o)),
+                 ('mpi -n 3 --parallel-read', lambda s, o: executables.runMPI(3, s, graphFile, ['--parallel-read'] + o)) ]
+        for engine, run in runs:
+            for source, baseline in baselines.items():
+                results = run(source, ['--sparse'] if conversion != 'dense' else [])
+                checker.checkEqual("{0} {1} {2}".format(test, engine, source), baseline, results, executables.lastOutput)
+
+
+# compressed predecessor - 0 for vertex without predecessor, otherwise zigzag
+# encoded difference between predecessor and vertex increased by 1; every byte
+# carries 7 bits, the highest bit is set in all bytes except the last one
+def encodePredecessor(vertex, predecessor):
+    if predecessor == -1:
+        value = 0
+    else:
+        difference = predecessor - vertex
+        value = (2 * difference if difference >= 0 else -2 * difference - 1) + 1
+    encoded = bytearray()
+    while value >= 0x80:
+        encoded.append(value & 0x7f | 0x80)
+        value >>= 7
+    encoded.append(value)
+    return bytes(encoded)
+
+
+def decodePredecessor(vertex, data, offset):
+    value, shift = 0, 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7f) << shift
+        shift += 7
+        if not byte & 0x80:
+            break
+    if value == 0:
+        return -1, offset
+    zigzag = value - 1
+    return vertex + (zigzag // 2 if zigzag % 2 == 0 else -(zigzag + 1) // 2), offset
+
+
+def decodePredecessors(data, offset, numberOfVertices):
+    predecessors = []
+    for vertex in range(0, numberOfVertices):
+        predecessor, offset = decodePredecessor(vertex, data, offset)
+        predecessors.append(predecessor)
+    return predecessors, offset
+
+
+# reference encoding has to round-trip differences of every length, files
+# written by executables are compared with it byte by byte
+def testVarints(checker):
+    vertex = 1 << 20
+    for predecessor in [ -1, vertex + 1, vertex - 1, vertex + 63, vertex - 64, vertex + 64, vertex - 65,
+                         vertex + 8191, vertex - 8192, vertex + 8192, 0, (1 << 31) - 1 ]:
+        encoded = encodePredecessor(vertex, predecessor)
+        checker.check("varint {0} -> {1}".format(vertex, predecessor),
+            decodePredecessor(vertex, encoded, 0) == (predecessor, len(encoded)), encoded.hex())
+    checker.check("varint one byte", len(encodePredecessor(vertex, vertex + 63)) == 1 and len(encodePredecessor(vertex, vertex - 63)) == 1)
+    checker.check("varint two bytes", len(encodePredecessor(vertex, vertex + 64)) == 2 and len(encodePredecessor(vertex, vertex - 64)) == 2
+        and len(encodePredecessor(vertex, vertex + 8191)) == 2 and len(encodePredecessor(vertex, vertex - 8191)) == 2)
+    checker.check("varint three bytes", len(encodePredecessor(vertex, vertex + 8192)) == 3 and len(encodePredecessor(vertex, vertex - 8192)) == 3)
+    checker.check("varint five bytes", len(encodePredecessor(0, (1 << 31) - 1)) == 5)
+
+
+# results file has to contain the same distances and predecessors as text
+# results, DijkstraPaths has to extract the same paths from it
+def testResultsFiles(executables, checker, name, baselines):
+    runs = [ ('serial', lambda s, o: executables.runSerial(s, executables.file(name + '.dat'), o)),
+             ('serial --sparse', lambda s, o: executables.runSerial(s, executables.file(name + '.dat'), ['--sparse'] + o)),
+             ('threaded', lambda s, o: executables.runThreaded(s, executables.file(name + '.dat'), ['--threads=3'] + o)),
+             ('mpi -n 1', lambda s, o: executables.runMPI(1, s, executables.file(name + '.dat'), o)),
+             ('mpi -n 3', lambda s, o: executables.runMPI(3, s, executables.file(name + '.dat'), o)),
+             ('mpi -n 4 --distributed', lambda s, o: executables.runMPI(4, s, executables.file(name + '.dat'), ['--distributed'] + o)) ]
+    for source, baseline in baselines.items():
+        distances, predecessors = parseResults(baseline)
+        numberOfVertices = len(distances)
+        for engine, run in runs:
+            for compressed in [False, True]:
+                test = "DJKRSLTS {0} {1} {2}{3}".format(name, engine, source, " compressed" if compressed else "")
+                resultsFile = executables.file('results.bin')
+                run(source, ['--binary-results=' + resultsFile] + (['--compress-results'] if compressed else []))
+                try:
+                    data = readFile(resultsFile)
+                except IOError:
+                    checker.check(test + " written", False, executables.lastOutput)
+                    continue
+                magic, version, byteOrderMark, vertices, sourceVertex, targetVertex, distancesOffset, predecessorsOffset, encoding, _ = \
+                    struct.unpack_from("=8sIIqqqQQII", data, 0)
+                checker.check(test + " header", magic == b'DJKRSLTS' and version == 1 and byteOrderMark == BYTE_ORDER_MARK
+                    and vertices == numberOfVertices and sourceVertex == source and targetVertex == -1
+                    and distancesOffset % 64 == 0 and predecessorsOffset % 64 == 0 and encoding == (2 if compressed else 1),
+                    "{0} {1} {2} {3} {4} {5} {6}".format(magic, version, vertices, sourceVertex, targetVertex, distancesOffset, encoding))
+
+                # text results have 6 significant digits
+                binaryDistances = readArray(data, distancesOffset, 'd', numberOfVertices)
+                checker.check(test + " distances", [ float("{0:g}".format(d)) for d in binaryDistances ] == distances)
+                if compressed:
+                    binaryPredecessors, end = decodePredecessors(data, predecessorsOffset, numberOfVertices)
+                    checker.check(test + " compressed size", end == len(data), "{0} {1}".format(end, len(data)))
+                    checker.check(test + " encoding", b''.join(encodePredecessor(v, binaryPredecessors[v])
+                        for v in range(0, numberOfVertices)) == data[predecessorsOffset:])
+                else:
+                    binaryPredecessors = readArray(data, predecessorsOffset, 'i', numberOfVertices)
+                checker.check(test + " predecessors", binaryPredecessors == predecessors)
+
+                targets = [ source, (source + 1) % numberOfVertices, numberOfVertices // 2, numberOfVertices - 1 ]
+                paths = executables.runPaths(resultsFile, targets)
+                distanceLines, pathLines = splitResults(baseline)
+                expected = "".join("{0}\n{1}\n".format(distanceLines[t + 1], pathLines[t].rstrip()) for t in targets)
+                checker.checkEqual(test + " paths", expected, "\n".join(line.rstrip() for line in paths.split("\n")) if paths else paths,
+                    executables.lastOutput)
+
+
+# reference all-pairs distances computed with Floyd-Warshall algorithm
+def floydWarshall(weights):
+    numberOfVertices = len(weights)
+    infinity = float('inf')
+    distances = [ [ 0.0 if i == j else (weights[i][j] if weights[i][j] > 0 else infinity)
+                    for j in range(0, numberOfVertices) ] for i in range(0, numberOfVertices) ]
+    for k in range(0, numberOfVertices):
+        rowK = distances[k]
+        for i in range(0, numberOfVertices):
+            rowI = distances[i]
+            distanceIK = rowI[k]
+            if distanceIK == infinity:
+                continue
+            for j in range(0, numberOfVertices):
+                if distanceIK + rowK[j] < rowI[j]:
+                    rowI[j] = distanceIK + rowK[j]
+    return distances
+
+
+def testDistanceTables(executables, checker, name, weights):
+    numberOfVertices = len(weights)
+    expected = floydWarshall(weights)
+    for numberOfProcesses in [1, 4]:
+        for options in [ [], ['--parallel-read'] ]:
+            test = "APSPDIST {0} -n {1} {2}".format(name, numberOfProcesses, " ".join(options))
+            tableFile = executables.file('distances.bin')
+            executables.runMPI(numberOfProcesses, 0, executables.file(name + '.dat'), ['--apsp=' + tableFile] + options, None)
+            try:
+                data = readFile(tableFile)
+            except IOError:
+                checker.check(test + " written", False, executables.lastOutput)
+                continue
+            magic, version, size, vertices = struct.unpack_from("=8sIIq", data, 0)
+            checker.check(test + " header", magic == b'APSPDIST' and version == 1 and size == 8 and vertices == numberOfVertices
+                and len(data) == 24 + numberOfVertices * numberOfVertices * 8)
+            table = readArray(data, 24, 'd', numberOfVertices * numberOfVertices)
+            checker.check(test + " distances", all(
+                table[i * numberOfVertices + j] == expected[i][j]
+                or abs(table[i * numberOfVertices + j] - expected[i][j]) <= 1e-9 * expected[i][j]
+                for i in range(0, numberOfVertices) for j in range(0, numberOfVertices)))
+
+
+if __name__ == '__main__':
+    main()